@@ -13,6 +13,7 @@
 
 #include <assert.h>
 
+#include <QJsonDocument>
 #include <QProcess>
 #include <QSharedMemory>
 #include <QThread>
@@ -124,6 +125,33 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
         PacketReceiver::makeUnsourcedListenerReference<AssignmentClient>(this, &AssignmentClient::handleStopNodePacket));
 }
 
+void AssignmentClient::startPacketCapture(const QString& path, qint64 maxSize) {
+    DependencyManager::get<NodeList>()->startPacketCapture(path, maxSize);
+}
+
+void AssignmentClient::startPacketReplay(const QString& path, float speed, bool isBenchmark) {
+    _isReplayBenchmark = isBenchmark;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    connect(nodeList.data(), &LimitedNodeList::packetReplayFinished, this, &AssignmentClient::packetReplayFinished);
+    nodeList->startPacketReplay(path, speed);
+}
+
+void AssignmentClient::packetReplayFinished() {
+    if (!_isReplayBenchmark) {
+        return;
+    }
+
+    if (_currentAssignment) {
+        auto frameTimeStats = QJsonDocument(_currentAssignment->getFrameTimeStats()).toJson(QJsonDocument::Compact);
+        qCInfo(assignment_client).noquote() << "Replay benchmark of" << _currentAssignment->getTypeName()
+            << "frame times:" << frameTimeStats;
+    } else {
+        qCWarning(assignment_client) << "Replay benchmark finished without the capture starting an assignment";
+    }
+    QCoreApplication::quit();
+}
+
 void AssignmentClient::stopAssignmentClient() {
     qCDebug(assignment_client) << "Forced stop of assignment-client.";
 
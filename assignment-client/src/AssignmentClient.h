@@ -28,6 +28,11 @@ public:
                      quint16 assignmentMonitorPort);
     ~AssignmentClient();
 
+    void startPacketCapture(const QString& path, qint64 maxSize);
+
+    // runs the assignment the capture was made of on its datagrams, see udt::PacketReplay
+    void startPacketReplay(const QString& path, float speed, bool isBenchmark);
+
 private slots:
     void sendAssignmentRequest();
     void assignmentCompleted();
@@ -41,6 +46,7 @@ public slots:
 private slots:
     void handleCreateAssignmentPacket(QSharedPointer<ReceivedMessage> message);
     void handleStopNodePacket(QSharedPointer<ReceivedMessage> message);
+    void packetReplayFinished();
 
 private:
     void setUpStatusToMonitor();
@@ -53,6 +59,7 @@ private:
     QTimer _requestTimer; // timer for requesting and assignment
     QTimer _statsTimerACM; // timer for sending stats to assignment client monitor
     QUuid _childAssignmentUUID = QUuid::createUuid();
+    bool _isReplayBenchmark { false };
 
  protected:
     HifiSockAddr _assignmentClientMonitorSocket;
@@ -23,6 +23,7 @@
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
 #include <shared/ScriptInitializerMixin.h>
+#include <udt/PacketCapture.h>
 
 #include "Assignment.h"
 #include "AssignmentClient.h"
@@ -102,6 +103,26 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption parentPIDOption(PARENT_PID_OPTION, "PID of the parent process", "parent-pid");
     parser.addOption(parentPIDOption);
 
+    const QCommandLineOption packetCaptureOption(ASSIGNMENT_PACKET_CAPTURE_OPTION,
+        "capture received datagrams to segment files at this path, for --replay", "capture-path");
+    parser.addOption(packetCaptureOption);
+
+    const QCommandLineOption packetCaptureMaxSizeOption(ASSIGNMENT_PACKET_CAPTURE_MAX_SIZE_OPTION,
+        "disk space a capture can take, older datagrams are dropped (default 256)", "megabytes");
+    parser.addOption(packetCaptureMaxSizeOption);
+
+    const QCommandLineOption packetReplayOption(ASSIGNMENT_PACKET_REPLAY_OPTION,
+        "replay a capture instead of using the network", "capture-path");
+    parser.addOption(packetReplayOption);
+
+    const QCommandLineOption packetReplaySpeedOption(ASSIGNMENT_PACKET_REPLAY_SPEED_OPTION,
+        "how many times faster than it was captured to replay a capture (default 1)", "speed");
+    parser.addOption(packetReplaySpeedOption);
+
+    const QCommandLineOption packetReplayBenchmarkOption(ASSIGNMENT_PACKET_REPLAY_BENCHMARK_OPTION,
+        "print the frame time distribution of the assignment and quit when the replay is done");
+    parser.addOption(packetReplayBenchmarkOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         std::cout << parser.errorText().toStdString() << std::endl; // Avoid Qt log spam
         parser.showHelp();
@@ -246,6 +267,12 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
     DependencyManager::set<ScriptInitializers>();
 
+    if ((numForks || minForks || maxForks) && (parser.isSet(packetCaptureOption) || parser.isSet(packetReplayOption))) {
+        qCritical() << "--capture and --replay capture or replay the datagrams of a single assignment-client, not of its children";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
     if (numForks || minForks || maxForks) {
         AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks,
                                                                         requestAssignmentType, assignmentPool, listenPort,
@@ -259,5 +286,15 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
                                                         assignmentServerPort, monitorPort);
         client->setParent(this);
         connect(this, &QCoreApplication::aboutToQuit, client, &AssignmentClient::aboutToQuit);
+
+        if (parser.isSet(packetReplayOption)) {
+            float speed = parser.isSet(packetReplaySpeedOption) ? parser.value(packetReplaySpeedOption).toFloat() : 1.0f;
+            client->startPacketReplay(parser.value(packetReplayOption), speed, parser.isSet(packetReplayBenchmarkOption));
+        } else if (parser.isSet(packetCaptureOption)) {
+            const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+            qint64 maxSize = parser.isSet(packetCaptureMaxSizeOption) ?
+                parser.value(packetCaptureMaxSizeOption).toLongLong() * BYTES_PER_MEGABYTE : udt::PacketCapture::DEFAULT_MAX_SIZE;
+            client->startPacketCapture(parser.value(packetCaptureOption), maxSize);
+        }
     }
 }
@@ -28,6 +28,11 @@ const QString ASSIGNMENT_MAX_FORKS_OPTION = "max";
 const QString ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION = "monitor-port";
 const QString ASSIGNMENT_HTTP_STATUS_PORT = "http-status-port";
 const QString ASSIGNMENT_LOG_DIRECTORY = "log-directory";
+const QString ASSIGNMENT_PACKET_CAPTURE_OPTION = "capture";
+const QString ASSIGNMENT_PACKET_CAPTURE_MAX_SIZE_OPTION = "capture-max-mb";
+const QString ASSIGNMENT_PACKET_REPLAY_OPTION = "replay";
+const QString ASSIGNMENT_PACKET_REPLAY_SPEED_OPTION = "replay-speed";
+const QString ASSIGNMENT_PACKET_REPLAY_BENCHMARK_OPTION = "replay-benchmark";
 
 class AssignmentClientApp : public QCoreApplication {
     Q_OBJECT
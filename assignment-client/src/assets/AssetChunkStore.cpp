@@ -0,0 +1,403 @@
+//
+//  AssetChunkStore.cpp
+//  assignment-client/src/assets
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkStore.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRegExp>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+
+static const QString CHUNKS_SUBDIR = "chunks";
+static const QString MANIFESTS_SUBDIR = "manifests";
+
+static const quint32 MANIFEST_VERSION = 1;
+
+bool AssetChunkStore::setResourcesDirectory(const QDir& resourcesDirectory) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!resourcesDirectory.mkpath(CHUNKS_SUBDIR) || !resourcesDirectory.mkpath(MANIFESTS_SUBDIR)) {
+        return false;
+    }
+    _chunksDirectory = QDir(resourcesDirectory.filePath(CHUNKS_SUBDIR));
+    _manifestsDirectory = QDir(resourcesDirectory.filePath(MANIFESTS_SUBDIR));
+
+    _chunks.clear();
+    _assetSizes.clear();
+    _assetBytes = 0;
+    _storedBytes = 0;
+
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    for (auto& fileName : _manifestsDirectory.entryList(QDir::Files)) {
+        if (!hashFileRegex.exactMatch(fileName)) {
+            continue;
+        }
+
+        auto manifest = loadManifest(_manifestsDirectory.filePath(fileName));
+        if (manifest) {
+            addReferences(*manifest);
+            _assetSizes[fileName] = manifest->size;
+            _assetBytes += manifest->size;
+        } else {
+            qCWarning(asset_server) << "Could not read the chunk manifest of" << fileName;
+        }
+    }
+
+    // chunks of uploads that didn't complete, or of assets whose removal didn't
+    int numUnusedChunks = 0;
+    QDirIterator chunkIterator(_chunksDirectory.path(), QDir::Files, QDirIterator::Subdirectories);
+    while (chunkIterator.hasNext()) {
+        auto chunkPath = chunkIterator.next();
+        if (!_chunks.contains(QByteArray::fromHex(chunkIterator.fileName().toLatin1()))) {
+            QFile::remove(chunkPath);
+            ++numUnusedChunks;
+        }
+    }
+    if (numUnusedChunks > 0) {
+        qCDebug(asset_server) << "Removed" << numUnusedChunks << "unused asset chunks";
+    }
+
+    return true;
+}
+
+bool AssetChunkStore::store(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    auto chunks = AssetUtils::chunkData(data);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_assetSizes.contains(hash)) {
+        return true;
+    }
+
+    Manifest manifest;
+    manifest.size = data.size();
+    qint64 offset = 0;
+    for (auto& chunk : chunks) {
+        if (!_chunks.contains(chunk.hash) && !writeChunk(chunk.hash, data.constData() + offset, chunk.size)) {
+            return false;
+        }
+
+        manifest.offsets.push_back(offset);
+        manifest.chunks.push_back(chunk);
+        offset += chunk.size;
+    }
+
+    return commitManifest(hash, manifest);
+}
+
+bool AssetChunkStore::Writer::write(const char* data, qint64 size) {
+    _pending.append(data, (int)size);
+    return cutChunks(false);
+}
+
+bool AssetChunkStore::Writer::finish(const AssetUtils::AssetHash& hash) {
+    if (!cutChunks(true)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_store._mutex);
+    if (_store._assetSizes.contains(hash)) {
+        return true;
+    }
+
+    // a chunk that was already stored when it was cut wasn't written again, and may have been removed since
+    for (auto& chunk : _manifest.chunks) {
+        if (!_store._chunks.contains(chunk.hash) && !QFile::exists(_store.getChunkPath(chunk.hash))) {
+            qCWarning(asset_server) << "Asset chunk" << chunk.hash.toHex() << "was removed while" << hash << "was stored";
+            return false;
+        }
+    }
+    return _store.commitManifest(hash, _manifest);
+}
+
+bool AssetChunkStore::Writer::cutChunks(bool isLast) {
+    if (_failed) {
+        return false;
+    }
+
+    // with a whole chunk's worth of data or more, a chunk is cut where it would be in the whole asset
+    const char* data = _pending.constData();
+    qint64 offset = 0;
+    qint64 size = _pending.size();
+    while (size - offset >= (qint64)AssetUtils::MAX_CHUNK_SIZE || (isLast && offset < size)) {
+        auto chunkSize = (qint64)AssetUtils::findChunkSize(data + offset, size - offset);
+        auto chunkHash = QCryptographicHash::hash(QByteArray::fromRawData(data + offset, (int)chunkSize),
+                                                  QCryptographicHash::Sha256);
+        bool isStored;
+        {
+            std::lock_guard<std::mutex> lock(_store._mutex);
+            isStored = _store._chunks.contains(chunkHash);
+        }
+        if (!isStored && !_store.writeChunk(chunkHash, data + offset, chunkSize)) {
+            _failed = true;
+            return false;
+        }
+
+        _manifest.offsets.push_back(_manifest.size);
+        _manifest.chunks.push_back({ chunkHash, (uint32_t)chunkSize });
+        _manifest.size += chunkSize;
+        offset += chunkSize;
+    }
+    _pending.remove(0, (int)offset);
+    return true;
+}
+
+bool AssetChunkStore::writeChunk(const QByteArray& chunkHash, const char* data, qint64 size) const {
+    auto chunkPath = getChunkPath(chunkHash);
+    QFileInfo(chunkPath).dir().mkpath(".");
+
+    QSaveFile chunkFile(chunkPath);
+    if (!chunkFile.open(QIODevice::WriteOnly) || chunkFile.write(data, size) != size || !chunkFile.commit()) {
+        qCWarning(asset_server) << "Could not write asset chunk" << chunkPath << "-" << chunkFile.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool AssetChunkStore::commitManifest(const AssetUtils::AssetHash& hash, const Manifest& manifest) {
+    QSaveFile manifestFile(getManifestPath(hash));
+    if (!manifestFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream(&manifestFile);
+    stream << MANIFEST_VERSION << manifest.size << (quint32)manifest.chunks.size();
+    for (auto& chunk : manifest.chunks) {
+        stream.writeRawData(chunk.hash.constData(), chunk.hash.size());
+        stream << (quint32)chunk.size;
+    }
+    if (stream.status() != QDataStream::Ok || !manifestFile.commit()) {
+        qCWarning(asset_server) << "Could not write the chunk manifest of" << hash << "-" << manifestFile.errorString();
+        return false;
+    }
+
+    addReferences(manifest);
+    _assetSizes[hash] = manifest.size;
+    _assetBytes += manifest.size;
+    return true;
+}
+
+bool AssetChunkStore::contains(const AssetUtils::AssetHash& hash) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _assetSizes.contains(hash);
+}
+
+AssetChunkStore::ManifestPointer AssetChunkStore::readManifest(const AssetUtils::AssetHash& hash) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_assetSizes.contains(hash)) {
+        return nullptr;
+    }
+    auto manifest = loadManifest(getManifestPath(hash));
+    if (!manifest) {
+        return nullptr;
+    }
+
+    // replies streaming the asset read its chunks long after this, they stay until the manifest is let go of
+    for (auto& chunk : manifest->chunks) {
+        ++_pinnedChunks[chunk.hash];
+    }
+    return ManifestPointer(manifest.get(), [this, manifest](const Manifest*) {
+        unpin(*manifest);
+    });
+}
+
+void AssetChunkStore::unpin(const Manifest& manifest) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& chunk : manifest.chunks) {
+        auto it = _pinnedChunks.find(chunk.hash);
+        if (it == _pinnedChunks.end() || --it.value() > 0) {
+            continue;
+        }
+        _pinnedChunks.erase(it);
+
+        // unless an asset stored since has it again
+        if (_removedPinnedChunks.remove(chunk.hash) && !_chunks.contains(chunk.hash)) {
+            QFile::remove(getChunkPath(chunk.hash));
+        }
+    }
+}
+
+void AssetChunkStore::removeChunk(const QByteArray& chunkHash) {
+    auto chunkIt = _chunks.find(chunkHash);
+    _storedBytes -= chunkIt->size;
+    _chunks.erase(chunkIt);
+
+    if (_pinnedChunks.contains(chunkHash)) {
+        _removedPinnedChunks.insert(chunkHash);
+    } else {
+        QFile::remove(getChunkPath(chunkHash));
+    }
+}
+
+bool AssetChunkStore::remove(const AssetUtils::AssetHash& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _assetSizes.find(hash);
+    if (it == _assetSizes.end()) {
+        return false;
+    }
+
+    auto manifestPath = getManifestPath(hash);
+    auto manifest = loadManifest(manifestPath);
+    if (!QFile::remove(manifestPath)) {
+        return false;
+    }
+    _assetBytes -= it.value();
+    _assetSizes.erase(it);
+
+    if (manifest) {
+        for (auto& chunk : manifest->chunks) {
+            auto chunkIt = _chunks.find(chunk.hash);
+            if (chunkIt != _chunks.end() && --chunkIt->references == 0) {
+                removeChunk(chunk.hash);
+            }
+        }
+    }
+    return true;
+}
+
+QStringList AssetChunkStore::getHashes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _assetSizes.keys();
+}
+
+bool AssetChunkStore::read(const Manifest& manifest, qint64 offset, qint64 size, char* data) const {
+    // the reader only holds the manifest while it reads
+    Reader reader(*this, ManifestPointer(&manifest, [](const Manifest*) {}));
+    return reader.read(offset, size, data);
+}
+
+bool AssetChunkStore::Reader::read(qint64 offset, qint64 size, char* data) {
+    auto& manifest = *_manifest;
+    if (offset < 0 || size < 0 || offset + size > manifest.size) {
+        return false;
+    }
+
+    // the chunk the range starts in
+    size_t index = std::upper_bound(manifest.offsets.begin(), manifest.offsets.end(), offset) -
+        manifest.offsets.begin() - 1;
+
+    while (size > 0) {
+        auto& chunk = manifest.chunks[index];
+        qint64 chunkOffset = offset - manifest.offsets[index];
+        qint64 readSize = std::min(size, (qint64)chunk.size - chunkOffset);
+
+        if (!_chunkFile.isOpen() || index != _chunkIndex) {
+            _chunkFile.close();
+            _chunkFile.setFileName(_store.getChunkPath(chunk.hash));
+            if (!_chunkFile.open(QIODevice::ReadOnly)) {
+                return false;
+            }
+            _chunkIndex = index;
+        }
+        if (!_chunkFile.seek(chunkOffset) || _chunkFile.read(data, readSize) != readSize) {
+            _chunkFile.close();
+            return false;
+        }
+
+        data += readSize;
+        offset += readSize;
+        size -= readSize;
+        ++index;
+    }
+    return true;
+}
+
+bool AssetChunkStore::assemble(const AssetUtils::AssetHash& hash, const QString& filePath) const {
+    auto manifest = readManifest(hash);
+    if (!manifest) {
+        return false;
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    for (auto& chunk : manifest->chunks) {
+        QFile chunkFile(getChunkPath(chunk.hash));
+        if (!chunkFile.open(QIODevice::ReadOnly) || file.write(chunkFile.readAll()) != (qint64)chunk.size) {
+            file.cancelWriting();
+            return false;
+        }
+    }
+    return file.commit();
+}
+
+AssetChunkStore::Stats AssetChunkStore::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Stats stats;
+    stats.numAssets = _assetSizes.size();
+    stats.numChunks = _chunks.size();
+    stats.assetBytes = _assetBytes;
+    stats.storedBytes = _storedBytes;
+    return stats;
+}
+
+QString AssetChunkStore::getChunkPath(const QByteArray& chunkHash) const {
+    // spread over subdirectories by the first byte of the hash, so that none of them holds too many files
+    auto hexHash = QString(chunkHash.toHex());
+    return _chunksDirectory.filePath(hexHash.left(2) + "/" + hexHash);
+}
+
+QString AssetChunkStore::getManifestPath(const AssetUtils::AssetHash& hash) const {
+    return _manifestsDirectory.filePath(hash);
+}
+
+AssetChunkStore::ManifestPointer AssetChunkStore::loadManifest(const QString& manifestPath) const {
+    QFile manifestFile(manifestPath);
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    QDataStream stream(&manifestFile);
+    quint32 version;
+    auto manifest = std::make_shared<Manifest>();
+    quint32 numChunks;
+    stream >> version >> manifest->size >> numChunks;
+    if (version != MANIFEST_VERSION) {
+        return nullptr;
+    }
+
+    qint64 offset = 0;
+    for (quint32 i = 0; i < numChunks && stream.status() == QDataStream::Ok; ++i) {
+        AssetUtils::AssetChunk chunk;
+        chunk.hash.resize(AssetUtils::SHA256_HASH_LENGTH);
+        stream.readRawData(chunk.hash.data(), chunk.hash.size());
+        quint32 size;
+        stream >> size;
+        chunk.size = size;
+
+        manifest->offsets.push_back(offset);
+        manifest->chunks.push_back(chunk);
+        offset += size;
+    }
+
+    if (stream.status() != QDataStream::Ok || offset != manifest->size) {
+        return nullptr;
+    }
+    return manifest;
+}
+
+void AssetChunkStore::addReferences(const Manifest& manifest) {
+    for (auto& chunk : manifest.chunks) {
+        auto& storedChunk = _chunks[chunk.hash];
+        if (storedChunk.references++ == 0) {
+            storedChunk.size = chunk.size;
+            _storedBytes += chunk.size;
+        }
+    }
+}
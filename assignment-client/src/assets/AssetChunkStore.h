@@ -0,0 +1,135 @@
+//
+//  AssetChunkStore.h
+//  assignment-client/src/assets
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkStore_h
+#define hifi_AssetChunkStore_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+
+// Stores large assets as content defined chunks, each chunk once however many assets have it, with a manifest per
+// asset listing its chunks.  The versions of an asset that was uploaded again with a few changes then take little
+// more space than one of them.
+// All members are thread safe.
+class AssetChunkStore {
+public:
+    // smaller assets are stored whole, there would be little to share between their versions
+    static const qint64 MIN_CHUNKED_ASSET_SIZE = 1024 * 1024;
+
+    struct Manifest {
+        qint64 size { 0 };
+        std::vector<AssetUtils::AssetChunk> chunks;
+        std::vector<qint64> offsets; // where each chunk starts in the asset
+    };
+    using ManifestPointer = std::shared_ptr<const Manifest>;
+
+    struct Stats {
+        int numAssets { 0 };
+        int numChunks { 0 };
+        qint64 assetBytes { 0 }; // the sizes of the assets
+        qint64 storedBytes { 0 }; // the sizes of the chunks they share
+    };
+
+    // uses the chunks and manifests directories of the asset server's resources directory, and reads the manifests
+    // already there
+    bool setResourcesDirectory(const QDir& resourcesDirectory);
+
+    // Stores an asset while it is still arriving, cut in the same chunks store() would cut it in, so that it never
+    // has to be held whole.  Chunks are written as they are cut, the asset exists once the writer is finished, and the
+    // chunks of a writer that never finishes are removed the next time the store is set up.
+    class Writer {
+    public:
+        Writer(AssetChunkStore& store) : _store(store) {}
+
+        bool write(const char* data, qint64 size);
+        // hash is the hash of everything written, computed by the caller as the data went by
+        bool finish(const AssetUtils::AssetHash& hash);
+
+    private:
+        bool cutChunks(bool isLast);
+
+        AssetChunkStore& _store;
+        QByteArray _pending; // what wasn't cut in chunks yet, never more than a chunk once written
+        Manifest _manifest;
+        bool _failed { false };
+    };
+
+    // Reads ranges of an asset one after the other, like the packets of a reply, keeping the chunk file it last read
+    // from open
+    class Reader {
+    public:
+        Reader(const AssetChunkStore& store, ManifestPointer manifest) : _store(store), _manifest(std::move(manifest)) {}
+
+        bool read(qint64 offset, qint64 size, char* data);
+
+    private:
+        const AssetChunkStore& _store;
+        ManifestPointer _manifest;
+        QFile _chunkFile;
+        size_t _chunkIndex { 0 };
+    };
+
+    bool store(const AssetUtils::AssetHash& hash, const QByteArray& data);
+    bool contains(const AssetUtils::AssetHash& hash) const;
+    // the chunks of the manifest are kept, even if the asset is removed, for as long as the manifest is held
+    ManifestPointer readManifest(const AssetUtils::AssetHash& hash) const;
+
+    // removes the manifest of an asset, and the chunks no other asset has once no manifest read before is held
+    bool remove(const AssetUtils::AssetHash& hash);
+
+    QStringList getHashes() const;
+
+    bool read(const Manifest& manifest, qint64 offset, qint64 size, char* data) const;
+
+    // writes an asset out whole, for tools that need it as a file
+    bool assemble(const AssetUtils::AssetHash& hash, const QString& filePath) const;
+
+    Stats getStats() const;
+
+private:
+    QString getChunkPath(const QByteArray& chunkHash) const;
+    QString getManifestPath(const AssetUtils::AssetHash& hash) const;
+    ManifestPointer loadManifest(const QString& manifestPath) const;
+    bool writeChunk(const QByteArray& chunkHash, const char* data, qint64 size) const;
+    // writes the manifest and counts its chunks as used, to be called with _mutex held
+    bool commitManifest(const AssetUtils::AssetHash& hash, const Manifest& manifest);
+    void addReferences(const Manifest& manifest);
+    void removeChunk(const QByteArray& chunkHash);
+    void unpin(const Manifest& manifest) const;
+
+    struct StoredChunk {
+        uint32_t size { 0 };
+        int references { 0 }; // how many times the manifests list the chunk
+    };
+
+    QDir _chunksDirectory;
+    QDir _manifestsDirectory;
+
+    mutable std::mutex _mutex;
+    QHash<QByteArray, StoredChunk> _chunks;
+    // the chunks of the manifests being read, and those of them whose assets were removed meanwhile
+    mutable QHash<QByteArray, int> _pinnedChunks;
+    mutable QSet<QByteArray> _removedPinnedChunks;
+    QHash<AssetUtils::AssetHash, qint64> _assetSizes;
+    qint64 _assetBytes { 0 };
+    qint64 _storedBytes { 0 };
+};
+
+#endif // hifi_AssetChunkStore_h
@@ -113,11 +113,44 @@ QString getBakeMapping(const AssetUtils::AssetHash& hash, const QString& relativ
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+
+// ovens are separate processes, that can mostly run alongside each other
+static const int DEFAULT_MAX_CONCURRENT_BAKES = std::max((int)std::thread::hardware_concurrency() / 2, 1);
+static const qint64 DEFAULT_BAKING_MEMORY_BUDGET = 2048 * BYTES_PER_MEGABYTE;
+
+QString bakeKindForAssetType(BakedAssetType type) {
+    switch (type) {
+        case BakedAssetType::Model:
+            return "model";
+        case BakedAssetType::Texture:
+            return "texture";
+        case BakedAssetType::Script:
+            return "script";
+        default:
+            return "";
+    }
+}
+
+// the most memory an oven is expected to need to bake an asset, a model's textures are baked along with it
+qint64 estimateBakeMemory(BakedAssetType type, qint64 size) {
+    static const qint64 OVEN_MEMORY = 64 * BYTES_PER_MEGABYTE;
+    switch (type) {
+        case BakedAssetType::Model:
+            return OVEN_MEMORY + 16 * size;
+        case BakedAssetType::Texture:
+            // compressed images are decoded to RGBA, with mips, before they are compressed again
+            return OVEN_MEMORY + 32 * size;
+        default:
+            return OVEN_MEMORY + 2 * size;
+    }
+}
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, &_chunkStore);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -125,7 +158,16 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        auto type = assetTypeForFilename(assetPath);
+        BakingScheduler::Bake bake;
+        bake.key = assetHash;
+        bake.path = assetPath;
+        bake.kind = bakeKindForAssetType(type);
+        auto manifest = _chunkStore.readManifest(assetHash);
+        bake.size = manifest ? manifest->size : QFileInfo(filePath).size();
+        bake.memoryEstimate = estimateBakeMemory(type, bake.size);
+        bake.runnable = task.get();
+        _bakingScheduler.enqueue(bake);
     } else {
         qDebug() << "Already in queue";
     }
@@ -295,6 +337,7 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
     _bakingTaskPool(this),
+    _bakingScheduler(_bakingTaskPool, DEFAULT_MAX_CONCURRENT_BAKES, DEFAULT_BAKING_MEMORY_BUDGET),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
 {
     BAKEABLE_TEXTURE_EXTENSIONS = image::getSupportedFormats();
@@ -304,11 +347,16 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+
+    // how long bakes are expected to take until some were timed, these only decide which bakes are started first
+    _bakingScheduler.setInitialRate(bakeKindForAssetType(BakedAssetType::Script), 20.0);
+    _bakingScheduler.setInitialRate(bakeKindForAssetType(BakedAssetType::Texture), 2000.0);
+    _bakingScheduler.setInitialRate(bakeKindForAssetType(BakedAssetType::Model), 8000.0);
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation },
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetBatch, PacketType::AssetGetInfo,
+                                              PacketType::AssetUpload, PacketType::AssetMappingOperation },
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::queueRequests));
 
 #ifdef Q_OS_WIN
@@ -331,18 +379,13 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
-    // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
-    auto it = _pendingBakes.begin();
-    while (it != _pendingBakes.end()) {
-        auto pendingRunnable =  _bakingTaskPool.tryTake(it->get());
-
-        if (pendingRunnable) {
-            it = _pendingBakes.erase(it);
-        } else {
-            qDebug() << "Aborting bake for" << it.key();
-            it.value()->abort();
-            ++it;
-        }
+    // remove pending bakes that were never started, abort each of our still running bake tasks
+    for (auto& hash : _bakingScheduler.clearQueued()) {
+        _pendingBakes.remove(hash);
+    }
+    for (auto it = _pendingBakes.begin(); it != _pendingBakes.end(); ++it) {
+        qDebug() << "Aborting bake for" << it.key();
+        it.value()->abort();
     }
 
     // make sure all bakers are finished or aborted
@@ -393,6 +436,18 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    static const QString MAX_CONCURRENT_BAKES_OPTION = "max_concurrent_bakes";
+    static const QString BAKING_MEMORY_BUDGET_OPTION = "baking_memory_budget";
+    auto maxConcurrentBakes = assetServerObject[MAX_CONCURRENT_BAKES_OPTION].toInt(0);
+    if (maxConcurrentBakes <= 0) {
+        maxConcurrentBakes = DEFAULT_MAX_CONCURRENT_BAKES;
+    }
+    auto bakingMemoryBudget = (qint64)assetServerObject[BAKING_MEMORY_BUDGET_OPTION]
+        .toInt(DEFAULT_BAKING_MEMORY_BUDGET / BYTES_PER_MEGABYTE) * BYTES_PER_MEGABYTE;
+    _bakingScheduler.setLimits(maxConcurrentBakes, bakingMemoryBudget);
+    qCInfo(asset_server) << "Running up to" << maxConcurrentBakes << "bakes at a time, within"
+        << bakingMemoryBudget / BYTES_PER_MEGABYTE << "MB.";
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -425,6 +480,17 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    if (!_chunkStore.setResourcesDirectory(_resourcesDirectory)) {
+        qCCritical(asset_server) << "Unable to create chunk directories for asset-server files. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+
+    // uploads that were still arriving when the server stopped
+    for (auto& fileName : _filesDirectory.entryList({ "*" + PARTIAL_UPLOAD_FILE_SUFFIX }, QDir::Files)) {
+        _filesDirectory.remove(fileName);
+    }
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -435,7 +501,8 @@ void AssetServer::completeSetup() {
         QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
         auto hashedFiles = files.filter(hashFileRegex);
 
-        qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
+        qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory and"
+            << _chunkStore.getStats().numAssets << "assets stored as chunks.";
 
         if (_fileMappings.size() > 0) {
             cleanupUnmappedFiles();
@@ -459,6 +526,15 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    static const QString MEMORY_CACHE_SIZE_OPTION = "memory_cache_size";
+    auto memoryCacheSize = (uint64_t)assetServerObject[MEMORY_CACHE_SIZE_OPTION]
+        .toInt(AssetMemoryCache::DEFAULT_SIZE / BYTES_PER_MEGABYTE);
+    _isMemoryCacheEnabled = memoryCacheSize > 0;
+    if (_isMemoryCacheEnabled) {
+        _memoryCache.data.setMaxWeight(memoryCacheSize * BYTES_PER_MEGABYTE);
+        qCInfo(asset_server) << "Keeping up to" << memoryCacheSize << "MB of popular assets in memory.";
+    }
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -467,10 +543,13 @@ void AssetServer::completeSetup() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGet));
+    packetReceiver.registerListener(PacketType::AssetGetBatch,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGetBatch));
     packetReceiver.registerListener(PacketType::AssetGetInfo,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGetInfo));
+    // uploads are read as they arrive
     packetReceiver.registerListener(PacketType::AssetUpload,
-        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload), true);
     packetReceiver.registerListener(PacketType::AssetMappingOperation,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetMappingOperation));
 
@@ -506,6 +585,9 @@ void AssetServer::replayRequests() {
             case PacketType::AssetGet:
                 handleAssetGet(request.first, request.second);
                 break;
+            case PacketType::AssetGetBatch:
+                handleAssetGetBatch(request.first, request.second);
+                break;
             case PacketType::AssetGetInfo:
                 handleAssetGetInfo(request.first, request.second);
                 break;
@@ -532,20 +614,15 @@ void AssetServer::cleanupUnmappedFiles() {
     for (const auto& fileInfo : files) {
         auto filename = fileInfo.fileName();
         if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
+            if (!_fileMappings.isMapped(filename)) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
+                    _memoryCache.remove(filename);
+
                     removeBakedPathsForDeletedAsset(filename);
                 } else {
                     qCDebug(asset_server) << "\tAttempt to delete unmapped file" << filename << "failed";
@@ -553,6 +630,16 @@ void AssetServer::cleanupUnmappedFiles() {
             }
         }
     }
+
+    for (const auto& hash : _chunkStore.getHashes()) {
+        if (!_fileMappings.isMapped(hash) && _chunkStore.remove(hash)) {
+            qCDebug(asset_server) << "\tDeleted" << hash << "from asset chunks since it is unmapped.";
+
+            _memoryCache.remove(hash);
+
+            removeBakedPathsForDeletedAsset(hash);
+        }
+    }
 }
 
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
@@ -575,12 +662,7 @@ void AssetServer::cleanupBakedFilesForDeletedAssets() {
     // enumerate the hashes for which we have baked content
     for (const auto& hash : bakedHashes) {
         // check if we have a mapping that points to this hash
-        auto matchingMapping = std::find_if(std::begin(_fileMappings), std::end(_fileMappings),
-                                            [&hash](const std::pair<AssetUtils::AssetPath, AssetUtils::AssetHash> mappingPair) {
-            return mappingPair.second == hash;
-        });
-
-        if (matchingMapping == std::end(_fileMappings)) {
+        if (!_fileMappings.isMapped(hash)) {
             // we didn't find a mapping for this hash, remove any baked content we still have for it
             removeBakedPathsForDeletedAsset(hash);
         }
@@ -609,7 +691,7 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
             handleGetMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::GetAll:
-            handleGetAllMappingOperation(*replyPacket);
+            handleGetAllMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::Set:
             handleSetMappingOperation(*message, canWriteToAssetServer, *replyPacket);
@@ -623,6 +705,12 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
         case AssetMappingOperationType::SetBakingEnabled:
             handleSetBakingEnabledOperation(*message, canWriteToAssetServer, *replyPacket);
             break;
+        case AssetMappingOperationType::GetBakingQueue:
+            handleGetBakingQueueOperation(*replyPacket);
+            break;
+        case AssetMappingOperationType::GetAssetChunks:
+            handleGetAssetChunksOperation(*message, *replyPacket);
+            break;
     }
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -706,14 +794,34 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
     }
 }
 
-void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
+void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket) {
+    // the mappings can be asked for a folder at a time, and a page at a time
+    AssetUtils::AssetPath prefix;
+    AssetUtils::AssetPath startAfter;
+    uint32_t limit = 0;
+    if (message.getBytesLeftToRead() > 0) {
+        prefix = message.readString();
+        startAfter = message.readString();
+        message.readPrimitive(&limit);
+    }
+
+    std::vector<AssetMappingStore::const_iterator> page;
+    auto pageEnd = _fileMappings.lowerBound(prefix, startAfter);
+    for (; pageEnd != _fileMappings.cend() && pageEnd->first.startsWith(prefix); ++pageEnd) {
+        if (limit > 0 && page.size() >= limit) {
+            break;
+        }
+        page.push_back(pageEnd);
+    }
+    bool hasMore = pageEnd != _fileMappings.cend() && pageEnd->first.startsWith(prefix) && !page.empty();
+
     replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
 
-    uint32_t count = (uint32_t)_fileMappings.size();
+    uint32_t count = (uint32_t)page.size();
 
     replyPacket.writePrimitive(count);
 
-    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
+    for (auto& it : page) {
         auto mapping = it->first;
         auto hash = it->second;
         replyPacket.writeString(mapping);
@@ -727,6 +835,49 @@ void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
             replyPacket.writeString(lastBakeErrors);
         }
     }
+
+    // where the next page starts, empty once all the mappings were sent
+    replyPacket.writeString(hasMore ? page.back()->first : AssetUtils::AssetPath());
+}
+
+void AssetServer::handleGetBakingQueueOperation(NLPacketList& replyPacket) {
+    replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
+
+    auto stats = _bakingScheduler.getStats();
+    replyPacket.writePrimitive((uint32_t)stats.numQueued);
+    replyPacket.writePrimitive((uint32_t)stats.maxConcurrentBakes);
+    replyPacket.writePrimitive((int64_t)stats.etaMsecs);
+
+    auto writeBakes = [&replyPacket](const std::vector<BakingScheduler::BakeRecord>& bakes) {
+        replyPacket.writePrimitive((uint32_t)bakes.size());
+        for (auto& bake : bakes) {
+            replyPacket.writeString(bake.path);
+            replyPacket.write(QByteArray::fromHex(bake.key.toUtf8()));
+            replyPacket.writePrimitive((int64_t)bake.size);
+            replyPacket.writePrimitive((int64_t)bake.msecs);
+        }
+    };
+    writeBakes(stats.running);
+    writeBakes(stats.recent);
+}
+
+void AssetServer::handleGetAssetChunksOperation(ReceivedMessage& message, NLPacketList& replyPacket) {
+    auto assetHash = message.read(AssetUtils::SHA256_HASH_LENGTH).toHex();
+
+    auto manifest = _chunkStore.readManifest(assetHash);
+    if (!manifest) {
+        // the asset isn't stored as chunks, the client can still get all of it
+        replyPacket.writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+        return;
+    }
+
+    replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
+    replyPacket.writePrimitive((int64_t)manifest->size);
+    replyPacket.writePrimitive((uint32_t)manifest->chunks.size());
+    for (auto& chunk : manifest->chunks) {
+        replyPacket.write(chunk.hash);
+        replyPacket.writePrimitive(chunk.size);
+    }
 }
 
 void AssetServer::handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket) {
@@ -847,12 +998,28 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->write(assetHash);
 
     QString fileName = QString(hexHash);
-    QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
 
-    if (fileInfo.exists() && fileInfo.isReadable()) {
-        qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+    // assets never change once stored, so the size of one that is still there can be answered from memory
+    qint64 fileSize = 0;
+    bool isFound = _isMemoryCacheEnabled && _memoryCache.sizes.get(fileName, fileSize);
+    if (!isFound) {
+        QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+        if (fileInfo.exists() && fileInfo.isReadable()) {
+            qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+            fileSize = fileInfo.size();
+            isFound = true;
+        } else if (auto manifest = _chunkStore.readManifest(fileName)) {
+            fileSize = manifest->size;
+            isFound = true;
+        }
+        if (isFound && _isMemoryCacheEnabled) {
+            _memoryCache.sizes.put(fileName, fileSize, 1);
+        }
+    }
+
+    if (isFound) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-        replyPacket->writePrimitive(fileInfo.size());
+        replyPacket->writePrimitive(fileSize);
     } else {
         qCDebug(asset_server) << "Asset not found: " << QString(hexHash);
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -872,7 +1039,14 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _isMemoryCacheEnabled ? &_memoryCache : nullptr,
+                                  &_chunkStore);
+    _transferTaskPool.start(task);
+}
+
+void AssetServer::handleAssetGetBatch(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _isMemoryCacheEnabled ? &_memoryCache : nullptr,
+                                  &_chunkStore);
     _transferTaskPool.start(task);
 }
 
@@ -886,7 +1060,8 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _transferTaskPool,
+                                        &_chunkStore);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -895,8 +1070,9 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
 
         auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
 
+        // the upload may still be arriving
         MessageID messageID;
-        message->readPrimitive(&messageID);
+        message->readHeadPrimitive(&messageID);
 
         // write the message ID and a permission denied error
         permissionErrorPacket->writePrimitive(messageID);
@@ -965,6 +1141,46 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    if (_isMemoryCacheEnabled) {
+        auto dataStats = _memoryCache.data.getStats();
+        auto sizeStats = _memoryCache.sizes.getStats();
+        auto hitRate = [](uint64_t hits, uint64_t misses) {
+            return hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0;
+        };
+
+        QJsonObject cacheStats;
+        cacheStats["1. Asset Hit Rate (%)"] = hitRate(dataStats.hits, dataStats.misses);
+        cacheStats["2. Asset Hits"] = (double)dataStats.hits;
+        cacheStats["3. Asset Misses"] = (double)dataStats.misses;
+        cacheStats["4. Served From Memory (MB)"] = _memoryCache.bytesServed / (double)BYTES_PER_MEGABYTE;
+        cacheStats["5. Cached Assets"] = (double)dataStats.numEntries;
+        cacheStats["6. Cached (MB)"] = dataStats.weight / (double)BYTES_PER_MEGABYTE;
+        cacheStats["7. Size Hit Rate (%)"] = hitRate(sizeStats.hits, sizeStats.misses);
+        serverStats["Memory Cache"] = cacheStats;
+    }
+
+    auto bakingStats = _bakingScheduler.getStats();
+    QJsonObject bakingQueueStats;
+    bakingQueueStats["1. Queued"] = bakingStats.numQueued;
+    bakingQueueStats["2. Running"] = (int)bakingStats.running.size();
+    bakingQueueStats["3. Max Concurrent"] = bakingStats.maxConcurrentBakes;
+    bakingQueueStats["4. ETA (s)"] = bakingStats.etaMsecs / (double)MSECS_PER_SECOND;
+    bakingQueueStats["5. Memory Budgeted (MB)"] = bakingStats.memoryInUse / (double)BYTES_PER_MEGABYTE;
+    if (!bakingStats.recent.empty()) {
+        bakingQueueStats["6. Last Bake (s)"] = bakingStats.recent.front().msecs / (double)MSECS_PER_SECOND;
+    }
+    serverStats["Baking Queue"] = bakingQueueStats;
+
+    auto chunkStats = _chunkStore.getStats();
+    QJsonObject chunkStoreStats;
+    chunkStoreStats["1. Assets"] = chunkStats.numAssets;
+    chunkStoreStats["2. Asset (MB)"] = chunkStats.assetBytes / (double)BYTES_PER_MEGABYTE;
+    chunkStoreStats["3. Stored (MB)"] = chunkStats.storedBytes / (double)BYTES_PER_MEGABYTE;
+    chunkStoreStats["4. Chunks"] = chunkStats.numChunks;
+    chunkStoreStats["5. Saved (%)"] = chunkStats.assetBytes > 0 ?
+        100.0 * (chunkStats.assetBytes - chunkStats.storedBytes) / chunkStats.assetBytes : 0.0;
+    serverStats["Chunk Store"] = chunkStoreStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -972,90 +1188,7 @@ void AssetServer::sendStatsPacket() {
 static const QString MAP_FILE_NAME = "map.json";
 
 bool AssetServer::loadMappingsFromFile() {
-
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.exists()) {
-        if (mapFile.open(QIODevice::ReadOnly)) {
-            QJsonParseError error;
-
-            auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
-
-            if (error.error == QJsonParseError::NoError) {
-                if (!jsonDocument.isObject()) {
-                    qCWarning(asset_server) << "Failed to read mapping file, root value in" << mapFilePath << "is not an object";
-                    return false;
-                }
-
-                //_fileMappings = jsonDocument.object().toVariantHash();
-                auto root = jsonDocument.object();
-                for (auto it = root.begin(); it != root.end(); ++it) {
-                    auto key = it.key();
-                    auto value = it.value();
-
-                    if (!value.isString()) {
-                        qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
-                        continue;
-                    }
-
-                    if (!AssetUtils::isValidFilePath(key)) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
-                        continue;
-                    }
-
-                    if (!AssetUtils::isValidHash(value.toString())) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
-                        continue;
-                    }
-
-
-                    qDebug() << "Added " << key << value.toString();
-                    _fileMappings[key] = value.toString();
-                }
-
-                qCInfo(asset_server) << "Loaded" << _fileMappings.size() << "mappings from map file at" << mapFilePath;
-                return true;
-            }
-        }
-
-        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
-        return false;
-    } else {
-        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
-    }
-
-    return true;
-}
-
-bool AssetServer::writeMappingsToFile() {
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QSaveFile mapFile { mapFilePath };
-    if (mapFile.open(QIODevice::WriteOnly)) {
-        QJsonObject root;
-
-        for (auto it : _fileMappings) {
-            root[it.first] = it.second;
-        }
-
-        QJsonDocument jsonDocument { root };
-
-        if (mapFile.write(jsonDocument.toJson()) != -1) {
-            if (mapFile.commit()) {
-                qCDebug(asset_server) << "Wrote JSON mappings to file at" << mapFilePath;
-                return true;
-            } else {
-                qCWarning(asset_server) << "Failed to commit JSON mappings to file at" << mapFilePath;
-            }
-        } else {
-            qCWarning(asset_server) << "Failed to write JSON mappings to file at" << mapFilePath;
-        }
-    } else {
-        qCWarning(asset_server) << "Failed to open map file at" << mapFilePath;
-    }
-
-    return false;
+    return _fileMappings.load(_resourcesDirectory.absoluteFilePath(MAP_FILE_NAME));
 }
 
 bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash) {
@@ -1071,27 +1204,13 @@ bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash h
         return false;
     }
 
-    // remember what the old mapping was in case persistence fails
-    auto it = _fileMappings.find(path);
-    auto oldMapping = it != _fileMappings.end() ? it->second : "";
-
-    // update the in memory QHash
-    _fileMappings[path] = hash;
-
-    // attempt to write to file
-    if (writeMappingsToFile()) {
+    // the mapping only changes in memory once it was persisted
+    if (_fileMappings.set(path, hash)) {
         // persistence succeeded, we are good to go
         qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
         maybeBake(path, hash);
         return true;
     } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.erase(_fileMappings.find(path));
-        } else {
-            _fileMappings[path] = oldMapping;
-        }
-
         qCWarning(asset_server) << "Failed to persist mapping:" << path << "=>" << hash;
 
         return false;
@@ -1115,8 +1234,7 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
 }
 
 bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
+    AssetMappingStore::Edits edits;
 
     QSet<QString> hashesToCheckForDeletion;
 
@@ -1126,24 +1244,20 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         // figure out if this path will delete a file or folder
         if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
-            auto sizeBefore = _fileMappings.size();
+            // the mappings in a folder are next to each other, sorted by path
+            auto folderMappings = _fileMappings.findPrefix(path);
+            int numDeleted = 0;
 
-            while (it != _fileMappings.end()) {
-                if (it->first.startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it->second;
+            for (auto it = folderMappings.first; it != folderMappings.second; ++it) {
+                // add this hash to the list we need to check for asset removal from the server
+                hashesToCheckForDeletion << it->second;
 
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
+                edits.push_back({ it->first, AssetUtils::AssetHash() });
+                ++numDeleted;
             }
 
-            auto sizeNow = _fileMappings.size();
-            if (sizeBefore != sizeNow) {
-                qCDebug(asset_server) << "Deleted" << sizeBefore - sizeNow << "mappings in folder: " << path;
+            if (numDeleted > 0) {
+                qCDebug(asset_server) << "Deleted" << numDeleted << "mappings in folder: " << path;
             } else {
                 qCDebug(asset_server) << "Did not find any mappings to delete in folder:" << path;
             }
@@ -1156,33 +1270,31 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
                 qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << it->second;
 
-                _fileMappings.erase(it);
+                edits.push_back({ path, AssetUtils::AssetHash() });
             } else {
                 qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
             }
         }
     }
 
-    // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
+    // attempt to persist the deletes, the mappings stay as they were if that fails
+    if (_fileMappings.apply(edits)) {
         // persistence succeeded we are good to go
 
-        // TODO iterate through hashesToCheckForDeletion instead
-        for (auto& pair : _fileMappings) {
-            auto it = hashesToCheckForDeletion.find(pair.second);
-            if (it != hashesToCheckForDeletion.end()) {
-                hashesToCheckForDeletion.erase(it);
+        // delete the asset files of the hashes that are now unmapped
+        for (auto& hash : hashesToCheckForDeletion) {
+            if (_fileMappings.isMapped(hash)) {
+                continue;
             }
-        }
 
-        // we now have a set of hashes that are unmapped - we will delete those asset files
-        for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
-            if (removeableFile.remove()) {
+            if (removeableFile.remove() || _chunkStore.remove(hash)) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
+                _memoryCache.remove(hash);
+
                 removeBakedPathsForDeletedAsset(hash);
             } else {
                 qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
@@ -1193,9 +1305,6 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
     } else {
         qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
 
-        // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
-
         return false;
     }
 }
@@ -1220,35 +1329,26 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
-
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
-
-        while (it != oldMappings.end()) {
-            auto& oldKey = it->first;
-            if (oldKey.startsWith(oldPath)) {
-                auto newKey = oldKey;
-                newKey.replace(0, oldPath.size(), newPath);
-
-                // remove the old version from the in memory file mappings
-                _fileMappings.erase(_fileMappings.find(oldKey));
-                _fileMappings[newKey] = it->second;
-            }
-
-            ++it;
+        // the mappings in a folder are next to each other, sorted by path
+        // all of them are removed before the renamed ones are added, in case one folder is inside the other
+        auto folderMappings = _fileMappings.findPrefix(oldPath);
+        AssetMappingStore::Edits removals;
+        AssetMappingStore::Edits additions;
+        for (auto it = folderMappings.first; it != folderMappings.second; ++it) {
+            auto newKey = it->first;
+            newKey.replace(0, oldPath.size(), newPath);
+
+            removals.push_back({ it->first, AssetUtils::AssetHash() });
+            additions.push_back({ newKey, it->second });
         }
+        removals.insert(removals.end(), additions.begin(), additions.end());
 
-        if (writeMappingsToFile()) {
+        if (_fileMappings.apply(removals)) {
             // persisted the changed mappings, return success
             qCDebug(asset_server) << "Renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return true;
         } else {
-            // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
-
             qCWarning(asset_server) << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return false;
@@ -1261,40 +1361,21 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take the old hash to remove the old mapping
         auto it = _fileMappings.find(oldPath);
-        auto oldSourceMapping = it->second;
-        _fileMappings.erase(it);
-
-        // in case we're overwriting, keep the current destination mapping for potential rollback
-        auto oldDestinationIt = _fileMappings.find(newPath);
-
-        if (!oldSourceMapping.isEmpty()) {
-            _fileMappings[newPath] = oldSourceMapping;
-
-            if (writeMappingsToFile()) {
-                // persisted the renamed mapping, return success
-                qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
-
-                return true;
-            } else {
-                // we couldn't persist the renamed mapping, rollback and return failure
-                _fileMappings[oldPath] = oldSourceMapping;
-
-                if (oldDestinationIt != _fileMappings.end()) {
-                    // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationIt->second;
-                } else {
-                    // clear the new mapping
-                    _fileMappings.erase(_fileMappings.find(newPath));
-                }
+        if (it == _fileMappings.end()) {
+            // failed to find a mapping that was to be renamed, return failure
+            return false;
+        }
 
-                qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
+        // this overwrites the destination mapping, if there is one
+        if (_fileMappings.apply({ { oldPath, AssetUtils::AssetHash() }, { newPath, it->second } })) {
+            // persisted the renamed mapping, return success
+            qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
 
-                return false;
-            }
+            return true;
         } else {
-            // failed to find a mapping that was to be renamed, return failure
+            qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
+
             return false;
         }
     }
@@ -1318,6 +1399,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
     writeMetaFile(originalAssetHash, meta);
 
     _pendingBakes.remove(originalAssetHash);
+    _bakingScheduler.bakeFinished(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1341,6 +1423,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
         writeMetaFile(originalAssetHash, meta);
 
         _pendingBakes.remove(originalAssetHash);
+        _bakingScheduler.bakeFinished(originalAssetHash);
     };
 
     bool errorCompletingBake { false };
@@ -1474,6 +1557,7 @@ void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
     _pendingBakes.remove(originalAssetHash);
+    _bakingScheduler.bakeAborted(originalAssetHash);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
@@ -12,12 +12,18 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <atomic>
+
 #include <QtCore/QDir>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
+#include <shared/BakingScheduler.h>
+#include <shared/TinyLFUCache.h>
 
+#include "AssetChunkStore.h"
+#include "AssetMappingStore.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -68,6 +74,23 @@ struct AssetMeta {
     QString redirectTarget;
 };
 
+// The popular assets, and the sizes of assets, kept in memory so that requests for them don't go to disk.
+// Shared by the transfer tasks.
+struct AssetMemoryCache {
+    static const uint64_t DEFAULT_SIZE = 256 * 1024 * 1024;
+    static const size_t EXPECTED_ASSETS = 16 * 1024;
+    static const size_t MAX_ASSET_SIZES = 64 * 1024;
+
+    cache::TinyLFUCache<AssetUtils::AssetHash, QByteArray> data { DEFAULT_SIZE, EXPECTED_ASSETS };
+    cache::TinyLFUCache<AssetUtils::AssetHash, qint64> sizes { MAX_ASSET_SIZES, MAX_ASSET_SIZES };
+    std::atomic<uint64_t> bytesServed { 0 };
+
+    void remove(const AssetUtils::AssetHash& hash) {
+        data.remove(hash);
+        sizes.remove(hash);
+    }
+};
+
 class BakeAssetTask;
 
 class AssetServer : public ThreadedAssignment {
@@ -86,6 +109,7 @@ private slots:
     void queueRequests(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
+    void handleAssetGetBatch(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
@@ -95,18 +119,19 @@ private:
     void replayRequests();
 
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
-    void handleGetAllMappingOperation(NLPacketList& replyPacket);
+    void handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleDeleteMappingsOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleRenameMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleSetBakingEnabledOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
+    void handleGetBakingQueueOperation(NLPacketList& replyPacket);
+    void handleGetAssetChunksOperation(ReceivedMessage& message, NLPacketList& replyPacket);
 
     void handleAssetServerBackup(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleAssetServerRestore(ReceivedMessage& message, NLPacketList& replyPacket);
 
     // Mapping file operations must be called from main assignment thread only
     bool loadMappingsFromFile();
-    bool writeMappingsToFile();
 
     /// Set the mapping for path to hash
     bool setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash);
@@ -148,16 +173,23 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
-    AssetUtils::Mappings _fileMappings;
+    AssetMappingStore _fileMappings;
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Large assets, stored as the chunks they share with other versions of themselves
+    AssetChunkStore _chunkStore;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    AssetMemoryCache _memoryCache;
+    bool _isMemoryCacheEnabled { true };
+
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
+    BakingScheduler _bakingScheduler;
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
@@ -18,16 +18,20 @@
 
 #include <PathUtils.h>
 
+#include "AssetChunkStore.h"
+
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
 static const int OVEN_STATUS_CODE_FAIL { 1 };
 static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             const AssetChunkStore* chunkStore) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _chunkStore(chunkStore)
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -55,7 +59,9 @@ void BakeAssetTask::run() {
     // Copy file to bake the temporary dir and give a name the oven can work with
     auto assetName = _assetPath.split("/").last();
     auto tempAssetPath = tempOutputDir + "/" + assetName;
-    auto success = QFile::copy(_filePath, tempAssetPath);
+    // assets stored as chunks are put back together for the oven
+    auto success = QFile::exists(_filePath) ? QFile::copy(_filePath, tempAssetPath)
+                                            : (_chunkStore && _chunkStore->assemble(_assetHash, tempAssetPath));
     if (!success) {
         QString errors = "Couldn't copy file to bake to temporary directory";
         emit bakeFailed(_assetHash, _assetPath, errors);
@@ -22,10 +22,13 @@
 
 #include <AssetUtils.h>
 
+class AssetChunkStore;
+
 class BakeAssetTask : public QObject, public QRunnable {
     Q_OBJECT
 public:
-    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                  const AssetChunkStore* chunkStore = nullptr);
 
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
@@ -46,6 +49,7 @@ private:
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
+    const AssetChunkStore* _chunkStore;
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
 };
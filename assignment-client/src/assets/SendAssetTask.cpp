@@ -12,8 +12,13 @@
 #include "SendAssetTask.h"
 
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <QFile>
+#include <QHash>
 
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
@@ -22,20 +27,283 @@
 #include <NodeList.h>
 #include <udt/Packet.h>
 
+#include "AssetChunkStore.h"
+#include "AssetGetBatch.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+namespace {
+
+// ranges smaller than this are copied into the reply when it is made
+const qint64 MIN_STREAMED_SIZE = 256 * 1024;
+
+// An asset file mapped into memory, shared by the transfers of the asset in progress
+class MappedAssetFile {
+public:
+    static std::shared_ptr<MappedAssetFile> open(const QString& filePath);
+
+    ~MappedAssetFile();
+
+    qint64 size() const { return _size; }
+    bool read(qint64 offset, char* data, qint64 size);
+
+private:
+    QString _filePath;
+    QFile _file;
+    qint64 _size { 0 };
+    const uchar* _data { nullptr };
+    bool _isShared { false };
+    std::mutex _fileMutex; // guards reads through the file when it could not be mapped
+};
+
+std::mutex mappedFilesMutex;
+QHash<QString, std::weak_ptr<MappedAssetFile>> mappedFiles;
+
+std::shared_ptr<MappedAssetFile> MappedAssetFile::open(const QString& filePath) {
+    std::lock_guard<std::mutex> lock(mappedFilesMutex);
+
+    auto file = mappedFiles.value(filePath).lock();
+    if (file) {
+        return file;
+    }
+
+    std::unique_ptr<MappedAssetFile> newFile(new MappedAssetFile());
+    newFile->_filePath = filePath;
+    newFile->_file.setFileName(filePath);
+    if (!newFile->_file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    newFile->_size = newFile->_file.size();
+    if (newFile->_size > 0) {
+        // fall back to reading through the file if it can't be mapped, say for lack of address space
+        newFile->_data = newFile->_file.map(0, newFile->_size);
+        if (!newFile->_data) {
+            qCDebug(networking) << "Could not map" << filePath << "-" << newFile->_file.errorString();
+        }
+    }
+
+    newFile->_isShared = true;
+    file = std::shared_ptr<MappedAssetFile>(newFile.release());
+    mappedFiles.insert(filePath, file);
+    return file;
+}
+
+MappedAssetFile::~MappedAssetFile() {
+    if (!_isShared) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mappedFilesMutex);
+    auto it = mappedFiles.find(_filePath);
+    if (it != mappedFiles.end() && it->expired()) {
+        mappedFiles.erase(it);
+    }
+}
+
+bool MappedAssetFile::read(qint64 offset, char* data, qint64 size) {
+    if (offset < 0 || size < 0 || offset + size > _size) {
+        return false;
+    }
+
+    if (_data) {
+        memcpy(data, _data + offset, size);
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    return _file.seek(offset) && _file.read(data, size) == size;
+}
+
+// A range of an asset, read into the packets of the reply as they are sent
+class MappedAssetRange : public udt::PacketList::StreamedData {
+public:
+    MappedAssetRange(std::shared_ptr<MappedAssetFile> file, qint64 offset, qint64 size) :
+        _file(std::move(file)), _offset(offset), _size(size) {}
+
+    qint64 size() const override { return _size; }
+    bool read(qint64 offset, char* data, qint64 size) override { return _file->read(_offset + offset, data, size); }
+
+private:
+    std::shared_ptr<MappedAssetFile> _file;
+    qint64 _offset;
+    qint64 _size;
+};
+
+// A range of an asset stored as chunks, read into the packets of the reply as they are sent.  Its manifest keeps the
+// chunks from being removed until the reply is sent.
+class ChunkedAssetRange : public udt::PacketList::StreamedData {
+public:
+    ChunkedAssetRange(const AssetChunkStore& chunkStore, AssetChunkStore::ManifestPointer manifest, qint64 offset, qint64 size) :
+        _reader(chunkStore, std::move(manifest)), _offset(offset), _size(size) {}
+
+    qint64 size() const override { return _size; }
+    bool read(qint64 offset, char* data, qint64 size) override { return _reader.read(_offset + offset, size, data); }
+
+private:
+    AssetChunkStore::Reader _reader;
+    qint64 _offset;
+    qint64 _size;
+};
+
+// A range of an asset held in memory
+class CachedAssetRange : public udt::PacketList::StreamedData {
+public:
+    CachedAssetRange(const QByteArray& data, qint64 offset, qint64 size) : _data(data), _offset(offset), _size(size) {}
+
+    qint64 size() const override { return _size; }
+    bool read(qint64 offset, char* data, qint64 size) override {
+        memcpy(data, _data.constData() + _offset + offset, size);
+        return true;
+    }
+
+private:
+    QByteArray _data;
+    qint64 _offset;
+    qint64 _size;
+};
+
+// An asset being sent, from wherever it is: the memory cache, its file, or the chunk store
+struct AssetSource {
+    QByteArray data;
+    bool isCacheHit { false };
+    bool hasData { false }; // whether the whole asset is in data
+    std::shared_ptr<MappedAssetFile> file;
+    AssetChunkStore::ManifestPointer manifest;
+    const AssetChunkStore* chunkStore { nullptr };
+    qint64 size { -1 }; // -1 if the asset wasn't found
+
+    bool read(qint64 offset, char* rangeData, qint64 rangeSize) const {
+        if (hasData) {
+            memcpy(rangeData, data.constData() + offset, rangeSize);
+            return true;
+        }
+        return file ? file->read(offset, rangeData, rangeSize) : chunkStore->read(*manifest, offset, rangeSize, rangeData);
+    }
+};
+
+// Finds an asset without reading it, its size is enough to tell how to reply
+AssetSource findAsset(const QString& hexHash, const QDir& resourcesDir, AssetMemoryCache* memoryCache,
+                      const AssetChunkStore* chunkStore) {
+    AssetSource source;
+    source.chunkStore = chunkStore;
+
+    // popular assets are served from memory, the others are read from disk as they are sent
+    source.isCacheHit = memoryCache && memoryCache->data.get(hexHash, source.data);
+    source.hasData = source.isCacheHit;
+    if (source.hasData) {
+        source.size = source.data.size();
+        return source;
+    }
+
+    // large assets are stored as chunks, unless they were uploaded before chunks were
+    source.file = MappedAssetFile::open(resourcesDir.filePath(hexHash));
+    if (source.file) {
+        source.size = source.file->size();
+    } else if (chunkStore) {
+        source.manifest = chunkStore->readManifest(hexHash);
+        source.size = source.manifest ? source.manifest->size : -1;
+    }
+    return source;
+}
+
+// Reads the whole asset for the memory cache when a range of it is about to be sent, if the cache would keep it.
+// Otherwise only the range is read.
+void cacheAsset(AssetSource& source, const QString& hexHash, AssetMemoryCache* memoryCache) {
+    if (!source.hasData && source.size >= 0 && memoryCache && memoryCache->data.wouldAdmit(hexHash, source.size)) {
+        QByteArray data((int)source.size, Qt::Uninitialized);
+        if (source.read(0, data.data(), source.size)) {
+            source.data = data;
+            source.hasData = true;
+            memoryCache->data.put(hexHash, data, data.size());
+        }
+    }
+}
+
+// Writes the reply to a get of a range of an asset that was found, from its error on
+void writeAssetReply(NLPacketList& replyPacketList, const QString& hexHash, AssetSource& source, ByteRange byteRange,
+                     AssetMemoryCache* memoryCache, const AssetChunkStore* chunkStore) {
+    auto assetSize = source.size;
+
+    // first fixup the range based on the now known file size
+    byteRange.fixupRange(assetSize);
+
+    // check if we're being asked to read data that we just don't have
+    // because of the file size
+    if (assetSize < byteRange.fromInclusive || assetSize < byteRange.toExclusive) {
+        replyPacketList.writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+        qCDebug(networking) << "Bad byte range: " << hexHash << " "
+            << byteRange.fromInclusive << ":" << byteRange.toExclusive;
+        return;
+    }
+
+    // we have a valid byte range, handle it and send the asset
+    auto size = byteRange.size();
+
+    // a negative range is read back from the end of the file
+    auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : assetSize + byteRange.fromInclusive;
+
+    cacheAsset(source, hexHash, memoryCache);
+
+    // small ranges not in memory are read now, and fail the reply if they can't be
+    QByteArray rangeData;
+    if (!source.hasData && size < MIN_STREAMED_SIZE) {
+        rangeData.resize((int)size);
+        if (!source.read(offset, rangeData.data(), size)) {
+            qCWarning(networking) << "Could not read asset" << hexHash << "from" << offset
+                << "to" << offset + size;
+            replyPacketList.writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+            return;
+        }
+    }
+
+    replyPacketList.writePrimitive(AssetUtils::AssetServerError::NoError);
+    replyPacketList.writePrimitive(size);
+
+    if (source.hasData) {
+        if (size < MIN_STREAMED_SIZE) {
+            replyPacketList.write(source.data.constData() + offset, size);
+        } else {
+            replyPacketList.setStreamedData(udt::PacketList::StreamedDataPointer(
+                new CachedAssetRange(source.data, offset, size)));
+        }
+        if (source.isCacheHit) {
+            memoryCache->bytesServed += size;
+        }
+    } else if (size < MIN_STREAMED_SIZE) {
+        replyPacketList.write(rangeData);
+    } else if (source.file) {
+        // large ranges are read into the reply's packets as they are sent
+        replyPacketList.setStreamedData(udt::PacketList::StreamedDataPointer(
+            new MappedAssetRange(source.file, offset, size)));
+    } else {
+        replyPacketList.setStreamedData(udt::PacketList::StreamedDataPointer(
+            new ChunkedAssetRange(*chunkStore, source.manifest, offset, size)));
+    }
+
+    qCDebug(networking) << "Sending asset: " << hexHash;
+}
+
+}
+
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             AssetMemoryCache* memoryCache, const AssetChunkStore* chunkStore) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _memoryCache(memoryCache),
+    _chunkStore(chunkStore)
 {
     
 }
 
 void SendAssetTask::run() {
+    if (_message->getType() == PacketType::AssetGetBatch) {
+        sendBatch();
+        return;
+    }
+
     MessageID messageID;
     ByteRange byteRange;
 
@@ -63,58 +331,91 @@ void SendAssetTask::run() {
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        auto source = findAsset(hexHash, _resourcesDir, _memoryCache, _chunkStore);
+        if (source.size >= 0) {
+            writeAssetReply(*replyPacketList, hexHash, source, byteRange, _memoryCache, _chunkStore);
+        } else {
+            qCDebug(networking) << "Asset not found: " << _resourcesDir.filePath(hexHash) << "(" << hexHash << ")";
+            replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+        }
+    }
 
-        if (file.open(QIODevice::ReadOnly)) {
+    sendReply(std::move(replyPacketList));
+}
 
-            // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+void SendAssetTask::sendReply(std::unique_ptr<NLPacketList> replyPacketList) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+    }
+}
 
-            // check if we're being asked to read data that we just don't have
-            // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
-                replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
-                qCDebug(networking) << "Bad byte range: " << hexHash << " "
-                    << byteRange.fromInclusive << ":" << byteRange.toExclusive;
-            } else {
-                // we have a valid byte range, handle it and send the asset
-                auto size = byteRange.size();
+void SendAssetTask::sendBatch() {
+    auto gets = AssetUtils::readBatchedGets(*_message);
 
-                if (byteRange.fromInclusive >= 0) {
+    qDebug() << "Starting task to send a batch of" << gets.size() << "assets";
+    auto replyPacketList = NLPacketList::create(PacketType::AssetGetBatchReply, QByteArray(), true, true);
+    AssetUtils::writeBatchedGetRepliesHeader(*replyPacketList, gets);
 
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
+    // small assets go back to back in the reply until it is full, the others are sent in replies of their own after it
+    std::vector<std::unique_ptr<NLPacketList>> separateReplies;
+    qint64 replySize = 0;
+    for (auto& get : gets) {
+        AssetUtils::BatchedGetReply reply;
+        reply.messageID = get.messageID;
 
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+        ByteRange byteRange;
+        byteRange.fromInclusive = get.start;
+        byteRange.toExclusive = get.end;
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+        if (!byteRange.isValid()) {
+            reply.error = AssetUtils::AssetServerError::InvalidByteRange;
+        } else {
+            QString hexHash = get.hash.toHex();
+            auto source = findAsset(hexHash, _resourcesDir, _memoryCache, _chunkStore);
+            if (source.size < 0) {
+                reply.error = AssetUtils::AssetServerError::AssetNotFound;
+            } else {
+                auto getRange = byteRange;
+                byteRange.fixupRange(source.size);
+                if (source.size < byteRange.fromInclusive || source.size < byteRange.toExclusive) {
+                    reply.error = AssetUtils::AssetServerError::InvalidByteRange;
+                } else {
+                    auto size = byteRange.size();
+                    auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : source.size + byteRange.fromInclusive;
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
+                    // whether the asset fits is told from its size, it is only read if it does
+                    reply.isIncluded = size <= AssetUtils::MAX_BATCHED_ASSET_SIZE &&
+                        replySize + size <= AssetUtils::MAX_BATCH_REPLY_SIZE;
+                    if (!reply.isIncluded) {
+                        auto separateReply = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
+                        separateReply->write(get.hash);
+                        separateReply->writePrimitive(get.messageID);
+                        writeAssetReply(*separateReply, hexHash, source, getRange, _memoryCache, _chunkStore);
+                        separateReplies.push_back(std::move(separateReply));
+                    } else {
+                        cacheAsset(source, hexHash, _memoryCache);
+                        reply.data.resize((int)size);
+                        if (!source.read(offset, reply.data.data(), size)) {
+                            reply.error = AssetUtils::AssetServerError::FileOperationFailed;
+                            reply.data.clear();
+                        }
+                        replySize += reply.data.size();
+                        if (source.isCacheHit) {
+                            _memoryCache->bytesServed += reply.data.size();
+                        }
+                    }
                 }
-
-                qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
-        } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
-            replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
         }
+
+        AssetUtils::writeBatchedGetReply(*replyPacketList, reply);
     }
 
-    auto nodeList = DependencyManager::get<NodeList>();
-    if (_senderNode) {
-        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
-    } else {
-        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+    sendReply(std::move(replyPacketList));
+    for (auto& separateReply : separateReplies) {
+        sendReply(std::move(separateReply));
     }
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_SendAssetTask_h
 #define hifi_SendAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QByteArray>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
@@ -21,18 +23,27 @@
 #include "AssetServer.h"
 #include "Node.h"
 
+class AssetChunkStore;
 class NLPacket;
+class NLPacketList;
 
+// Sends the asset an AssetGet asks for, or the assets of an AssetGetBatch
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  AssetMemoryCache* memoryCache = nullptr, const AssetChunkStore* chunkStore = nullptr);
 
     void run() override;
 
 private:
+    void sendBatch();
+    void sendReply(std::unique_ptr<NLPacketList> replyPacketList);
+
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    AssetMemoryCache* _memoryCache;
+    const AssetChunkStore* _chunkStore;
 };
 
 #endif
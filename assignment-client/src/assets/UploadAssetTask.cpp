@@ -11,107 +11,295 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
+#include <atomic>
+
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
+#include <QtCore/QTemporaryFile>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
 
+#include "AssetChunkStore.h"
 #include "ClientServerUtils.h"
 
-UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
-    _receivedMessage(receivedMessage),
+// whether a stored file holds the asset with the hash, read a block at a time
+static bool fileHasHash(QFile& file, const QByteArray& hash) {
+    QCryptographicHash fileHash(QCryptographicHash::Sha256);
+    bool hasHash = file.open(QIODevice::ReadOnly) && fileHash.addData(&file) && fileHash.result() == hash;
+    file.close();
+    return hasHash;
+}
+
+class UploadAssetTask::Upload : public std::enable_shared_from_this<Upload> {
+public:
+    Upload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode, const QDir& resourcesDir,
+           uint64_t filesizeLimit, QThreadPool& threadPool, AssetChunkStore* chunkStore);
+
+    // only ever runs on one task of the upload at a time
+    void readArrived();
+
+private:
+    void start();
+    void scheduleRead();
+    bool hasAsset(const QByteArray& hash);
+    void receive(const char* data, qint64 size);
+    void finish();
+    void sendReply(AssetUtils::AssetServerError error, const QByteArray& hash = QByteArray());
+    QString senderName() const;
+
+    QSharedPointer<ReceivedMessage> _message;
+    SharedNodePointer _senderNode;
+    QDir _resourcesDir;
+    uint64_t _filesizeLimit;
+    QThreadPool& _threadPool;
+    AssetChunkStore* _chunkStore;
+
+    // set while a task of the upload is queued or running, the first one is started by the asset server
+    std::atomic<bool> _isReadScheduled { true };
+    bool _isStarted { false };
+    QMetaObject::Connection _progressConnection;
+    QMetaObject::Connection _completedConnection;
+
+    MessageID _messageID { 0 };
+    uint64_t _fileSize { 0 };
+    QByteArray _declaredHash;
+    bool _hasReplied { false }; // what arrives after the upload was answered is dropped
+    bool _writeFailed { false };
+    uint64_t _bytesReceived { 0 };
+    QCryptographicHash _hash { QCryptographicHash::Sha256 };
+    std::unique_ptr<QTemporaryFile> _file;
+    std::unique_ptr<AssetChunkStore::Writer> _chunkWriter;
+};
+
+UploadAssetTask::Upload::Upload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode,
+                                const QDir& resourcesDir, uint64_t filesizeLimit, QThreadPool& threadPool,
+                                AssetChunkStore* chunkStore) :
+    _message(message),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _threadPool(threadPool),
+    _chunkStore(chunkStore)
 {
-    
+
 }
 
-void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
-    MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
-    
-    uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+void UploadAssetTask::Upload::readArrived() {
+    if (!_isStarted) {
+        start();
+    }
 
-    if (_senderNode) {
-        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
-    } else {
-        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << _receivedMessage->getSenderSockAddr();
+    while (true) {
+        // what arrives once this was checked is read by the next round
+        bool isComplete = _message->isComplete();
+        _message->readArrived([this](const char* data, qint64 size) {
+            receive(data, size);
+        });
+
+        if (isComplete) {
+            finish();
+            return;
+        }
+
+        // from now on the packets that arrive schedule the next task, and those that arrived while reading are
+        // read right away unless they already did
+        _isReadScheduled = false;
+        bool hasArrived = _message->isComplete() || _message->getBytesLeftToRead() > 0;
+        bool wasScheduled = false;
+        if (!hasArrived || !_isReadScheduled.compare_exchange_strong(wasScheduled, true)) {
+            return;
+        }
     }
-    
-    auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
-    replyPacket->writePrimitive(messageID);
-    
-    if (fileSize > _filesizeLimit) {
-        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+}
+
+void UploadAssetTask::Upload::start() {
+    _isStarted = true;
+
+    // the packets still arriving are read by tasks of their own, the connections keep the upload alive until then
+    if (!_message->isComplete()) {
+        auto upload = shared_from_this();
+        _progressConnection = QObject::connect(_message.data(), &ReceivedMessage::progress, [upload] {
+            upload->scheduleRead();
+        });
+        _completedConnection = QObject::connect(_message.data(), &ReceivedMessage::completed, [upload] {
+            upload->scheduleRead();
+        });
+    }
+
+    _message->readHeadPrimitive(&_messageID);
+    _message->readHeadPrimitive(&_fileSize);
+
+    bool hasDeclaredHash = false;
+    _message->readHeadPrimitive(&hasDeclaredHash);
+    if (hasDeclaredHash) {
+        _declaredHash = _message->readHead(AssetUtils::SHA256_HASH_LENGTH);
+    }
+
+    qDebug() << "UploadAssetTask reading a file of " << _fileSize << "bytes from" << senderName();
+
+    if (_fileSize > _filesizeLimit) {
+        sendReply(AssetUtils::AssetServerError::AssetTooLarge);
+        return;
+    }
+
+    if (_declaredHash.size() == AssetUtils::SHA256_HASH_LENGTH && hasAsset(_declaredHash)) {
+        qDebug() << "Not writing upload of existing file" << _declaredHash.toHex() << "from" << senderName();
+        sendReply(AssetUtils::AssetServerError::NoError, _declaredHash);
+        return;
+    }
+
+    // large assets are stored as chunks, shared with the other versions of the asset
+    if (_chunkStore && _fileSize >= (uint64_t)AssetChunkStore::MIN_CHUNKED_ASSET_SIZE) {
+        _chunkWriter.reset(new AssetChunkStore::Writer(*_chunkStore));
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
-        auto hexHash = hash.toHex();
+        _file.reset(new QTemporaryFile(_resourcesDir.filePath("upload-XXXXXX" + PARTIAL_UPLOAD_FILE_SUFFIX)));
+        if (!_file->open()) {
+            qWarning() << "Failed to create a file for an upload from" << senderName() << "-" << _file->errorString();
+            _writeFailed = true;
+        }
+    }
+}
+
+void UploadAssetTask::Upload::scheduleRead() {
+    if (!_isReadScheduled.exchange(true)) {
+        _threadPool.start(new UploadAssetTask(shared_from_this()));
+    }
+}
+
+bool UploadAssetTask::Upload::hasAsset(const QByteArray& hash) {
+    auto hexHash = QString(hash.toHex());
+    if (_chunkStore && _chunkStore->contains(hexHash)) {
+        return true;
+    }
+
+    QFile file { _resourcesDir.filePath(hexHash) };
+    return file.exists() && fileHasHash(file, hash);
+}
+
+void UploadAssetTask::Upload::receive(const char* data, qint64 size) {
+    size = std::min(size, (qint64)(_fileSize - _bytesReceived));
+    if (_hasReplied || _writeFailed || size <= 0) {
+        return;
+    }
+
+    _bytesReceived += size;
+    _hash.addData(data, (int)size);
+
+    bool written = _chunkWriter ? _chunkWriter->write(data, size) : _file->write(data, size) == size;
+    if (!written) {
+        qWarning() << "Failed to write an upload from" << senderName();
+        _writeFailed = true;
+    }
+}
+
+void UploadAssetTask::Upload::finish() {
+    QObject::disconnect(_progressConnection);
+    QObject::disconnect(_completedConnection);
 
-        if (_senderNode) {
-            qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
+    if (_hasReplied) {
+        return;
+    }
+    if (_message->failed()) {
+        qDebug() << "Upload from" << senderName() << "did not complete";
+        return;
+    }
+    if (_writeFailed || _bytesReceived != _fileSize) {
+        qWarning() << "Failed to upload a file from" << senderName() << "- upload failed.";
+        sendReply(AssetUtils::AssetServerError::FileOperationFailed);
+        return;
+    }
+
+    auto hash = _hash.result();
+    auto hexHash = hash.toHex();
+    qDebug() << "Hash for uploaded file from" << senderName() << "is: (" << hexHash << ")";
+
+    if (!_declaredHash.isEmpty() && _declaredHash != hash) {
+        qWarning() << "Uploaded file" << hexHash << "does not have the hash it was declared with:" << _declaredHash.toHex();
+        sendReply(AssetUtils::AssetServerError::FileOperationFailed);
+        return;
+    }
+
+    QFile file { _resourcesDir.filePath(QString(hexHash)) };
+
+    if (_chunkWriter) {
+        // a file that was stored whole before the chunk store existed is kept, the chunks this upload wrote are then
+        // removed with the unused ones the next time the server starts
+        if ((file.exists() && fileHasHash(file, hash)) || _chunkWriter->finish(QString(hexHash))) {
+            qDebug() << "Stored chunks of file" << hexHash << ". Upload complete";
+            sendReply(AssetUtils::AssetServerError::NoError, hash);
         } else {
-            qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
-        }
-        
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
-
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
-
-                existingCorrectFile = true;
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
-            }
+            qWarning() << "Failed to store the chunks of file" << hexHash << " - upload failed.";
+            sendReply(AssetUtils::AssetServerError::FileOperationFailed);
         }
+        return;
+    }
 
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
-                qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
-                
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
-            }
+    _file->close();
+    if (file.exists()) {
+        // check if the local file has the correct contents, otherwise we overwrite
+        if (fileHasHash(file, hash)) {
+            qDebug() << "Not overwriting existing verified file: " << hexHash;
+            sendReply(AssetUtils::AssetServerError::NoError, hash);
+            return;
         }
 
+        qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+        file.remove();
+    }
+
+    // the file only ever appears under its hash whole
+    if (_file->rename(file.fileName())) {
+        _file->setAutoRemove(false);
+        qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+        sendReply(AssetUtils::AssetServerError::NoError, hash);
+    } else if (file.exists() && fileHasHash(file, hash)) {
+        // a concurrent upload of the same asset got its file in place first
+        _file->remove();
+        qDebug() << "File" << hexHash << "was stored by another upload. Upload complete";
+        sendReply(AssetUtils::AssetServerError::NoError, hash);
+    } else {
+        qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+        sendReply(AssetUtils::AssetServerError::FileOperationFailed);
+    }
+}
 
+void UploadAssetTask::Upload::sendReply(AssetUtils::AssetServerError error, const QByteArray& hash) {
+    _hasReplied = true;
+    _chunkWriter.reset();
+    _file.reset();
+
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
+    replyPacket->writePrimitive(_messageID);
+    replyPacket->writePrimitive(error);
+    if (error == AssetUtils::AssetServerError::NoError) {
+        replyPacket->write(hash);
     }
-    
+
     auto nodeList = DependencyManager::get<NodeList>();
     if (_senderNode) {
         nodeList->sendPacket(std::move(replyPacket), *_senderNode);
     } else {
-        nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
+        nodeList->sendPacket(std::move(replyPacket), _message->getSenderSockAddr());
+    }
+}
+
+QString UploadAssetTask::Upload::senderName() const {
+    if (_senderNode) {
+        return uuidStringWithoutCurlyBraces(_senderNode->getUUID());
     }
+    return _message->getSenderSockAddr().toString();
+}
+
+UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
+                                 const QDir& resourcesDir, uint64_t filesizeLimit, QThreadPool& threadPool,
+                                 AssetChunkStore* chunkStore) :
+    _upload(std::make_shared<Upload>(receivedMessage, senderNode, resourcesDir, filesizeLimit, threadPool, chunkStore))
+{
+
+}
+
+void UploadAssetTask::run() {
+    _upload->readArrived();
 }
@@ -14,28 +14,43 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 
 #include "ReceivedMessage.h"
 
+class AssetChunkStore;
 class NLPacketList;
 class Node;
 
+// the files uploads are written to until they are complete
+const QString PARTIAL_UPLOAD_FILE_SUFFIX = ".part";
+
+// Receives an upload on a thread pool.  The upload can be started as soon as its first packet arrived: it is hashed
+// and written out a few packets at a time as the rest arrives, and the packets let go of, so that an upload never
+// takes as much memory as the asset.  An asset is written to a temporary file renamed to its hash once complete, or
+// to the chunk store as it is cut in chunks if it is large.  An upload declaring the hash of its asset is answered
+// right away, and its data dropped as it arrives, if the asset is already there.
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, QThreadPool& threadPool,
+                    AssetChunkStore* chunkStore = nullptr);
 
     void run() override;
 
 private:
-    QSharedPointer<ReceivedMessage> _receivedMessage;
-    QSharedPointer<Node> _senderNode;
-    QDir _resourcesDir;
-    uint64_t _filesizeLimit;
+    class Upload;
+
+    // reads what arrived since the last task of the upload
+    UploadAssetTask(std::shared_ptr<Upload> upload) : _upload(upload) {}
+
+    std::shared_ptr<Upload> _upload;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -120,10 +120,19 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
         PacketReceiver::makeUnsourcedListenerReference<AudioMixer>(this, &AudioMixer::queueReplicatedAudioPacket)
     );
 
+    // the single packet streams skip the Qt event queue and are handed to their nodes at the start of each frame
+    packetReceiver.registerPacketViewQueue({
+            PacketType::MicrophoneAudioNoEcho,
+            PacketType::MicrophoneAudioWithEcho,
+            PacketType::InjectAudio,
+            PacketType::SilentAudioFrame },
+        &_packetViews);
+
     connect(nodeList.data(), &NodeList::nodeKilled, this, &AudioMixer::handleNodeKilled);
 }
 
 void AudioMixer::aboutToFinish() {
+    DependencyManager::get<NodeList>()->getPacketReceiver().unregisterPacketViewQueue(&_packetViews);
     DependencyManager::destroy<PluginManager>();
 }
 
@@ -135,6 +144,27 @@ void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, Share
     getOrCreateClientData(node.data())->queuePacket(message, node);
 }
 
+void AudioMixer::queuePacketViews() {
+    auto now = p_high_resolution_clock::now();
+
+    ReceivedPacketView view;
+    while (_packetViews.pop(view)) {
+        SharedNodePointer node = view.getSourceNode();
+        if (!node) {
+            continue;
+        }
+
+        ++_numPacketViews;
+        _packetViewLatencyUsecs += std::chrono::duration_cast<std::chrono::microseconds>(now - view.getReceiveTime()).count();
+
+        if (view.getType() == PacketType::SilentAudioFrame) {
+            _numSilentPackets++;
+        }
+
+        getOrCreateClientData(node.data())->queuePacketView(std::move(view));
+    }
+}
+
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
     // make sure we have a replicated node for the original sender of the packet
     auto nodeList = DependencyManager::get<NodeList>();
@@ -294,6 +324,28 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
+    // packets taken on the fast path, how long they waited for a frame, and how long until they were parsed
+    PacketViewTimings packetViewTimings;
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        auto clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (clientData) {
+            packetViewTimings += clientData->takePacketViewTimings();
+        }
+    });
+    QJsonObject fastPathStats;
+    uint64_t droppedPacketViews = _packetViews.getDroppedCount();
+    fastPathStats["packets_per_frame"] = (float)_numPacketViews / (float)_numStatFrames;
+    fastPathStats["dropped_packets"] = (qint64)(droppedPacketViews - _lastDroppedPacketViews);
+    fastPathStats["avg_us_queued"] = _numPacketViews > 0 ? (qint64)(_packetViewLatencyUsecs / _numPacketViews) : 0;
+    if (packetViewTimings.numPackets > 0) {
+        fastPathStats["avg_us_end_to_end"] = (qint64)(packetViewTimings.endToEndUsecs / packetViewTimings.numPackets);
+        fastPathStats["avg_us_parsing"] = (qint64)(packetViewTimings.handlingUsecs / packetViewTimings.numPackets);
+    }
+    statsObject["fast_path_stats"] = fastPathStats;
+    _lastDroppedPacketViews = droppedPacketViews;
+    _numPacketViews = 0;
+    _packetViewLatencyUsecs = 0;
+
     // timing stats
     QJsonObject timingStats;
 
@@ -427,6 +479,7 @@ void AudioMixer::start() {
         } else {
             auto timer = _checkTimeTiming.timer();
             auto frameDuration = timeFrame();
+            recordFrameTime(frameDuration);
             throttle(frameDuration, frame);
         }
 
@@ -439,6 +492,8 @@ void AudioMixer::start() {
             // first clear the concurrent vector of added streams that the slaves will add to when they process packets
             _workerSharedData.addedStreams.clear();
 
+            queuePacketViews();
+
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 _slavePool.processPackets(cbegin, cend);
             });
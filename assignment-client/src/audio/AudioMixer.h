@@ -15,6 +15,7 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <PacketViewQueue.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
@@ -88,6 +89,7 @@ private:
     void throttle(std::chrono::microseconds frameDuration, int frame);
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
+    void queuePacketViews();
 
     QString percentageForMixStats(int counter);
 
@@ -102,6 +104,12 @@ private:
 
     int _numSilentPackets { 0 };
 
+    // the audio stream packets, which make up most of the traffic, come in on the PacketReceiver fast path
+    PacketViewQueue _packetViews;
+    int _numPacketViews { 0 };
+    uint64_t _packetViewLatencyUsecs { 0 }; // from the network thread to the mixer, summed over the stat period
+    uint64_t _lastDroppedPacketViews { 0 };
+
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
 
@@ -57,6 +57,27 @@ void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message,
     _packetQueue.push(message);
 }
 
+void AudioMixerClientData::queuePacketView(ReceivedPacketView&& view) {
+    _packetViews.push_back(std::move(view));
+}
+
+PacketViewTimings AudioMixerClientData::takePacketViewTimings() {
+    auto timings = _packetViewTimings;
+    _packetViewTimings = PacketViewTimings();
+    return timings;
+}
+
+void AudioMixerClientData::handleStreamPacket(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node,
+                                              ConcurrentAddedStreams& addedStreams) {
+    if (node->isUpstream()) {
+        setupCodecForReplicatedAgent(message);
+    }
+
+    processStreamPacket(*message, addedStreams);
+
+    optionallyReplicatePacket(*message, *node);
+}
+
 int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
     SharedNodePointer node = _packetQueue.node;
     assert(_packetQueue.empty() || node);
@@ -70,13 +91,7 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             case PacketType::MicrophoneAudioWithEcho:
             case PacketType::InjectAudio:
             case PacketType::SilentAudioFrame: {
-                if (node->isUpstream()) {
-                    setupCodecForReplicatedAgent(packet);
-                }
-
-                processStreamPacket(*packet, addedStreams);
-
-                optionallyReplicatePacket(*packet, *node);
+                handleStreamPacket(packet, node, addedStreams);
                 break;
             }
             case PacketType::AudioStreamStats: {
@@ -115,6 +130,22 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
     }
     assert(_packetQueue.empty());
 
+    for (auto& view : _packetViews) {
+        auto start = p_high_resolution_clock::now();
+        auto receiveTime = view.getReceiveTime();
+        SharedNodePointer sourceNode = view.getSourceNode();
+
+        if (_packetViewMessage) {
+            _packetViewMessage->reset(view);
+        } else {
+            _packetViewMessage = QSharedPointer<ReceivedMessage>::create(view);
+        }
+        handleStreamPacket(_packetViewMessage, sourceNode, addedStreams);
+
+        _packetViewTimings.add(receiveTime, start, p_high_resolution_clock::now());
+    }
+    _packetViews.clear();
+
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
     return checkBuffersBeforeFrameSend();
@@ -24,6 +24,7 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
+#include <PacketViewQueue.h>
 #include <UUIDHasher.h>
 
 #include <plugins/Forward.h>
@@ -53,8 +54,12 @@ public:
     using AudioStreamVector = std::vector<SharedStreamPointer>;
 
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
+    void queuePacketView(ReceivedPacketView&& view);
     int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
 
+    // the timings of the stream packets taken on the fast path since the last call
+    PacketViewTimings takePacketViewTimings();
+
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
 
@@ -177,6 +182,14 @@ private:
     };
     PacketQueue _packetQueue;
 
+    // stream packets from the fast path, all parsed with the one message reset to each in turn
+    std::vector<ReceivedPacketView> _packetViews;
+    QSharedPointer<ReceivedMessage> _packetViewMessage;
+    PacketViewTimings _packetViewTimings;
+
+    void handleStreamPacket(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node,
+                            ConcurrentAddedStreams& addedStreams);
+
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
@@ -104,6 +104,9 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::ReplicatedBulkAvatarData,
         PacketReceiver::makeUnsourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleReplicatedBulkAvatarPacket));
 
+    // avatar data skips the Qt event queue and is handed to its node at the start of each frame
+    packetReceiver.registerPacketViewQueue({ PacketType::AvatarData }, &_packetViews);
+
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
     connect(nodeList.data(), &NodeList::nodeAdded, this, [this](const SharedNodePointer& node) {
@@ -222,6 +225,27 @@ void AvatarMixer::queueIncomingPacket(QSharedPointer<ReceivedMessage> message, S
     _queueIncomingPacketElapsedTime += (end - start);
 }
 
+void AvatarMixer::queuePacketViews() {
+    auto start = usecTimestampNow();
+    auto now = p_high_resolution_clock::now();
+
+    ReceivedPacketView view;
+    while (_packetViews.pop(view)) {
+        SharedNodePointer node = view.getSourceNode();
+        if (!node) {
+            continue;
+        }
+
+        ++_numPacketViews;
+        _packetViewLatencyUsecs += std::chrono::duration_cast<std::chrono::microseconds>(now - view.getReceiveTime()).count();
+
+        getOrCreateClientData(node)->queuePacketView(std::move(view));
+    }
+
+    auto end = usecTimestampNow();
+    _queueIncomingPacketElapsedTime += (end - start);
+}
+
 void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
     if (destinationNode->getType() == NodeType::Agent && !destinationNode->isUpstream()) {
         QByteArray individualData = nodeData->getAvatar().identityByteArray();
@@ -263,6 +287,9 @@ void AvatarMixer::start() {
     while (!_isFinished) {
 
         auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
+        if (frame > 1) {
+            recordFrameTime(frameDuration);
+        }
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
 
         int lockWait, nodeTransform, functor;
@@ -292,6 +319,8 @@ void AvatarMixer::start() {
 
         // Allow nodes to process any pending/queued packets across our worker threads
         {
+            queuePacketViews();
+
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
@@ -787,6 +816,28 @@ void AvatarMixer::sendStatsPacket() {
     singleCoreTasks["processEvents"] = TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime);
     singleCoreTasks["queueIncomingPacket"] = TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime);
 
+    // packets taken on the fast path, how long they waited for a frame, and how long until they were parsed
+    PacketViewTimings packetViewTimings;
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        auto clientData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
+        if (clientData) {
+            packetViewTimings += clientData->takePacketViewTimings();
+        }
+    });
+    QJsonObject fastPathStats;
+    uint64_t droppedPacketViews = _packetViews.getDroppedCount();
+    fastPathStats["packets_per_frame"] = (float)_numPacketViews / (float)tightLoopFrames;
+    fastPathStats["dropped_packets"] = (qint64)(droppedPacketViews - _lastDroppedPacketViews);
+    fastPathStats["avg_us_queued"] = _numPacketViews > 0 ? (qint64)(_packetViewLatencyUsecs / _numPacketViews) : 0;
+    if (packetViewTimings.numPackets > 0) {
+        fastPathStats["avg_us_end_to_end"] = (qint64)(packetViewTimings.endToEndUsecs / packetViewTimings.numPackets);
+        fastPathStats["avg_us_parsing"] = (qint64)(packetViewTimings.handlingUsecs / packetViewTimings.numPackets);
+    }
+    statsObject["fast_path_stats"] = fastPathStats;
+    _lastDroppedPacketViews = droppedPacketViews;
+    _numPacketViews = 0;
+    _packetViewLatencyUsecs = 0;
+
     QJsonObject incomingPacketStats;
     incomingPacketStats["handleAvatarIdentityPacket"] = TIGHT_LOOP_STAT_UINT64(_handleAvatarIdentityPacketElapsedTime);
     incomingPacketStats["handleKillAvatarPacket"] = TIGHT_LOOP_STAT_UINT64(_handleKillAvatarPacketElapsedTime);
@@ -1157,6 +1208,8 @@ void AvatarMixer::entityChange() {
 }
 
 void AvatarMixer::aboutToFinish() {
+    DependencyManager::get<NodeList>()->getPacketReceiver().unregisterPacketViewQueue(&_packetViews);
+
     DependencyManager::destroy<ResourceManager>();
     DependencyManager::destroy<ResourceCacheSharedItems>();
     DependencyManager::destroy<ModelCache>();
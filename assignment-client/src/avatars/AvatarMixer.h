@@ -19,6 +19,7 @@
 #include <shared/RateCounter.h>
 #include <PortableHighResolutionClock.h>
 
+#include <PacketViewQueue.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
 #include "AvatarMixerClientData.h"
@@ -69,6 +70,7 @@ private slots:
 
 private:
     AvatarMixerClientData* getOrCreateClientData(SharedNodePointer node);
+    void queuePacketViews();
     std::chrono::microseconds timeFrame(p_high_resolution_clock::time_point& timestamp);
     void throttle(std::chrono::microseconds duration, int frame);
 
@@ -146,6 +148,12 @@ private:
     quint64 _processEventsElapsedTime { 0 };
     quint64 _sendStatsElapsedTime { 0 };
     quint64 _queueIncomingPacketElapsedTime { 0 };
+
+    // avatar data, which makes up most of the traffic, comes in on the PacketReceiver fast path
+    PacketViewQueue _packetViews;
+    int _numPacketViews { 0 };
+    quint64 _packetViewLatencyUsecs { 0 }; // from the network thread to the mixer, summed over the stat period
+    uint64_t _lastDroppedPacketViews { 0 };
     quint64 _lastStatsTime { usecTimestampNow() };
 
     RateCounter<> _loopRate; // this is the rate that the main thread tight loop runs
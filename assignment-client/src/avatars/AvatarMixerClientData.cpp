@@ -52,6 +52,16 @@ void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message,
     _packetQueue.push(message);
 }
 
+void AvatarMixerClientData::queuePacketView(ReceivedPacketView&& view) {
+    _packetViews.push_back(std::move(view));
+}
+
+PacketViewTimings AvatarMixerClientData::takePacketViewTimings() {
+    auto timings = _packetViewTimings;
+    _packetViewTimings = PacketViewTimings();
+    return timings;
+}
+
 int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData) {
     int packetsProcessed = 0;
     SharedNodePointer node = _packetQueue.node;
@@ -83,6 +93,15 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
     }
     assert(_packetQueue.empty());
 
+    for (auto& view : _packetViews) {
+        packetsProcessed++;
+
+        auto start = p_high_resolution_clock::now();
+        parseData(view, slaveSharedData);
+        _packetViewTimings.add(view.getReceiveTime(), start, p_high_resolution_clock::now());
+    }
+    _packetViews.clear();
+
     if (_avatar) {
         _avatar->processCertifyEvents();
     }
@@ -140,6 +159,24 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message, const SlaveShared
 
     message.readPrimitive(&sequenceNumber);
 
+    return parseAvatarData(sequenceNumber, message.readWithoutCopy(message.getBytesLeftToRead()), slaveSharedData);
+}
+
+int AvatarMixerClientData::parseData(const ReceivedPacketView& view, const SlaveSharedData& slaveSharedData) {
+    // the avatar data is read where the packet was received into
+    uint16_t sequenceNumber;
+    if (view.getPayloadSize() < (qint64)sizeof(sequenceNumber)) {
+        return false;
+    }
+    memcpy(&sequenceNumber, view.getPayload(), sizeof(sequenceNumber));
+
+    auto data = QByteArray::fromRawData(view.getPayload() + sizeof(sequenceNumber),
+                                        (int)(view.getPayloadSize() - sizeof(sequenceNumber)));
+    return parseAvatarData(sequenceNumber, data, slaveSharedData);
+}
+
+int AvatarMixerClientData::parseAvatarData(uint16_t sequenceNumber, const QByteArray& data,
+                                           const SlaveSharedData& slaveSharedData) {
     if (sequenceNumber < _lastReceivedSequenceNumber && _lastReceivedSequenceNumber != UINT16_MAX) {
         incrementNumOutOfOrderSends();
     }
@@ -147,8 +184,7 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message, const SlaveShared
     glm::vec3 oldPosition = _avatar->getClientGlobalPosition();
     bool oldHasPriority = _avatar->getHasPriority();
 
-    // compute the offset to the data payload
-    if (!_avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()))) {
+    if (!_avatar->parseDataFromBuffer(data)) {
         return false;
     }
 
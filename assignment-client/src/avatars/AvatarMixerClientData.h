@@ -25,6 +25,7 @@
 #include <AssociatedTraitValues.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
+#include <PacketViewQueue.h>
 #include <udt/PacketHeaders.h>
 #include <PortableHighResolutionClock.h>
 #include <SimpleMovingAverage.h>
@@ -47,6 +48,7 @@ public:
 
     using NodeData::parseData;  // Avoid clang warning about hiding.
     int parseData(ReceivedMessage& message, const SlaveSharedData& SlaveSharedData);
+    int parseData(const ReceivedPacketView& view, const SlaveSharedData& slaveSharedData);
     MixerAvatar& getAvatar() { return *_avatar; }
     const MixerAvatar& getAvatar() const { return *_avatar; }
     const MixerAvatar* getConstAvatarData() const { return _avatar.get(); }
@@ -129,8 +131,12 @@ public:
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+    void queuePacketView(ReceivedPacketView&& view);
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
 
+    // the timings of the avatar data taken on the fast path since the last call
+    PacketViewTimings takePacketViewTimings();
+
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
     void processBulkAvatarTraitsAckMessage(ReceivedMessage& message);
     void checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData, Node& sendingNode,
@@ -164,6 +170,12 @@ private:
     };
     PacketQueue _packetQueue;
 
+    // avatar data from the fast path, parsed where it was received
+    std::vector<ReceivedPacketView> _packetViews;
+    PacketViewTimings _packetViewTimings;
+
+    int parseAvatarData(uint16_t sequenceNumber, const QByteArray& data, const SlaveSharedData& slaveSharedData);
+
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
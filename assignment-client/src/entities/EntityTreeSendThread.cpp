@@ -12,6 +12,7 @@
 #include "EntityTreeSendThread.h"
 
 #include <EntityNodeData.h>
+#include <EntityQueryIndex.h>
 #include <EntityTypes.h>
 #include <OctreeUtils.h>
 
@@ -61,30 +62,28 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
                 bool requiresFullScene = false;
 
-                // enumerate the set of entity IDs we know currently match the filter
-                foreach(const QUuid& entityID, nodeData->getSentFilteredEntities()) {
-                    if (includeAncestors) {
-                        // we need to include ancestors - recurse up to reach them all and add their IDs
-                        // to the set of extra entities to include for this node
-                        entityTree->withReadLock([&]{
-                            auto filteredEntity = entityTree->findEntityByID(entityID);
-                            if (filteredEntity) {
-                                requiresFullScene |= addAncestorsToExtraFlaggedEntities(entityID, *filteredEntity, *nodeData);
-                            }
-                        });
-                    }
+                // enumerate the set of entity IDs we know currently match the filter, holding the tree lock
+                // once for the whole set rather than once per entity
+                entityTree->withReadLock([&]{
+                    foreach(const QUuid& entityID, nodeData->getSentFilteredEntities()) {
+                        auto filteredEntity = entityTree->findEntityByID(entityID);
+                        if (!filteredEntity) {
+                            continue;
+                        }
+
+                        if (includeAncestors) {
+                            // we need to include ancestors - recurse up to reach them all and add their IDs
+                            // to the set of extra entities to include for this node
+                            requiresFullScene |= addAncestorsToExtraFlaggedEntities(entityID, *filteredEntity, *nodeData);
+                        }
 
-                    if (includeDescendants) {
-                        // we need to include descendants - recurse down to reach them all and add their IDs
-                        // to the set of extra entities to include for this node
-                        entityTree->withReadLock([&]{
-                            auto filteredEntity = entityTree->findEntityByID(entityID);
-                            if (filteredEntity) {
-                                requiresFullScene |= addDescendantsToExtraFlaggedEntities(entityID, *filteredEntity, *nodeData);
-                            }
-                        });
+                        if (includeDescendants) {
+                            // we need to include descendants - recurse down to reach them all and add their IDs
+                            // to the set of extra entities to include for this node
+                            requiresFullScene |= addDescendantsToExtraFlaggedEntities(entityID, *filteredEntity, *nodeData);
+                        }
                     }
-                }
+                });
 
                 if (requiresFullScene) {
                     // for one or more of the entities matching our filter we found new extra entities to include
@@ -110,12 +109,21 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
 
         int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
         newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
-        
-        startNewTraversal(newView, root, isFullScene);
+
+        auto jsonFilters = nodeData->getJSONParameters();
+        if (!newView.usesViewFrustums() && EntityQueryIndex::canQuery(jsonFilters)) {
+            // filtered queries without a view (agents, the entity script server) can only ever be sent
+            // the entities matching their filter, so look those up in the query index instead of walking the tree
+            startNewIndexedQuery(jsonFilters, *static_cast<EntityNodeData*>(nodeData), isFullScene);
+        } else {
+            // coming back from an indexed query the last completed traversal is stale, so start over
+            startNewTraversal(newView, root, isFullScene || _usingQueryIndex);
+            _usingQueryIndex = false;
+        }
 
         // When the viewFrustum changed the sort order may be incorrect, so we re-sort
         // and also use the opportunity to cull anything no longer in view
-        if (viewFrustumChanged && !_sendQueue.empty()) {
+        if (viewFrustumChanged && !_usingQueryIndex && !_sendQueue.empty()) {
             EntityPriorityQueue prevSendQueue;
             std::swap(_sendQueue, prevSendQueue);
             assert(_sendQueue.empty());
@@ -317,6 +325,46 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     }
 }
 
+void EntityTreeSendThread::startNewIndexedQuery(const QJsonObject& jsonFilters, EntityNodeData& nodeData,
+                                                bool forceFirstPass) {
+    if (forceFirstPass) {
+        _knownState.clear();
+    }
+    _usingQueryIndex = true;
+
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+
+    QVector<EntityItemPointer> entities;
+    entityTree->findEntitiesMatchingJSONFilters(jsonFilters, entities);
+
+    // entities that matched the filter before or were flagged as extras still need to be sent when they change
+    auto addEntityByID = [&](const QUuid& entityID) {
+        auto entity = entityTree->findEntityByID(entityID);
+        if (entity) {
+            entities.push_back(entity);
+        }
+    };
+    foreach(const QUuid& entityID, nodeData.getSentFilteredEntities()) {
+        addEntityByID(entityID);
+    }
+    foreach(const QUuid& entityID, nodeData.getFlaggedExtraEntities()) {
+        addEntityByID(entityID);
+    }
+
+    // there is no view, so everything unknown or changed since we last sent it goes in with the same priority
+    for (const auto& entity : entities) {
+        if (_sendQueue.contains(entity.get())) {
+            continue;
+        }
+        auto knownTimestamp = _knownState.find(entity.get());
+        if (knownTimestamp == _knownState.end() ||
+            entity->getLastEdited() > knownTimestamp->second ||
+            entity->getLastChangedOnServer() > knownTimestamp->second) {
+            _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY);
+        }
+    }
+}
+
 bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) {
     if (_sendQueue.empty()) {
         params.stopReason = EncodeBitstreamParams::FINISHED;
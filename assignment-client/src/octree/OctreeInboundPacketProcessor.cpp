@@ -11,9 +11,11 @@
 
 #include "OctreeInboundPacketProcessor.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <NumericalConstants.h>
+#include <PortableHighResolutionClock.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
 
@@ -23,6 +25,10 @@
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
 
+// how long edits wait to be coalesced with later edits before they are applied, and how many may wait
+const quint64 EDIT_COALESCING_WINDOW = 5 * USECS_PER_MSEC;
+const size_t MAX_PENDING_EDIT_MESSAGES = 1000;
+
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
     _receivedPacketCount(0),
@@ -42,6 +48,10 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalEditsReceived = 0;
+    _totalEditsApplied = 0;
+    _totalEditBatches = 0;
+    _totalLockHoldTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -49,13 +59,16 @@ void OctreeInboundPacketProcessor::resetStats() {
 }
 
 uint32_t OctreeInboundPacketProcessor::getMaxWait() const {
-    // calculate time until next sendNackPackets()
-    quint64 nextNackTime = _lastNackTime + TOO_LONG_SINCE_LAST_NACK;
+    // calculate time until next sendNackPackets() or until pending edits have to be applied
+    quint64 nextWakeTime = _lastNackTime + TOO_LONG_SINCE_LAST_NACK;
+    if (!_pendingEdits.empty()) {
+        nextWakeTime = std::min(nextWakeTime, _oldestPendingEditAt + EDIT_COALESCING_WINDOW);
+    }
     quint64 now = usecTimestampNow();
-    if (now >= nextNackTime) {
+    if (now >= nextWakeTime) {
         return 0;
     }
-    return (nextNackTime - now) / USECS_PER_MSEC + 1;
+    return (nextWakeTime - now) / USECS_PER_MSEC + 1;
 }
 
 void OctreeInboundPacketProcessor::preProcess() {
@@ -65,6 +78,11 @@ void OctreeInboundPacketProcessor::preProcess() {
         _lastNackTime = now;
         sendNackPackets();
     }
+
+    // we may have woken up without new packets because edits waited out the coalescing window
+    if (shouldApplyPendingEdits(now)) {
+        applyPendingEdits();
+    }
 }
 
 void OctreeInboundPacketProcessor::midProcess() {
@@ -76,9 +94,62 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    if (shouldApplyPendingEdits(usecTimestampNow())) {
+        applyPendingEdits();
+    }
+}
+
+void OctreeInboundPacketProcessor::shutdown() {
+    // the thread can stop without another pass through process(), edits that were accepted still go into the tree
+    applyPendingEdits();
+}
+
+bool OctreeInboundPacketProcessor::shouldApplyPendingEdits(quint64 now) const {
+    return !_pendingEdits.empty() &&
+        (_shuttingDown || _pendingEdits.size() >= MAX_PENDING_EDIT_MESSAGES ||
+         now - _oldestPendingEditAt >= EDIT_COALESCING_WINDOW);
+}
+
+void OctreeInboundPacketProcessor::applyPendingEdits() {
+    if (_pendingEdits.empty()) {
+        return;
+    }
+
+    auto batchStart = p_high_resolution_clock::now();
+    Octree::EditBatchStats stats = _myServer->getOctree()->processEditPacketBatch(_pendingEdits);
+    _myServer->recordFrameTime(std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - batchStart));
+
+    if (_myServer->wantsDebugReceiving()) {
+        qDebug() << "OctreeInboundPacketProcessor applied" << stats.editsApplied << "of" << stats.editsReceived
+            << "edits from" << _pendingEdits.size() << "packets, lock held for" << stats.lockHoldUsecs << "usecs";
+    }
+
+    // the batch was applied under one lock, so split its times across the packets in it by edit count
+    quint64 editsInBatch = std::max(stats.editsReceived, 1);
+    for (size_t i = 0; i < _pendingEditMessages.size(); ++i) {
+        const PendingEditMessage& pendingMessage = _pendingEditMessages[i];
+        int editsInPacket = stats.editsPerMessage[i];
+        quint64 processTime = stats.lockHoldUsecs * editsInPacket / editsInBatch;
+        quint64 lockWaitTime = stats.lockWaitUsecs * editsInPacket / editsInBatch;
+        trackInboundPacket(pendingMessage.nodeUUID, pendingMessage.sequence, pendingMessage.transitTime,
+                           editsInPacket, processTime, lockWaitTime);
+    }
+
+    _totalEditsReceived += stats.editsReceived;
+    _totalEditsApplied += stats.editsApplied;
+    _totalEditBatches++;
+    _totalLockHoldTime += stats.lockHoldUsecs;
+
+    _pendingEdits.clear();
+    _pendingEditMessages.clear();
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
+        // edits that were already accepted still go into the tree before it is persisted
+        applyPendingEdits();
         return;
     }
 
@@ -92,7 +163,12 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
     // Ask our tree subclass if it can handle the incoming packet...
     PacketType packetType = message->getType();
-    
+
+    if (!_myServer->getOctree()->handlesEditPacketType(packetType)) {
+        // anything else touching the tree has to come after the edits that arrived before it
+        applyPendingEdits();
+    }
+
     if (packetType == PacketType::ChallengeOwnership) {
         _myServer->getOctree()->withWriteLock([&] {
             _myServer->getOctree()->processChallengeOwnershipPacket(*message, sendingNode);
@@ -125,9 +201,6 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         }
 
         quint64 transitTime = arrivedAt - sentAt;
-        int editsInPacket = 0;
-        quint64 processTime = 0;
-        quint64 lockWaitTime = 0;
 
         if (debugProcessPacket || _myServer->wantsDebugReceiving()) {
             qDebug() << "PROCESSING THREAD: got '" << packetType << "' packet - " << _receivedPacketCount << " command from client";
@@ -152,60 +225,6 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                 qDebug() << "    ----- UNEXPECTED ---- got a packet without any edit details!!!! --------";
             }
         }
-        
-        const unsigned char* editData = nullptr;
-        
-        while (message->getBytesLeftToRead() > 0) {
-
-            editData = reinterpret_cast<const unsigned char*>(message->getRawMessage() + message->getPosition());
-
-            int maxSize = message->getBytesLeftToRead();
-
-            if (debugProcessPacket) {
-                qDebug() << " --- inside while loop ---";
-                qDebug() << "    maxSize=" << maxSize;
-                qDebug("OctreeInboundPacketProcessor::processPacket() %hhu "
-                       "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld maxSize=%d",
-                       (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData,
-                        message->getPosition(), maxSize);
-            }
-
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
-            quint64 endProcess = usecTimestampNow();
-
-            if (debugProcessPacket) {
-                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
-                    << "editDataBytesRead=" << editDataBytesRead;
-            }
-
-            editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
-            processTime += thisProcessTime;
-            lockWaitTime += thisLockWaitTime;
-
-            // skip to next edit record in the packet
-            message->seek(message->getPosition() + editDataBytesRead);
-
-            if (debugProcessPacket) {
-                qDebug() << "    editDataBytesRead=" << editDataBytesRead;
-                qDebug() << "    AFTER processEditPacketData payload position=" << message->getPosition();
-                qDebug() << "    AFTER processEditPacketData payload size=" << message->getSize();
-            }
-
-        }
-
-        if (debugProcessPacket) {
-            qDebug("OctreeInboundPacketProcessor::processPacket() DONE LOOPING FOR %hhu "
-                   "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld",
-                   (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData, message->getPosition());
-        }
 
         // Make sure our Node and NodeList knows we've heard from this node.
         QUuid& nodeUUID = DEFAULT_NODE_ID_REF;
@@ -219,7 +238,14 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                 qDebug() << "sender has no known nodeUUID.";
             }
         }
-        trackInboundPacket(nodeUUID, sequence, transitTime, editsInPacket, processTime, lockWaitTime);
+
+        // hold on to the edits so that repeated edits to the same entity can be coalesced, they are
+        // applied together once the coalescing window has passed (see applyPendingEdits)
+        if (_pendingEdits.empty()) {
+            _oldestPendingEditAt = arrivedAt;
+        }
+        _pendingEdits.push_back({ sendingNode, message });
+        _pendingEditMessages.push_back({ nodeUUID, sequence, transitTime });
     } else {
         qDebug("unknown packet ignored... packetType=%hhu", (unsigned char)packetType);
     }
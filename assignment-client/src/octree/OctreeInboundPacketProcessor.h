@@ -70,6 +70,12 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    quint64 getTotalEditsReceived() const { return _totalEditsReceived; }
+    quint64 getTotalEditsApplied() const { return _totalEditsApplied; }
+    quint64 getTotalEditBatches() const { return _totalEditBatches; }
+    quint64 getAverageLockHoldTimePerBatch() const
+                { return _totalEditBatches == 0 ? 0 : _totalLockHoldTime / _totalEditBatches; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,10 +89,16 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
+    virtual void shutdown() override;
 
 private:
     int sendNackPackets();
 
+    // edit messages are held for a short window and then applied together, see Octree::processEditPacketBatch()
+    bool shouldApplyPendingEdits(quint64 now) const;
+    void applyPendingEdits();
+
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
@@ -99,6 +111,21 @@ private:
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+
+    std::atomic<uint64_t> _totalEditsReceived { 0 };
+    std::atomic<uint64_t> _totalEditsApplied { 0 };
+    std::atomic<uint64_t> _totalEditBatches { 0 };
+    std::atomic<uint64_t> _totalLockHoldTime { 0 };
+
+    class PendingEditMessage {
+    public:
+        QUuid nodeUUID;
+        unsigned short int sequence;
+        quint64 transitTime;
+    };
+    std::vector<NodeSharedReceivedMessagePair> _pendingEdits;
+    std::vector<PendingEditMessage> _pendingEditMessages;
+    quint64 _oldestPendingEditAt { 0 };
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
@@ -656,6 +656,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
+        quint64 totalEditsReceived = _octreeInboundPacketProcessor->getTotalEditsReceived();
+        quint64 totalEditsApplied = _octreeInboundPacketProcessor->getTotalEditsApplied();
+        quint64 totalEditBatches = _octreeInboundPacketProcessor->getTotalEditBatches();
+        quint64 averageLockHoldTimePerBatch = _octreeInboundPacketProcessor->getAverageLockHoldTimePerBatch();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
         quint64 averageLookupTime = _tree->getAverageLookupTime();
@@ -691,6 +695,14 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)averageProcessTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("            Total Edits Received: %1 edits\r\n")
+            .arg(locale.toString((uint)totalEditsReceived).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("             Total Edits Applied: %1 edits (after coalescing)\r\n")
+            .arg(locale.toString((uint)totalEditsApplied).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("              Total Edit Batches: %1 batches\r\n")
+            .arg(locale.toString((uint)totalEditBatches).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("    Average Lock Hold Time/Batch: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageLockHoldTimePerBatch).rightJustified(COLUMN_WIDTH, ' '));
 
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
@@ -1287,8 +1299,10 @@ void OctreeServer::aboutToFinish() {
     // This ensures that we don't get any more newly connecting nodes
     DependencyManager::get<NodeList>()->linkedDataCreateCallback = nullptr;
 
+    // stop the inbound packet processor, which applies the edits it is holding, before the tree is persisted
     if (_octreeInboundPacketProcessor) {
         _octreeInboundPacketProcessor->terminating();
+        _octreeInboundPacketProcessor->terminate();
     }
 
     // Shut down all the send threads
@@ -1387,6 +1401,13 @@ QString OctreeServer::getFileLoadTime() {
             }
             result += QString().sprintf("%.3f seconds", (double)seconds);
         }
+
+        Octree::LoadTimings loadTimings = getLoadTimings();
+        result += QString(" (decompress %1 ms, parse %2 ms, convert %3 ms, build %4 ms)")
+            .arg(loadTimings.decompressUsecs / USECS_PER_MSEC)
+            .arg(loadTimings.parseUsecs / USECS_PER_MSEC)
+            .arg(loadTimings.convertUsecs / USECS_PER_MSEC)
+            .arg(loadTimings.buildUsecs / USECS_PER_MSEC);
     } else {
         result = "Not yet loaded...";
     }
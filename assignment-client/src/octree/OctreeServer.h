@@ -63,6 +63,9 @@ public:
     bool isInitialLoadComplete() const { return (_persistManager) ? _persistManager->isInitialLoadComplete() : true; }
     bool isPersistEnabled() const { return (_persistManager) ? true : false; }
     quint64 getLoadElapsedTime() const { return (_persistManager) ? _persistManager->getLoadElapsedTime() : 0; }
+    Octree::LoadTimings getLoadTimings() const {
+        return (_persistManager) ? _persistManager->getLoadTimings() : Octree::LoadTimings();
+    }
     QString getPersistFilename() const { return (_persistManager) ? _persistManager->getPersistFilename() : ""; }
     QString getPersistFileMimeType() const { return (_persistManager) ? _persistManager->getPersistFileMimeType() : "text/plain"; }
     QByteArray getPersistFileContents() const { return (_persistManager) ? _persistManager->getPersistFileContents() : QByteArray(); }
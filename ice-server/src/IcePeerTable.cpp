@@ -0,0 +1,108 @@
+//
+//  IcePeerTable.cpp
+//  ice-server/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IcePeerTable.h"
+
+#include <QtCore/QCoreApplication>
+
+bool IcePeerTable::readPeer(const QUuid& domainID, const std::function<void(const NetworkPeer&)>& reader) const {
+    const Shard& shard = shardFor(domainID);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.domains.find(domainID);
+    if (it == shard.domains.end() || !it->second.peer) {
+        return false;
+    }
+    reader(*it->second.peer);
+    return true;
+}
+
+RSAPublicKeyPointer IcePeerTable::getPublicKey(const QUuid& domainID) const {
+    const Shard& shard = shardFor(domainID);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.domains.find(domainID);
+    return it != shard.domains.end() ? it->second.publicKey : RSAPublicKeyPointer();
+}
+
+void IcePeerTable::setPublicKey(const QUuid& domainID, RSAPublicKeyPointer publicKey) {
+    Shard& shard = shardFor(domainID);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    Domain& domain = shard.domains[domainID];
+    domain.publicKey = std::move(publicKey);
+
+    // heartbeats verified with the old key have to be verified again
+    domain.lastVerifiedHeartbeat.clear();
+}
+
+bool IcePeerTable::updatePeerForRepeatedHeartbeat(const QUuid& domainID, const QByteArray& signedHeartbeat,
+                                                  const HifiSockAddr& senderSockAddr, quint64 now) {
+    Shard& shard = shardFor(domainID);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.domains.find(domainID);
+    if (it == shard.domains.end() || !it->second.peer || it->second.lastVerifiedHeartbeat != signedHeartbeat) {
+        return false;
+    }
+
+    auto& peer = it->second.peer;
+    peer->activateMatchingOrNewSymmetricSocket(senderSockAddr);
+    peer->setLastHeardMicrostamp(now);
+    return true;
+}
+
+void IcePeerTable::updatePeerForVerifiedHeartbeat(const QUuid& domainID, const HifiSockAddr& publicSocket,
+                                                  const HifiSockAddr& localSocket, const QByteArray& signedHeartbeat,
+                                                  const HifiSockAddr& senderSockAddr, const RSAPublicKeyPointer& publicKey,
+                                                  quint64 now) {
+    Shard& shard = shardFor(domainID);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    Domain& domain = shard.domains[domainID];
+    if (!domain.peer) {
+        domain.peer = QSharedPointer<NetworkPeer>::create(domainID, publicSocket, localSocket);
+
+        // peers are created by the threads verifying heartbeats, but belong with the rest of the server
+        domain.peer->moveToThread(QCoreApplication::instance()->thread());
+
+        qDebug() << "Added a new network peer" << *domain.peer;
+    } else {
+        domain.peer->setPublicSocket(publicSocket);
+        domain.peer->setLocalSocket(localSocket);
+    }
+
+    // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+    domain.peer->activateMatchingOrNewSymmetricSocket(senderSockAddr);
+    domain.peer->setLastHeardMicrostamp(now);
+
+    // the key may have been replaced while this heartbeat was being verified with the old one
+    if (domain.publicKey == publicKey) {
+        domain.lastVerifiedHeartbeat = signedHeartbeat;
+    }
+}
+
+std::vector<SharedNetworkPeer> IcePeerTable::removeInactivePeers(quint64 lastHeardBefore) {
+    std::vector<SharedNetworkPeer> removedPeers;
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.domains.begin(); it != shard.domains.end();) {
+            auto& peer = it->second.peer;
+            if (peer && peer->getLastHeardMicrostamp() < lastHeardBefore) {
+                removedPeers.push_back(peer);
+                it = shard.domains.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    return removedPeers;
+}
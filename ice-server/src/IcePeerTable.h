@@ -0,0 +1,74 @@
+//
+//  IcePeerTable.h
+//  ice-server/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IcePeerTable_h
+#define hifi_IcePeerTable_h
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <openssl/rsa.h>
+
+#include <UUIDHasher.h>
+
+#include <NetworkPeer.h>
+
+using RSAPublicKeyPointer = std::shared_ptr<RSA>;
+
+// The heartbeating domains an ice-server knows of, with the public key their heartbeats are verified with and the last
+// heartbeat that was.  The domains are spread over shards with a lock each, so that the threads verifying heartbeats
+// and the thread answering peer queries rarely wait on each other.
+class IcePeerTable {
+public:
+    static const int NUM_SHARDS = 32;
+
+    // calls reader with the peer of a domain under the lock of its shard, returns false if there is no such peer
+    bool readPeer(const QUuid& domainID, const std::function<void(const NetworkPeer&)>& reader) const;
+
+    RSAPublicKeyPointer getPublicKey(const QUuid& domainID) const;
+    void setPublicKey(const QUuid& domainID, RSAPublicKeyPointer publicKey);
+
+    // a domain resends the same signed heartbeat until its sockets change.  If signedHeartbeat is the last one verified
+    // for the domain its peer is marked as heard from, and true returned, without verifying it again
+    bool updatePeerForRepeatedHeartbeat(const QUuid& domainID, const QByteArray& signedHeartbeat,
+                                        const HifiSockAddr& senderSockAddr, quint64 now);
+
+    // adds or updates the peer of a domain whose heartbeat was verified with publicKey
+    void updatePeerForVerifiedHeartbeat(const QUuid& domainID, const HifiSockAddr& publicSocket, const HifiSockAddr& localSocket,
+                                        const QByteArray& signedHeartbeat, const HifiSockAddr& senderSockAddr,
+                                        const RSAPublicKeyPointer& publicKey, quint64 now);
+
+    // removes the domains whose peers were last heard from before the given time, along with their public keys
+    std::vector<SharedNetworkPeer> removeInactivePeers(quint64 lastHeardBefore);
+
+private:
+    struct Domain {
+        SharedNetworkPeer peer;
+        RSAPublicKeyPointer publicKey;
+        QByteArray lastVerifiedHeartbeat;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<QUuid, Domain> domains;
+    };
+
+    Shard& shardFor(const QUuid& domainID) { return _shards[qHash(domainID) % NUM_SHARDS]; }
+    const Shard& shardFor(const QUuid& domainID) const { return _shards[qHash(domainID) % NUM_SHARDS]; }
+
+    std::array<Shard, NUM_SHARDS> _shards;
+};
+
+#endif // hifi_IcePeerTable_h
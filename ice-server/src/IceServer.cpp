@@ -13,6 +13,7 @@
 
 #include <openssl/x509.h>
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QTimer>
@@ -29,11 +30,58 @@
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
 
+// enough to keep the verification threads busy without holding heartbeats back for long
+const size_t MAX_VERIFICATION_BATCH_SIZE = 64;
+
+namespace {
+
+class HeartbeatVerificationTask : public QRunnable {
+public:
+    HeartbeatVerificationTask(IceServer* server, IcePeerTable& peerTable, std::vector<HeartbeatVerification> heartbeats,
+                              std::function<void(std::vector<HeartbeatVerification>)> finished) :
+        _server(server), _peerTable(peerTable), _heartbeats(std::move(heartbeats)), _finished(finished) {}
+
+    void run() override {
+        for (auto& heartbeat : _heartbeats) {
+            auto hashedPlaintext = QCryptographicHash::hash(heartbeat.signedHeartbeat.left(heartbeat.plaintextSize),
+                                                            QCryptographicHash::Sha256);
+            int verificationResult = RSA_verify(NID_sha256,
+                                                reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                                hashedPlaintext.size(),
+                                                reinterpret_cast<const unsigned char*>(heartbeat.signature.constData()),
+                                                heartbeat.signature.size(),
+                                                heartbeat.publicKey.get());
+
+            // this is the only success case
+            heartbeat.isVerified = verificationResult == 1;
+            if (heartbeat.isVerified) {
+                _peerTable.updatePeerForVerifiedHeartbeat(heartbeat.domainID, heartbeat.publicSocket, heartbeat.localSocket,
+                                                          heartbeat.signedHeartbeat, heartbeat.senderSockAddr,
+                                                          heartbeat.publicKey, usecTimestampNow());
+            }
+        }
+
+        // the replies go out from the thread the socket is on
+        auto finished = _finished;
+        auto heartbeats = std::move(_heartbeats);
+        QMetaObject::invokeMethod(_server, [finished, heartbeats] {
+            finished(heartbeats);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    IceServer* _server;
+    IcePeerTable& _peerTable;
+    std::vector<HeartbeatVerification> _heartbeats;
+    std::function<void(std::vector<HeartbeatVerification>)> _finished;
+};
+
+}
+
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
-    _serverSocket(0, false),
-    _activePeers()
+    _serverSocket(0, false)
 {
     // start the ice-server socket
     qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
@@ -75,20 +123,7 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
         
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
+            processHeartbeat(*nlPacket);
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
             QDataStream heartbeatStream(nlPacket.get());
             
@@ -104,20 +139,30 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
             QUuid connectRequestID;
             heartbeatStream >> connectRequestID;
             
-            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID);
-            
-            if (matchingPeer) {
+            // read what we need of the peer while its shard is locked, the verification threads may be updating it
+            QByteArray matchingPeerInformation;
+            HifiSockAddr matchingPeerSocket;
+            bool hasMatchingPeer = _peerTable.readPeer(connectRequestID, [&](const NetworkPeer& matchingPeer) {
+                matchingPeerInformation = matchingPeer.toByteArray();
+                if (matchingPeer.getActiveSocket()) {
+                    matchingPeerSocket = *matchingPeer.getActiveSocket();
+                }
+            });
+
+            if (hasMatchingPeer) {
                 
                 qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
                 
                 // we have the peer they want to connect to - send them pack the information for that peer
-                sendPeerInformationPacket(*matchingPeer, &nlPacket->getSenderSockAddr());
+                sendPeerInformationPacket(matchingPeerInformation, nlPacket->getSenderSockAddr());
                 
                 // we also need to send them to the active peer they are hoping to connect to
-                // create a dummy peer object we can pass to sendPeerInformationPacket
+                // create a dummy peer object we can take the information of
                 
-                NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
-                sendPeerInformationPacket(dummyPeer, matchingPeer->getActiveSocket());
+                if (!matchingPeerSocket.isNull()) {
+                    NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
+                    sendPeerInformationPacket(dummyPeer.toByteArray(), matchingPeerSocket);
+                }
             } else {
                 qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
             }
@@ -125,85 +170,95 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     }
 }
 
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
+void IceServer::processHeartbeat(NLPacket& packet) {
+    HeartbeatVerification heartbeat;
 
     // pull the UUID, public and private sock addrs for this peer
-    QUuid senderUUID;
-    HifiSockAddr publicSocket, localSocket;
-    QByteArray signature;
-
     QDataStream heartbeatStream(&packet);
-    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
+    heartbeatStream >> heartbeat.domainID >> heartbeat.publicSocket >> heartbeat.localSocket;
 
-    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
-    heartbeatStream >> signature;
+    heartbeat.plaintextSize = heartbeatStream.device()->pos();
+    heartbeatStream >> heartbeat.signature;
 
-    // make sure this is a verified heartbeat before performing any more processing
-    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
-        // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+    heartbeat.signedHeartbeat = QByteArray(packet.getPayload(), heartbeatStream.device()->pos());
+    heartbeat.senderSockAddr = packet.getSenderSockAddr();
 
-        if (!matchingPeer) {
-            // if we don't have this sender we need to create them now
-            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+    // a heartbeat the domain has already had verified needs no more processing
+    if (_peerTable.updatePeerForRepeatedHeartbeat(heartbeat.domainID, heartbeat.signedHeartbeat,
+                                                  heartbeat.senderSockAddr, usecTimestampNow())) {
+        sendHeartbeatReply(true, heartbeat.senderSockAddr);
+        return;
+    }
 
-            qDebug() << "Added a new network peer" << *matchingPeer;
-        } else {
-            // we already had the peer so just potentially update their sockets
-            matchingPeer->setPublicSocket(publicSocket);
-            matchingPeer->setLocalSocket(localSocket);
+    // make sure we're not already waiting for a public key for this domain-server
+    if (!_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+        // check if we have a public key for this domain ID - if we do not then fire off the request for it
+        heartbeat.publicKey = _peerTable.getPublicKey(heartbeat.domainID);
+        if (heartbeat.publicKey) {
+            queueHeartbeatVerification(std::move(heartbeat));
+            return;
         }
 
-        // update our last heard microstamp for this network peer to now
-        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
-        
-        return matchingPeer;
-    } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
+        requestDomainPublicKey(heartbeat.domainID);
+    }
+
+    sendHeartbeatReply(false, heartbeat.senderSockAddr);
+}
+
+void IceServer::queueHeartbeatVerification(HeartbeatVerification&& heartbeat) {
+    _pendingVerifications.push_back(std::move(heartbeat));
+
+    if (_pendingVerifications.size() >= MAX_VERIFICATION_BATCH_SIZE) {
+        dispatchHeartbeatVerifications();
+    } else if (!_isVerificationDispatchQueued) {
+        // dispatch the heartbeats that come in with this one once the socket has read them
+        _isVerificationDispatchQueued = true;
+        QMetaObject::invokeMethod(this, "dispatchHeartbeatVerifications", Qt::QueuedConnection);
     }
 }
 
-bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
-
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+void IceServer::dispatchHeartbeatVerifications() {
+    _isVerificationDispatchQueued = false;
+    if (_pendingVerifications.empty()) {
+        return;
+    }
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
+    std::vector<HeartbeatVerification> batch;
+    batch.swap(_pendingVerifications);
+    _pendingVerifications.reserve(MAX_VERIFICATION_BATCH_SIZE);
+
+    _verificationPool.start(new HeartbeatVerificationTask(this, _peerTable, std::move(batch),
+        [this](std::vector<HeartbeatVerification> heartbeats) {
+            finishHeartbeatVerifications(heartbeats);
+        }));
+}
+
+void IceServer::finishHeartbeatVerifications(const std::vector<HeartbeatVerification>& heartbeats) {
+    for (auto& heartbeat : heartbeats) {
+        if (!heartbeat.isVerified) {
+            qDebug() << "Failed to verify heartbeat for" << heartbeat.domainID << "- re-requesting public key from API.";
+
+            // the domain may have a new keypair, or be a bad actor
+            if (!_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+                requestDomainPublicKey(heartbeat.domainID);
             }
         }
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+        sendHeartbeatReply(heartbeat.isVerified, heartbeat.senderSockAddr);
     }
+}
 
-    return false;
+void IceServer::sendHeartbeatReply(bool isVerified, const HifiSockAddr& senderSockAddr) {
+    if (isVerified) {
+        // we have an active and verified heartbeating peer
+        // send them an ACK packet so they know that they are being heard and ready for ICE
+        static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+        _serverSocket.writePacket(*ackPacket, senderSockAddr);
+    } else {
+        // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+        static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+        _serverSocket.writePacket(*deniedPacket, senderSockAddr);
+    }
 }
 
 void IceServer::requestDomainPublicKey(const QUuid& domainID) {
@@ -262,7 +317,7 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    _peerTable.setPublicKey(domainID, RSAPublicKeyPointer(rsaPublicKey, RSA_free));
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -288,33 +343,21 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
     reply->deleteLater();
 }
 
-void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr) {
+void IceServer::sendPeerInformationPacket(const QByteArray& peerInformation, const HifiSockAddr& destinationSockAddr) {
     auto peerPacket = NLPacket::create(PacketType::ICEServerPeerInformation);
 
-    // get the byte array for this peer
-    peerPacket->write(peer.toByteArray());
+    // write the byte array for this peer
+    peerPacket->write(peerInformation);
     
     // write the current packet
-    _serverSocket.writePacket(*peerPacket, *destinationSockAddr);
+    _serverSocket.writePacket(*peerPacket, destinationSockAddr);
 }
 
 void IceServer::clearInactivePeers() {
-    NetworkPeerHash::iterator peerItem = _activePeers.begin();
+    quint64 lastHeardBefore = usecTimestampNow() - (PEER_SILENCE_THRESHOLD_MSECS * 1000);
 
-    while (peerItem != _activePeers.end()) {
-        SharedNetworkPeer peer = peerItem.value();
-
-        if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
-            qDebug() << "Removing peer from memory for inactivity -" << *peer;
-
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
-
-            // remove the peer object
-            peerItem = _activePeers.erase(peerItem);
-        } else {
-            // we didn't kill this peer, push the iterator forwards
-            ++peerItem;
-        }
+    // the public keys of these domains are removed with them
+    for (auto& peer : _peerTable.removeInactivePeers(lastHeardBefore)) {
+        qDebug() << "Removing peer from memory for inactivity -" << *peer;
     }
 }
@@ -12,12 +12,13 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 #include <QUdpSocket>
 
-#include <openssl/rsa.h>
-
 #include <UUIDHasher.h>
 
 #include <NetworkPeer.h>
@@ -26,8 +27,23 @@
 #include <NLPacket.h>
 #include <udt/Socket.h>
 
+#include "IcePeerTable.h"
+
 class QNetworkReply;
 
+// a heartbeat waiting for its signature to be checked by the verification pool
+struct HeartbeatVerification {
+    QUuid domainID;
+    HifiSockAddr publicSocket;
+    HifiSockAddr localSocket;
+    HifiSockAddr senderSockAddr;
+    QByteArray signedHeartbeat; // the plaintext followed by the signature, as it was received
+    int plaintextSize { 0 };
+    QByteArray signature;
+    RSAPublicKeyPointer publicKey;
+    bool isVerified { false };
+};
+
 class IceServer : public QCoreApplication {
     Q_OBJECT
 public:
@@ -35,25 +51,29 @@ public:
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
+    void dispatchHeartbeatVerifications();
 private:
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
-    void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
+    void processHeartbeat(NLPacket& packet);
+    void queueHeartbeatVerification(HeartbeatVerification&& heartbeat);
+    void finishHeartbeatVerifications(const std::vector<HeartbeatVerification>& heartbeats);
+    void sendHeartbeatReply(bool isVerified, const HifiSockAddr& senderSockAddr);
+
+    void sendPeerInformationPacket(const QByteArray& peerInformation, const HifiSockAddr& destinationSockAddr);
+
     void requestDomainPublicKey(const QUuid& domainID);
 
     QUuid _id;
     udt::Socket _serverSocket;
 
-    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
-    NetworkPeerHash _activePeers;
+    IcePeerTable _peerTable;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
-    DomainPublicKeyHash _domainPublicKeys;
+    // heartbeats are verified in batches, on threads of their own
+    QThreadPool _verificationPool;
+    std::vector<HeartbeatVerification> _pendingVerifications;
+    bool _isVerificationDispatchQueued { false };
 
     QSet<QUuid> _pendingPublicKeyRequests;
 };
@@ -573,6 +573,7 @@ void EntityTreeRenderer::update(bool simulate) {
                 scene->enqueueTransaction(transaction);
             }
         }
+        updateLoadingPriorities();
         {
             PerformanceTimer perfTimer("workload::transaction");
             workload::Transaction spaceTransaction;
@@ -607,6 +608,21 @@ void EntityTreeRenderer::update(bool simulate) {
     }
 }
 
+void EntityTreeRenderer::updateLoadingPriorities() {
+    // what is still loading is reprioritized as the avatar moves, rather than keeping the priorities it had from where
+    // the avatar was when it was requested
+    auto avatarPosition = _viewState->getAvatarPosition();
+    if (glm::distance(avatarPosition, _loadingPrioritiesPosition) < LOADING_PRIORITIES_UPDATE_DISTANCE) {
+        return;
+    }
+    _loadingPrioritiesPosition = avatarPosition;
+
+    PROFILE_RANGE(simulation_physics, "LoadingPriorities");
+    for (const auto& entry : _entitiesInScene) {
+        entry.second->updateLoadingPriority();
+    }
+}
+
 void EntityTreeRenderer::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUpdate) {
     std::unique_lock<std::mutex> lock(_spaceLock);
     _spaceUpdates.emplace_back(proxyUpdate.first, proxyUpdate.second);
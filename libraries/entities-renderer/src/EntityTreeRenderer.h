@@ -182,6 +182,8 @@ private:
     bool applyLayeredZones();
     void stopDomainAndNonOwnedEntities();
 
+    void updateLoadingPriorities();
+
     void checkAndCallPreload(const EntityItemID& entityID, bool reload = false, bool unloadFirst = false);
 
     EntityItemID _currentHoverOverEntityID;
@@ -249,6 +251,9 @@ private:
     const uint64_t ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
     const float ZONE_CHECK_DISTANCE = 0.001f;
 
+    glm::vec3 _loadingPrioritiesPosition { 0.0f };
+    const float LOADING_PRIORITIES_UPDATE_DISTANCE = 2.0f;
+
     float _avgRenderableUpdateCost { 0.0f };
 
     ReadWriteLockable _changedEntitiesGuard;
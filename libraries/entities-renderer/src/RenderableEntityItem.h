@@ -55,6 +55,9 @@ public:
 
     const uint64_t& getUpdateTime() const { return _updateTime; }
 
+    // Called on the main thread when the view has moved, for what is still loading to be loaded in the new order
+    virtual void updateLoadingPriority() {}
+
     virtual void addMaterial(graphics::MaterialLayer material, const std::string& parentMaterialName);
     virtual void removeMaterial(graphics::MaterialPointer material, const std::string& parentMaterialName);
 
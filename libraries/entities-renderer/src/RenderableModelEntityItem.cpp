@@ -1429,6 +1429,15 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
     }
 }
 
+void ModelEntityRenderer::updateLoadingPriority() {
+    ModelPointer model = resultWithReadLock<ModelPointer>([&] {
+        return _model;
+    });
+    if (model && !model->isLoaded()) {
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*_entity));
+    }
+}
+
 void ModelEntityRenderer::setIsVisibleInSecondaryCamera(bool value) {
     Parent::setIsVisibleInSecondaryCamera(value);
     // called within a lock so no need to lock for _model
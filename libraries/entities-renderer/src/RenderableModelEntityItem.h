@@ -151,6 +151,8 @@ public:
     // FIXME: model mesh parts should fade individually
     bool isFading() const override { return false; }
 
+    void updateLoadingPriority() override;
+
 protected:
     virtual void removeFromScene(const ScenePointer& scene, Transaction& transaction) override;
     virtual void onRemoveFromSceneTyped(const TypedEntityPointer& entity) override;
@@ -0,0 +1,647 @@
+//
+//  EntityEditFilterRules.cpp
+//  libraries/entities/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFilterRules.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QSet>
+
+#include <shared/JSONHelpers.h>
+
+#include "EntityItem.h"
+
+// What a condition is evaluated against: the edited properties, or the current properties of the entity for deletes.
+struct EntityEditFilterRules::Subject {
+    const EntityItemProperties& properties;
+    const EntityPropertyFlags& changedProperties;
+    bool onlyChangedProperties;
+    EntityTypes::EntityType type;
+
+    bool hasProperty(EntityPropertyList property) const {
+        return !onlyChangedProperties || changedProperties.getHasProperty(property);
+    }
+};
+
+class EntityEditFilterRules::Condition {
+public:
+    virtual ~Condition() = default;
+    virtual bool matches(const Subject& subject) const = 0;
+};
+
+// Direct access to the properties that can be clamped or compared, so a rule never goes through a QVariant or script value.
+struct EntityEditFilterRules::PropertyAccessor {
+    enum Kind { Bool, Float, Vec3, String };
+
+    EntityPropertyList propertyEnum;
+    Kind kind;
+    bool (*getBool)(const EntityItemProperties&) { nullptr };
+    float (*getFloat)(const EntityItemProperties&) { nullptr };
+    void (*setFloat)(EntityItemProperties&, float) { nullptr };
+    glm::vec3 (*getVec3)(const EntityItemProperties&) { nullptr };
+    void (*setVec3)(EntityItemProperties&, const glm::vec3&) { nullptr };
+    QString (*getString)(const EntityItemProperties&) { nullptr };
+};
+
+using PropertyAccessor = EntityEditFilterRules::PropertyAccessor;
+using Condition = EntityEditFilterRules::Condition;
+using Subject = EntityEditFilterRules::Subject;
+
+#define ADD_BOOL_ACCESSOR(P, N, n) \
+    { \
+        PropertyAccessor accessor { P, PropertyAccessor::Bool }; \
+        accessor.getBool = [](const EntityItemProperties& properties) { return (bool)properties.get##N(); }; \
+        accessors[#n] = accessor; \
+    }
+
+#define ADD_FLOAT_ACCESSOR(P, N, n) \
+    { \
+        PropertyAccessor accessor { P, PropertyAccessor::Float }; \
+        accessor.getFloat = [](const EntityItemProperties& properties) { return (float)properties.get##N(); }; \
+        accessor.setFloat = [](EntityItemProperties& properties, float value) { properties.set##N(value); }; \
+        accessors[#n] = accessor; \
+    }
+
+#define ADD_VEC3_ACCESSOR(P, N, n) \
+    { \
+        PropertyAccessor accessor { P, PropertyAccessor::Vec3 }; \
+        accessor.getVec3 = [](const EntityItemProperties& properties) { return properties.get##N(); }; \
+        accessor.setVec3 = [](EntityItemProperties& properties, const glm::vec3& value) { properties.set##N(value); }; \
+        accessors[#n] = accessor; \
+    }
+
+#define ADD_STRING_ACCESSOR(P, N, n) \
+    { \
+        PropertyAccessor accessor { P, PropertyAccessor::String }; \
+        accessor.getString = [](const EntityItemProperties& properties) { return properties.get##N(); }; \
+        accessors[#n] = accessor; \
+    }
+
+namespace {
+
+const QString TYPE_PROPERTY = "type";
+
+const QHash<QString, PropertyAccessor>& getPropertyAccessors() {
+    static const QHash<QString, PropertyAccessor> propertyAccessors = [] {
+        QHash<QString, PropertyAccessor> accessors;
+
+        ADD_BOOL_ACCESSOR(PROP_VISIBLE, Visible, visible);
+        ADD_BOOL_ACCESSOR(PROP_LOCKED, Locked, locked);
+        ADD_BOOL_ACCESSOR(PROP_COLLISIONLESS, Collisionless, collisionless);
+        ADD_BOOL_ACCESSOR(PROP_DYNAMIC, Dynamic, dynamic);
+        ADD_BOOL_ACCESSOR(PROP_CLONEABLE, Cloneable, cloneable);
+
+        ADD_FLOAT_ACCESSOR(PROP_DENSITY, Density, density);
+        ADD_FLOAT_ACCESSOR(PROP_DAMPING, Damping, damping);
+        ADD_FLOAT_ACCESSOR(PROP_ANGULAR_DAMPING, AngularDamping, angularDamping);
+        ADD_FLOAT_ACCESSOR(PROP_RESTITUTION, Restitution, restitution);
+        ADD_FLOAT_ACCESSOR(PROP_FRICTION, Friction, friction);
+        ADD_FLOAT_ACCESSOR(PROP_LIFETIME, Lifetime, lifetime);
+        ADD_FLOAT_ACCESSOR(PROP_CLONE_LIFETIME, CloneLifetime, cloneLifetime);
+        ADD_FLOAT_ACCESSOR(PROP_CLONE_LIMIT, CloneLimit, cloneLimit);
+
+        ADD_VEC3_ACCESSOR(PROP_POSITION, Position, position);
+        ADD_VEC3_ACCESSOR(PROP_LOCAL_POSITION, LocalPosition, localPosition);
+        ADD_VEC3_ACCESSOR(PROP_DIMENSIONS, Dimensions, dimensions);
+        ADD_VEC3_ACCESSOR(PROP_REGISTRATION_POINT, RegistrationPoint, registrationPoint);
+        ADD_VEC3_ACCESSOR(PROP_VELOCITY, Velocity, velocity);
+        ADD_VEC3_ACCESSOR(PROP_ANGULAR_VELOCITY, AngularVelocity, angularVelocity);
+        ADD_VEC3_ACCESSOR(PROP_GRAVITY, Gravity, gravity);
+        ADD_VEC3_ACCESSOR(PROP_ACCELERATION, Acceleration, acceleration);
+
+        ADD_STRING_ACCESSOR(PROP_NAME, Name, name);
+        ADD_STRING_ACCESSOR(PROP_USER_DATA, UserData, userData);
+        ADD_STRING_ACCESSOR(PROP_HREF, Href, href);
+        ADD_STRING_ACCESSOR(PROP_DESCRIPTION, Description, description);
+        ADD_STRING_ACCESSOR(PROP_SCRIPT, Script, script);
+        ADD_STRING_ACCESSOR(PROP_SERVER_SCRIPTS, ServerScripts, serverScripts);
+
+        return accessors;
+    }();
+    return propertyAccessors;
+}
+
+bool vec3FromRuleValue(const QJsonValue& value, glm::vec3& result) {
+    if (value.isDouble() || value.isArray()) {
+        result = vec3FromJsonValue(value);
+        return true;
+    }
+    if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        if (object["x"].isDouble() && object["y"].isDouble() && object["z"].isDouble()) {
+            result = glm::vec3(object["x"].toDouble(), object["y"].toDouble(), object["z"].toDouble());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool stringsFromRuleValue(const QJsonValue& value, QSet<QString>& result) {
+    if (value.isString()) {
+        result.insert(value.toString());
+        return true;
+    }
+    if (value.isArray()) {
+        for (const auto& element : value.toArray()) {
+            if (!element.isString()) {
+                return false;
+            }
+            result.insert(element.toString());
+        }
+        return true;
+    }
+    return false;
+}
+
+class CompositeCondition : public Condition {
+public:
+    CompositeCondition(bool matchAll, std::vector<std::unique_ptr<Condition>> conditions) :
+        _matchAll(matchAll), _conditions(std::move(conditions)) {}
+
+    bool matches(const Subject& subject) const override {
+        for (const auto& condition : _conditions) {
+            if (condition->matches(subject) != _matchAll) {
+                return !_matchAll;
+            }
+        }
+        return _matchAll;
+    }
+
+private:
+    bool _matchAll;
+    std::vector<std::unique_ptr<Condition>> _conditions;
+};
+
+class NotCondition : public Condition {
+public:
+    NotCondition(std::unique_ptr<Condition> condition) : _condition(std::move(condition)) {}
+    bool matches(const Subject& subject) const override { return !_condition->matches(subject); }
+
+private:
+    std::unique_ptr<Condition> _condition;
+};
+
+class ChangedCondition : public Condition {
+public:
+    ChangedCondition(std::vector<EntityPropertyList> properties) : _properties(std::move(properties)) {}
+
+    bool matches(const Subject& subject) const override {
+        if (!subject.onlyChangedProperties) {
+            return false;
+        }
+        for (auto property : _properties) {
+            if (subject.changedProperties.getHasProperty(property)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<EntityPropertyList> _properties;
+};
+
+class TypeCondition : public Condition {
+public:
+    TypeCondition(QSet<int> types, bool negate) : _types(std::move(types)), _negate(negate) {}
+    bool matches(const Subject& subject) const override { return _types.contains(subject.type) != _negate; }
+
+private:
+    QSet<int> _types;
+    bool _negate;
+};
+
+class BoolCondition : public Condition {
+public:
+    BoolCondition(const PropertyAccessor& accessor, bool value) : _accessor(accessor), _value(value) {}
+
+    bool matches(const Subject& subject) const override {
+        return subject.hasProperty(_accessor.propertyEnum) && _accessor.getBool(subject.properties) == _value;
+    }
+
+private:
+    const PropertyAccessor& _accessor;
+    bool _value;
+};
+
+// compares a float property, or the length of a vec3 property
+class NumberCondition : public Condition {
+public:
+    enum Comparison { Equals, NotEquals, GreaterThan, LessThan };
+
+    NumberCondition(const PropertyAccessor& accessor, Comparison comparison, float value) :
+        _accessor(accessor), _comparison(comparison), _value(value) {}
+
+    bool matches(const Subject& subject) const override {
+        if (!subject.hasProperty(_accessor.propertyEnum)) {
+            return false;
+        }
+        float value = _accessor.kind == PropertyAccessor::Float ?
+            _accessor.getFloat(subject.properties) : glm::length(_accessor.getVec3(subject.properties));
+        switch (_comparison) {
+            case Equals:
+                return value == _value;
+            case NotEquals:
+                return value != _value;
+            case GreaterThan:
+                return value > _value;
+            case LessThan:
+                return value < _value;
+        }
+        return false;
+    }
+
+private:
+    const PropertyAccessor& _accessor;
+    Comparison _comparison;
+    float _value;
+};
+
+class BoxCondition : public Condition {
+public:
+    BoxCondition(const PropertyAccessor& accessor, const glm::vec3& min, const glm::vec3& max, bool inside) :
+        _accessor(accessor), _min(min), _max(max), _inside(inside) {}
+
+    bool matches(const Subject& subject) const override {
+        if (!subject.hasProperty(_accessor.propertyEnum)) {
+            return false;
+        }
+        glm::vec3 value = _accessor.getVec3(subject.properties);
+        bool inside = glm::all(glm::greaterThanEqual(value, _min)) && glm::all(glm::lessThanEqual(value, _max));
+        return inside == _inside;
+    }
+
+private:
+    const PropertyAccessor& _accessor;
+    glm::vec3 _min;
+    glm::vec3 _max;
+    bool _inside;
+};
+
+class StringCondition : public Condition {
+public:
+    enum Comparison { In, NotIn, Contains, StartsWith };
+
+    StringCondition(const PropertyAccessor& accessor, Comparison comparison, QSet<QString> values) :
+        _accessor(accessor), _comparison(comparison), _values(std::move(values)) {}
+
+    bool matches(const Subject& subject) const override {
+        if (!subject.hasProperty(_accessor.propertyEnum)) {
+            return false;
+        }
+        QString value = _accessor.getString(subject.properties);
+        switch (_comparison) {
+            case In:
+                return _values.contains(value);
+            case NotIn:
+                return !_values.contains(value);
+            case Contains:
+            case StartsWith:
+                for (const auto& pattern : _values) {
+                    if (_comparison == Contains ? value.contains(pattern) : value.startsWith(pattern)) {
+                        return true;
+                    }
+                }
+                return false;
+        }
+        return false;
+    }
+
+private:
+    const PropertyAccessor& _accessor;
+    Comparison _comparison;
+    QSet<QString> _values;
+};
+
+std::unique_ptr<Condition> compileCondition(const QJsonValue& value, QString& error);
+
+std::unique_ptr<Condition> compileComposite(bool matchAll, const QJsonValue& value, QString& error) {
+    if (!value.isArray()) {
+        error = QString("\"%1\" needs an array of conditions").arg(matchAll ? "all" : "any");
+        return nullptr;
+    }
+    std::vector<std::unique_ptr<Condition>> conditions;
+    for (const auto& element : value.toArray()) {
+        auto condition = compileCondition(element, error);
+        if (!condition) {
+            return nullptr;
+        }
+        conditions.push_back(std::move(condition));
+    }
+    return std::unique_ptr<Condition>(new CompositeCondition(matchAll, std::move(conditions)));
+}
+
+std::unique_ptr<Condition> compilePropertyCondition(const QString& propertyName, const QJsonObject& object, QString& error) {
+    if (propertyName == TYPE_PROPERTY) {
+        bool negate = object.contains("notEquals") || object.contains("notIn");
+        QJsonValue typeNames = object.contains("equals") ? object["equals"] : object.contains("notEquals") ? object["notEquals"] :
+            object.contains("in") ? object["in"] : object["notIn"];
+        QSet<QString> names;
+        if (!stringsFromRuleValue(typeNames, names)) {
+            error = "\"type\" conditions need \"equals\", \"notEquals\", \"in\" or \"notIn\" with entity type names";
+            return nullptr;
+        }
+        QSet<int> types;
+        for (const auto& name : names) {
+            EntityTypes::EntityType type = EntityTypes::getEntityTypeFromName(name);
+            if (type == EntityTypes::Unknown) {
+                error = "unknown entity type " + name;
+                return nullptr;
+            }
+            types.insert(type);
+        }
+        return std::unique_ptr<Condition>(new TypeCondition(types, negate));
+    }
+
+    const auto& accessors = getPropertyAccessors();
+    auto itr = accessors.find(propertyName);
+    if (itr == accessors.end()) {
+        error = "conditions are not supported on property " + propertyName;
+        return nullptr;
+    }
+    const PropertyAccessor& accessor = itr.value();
+
+    switch (accessor.kind) {
+        case PropertyAccessor::Bool:
+            if (object["equals"].isBool()) {
+                return std::unique_ptr<Condition>(new BoolCondition(accessor, object["equals"].toBool()));
+            } else if (object["notEquals"].isBool()) {
+                return std::unique_ptr<Condition>(new BoolCondition(accessor, !object["notEquals"].toBool()));
+            }
+            break;
+
+        case PropertyAccessor::Float:
+        case PropertyAccessor::Vec3: {
+            static const std::vector<std::pair<QString, NumberCondition::Comparison>> COMPARISONS {
+                { "equals", NumberCondition::Equals },
+                { "notEquals", NumberCondition::NotEquals },
+                { "greaterThan", NumberCondition::GreaterThan },
+                { "lessThan", NumberCondition::LessThan }
+            };
+            for (const auto& comparison : COMPARISONS) {
+                if (object[comparison.first].isDouble()) {
+                    float value = (float)object[comparison.first].toDouble();
+                    return std::unique_ptr<Condition>(new NumberCondition(accessor, comparison.second, value));
+                }
+            }
+            if (accessor.kind == PropertyAccessor::Vec3 && (object.contains("inside") || object.contains("outside"))) {
+                bool inside = object.contains("inside");
+                QJsonObject box = object[inside ? "inside" : "outside"].toObject();
+                glm::vec3 min;
+                glm::vec3 max;
+                if (vec3FromRuleValue(box["min"], min) && vec3FromRuleValue(box["max"], max)) {
+                    return std::unique_ptr<Condition>(new BoxCondition(accessor, min, max, inside));
+                }
+            }
+            break;
+        }
+
+        case PropertyAccessor::String: {
+            static const std::vector<std::pair<QString, StringCondition::Comparison>> COMPARISONS {
+                { "equals", StringCondition::In },
+                { "in", StringCondition::In },
+                { "notEquals", StringCondition::NotIn },
+                { "notIn", StringCondition::NotIn },
+                { "contains", StringCondition::Contains },
+                { "startsWith", StringCondition::StartsWith }
+            };
+            for (const auto& comparison : COMPARISONS) {
+                QSet<QString> values;
+                if (object.contains(comparison.first) && stringsFromRuleValue(object[comparison.first], values)) {
+                    return std::unique_ptr<Condition>(new StringCondition(accessor, comparison.second, values));
+                }
+            }
+            break;
+        }
+    }
+
+    error = "unsupported comparison on property " + propertyName;
+    return nullptr;
+}
+
+std::unique_ptr<Condition> compileCondition(const QJsonValue& value, QString& error) {
+    if (!value.isObject()) {
+        error = "conditions must be objects";
+        return nullptr;
+    }
+    QJsonObject object = value.toObject();
+
+    if (object.contains("all")) {
+        return compileComposite(true, object["all"], error);
+    }
+    if (object.contains("any")) {
+        return compileComposite(false, object["any"], error);
+    }
+    if (object.contains("not")) {
+        auto condition = compileCondition(object["not"], error);
+        return condition ? std::unique_ptr<Condition>(new NotCondition(std::move(condition))) : nullptr;
+    }
+    if (object.contains("changed")) {
+        QSet<QString> names;
+        if (!stringsFromRuleValue(object["changed"], names)) {
+            error = "\"changed\" needs a property name or an array of property names";
+            return nullptr;
+        }
+        std::vector<EntityPropertyList> properties;
+        for (const auto& name : names) {
+            EntityPropertyInfo propertyInfo;
+            if (!EntityItemProperties::getPropertyInfo(name, propertyInfo)) {
+                error = "unknown property " + name;
+                return nullptr;
+            }
+            properties.push_back(propertyInfo.propertyEnum);
+        }
+        return std::unique_ptr<Condition>(new ChangedCondition(std::move(properties)));
+    }
+    if (object["property"].isString()) {
+        return compilePropertyCondition(object["property"].toString(), object, error);
+    }
+
+    error = "conditions need one of \"all\", \"any\", \"not\", \"changed\" or \"property\"";
+    return nullptr;
+}
+
+}
+
+EntityEditFilterRules::~EntityEditFilterRules() = default;
+
+std::shared_ptr<EntityEditFilterRules> EntityEditFilterRules::compile(const QJsonObject& ruleSet, QString& error) {
+    auto rules = std::make_shared<EntityEditFilterRules>();
+
+    auto readFlag = [&](const char* name, bool& flag) {
+        if (ruleSet[name].isBool()) {
+            flag = ruleSet[name].toBool();
+        }
+    };
+    readFlag("wantsToFilterAdd", rules->_wantsToFilterAdd);
+    readFlag("wantsToFilterEdit", rules->_wantsToFilterEdit);
+    readFlag("wantsToFilterPhysics", rules->_wantsToFilterPhysics);
+    readFlag("wantsToFilterDelete", rules->_wantsToFilterDelete);
+
+    if (ruleSet.contains("allowedProperties")) {
+        QSet<QString> names;
+        if (!stringsFromRuleValue(ruleSet["allowedProperties"], names)) {
+            error = "\"allowedProperties\" needs an array of property names";
+            return nullptr;
+        }
+        rules->_hasAllowedProperties = true;
+        // clients send these alongside other edits as bookkeeping, so they are never refused on their own
+        rules->_allowedProperties << PROP_LAST_EDITED_BY << PROP_QUERY_AA_CUBE;
+        for (const auto& name : names) {
+            EntityPropertyInfo propertyInfo;
+            if (!EntityItemProperties::getPropertyInfo(name, propertyInfo)) {
+                error = "unknown property " + name;
+                return nullptr;
+            }
+            rules->_allowedProperties << propertyInfo.propertyEnum;
+        }
+    }
+
+    QJsonObject clamps = ruleSet["clamp"].toObject();
+    const auto& accessors = getPropertyAccessors();
+    for (auto itr = clamps.begin(); itr != clamps.end(); ++itr) {
+        auto accessor = accessors.find(itr.key());
+        if (accessor == accessors.end() ||
+            (accessor->kind != PropertyAccessor::Float && accessor->kind != PropertyAccessor::Vec3)) {
+            error = "clamps are not supported on property " + itr.key();
+            return nullptr;
+        }
+
+        QJsonObject range = itr.value().toObject();
+        Clamp clamp;
+        clamp.accessor = &accessor.value();
+        clamp.hasMin = range.contains("min");
+        clamp.hasMax = range.contains("max");
+        clamp.hasMaxLength = accessor->kind == PropertyAccessor::Vec3 && range["maxLength"].isDouble();
+        if ((clamp.hasMin && !vec3FromRuleValue(range["min"], clamp.min)) ||
+            (clamp.hasMax && !vec3FromRuleValue(range["max"], clamp.max))) {
+            error = "bad clamp range for property " + itr.key();
+            return nullptr;
+        }
+        if (clamp.hasMaxLength) {
+            clamp.maxLength = (float)range["maxLength"].toDouble();
+        }
+        if (!clamp.hasMin && !clamp.hasMax && !clamp.hasMaxLength) {
+            error = "clamp on property " + itr.key() + " needs \"min\", \"max\" or \"maxLength\"";
+            return nullptr;
+        }
+        rules->_clamps.push_back(clamp);
+    }
+
+    if (ruleSet.contains("reject")) {
+        if (!ruleSet["reject"].isArray()) {
+            error = "\"reject\" needs an array of conditions";
+            return nullptr;
+        }
+        for (const auto& value : ruleSet["reject"].toArray()) {
+            auto condition = compileCondition(value, error);
+            if (!condition) {
+                return nullptr;
+            }
+            rules->_rejectConditions.push_back(std::move(condition));
+        }
+    }
+
+    return rules;
+}
+
+bool EntityEditFilterRules::wantsToFilter(EntityTree::FilterType filterType) const {
+    switch (filterType) {
+        case EntityTree::FilterType::Add:
+            return _wantsToFilterAdd;
+        case EntityTree::FilterType::Edit:
+            return _wantsToFilterEdit;
+        case EntityTree::FilterType::Physics:
+            return _wantsToFilterPhysics;
+        case EntityTree::FilterType::Delete:
+            return _wantsToFilterDelete;
+    }
+    return true;
+}
+
+bool EntityEditFilterRules::filter(EntityItemProperties& properties, bool& wasChanged, EntityTree::FilterType filterType,
+                                   const EntityItemPointer& existingEntity) const {
+    if (filterType == EntityTree::FilterType::Delete) {
+        // nothing is being edited, so check the conditions against what is being deleted
+        if (_rejectConditions.empty() || !existingEntity) {
+            return true;
+        }
+        EntityItemProperties currentProperties = existingEntity->getProperties();
+        EntityPropertyFlags noChangedProperties;
+        Subject subject { currentProperties, noChangedProperties, false, existingEntity->getType() };
+        for (const auto& condition : _rejectConditions) {
+            if (condition->matches(subject)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    EntityPropertyFlags changedProperties = properties.getChangedProperties();
+
+    if (_hasAllowedProperties && !changedProperties.isEmpty()) {
+        for (int flag = (int)changedProperties.firstFlag(); flag <= (int)changedProperties.lastFlag(); flag++) {
+            EntityPropertyList property = (EntityPropertyList)flag;
+            if (changedProperties.getHasProperty(property) && !_allowedProperties.getHasProperty(property)) {
+                return false;
+            }
+        }
+    }
+
+    EntityTypes::EntityType type = existingEntity ? existingEntity->getType() : properties.getType();
+    Subject subject { properties, changedProperties, true, type };
+    for (const auto& condition : _rejectConditions) {
+        if (condition->matches(subject)) {
+            return false;
+        }
+    }
+
+    for (const auto& clamp : _clamps) {
+        const PropertyAccessor& accessor = *clamp.accessor;
+        if (!changedProperties.getHasProperty(accessor.propertyEnum)) {
+            continue;
+        }
+        if (accessor.kind == PropertyAccessor::Float) {
+            float value = accessor.getFloat(properties);
+            float clamped = value;
+            if (clamp.hasMin) {
+                clamped = std::max(clamped, clamp.min.x);
+            }
+            if (clamp.hasMax) {
+                clamped = std::min(clamped, clamp.max.x);
+            }
+            if (clamped != value) {
+                accessor.setFloat(properties, clamped);
+                wasChanged = true;
+            }
+        } else {
+            glm::vec3 value = accessor.getVec3(properties);
+            glm::vec3 clamped = value;
+            if (clamp.hasMin) {
+                clamped = glm::max(clamped, clamp.min);
+            }
+            if (clamp.hasMax) {
+                clamped = glm::min(clamped, clamp.max);
+            }
+            if (clamp.hasMaxLength) {
+                float length = glm::length(clamped);
+                if (length > clamp.maxLength) {
+                    clamped *= clamp.maxLength / length;
+                }
+            }
+            if (clamped != value) {
+                accessor.setVec3(properties, clamped);
+                wasChanged = true;
+            }
+        }
+    }
+
+    return true;
+}
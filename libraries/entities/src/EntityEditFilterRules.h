@@ -0,0 +1,90 @@
+//
+//  EntityEditFilterRules.h
+//  libraries/entities/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditFilterRules_h
+#define hifi_EntityEditFilterRules_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+
+// A declarative entity edit filter, compiled once from a JSON rule set and evaluated directly against
+// EntityItemProperties, without a script engine.  A rule set looks like:
+//
+//  {
+//      "wantsToFilterAdd": true,                 // optional, same defaults as the script filter flags
+//      "wantsToFilterEdit": true,
+//      "wantsToFilterPhysics": true,
+//      "wantsToFilterDelete": false,
+//      "allowedProperties": [ "position", "rotation", "velocity" ],
+//      "clamp": {
+//          "dimensions": { "min": 0.01, "max": { "x": 10, "y": 5, "z": 10 } },
+//          "velocity": { "maxLength": 20 },
+//          "lifetime": { "max": 3600 }
+//      },
+//      "reject": [
+//          { "changed": [ "script", "serverScripts" ] },
+//          { "property": "type", "in": [ "ParticleEffect", "Web" ] },
+//          { "all": [ { "property": "dynamic", "equals": true }, { "property": "density", "greaterThan": 5000 } ] }
+//      ]
+//  }
+//
+// An edit that changes a property missing from "allowedProperties" is rejected, as is an edit matching any "reject"
+// condition.  Conditions on a property only match when the edit changes that property, except for deletes, which are
+// checked against the current properties of the entity.  Clamps adjust the edited values and mark the edit as changed.
+class EntityEditFilterRules {
+public:
+    ~EntityEditFilterRules();
+
+    // returns nullptr and fills in error if the rule set is malformed
+    static std::shared_ptr<EntityEditFilterRules> compile(const QJsonObject& ruleSet, QString& error);
+
+    bool wantsToFilter(EntityTree::FilterType filterType) const;
+
+    // returns false if the edit is rejected, otherwise applies the clamps to properties
+    bool filter(EntityItemProperties& properties, bool& wasChanged, EntityTree::FilterType filterType,
+                const EntityItemPointer& existingEntity) const;
+
+    // the compiled predicate tree, see EntityEditFilterRules.cpp
+    struct Subject;
+    class Condition;
+    struct PropertyAccessor;
+
+private:
+    struct Clamp {
+        const PropertyAccessor* accessor { nullptr };
+        bool hasMin { false };
+        bool hasMax { false };
+        bool hasMaxLength { false };
+        glm::vec3 min;
+        glm::vec3 max;
+        float maxLength { 0.0f };
+    };
+
+    bool _wantsToFilterAdd { true };
+    bool _wantsToFilterEdit { true };
+    bool _wantsToFilterPhysics { true };
+    bool _wantsToFilterDelete { false };
+
+    bool _hasAllowedProperties { false };
+    EntityPropertyFlags _allowedProperties;
+    std::vector<Clamp> _clamps;
+    std::vector<std::unique_ptr<Condition>> _rejectConditions;
+};
+
+using EntityEditFilterRulesPointer = std::shared_ptr<EntityEditFilterRules>;
+
+#endif // hifi_EntityEditFilterRules_h
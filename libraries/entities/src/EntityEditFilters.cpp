@@ -11,6 +11,7 @@
 
 #include "EntityEditFilters.h"
 
+#include <QJsonDocument>
 #include <QUrl>
 
 #include <ResourceManager.h>
@@ -73,6 +74,17 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
+            if (filterData.rules) {
+                // compiled rules work directly on the properties, without a round trip through the script engine
+                if (!filterData.rules->filter(propertiesIn, wasChanged, filterType, existingEntity)) {
+                    return false;
+                }
+                if (&propertiesOut != &propertiesIn) {
+                    propertiesOut = propertiesIn;
+                }
+                continue;
+            }
+
             auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
@@ -255,138 +267,173 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         const QString urlString = scriptRequest->getUrl().toString();
         auto scriptContents = scriptRequest->getData();
         qInfo() << "Downloaded script:" << scriptContents;
-        QScriptProgram program(scriptContents, urlString);
-        if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->setObjectName("filter:" + entityID.toString());
-            engine->setProperty("type", "edit_filter");
-            engine->setProperty("fileName", urlString);
-            engine->setProperty("entityID", entityID);
-            engine->globalObject().setProperty("Script", engine->newQObject(engine));
-            DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
-            engine->evaluate(scriptContents, urlString);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
-                FilterData filterData;
-                filterData.engine = engine;
-                filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
-                    qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
-                    filterData.rejectAll=true;
-                }
+        if (setFilterContents(entityID, urlString, scriptContents)) {
+            emit filterAdded(entityID, true);
+            return;
+        }
+    } else if (scriptRequest) {
+        const QString urlString = scriptRequest->getUrl().toString();
+        qCritical() << "Failed to download script";
+        // See HTTPResourceRequest::onRequestFinished for interpretation of codes. For example, a 404 is code 6 and 403 is 3. A timeout is 2. Go figure.
+        qCritical() << "ResourceRequest error was" << scriptRequest->getResult();
+    } else {
+        qCritical() << "Failed to create script request.";
+    }
+    emit filterAdded(entityID, false);
+}
 
-                // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
-                filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
-
-                // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
-                filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
-
-                // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
-                filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
-
-                // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
-                QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
-                filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
-
-                // check to see if the filterFn has properties asking for Original props
-                QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
-                // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
-                //   - boolean - true  - include all original properties
-                //               false - no properties at all
-                //   - string  - empty - no properties at all
-                //               any valid property - include just that property in the Original properties
-                //   - list of strings - include only those properties in the Original properties
-                if (wantsOriginalPropertiesValue.isBool()) {
-                    filterData.wantsOriginalProperties = wantsOriginalPropertiesValue.toBool();
-                } else if (wantsOriginalPropertiesValue.isString()) {
-                    auto stringValue = wantsOriginalPropertiesValue.toString();
-                    filterData.wantsOriginalProperties = !stringValue.isEmpty();
-                    if (filterData.wantsOriginalProperties) {
-                        EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
-                    }
-                } else if (wantsOriginalPropertiesValue.isArray()) {
+bool EntityEditFilters::setFilterContents(EntityItemID entityID, const QString& urlString, const QByteArray& scriptContents) {
+    // a JSON rule set is compiled once, and then runs without a script engine
+    QJsonParseError parseError;
+    auto ruleSet = QJsonDocument::fromJson(scriptContents, &parseError);
+    if (ruleSet.isObject() || QUrl(urlString).path().endsWith(".json", Qt::CaseInsensitive)) {
+        QString error = parseError.error != QJsonParseError::NoError ? parseError.errorString() : QString();
+        EntityEditFilterRulesPointer rules = error.isEmpty() ? EntityEditFilterRules::compile(ruleSet.object(), error) : nullptr;
+        if (!rules) {
+            qCritical() << "Invalid entity edit filter rules in" << urlString << ":" << error;
+            return false;
+        }
+
+        FilterData filterData;
+        filterData.rules = rules;
+        filterData.rejectAll = false;
+        filterData.wantsToFilterAdd = rules->wantsToFilter(EntityTree::FilterType::Add);
+        filterData.wantsToFilterEdit = rules->wantsToFilter(EntityTree::FilterType::Edit);
+        filterData.wantsToFilterPhysics = rules->wantsToFilter(EntityTree::FilterType::Physics);
+        filterData.wantsToFilterDelete = rules->wantsToFilter(EntityTree::FilterType::Delete);
+
+        QWriteLocker writeLock(&_lock);
+        FilterData oldFilterData = _filterDataMap.value(entityID);
+        if (oldFilterData.engine) {
+            delete oldFilterData.engine;
+        }
+        _filterDataMap.insert(entityID, filterData);
+        qDebug() << "filter rules processed for entity id " << entityID;
+        return true;
+    }
+
+    QScriptProgram program(scriptContents, urlString);
+    if (hasCorrectSyntax(program)) {
+        // create a QScriptEngine for this script
+        QScriptEngine* engine = new QScriptEngine();
+        engine->setObjectName("filter:" + entityID.toString());
+        engine->setProperty("type", "edit_filter");
+        engine->setProperty("fileName", urlString);
+        engine->setProperty("entityID", entityID);
+        engine->globalObject().setProperty("Script", engine->newQObject(engine));
+        DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
+        engine->evaluate(scriptContents, urlString);
+        if (!hadUncaughtExceptions(*engine, urlString)) {
+            // put the engine in the engine map (so we don't leak them, etc...)
+            FilterData filterData;
+            filterData.engine = engine;
+            filterData.rejectAll = false;
+            
+            // define the uncaughtException function
+            QScriptEngine& engineRef = *engine;
+            filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
+
+            // now get the filter function
+            auto global = engine->globalObject();
+            auto entitiesObject = engine->newObject();
+            entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+            entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+            entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+            entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
+            global.setProperty("Entities", entitiesObject);
+            filterData.filterFn = global.property("filter");
+            if (!filterData.filterFn.isFunction()) {
+                qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
+                delete engine;
+                filterData.rejectAll=true;
+            }
+
+            // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
+            filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
+
+            // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
+            filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
+
+            // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
+            filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
+
+            // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
+            QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
+            filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
+
+            // check to see if the filterFn has properties asking for Original props
+            QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
+            // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
+            //   - boolean - true  - include all original properties
+            //               false - no properties at all
+            //   - string  - empty - no properties at all
+            //               any valid property - include just that property in the Original properties
+            //   - list of strings - include only those properties in the Original properties
+            if (wantsOriginalPropertiesValue.isBool()) {
+                filterData.wantsOriginalProperties = wantsOriginalPropertiesValue.toBool();
+            } else if (wantsOriginalPropertiesValue.isString()) {
+                auto stringValue = wantsOriginalPropertiesValue.toString();
+                filterData.wantsOriginalProperties = !stringValue.isEmpty();
+                if (filterData.wantsOriginalProperties) {
                     EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
-                    filterData.wantsOriginalProperties = !filterData.includedOriginalProperties.isEmpty();
                 }
+            } else if (wantsOriginalPropertiesValue.isArray()) {
+                EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
+                filterData.wantsOriginalProperties = !filterData.includedOriginalProperties.isEmpty();
+            }
 
-                // check to see if the filterFn has properties asking for Zone props
-                QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
-                // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
-                //   - boolean - true  - include all Zone properties
-                //               false - no properties at all
-                //   - string  - empty - no properties at all
-                //               any valid property - include just that property in the Zone properties
-                //   - list of strings - include only those properties in the Zone properties
-                if (wantsZonePropertiesValue.isBool()) {
-                    filterData.wantsZoneProperties = wantsZonePropertiesValue.toBool();
-                    filterData.wantsZoneBoundingBox = filterData.wantsZoneProperties; // include this too
-                } else if (wantsZonePropertiesValue.isString()) {
-                    auto stringValue = wantsZonePropertiesValue.toString();
-                    filterData.wantsZoneProperties = !stringValue.isEmpty();
-                    if (filterData.wantsZoneProperties) {
+            // check to see if the filterFn has properties asking for Zone props
+            QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
+            // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
+            //   - boolean - true  - include all Zone properties
+            //               false - no properties at all
+            //   - string  - empty - no properties at all
+            //               any valid property - include just that property in the Zone properties
+            //   - list of strings - include only those properties in the Zone properties
+            if (wantsZonePropertiesValue.isBool()) {
+                filterData.wantsZoneProperties = wantsZonePropertiesValue.toBool();
+                filterData.wantsZoneBoundingBox = filterData.wantsZoneProperties; // include this too
+            } else if (wantsZonePropertiesValue.isString()) {
+                auto stringValue = wantsZonePropertiesValue.toString();
+                filterData.wantsZoneProperties = !stringValue.isEmpty();
+                if (filterData.wantsZoneProperties) {
+                    if (stringValue == "boundingBox") {
+                        filterData.wantsZoneBoundingBox = true;
+                    } else {
+                        EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                    }
+                }
+            } else if (wantsZonePropertiesValue.isArray()) {
+                auto length = wantsZonePropertiesValue.property("length").toInteger();
+                for (int i = 0; i < length; i++) {
+                    auto stringValue = wantsZonePropertiesValue.property(i).toString();
+                    if (!stringValue.isEmpty()) {
+                        filterData.wantsZoneProperties = true;
+
+                        // boundingBox is a special case since it's not a true EntityPropertyFlag, so we
+                        // need to detect it here.
                         if (stringValue == "boundingBox") {
                             filterData.wantsZoneBoundingBox = true;
-                        } else {
-                            EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                            break; // we can break here, since there are no other special cases
                         }
-                    }
-                } else if (wantsZonePropertiesValue.isArray()) {
-                    auto length = wantsZonePropertiesValue.property("length").toInteger();
-                    for (int i = 0; i < length; i++) {
-                        auto stringValue = wantsZonePropertiesValue.property(i).toString();
-                        if (!stringValue.isEmpty()) {
-                            filterData.wantsZoneProperties = true;
-
-                            // boundingBox is a special case since it's not a true EntityPropertyFlag, so we
-                            // need to detect it here.
-                            if (stringValue == "boundingBox") {
-                                filterData.wantsZoneBoundingBox = true;
-                                break; // we can break here, since there are no other special cases
-                            }
 
-                        }
-                    }
-                    if (filterData.wantsZoneProperties) {
-                        EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
                     }
                 }
+                if (filterData.wantsZoneProperties) {
+                    EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                }
+            }
 
-                _lock.lockForWrite();
-                _filterDataMap.insert(entityID, filterData);
-                _lock.unlock();
+            _lock.lockForWrite();
+            _filterDataMap.insert(entityID, filterData);
+            _lock.unlock();
 
-                qDebug() << "script request filter processed for entity id " << entityID;
-                
-                emit filterAdded(entityID, true);
-                return;
-            }
-        } 
-    } else if (scriptRequest) {
-        const QString urlString = scriptRequest->getUrl().toString();
-        qCritical() << "Failed to download script";
-        // See HTTPResourceRequest::onRequestFinished for interpretation of codes. For example, a 404 is code 6 and 403 is 3. A timeout is 2. Go figure.
-        qCritical() << "ResourceRequest error was" << scriptRequest->getResult();
-    } else {
-        qCritical() << "Failed to create script request.";
+            qDebug() << "script request filter processed for entity id " << entityID;
+            return true;
+        }
     }
-    emit filterAdded(entityID, false);
+    return false;
 }
@@ -19,6 +19,7 @@
 
 #include <functional>
 
+#include "EntityEditFilterRules.h"
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
@@ -43,9 +44,12 @@ public:
         std::function<bool()> uncaughtExceptions;
         QScriptEngine* engine;
         bool rejectAll;
+
+        // set instead of the script engine when the filter is a declarative rule set
+        EntityEditFilterRulesPointer rules;
         
         FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        bool valid() { return (rejectAll || rules || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
     };
 
     EntityEditFilters() {};
@@ -54,6 +58,10 @@ public:
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
 
+    // installs a filter from already downloaded contents, either a JSON rule set (see EntityEditFilterRules) or a
+    // script defining a filter function.  Returns false if the filter can't be used.
+    bool setFilterContents(EntityItemID entityID, const QString& urlString, const QByteArray& contents);
+
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity);
 
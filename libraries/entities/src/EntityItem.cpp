@@ -41,6 +41,7 @@
 #include "EntityTree.h"
 #include "EntitySimulation.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "EntityNodeData.h"
 
 //#define WANT_DEBUG
 
@@ -1890,6 +1891,7 @@ void EntityItem::setParentID(const QUuid& value) {
 
         if (tree) {
             tree->addToNeedsParentFixupList(getThisPointer());
+            tree->updateEntityQueryIndex(getThisPointer());
         }
         updateQueryAACube();
     }
@@ -2665,26 +2667,38 @@ bool EntityItem::matchesJSONFilters(const QJsonObject& jsonFilters) const {
     // ALL entity properties. Some work will need to be done to the property system so that it can be more flexible
     // (to grab the value and default value of a property given the string representation of that property, for example)
 
-    // currently the only property filter we handle in EntityItem is '+' for serverScripts
-    // which means that we only handle a filtered query asking for entities where the serverScripts property is non-default
+    // currently we handle '+' for serverScripts, which means that we only handle a filtered query asking for entities
+    // where the serverScripts property is non-default, and exact matches on type, name, owningAvatarID and parentID.
+    // Every one of these present in the filter has to match. Keep this in sync with EntityQueryIndex, which the
+    // entity server uses to find candidates for these filters without visiting the whole tree.
 
-    static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
-    static const QString ENTITY_TYPE_PROPERTY = "type";
+    using namespace EntityJSONQueryProperties;
 
-    foreach(const auto& property, jsonFilters.keys()) {
-        if (property == SERVER_SCRIPTS_PROPERTY && jsonFilters[property] == EntityQueryFilterSymbol::NonDefault) {
-            // check if this entity has a non-default value for serverScripts
-            if (_serverScripts != ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS) {
-                return true;
-            } else {
-                return false;
-            }
-        } else if (property == ENTITY_TYPE_PROPERTY) {
-            return (jsonFilters[property] == EntityTypes::getEntityTypeName(getType()) );
-        }
+    if (jsonFilters[SERVER_SCRIPTS_PROPERTY] == EntityQueryFilterSymbol::NonDefault &&
+        _serverScripts == ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS) {
+        return false;
+    }
+
+    if (jsonFilters.contains(TYPE_PROPERTY) && jsonFilters[TYPE_PROPERTY] != EntityTypes::getEntityTypeName(getType())) {
+        return false;
+    }
+
+    QJsonValue nameFilter = jsonFilters[NAME_PROPERTY];
+    if (nameFilter.isString() && nameFilter.toString() != getName()) {
+        return false;
+    }
+
+    QJsonValue owningAvatarFilter = jsonFilters[OWNING_AVATAR_ID_PROPERTY];
+    if (owningAvatarFilter.isString() && QUuid(owningAvatarFilter.toString()) != getOwningAvatarID()) {
+        return false;
+    }
+
+    QJsonValue parentFilter = jsonFilters[PARENT_ID_PROPERTY];
+    if (parentFilter.isString() && QUuid(parentFilter.toString()) != getParentID()) {
+        return false;
     }
 
-    // the json filter syntax did not match what we expected, return a match
+    // anything in the json filter we did not recognize is ignored, so an empty filter is a match
     return true;
 }
 
@@ -2877,10 +2891,19 @@ QString EntityItem::getServerScripts() const {
 }
 
 void EntityItem::setServerScripts(const QString& serverScripts) {
+    bool hadServerScripts = false;
     withWriteLock([&] {
+        hadServerScripts = !_serverScripts.isEmpty();
         _serverScripts = serverScripts;
         _serverScriptsChangedTimestamp = usecTimestampNow();
     });
+
+    if (hadServerScripts == serverScripts.isEmpty()) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->updateEntityQueryIndex(getThisPointer());
+        }
+    }
 }
 
 QString EntityItem::getCollisionSoundURL() const {
@@ -2916,9 +2939,18 @@ QString EntityItem::getName() const {
 }
 
 void EntityItem::setName(const QString& value) {
+    bool changed = false;
     withWriteLock([&] {
+        changed = _name != value;
         _name = value;
     });
+
+    if (changed) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->updateEntityQueryIndex(getThisPointer());
+        }
+    }
 }
 
 QString EntityItem::getDebugName() {
@@ -3473,11 +3505,19 @@ QUuid EntityItem::getOwningAvatarIDForProperties() const {
 }
 
 void EntityItem::setOwningAvatarID(const QUuid& owningAvatarID) {
+    QUuid oldOwningAvatarID = _owningAvatarID;
     if (!owningAvatarID.isNull() && owningAvatarID == Physics::getSessionUUID()) {
         _owningAvatarID = AVATAR_SELF_ID;
     } else {
         _owningAvatarID = owningAvatarID;
     }
+
+    if (_owningAvatarID != oldOwningAvatarID) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->updateEntityQueryIndex(getThisPointer());
+        }
+    }
 }
 
 void EntityItem::addGrab(GrabPointer grab) {
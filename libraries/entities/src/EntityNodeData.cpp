@@ -28,3 +28,11 @@ bool EntityNodeData::isEntityFlaggedAsExtra(const QUuid& entityID) const {
 
     return false;
 }
+
+QSet<QUuid> EntityNodeData::getFlaggedExtraEntities() const {
+    QSet<QUuid> extraEntities;
+    foreach(QSet<QUuid> entitySet, _flaggedExtraEntities) {
+        extraEntities.unite(entitySet);
+    }
+    return extraEntities;
+}
@@ -18,6 +18,10 @@
 
 namespace EntityJSONQueryProperties {
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
+    static const QString TYPE_PROPERTY = "type";
+    static const QString NAME_PROPERTY = "name";
+    static const QString OWNING_AVATAR_ID_PROPERTY = "owningAvatarID";
+    static const QString PARENT_ID_PROPERTY = "parentID";
     static const QString FLAGS_PROPERTY = "flags";
     static const QString INCLUDE_ANCESTORS_PROPERTY = "includeAncestors";
     static const QString INCLUDE_DESCENDANTS_PROPERTY = "includeDescendants";
@@ -42,6 +46,7 @@ public:
     bool insertFlaggedExtraEntity(const QUuid& filteredEntityID, const QUuid& extraEntityID);
     
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
+    QSet<QUuid> getFlaggedExtraEntities() const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
 private:
@@ -0,0 +1,178 @@
+//
+//  EntityQueryIndex.cpp
+//  libraries/entities/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityQueryIndex.h"
+
+#include "EntityItem.h"
+#include "EntityNodeData.h"
+#include "EntityTree.h"
+
+namespace {
+
+template <typename K>
+void addToBucket(QHash<K, QSet<EntityItemID>>& index, const K& key, const EntityItemID& entityID) {
+    index[key].insert(entityID);
+}
+
+template <typename K>
+void removeFromBucket(QHash<K, QSet<EntityItemID>>& index, const K& key, const EntityItemID& entityID) {
+    auto itr = index.find(key);
+    if (itr != index.end()) {
+        itr->remove(entityID);
+        if (itr->isEmpty()) {
+            index.erase(itr);
+        }
+    }
+}
+
+}
+
+bool EntityQueryIndex::canQuery(const QJsonObject& jsonFilters) {
+    using namespace EntityJSONQueryProperties;
+    return jsonFilters[SERVER_SCRIPTS_PROPERTY] == EntityQueryFilterSymbol::NonDefault ||
+        jsonFilters[TYPE_PROPERTY].isString() ||
+        jsonFilters[NAME_PROPERTY].isString() ||
+        jsonFilters[OWNING_AVATAR_ID_PROPERTY].isString() ||
+        jsonFilters[PARENT_ID_PROPERTY].isString();
+}
+
+EntityQueryIndex::Keys EntityQueryIndex::keysForEntity(const EntityItemPointer& entity) {
+    Keys keys;
+    keys.type = entity->getType();
+    keys.name = entity->getName();
+    keys.owningAvatarID = entity->getOwningAvatarID();
+    keys.parentID = entity->getParentID();
+    keys.hasServerScripts = entity->getServerScripts() != ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS;
+    return keys;
+}
+
+void EntityQueryIndex::addKeys(const EntityItemID& entityID, const Keys& keys) {
+    addToBucket(_byType, keys.type, entityID);
+    addToBucket(_byName, keys.name, entityID);
+    addToBucket(_byOwningAvatar, keys.owningAvatarID, entityID);
+    addToBucket(_byParent, keys.parentID, entityID);
+    if (keys.hasServerScripts) {
+        _withServerScripts.insert(entityID);
+    }
+}
+
+void EntityQueryIndex::removeKeys(const EntityItemID& entityID, const Keys& keys) {
+    removeFromBucket(_byType, keys.type, entityID);
+    removeFromBucket(_byName, keys.name, entityID);
+    removeFromBucket(_byOwningAvatar, keys.owningAvatarID, entityID);
+    removeFromBucket(_byParent, keys.parentID, entityID);
+    _withServerScripts.remove(entityID);
+}
+
+void EntityQueryIndex::insert(const EntityItemPointer& entity) {
+    EntityItemID entityID = entity->getEntityItemID();
+    if (_keys.contains(entityID)) {
+        update(entity);
+        return;
+    }
+    Keys keys = keysForEntity(entity);
+    addKeys(entityID, keys);
+    _keys.insert(entityID, keys);
+}
+
+void EntityQueryIndex::update(const EntityItemPointer& entity) {
+    EntityItemID entityID = entity->getEntityItemID();
+    auto itr = _keys.find(entityID);
+    if (itr == _keys.end()) {
+        return;
+    }
+
+    Keys keys = keysForEntity(entity);
+    Keys& oldKeys = itr.value();
+    if (keys.type != oldKeys.type) {
+        removeFromBucket(_byType, oldKeys.type, entityID);
+        addToBucket(_byType, keys.type, entityID);
+    }
+    if (keys.name != oldKeys.name) {
+        removeFromBucket(_byName, oldKeys.name, entityID);
+        addToBucket(_byName, keys.name, entityID);
+    }
+    if (keys.owningAvatarID != oldKeys.owningAvatarID) {
+        removeFromBucket(_byOwningAvatar, oldKeys.owningAvatarID, entityID);
+        addToBucket(_byOwningAvatar, keys.owningAvatarID, entityID);
+    }
+    if (keys.parentID != oldKeys.parentID) {
+        removeFromBucket(_byParent, oldKeys.parentID, entityID);
+        addToBucket(_byParent, keys.parentID, entityID);
+    }
+    if (keys.hasServerScripts) {
+        _withServerScripts.insert(entityID);
+    } else {
+        _withServerScripts.remove(entityID);
+    }
+    oldKeys = keys;
+}
+
+void EntityQueryIndex::remove(const EntityItemID& entityID) {
+    auto itr = _keys.find(entityID);
+    if (itr != _keys.end()) {
+        removeKeys(entityID, itr.value());
+        _keys.erase(itr);
+    }
+}
+
+void EntityQueryIndex::clear() {
+    _keys.clear();
+    _byType.clear();
+    _byName.clear();
+    _byOwningAvatar.clear();
+    _byParent.clear();
+    _withServerScripts.clear();
+}
+
+QSet<EntityItemID> EntityQueryIndex::findCandidates(const QJsonObject& jsonFilters) const {
+    using namespace EntityJSONQueryProperties;
+
+    // every filtered property has to match, so the smallest bucket named by the filter holds all the matches
+    const QSet<EntityItemID>* smallest = nullptr;
+    bool foundEmptyBucket = false;
+    auto considerBucket = [&](const QSet<EntityItemID>* bucket) {
+        if (!bucket) {
+            foundEmptyBucket = true;
+        } else if (!smallest || bucket->size() < smallest->size()) {
+            smallest = bucket;
+        }
+    };
+    auto findBucket = [](const auto& index, const auto& key) -> const QSet<EntityItemID>* {
+        auto itr = index.find(key);
+        return itr != index.end() ? &itr.value() : nullptr;
+    };
+
+    if (jsonFilters[SERVER_SCRIPTS_PROPERTY] == EntityQueryFilterSymbol::NonDefault) {
+        considerBucket(_withServerScripts.isEmpty() ? nullptr : &_withServerScripts);
+    }
+    QJsonValue typeFilter = jsonFilters[TYPE_PROPERTY];
+    if (typeFilter.isString()) {
+        considerBucket(findBucket(_byType, (int)EntityTypes::getEntityTypeFromName(typeFilter.toString())));
+    }
+    QJsonValue nameFilter = jsonFilters[NAME_PROPERTY];
+    if (nameFilter.isString()) {
+        considerBucket(findBucket(_byName, nameFilter.toString()));
+    }
+    QJsonValue owningAvatarFilter = jsonFilters[OWNING_AVATAR_ID_PROPERTY];
+    if (owningAvatarFilter.isString()) {
+        considerBucket(findBucket(_byOwningAvatar, QUuid(owningAvatarFilter.toString())));
+    }
+    QJsonValue parentFilter = jsonFilters[PARENT_ID_PROPERTY];
+    if (parentFilter.isString()) {
+        considerBucket(findBucket(_byParent, QUuid(parentFilter.toString())));
+    }
+
+    if (foundEmptyBucket || !smallest) {
+        return QSet<EntityItemID>();
+    }
+    return *smallest;
+}
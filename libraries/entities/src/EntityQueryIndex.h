@@ -0,0 +1,62 @@
+//
+//  EntityQueryIndex.h
+//  libraries/entities/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityQueryIndex_h
+#define hifi_EntityQueryIndex_h
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSet>
+
+#include "EntityItemID.h"
+#include "EntityTypes.h"
+
+// Secondary indexes over the entities in an EntityTree, used to answer JSON-filtered entity queries
+// (see EntityItem::matchesJSONFilters) without visiting every entity in the tree.
+// The index only narrows the search: candidates must still be checked against the filter.
+// Not thread safe, the owning EntityTree guards it with its entity map lock.
+class EntityQueryIndex {
+public:
+    // returns true if the filter has at least one property the index can answer
+    static bool canQuery(const QJsonObject& jsonFilters);
+
+    void insert(const EntityItemPointer& entity);
+    void update(const EntityItemPointer& entity); // re-reads the indexed properties of an entity already in the index
+    void remove(const EntityItemID& entityID);
+    void clear();
+
+    int size() const { return _keys.size(); }
+
+    // returns the smallest set of entity IDs that contains every entity matching the filter
+    QSet<EntityItemID> findCandidates(const QJsonObject& jsonFilters) const;
+
+private:
+    struct Keys {
+        int type { EntityTypes::Unknown };
+        QString name;
+        QUuid owningAvatarID;
+        QUuid parentID;
+        bool hasServerScripts { false };
+    };
+
+    static Keys keysForEntity(const EntityItemPointer& entity);
+    void addKeys(const EntityItemID& entityID, const Keys& keys);
+    void removeKeys(const EntityItemID& entityID, const Keys& keys);
+
+    QHash<EntityItemID, Keys> _keys;
+    QHash<int, QSet<EntityItemID>> _byType;
+    QHash<QString, QSet<EntityItemID>> _byName;
+    QHash<QUuid, QSet<EntityItemID>> _byOwningAvatar;
+    QHash<QUuid, QSet<EntityItemID>> _byParent;
+    QSet<EntityItemID> _withServerScripts;
+};
+
+#endif // hifi_EntityQueryIndex_h
@@ -11,6 +11,9 @@
 //
 
 #include "EntityTree.h"
+
+#include <algorithm>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
 #include <openssl/err.h>
@@ -23,6 +26,8 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QThreadPool>
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
@@ -46,6 +51,7 @@
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 static const QString DOMAIN_UNLIMITED = "domainUnlimited";
+static const int ENTITIES_PER_CONVERT_JOB = 256;
 
 EntityTree::EntityTree(bool shouldReaverage) :
     Octree(shouldReaverage)
@@ -113,6 +119,10 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
             }
         }
         _entityMap.swap(savedEntities);
+        _queryIndex.clear();
+        foreach(EntityItemPointer entity, _entityMap) {
+            _queryIndex.insert(entity);
+        }
     });
 
     resetClientEditStats();
@@ -141,6 +151,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
     localMap.swap(_entityMap);
+    _queryIndex.clear();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -173,13 +184,13 @@ void EntityTree::readBitstreamToTree(const unsigned char* bitstream,
     Octree::readBitstreamToTree(bitstream, bufferSizeBytes, args);
 
     // add entities
+    std::vector<EntityItemPointer> entitiesToAdd;
+    entitiesToAdd.reserve(_entitiesToAdd.size());
     QHash<EntityItemID, EntityItemPointer>::const_iterator itr;
     for (itr = _entitiesToAdd.constBegin(); itr != _entitiesToAdd.constEnd(); ++itr) {
-        const EntityItemPointer& entityItem = itr.value();
-        AddEntityOperator theOperator(getThisPointer(), entityItem);
-        recurseTreeWithOperator(&theOperator);
-        postAddEntity(entityItem);
+        entitiesToAdd.push_back(itr.value());
     }
+    addEntities(entitiesToAdd);
     _entitiesToAdd.clear();
 
     // move entities
@@ -289,28 +300,36 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
 
 /// Adds a new entity item to the tree
 void EntityTree::postAddEntity(EntityItemPointer entity) {
-    assert(entity);
+    postAddEntities({ entity });
+}
 
-    if (getIsServer()) {
-        addCertifiedEntityOnServer(entity);
-    }
+void EntityTree::postAddEntities(const std::vector<EntityItemPointer>& entities) {
+    for (const auto& entity : entities) {
+        assert(entity);
 
-    // check to see if we need to simulate this entity..
-    if (_simulation) {
-        _simulation->addEntity(entity);
-    }
+        if (getIsServer()) {
+            addCertifiedEntityOnServer(entity);
+        }
+
+        // check to see if we need to simulate this entity..
+        if (_simulation) {
+            _simulation->addEntity(entity);
+        }
 
-    if (!entity->getParentID().isNull()) {
-        addToNeedsParentFixupList(entity);
+        if (!entity->getParentID().isNull()) {
+            addToNeedsParentFixupList(entity);
+        }
     }
 
     _isDirty = true;
 
-    // find and hook up any entities with this entity as a (previously) missing parent
+    // find and hook up any entities with these entities as a (previously) missing parent
     fixupNeedsParentFixups();
 
-    emit addingEntity(entity->getEntityItemID());
-    emit addingEntityPointer(entity.get());
+    for (const auto& entity : entities) {
+        emit addingEntity(entity->getEntityItemID());
+        emit addingEntityPointer(entity.get());
+    }
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
@@ -538,12 +557,12 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
     return true;
 }
 
-EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
+EntityItemPointer EntityTree::createEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
     EntityItemProperties props = properties;
 
     auto nodeList = DependencyManager::get<NodeList>();
     if (!nodeList) {
-        qCDebug(entities) << "EntityTree::addEntity -- can't get NodeList";
+        qCDebug(entities) << "EntityTree::createEntity -- can't get NodeList";
         return nullptr;
     }
 
@@ -573,10 +592,15 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     EntityTypes::EntityType type = props.getType();
     EntityItemPointer result = EntityTypes::constructEntityItem(type, entityID, props);
 
+    if (result && recordCreationTime) {
+        result->recordCreationTime();
+    }
+    return result;
+}
+
+EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
+    EntityItemPointer result = createEntity(entityID, properties, isClone, isImport);
     if (result) {
-        if (recordCreationTime) {
-            result->recordCreationTime();
-        }
         // Recurse the tree and store the entity in the correct tree element
         AddEntityOperator theOperator(getThisPointer(), result);
         recurseTreeWithOperator(&theOperator);
@@ -585,6 +609,167 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     return result;
 }
 
+namespace {
+// Interleaves the top 21 bits of each axis of a point into the octal code ordering used by OctreeElement children,
+// so that sorting by this key visits the tree depth first.
+uint64_t octalCodeKeyForPoint(const glm::vec3& point) {
+    const int BITS_PER_AXIS = 21;
+    const float MAX_AXIS_VALUE = (float)((1 << BITS_PER_AXIS) - 1);
+    glm::vec3 normalized = glm::clamp((point + (float)HALF_TREE_SCALE) / (float)TREE_SCALE, 0.0f, 1.0f);
+    uint32_t x = (uint32_t)(normalized.x * MAX_AXIS_VALUE);
+    uint32_t y = (uint32_t)(normalized.y * MAX_AXIS_VALUE);
+    uint32_t z = (uint32_t)(normalized.z * MAX_AXIS_VALUE);
+
+    uint64_t key = 0;
+    for (int bit = BITS_PER_AXIS - 1; bit >= 0; --bit) {
+        key = (key << 3) | (((x >> bit) & 1) << 2) | (((y >> bit) & 1) << 1) | ((z >> bit) & 1);
+    }
+    return key;
+}
+}
+
+void EntityTree::addEntities(const std::vector<EntityItemPointer>& entities) {
+    if (entities.empty()) {
+        return;
+    }
+
+    for (const auto& entity : entities) {
+        addEntityMapEntry(entity);
+    }
+    placeEntities(entities);
+    postAddEntities(entities);
+}
+
+void EntityTree::relocateEntities(const std::vector<EntityItemPointer>& entities) {
+    if (entities.empty()) {
+        return;
+    }
+
+    // the old elements of relocated entities may now be empty
+    pruneElementsContaining(placeEntities(entities));
+}
+
+int EntityTree::rebalanceTree() {
+    // bounds how long a single pass holds the write lock, whatever is left over is picked up by the next pass
+    const size_t MAX_ENTITIES_RELOCATED_PER_REBALANCE = 1000;
+
+    // find entities that are no longer in their best fit element, eg because their queryAACube changed
+    // without a move, while only holding the read lock
+    std::vector<EntityItemPointer> misplacedEntities;
+    QHash<EntityItemID, AACube> unplaceableEntities;
+    withReadLock([&] {
+        QReadLocker locker(&_entityMapLock);
+        for (const auto& entity : _entityMap) {
+            EntityTreeElementPointer element = entity->getElement();
+            if (!element || element->bestFitEntityBounds(entity)) {
+                continue;
+            }
+
+            // an entity that the last pass couldn't place any better is left alone until its queryAACube changes
+            bool success;
+            AACube queryCube = entity->getQueryAACube(success);
+            auto unplaceable = _unplaceableEntities.constFind(entity->getEntityItemID());
+            if (unplaceable != _unplaceableEntities.constEnd() && unplaceable.value() == queryCube) {
+                unplaceableEntities.insert(entity->getEntityItemID(), queryCube);
+                continue;
+            }
+
+            if (misplacedEntities.size() < MAX_ENTITIES_RELOCATED_PER_REBALANCE) {
+                misplacedEntities.push_back(entity);
+            }
+        }
+    });
+
+    withWriteLock([&] {
+        // entities may have been deleted or moved since we looked
+        misplacedEntities.erase(std::remove_if(misplacedEntities.begin(), misplacedEntities.end(),
+            [](const EntityItemPointer& entity) {
+                EntityTreeElementPointer element = entity->getElement();
+                return !element || element->bestFitEntityBounds(entity);
+            }), misplacedEntities.end());
+
+        // deletes and moves already prune along their own paths, so only the elements this pass
+        // moved entities out of need to be checked rather than the whole tree
+        pruneElementsContaining(placeEntities(misplacedEntities));
+
+        for (const auto& entity : misplacedEntities) {
+            EntityTreeElementPointer element = entity->getElement();
+            if (element && !element->bestFitEntityBounds(entity)) {
+                bool success;
+                unplaceableEntities.insert(entity->getEntityItemID(), entity->getQueryAACube(success));
+            }
+        }
+    });
+
+    // rebuilt every pass, so deleted entities drop out
+    _unplaceableEntities.swap(unplaceableEntities);
+
+    return (int)misplacedEntities.size();
+}
+
+std::vector<AACube> EntityTree::placeEntities(const std::vector<EntityItemPointer>& entities) {
+    class PendingPlacement {
+    public:
+        uint64_t octalCodeKey;
+        AACube cube;
+        EntityItemPointer entity;
+    };
+
+    std::vector<AACube> vacatedCubes;
+    std::vector<PendingPlacement> pendingPlacements;
+    pendingPlacements.reserve(entities.size());
+    for (const auto& entity : entities) {
+        bool success;
+        AACube cube = entity->getQueryAACube(success).clamp((float)(-HALF_TREE_SCALE), (float)HALF_TREE_SCALE);
+        pendingPlacements.push_back({ octalCodeKeyForPoint(cube.calcCenter()), cube, entity });
+    }
+
+    // Sorted by octal code consecutive entities share most of their path, so instead of recursing from the root
+    // for every entity we back up the previous path to the deepest element that still contains the next one.
+    // This builds the elements needed for n entities in O(n log n).
+    std::sort(pendingPlacements.begin(), pendingPlacements.end(), [](const PendingPlacement& a, const PendingPlacement& b) {
+        return a.octalCodeKey < b.octalCodeKey;
+    });
+
+    std::vector<EntityTreeElementPointer> path { getRoot() };
+    path.front()->markWithChangedTime();
+    for (const auto& pendingPlacement : pendingPlacements) {
+        while (path.size() > 1 && !path.back()->getAACube().contains(pendingPlacement.cube)) {
+            path.pop_back();
+        }
+
+        // descend the same way AddEntityOperator would, creating elements as needed. Where AddEntityOperator
+        // would find no best fit element and leave the entity out of the tree, the entity is kept in the
+        // deepest element that contains it instead, so that every entity in the map has an element.
+        EntityTreeElementPointer element = path.back();
+        while (!element->bestFitBounds(pendingPlacement.cube)) {
+            float childElementScale = element->getAACube().getScale() / 2.0f;
+            if (pendingPlacement.cube.getLargestDimension() > childElementScale) {
+                break;
+            }
+            int childIndex = element->getMyChildContaining(pendingPlacement.cube);
+            if (childIndex == OctreeElement::CHILD_UNKNOWN) {
+                break;
+            }
+            element = std::static_pointer_cast<EntityTreeElement>(element->addChildAtIndex(childIndex));
+            element->markWithChangedTime();
+            path.push_back(element);
+        }
+
+        const EntityItemPointer& entity = pendingPlacement.entity;
+        EntityTreeElementPointer oldElement = entity->getElement();
+        if (oldElement == element) {
+            continue;
+        }
+        if (oldElement) {
+            oldElement->removeEntityItem(entity);
+            vacatedCubes.push_back(oldElement->getAACube());
+        }
+        element->addEntityItem(entity);
+    }
+    return vacatedCubes;
+}
+
 void EntityTree::emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload) {
     emit entityScriptChanging(entityItemID, reload);
 }
@@ -1804,8 +1989,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
-    bool isClone = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -1815,312 +1998,476 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityClone:
-            isClone = true; // fall through to next case
-            // FALLTHRU
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
-            // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
+            EntityItemID entityItemID;
+            EntityItemProperties properties;
+            EntityItemID entityIDToClone;
+            if (decodeEditPacketData(message.getType(), editData, maxLength, processedBytes,
+                                     entityItemID, properties, entityIDToClone)) {
+                applyEditPacketData(message.getType(), entityItemID, properties, entityIDToClone, senderNode);
+            }
+            break;
+        }
 
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
 
-            _totalEditMessages++;
+Octree::EditBatchStats EntityTree::processEditPacketBatch(const std::vector<NodeSharedReceivedMessagePair>& messages) {
+    if (!getIsServer()) {
+        return Octree::processEditPacketBatch(messages);
+    }
+
+    // Simulation owners send a stream of terse EntityEdit/EntityPhysics updates for the same entity, so those are
+    // decoded before we take the write lock, and an edit is folded into the next edit to the same entity when both
+    // come from the same sender in the same kind of packet with no other sender's edit to that entity in between.
+    // The folded edit is applied where the later one arrived, so nothing ever sees an entity ahead of time.
+    // Every edit goes through the whitelist, permission and filter checks on its own before it is folded, and
+    // nothing is folded into or out of an edit that changes the simulation owner, so the ownership checks made
+    // when the folded edit is applied come out the same as for each of the edits in it.
+    // Adds, clones and erases are applied as they come and nothing is folded across them.
+    struct PendingEdit {
+        size_t messageIndex;
+        bool wholeMessage { false };
+        PacketType packetType { PacketType::Unknown };
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        bool valid { false };
+        bool coalesced { false };
+    };
 
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
+    EditBatchStats stats;
+    stats.editsPerMessage.resize(messages.size(), 0);
+
+    std::vector<PendingEdit> pendingEdits;
+    QHash<EntityItemID, size_t> lastEditToEntity;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        ReceivedMessage& message = *messages[i].second;
+        PacketType packetType = message.getType();
+
+        if (packetType != PacketType::EntityEdit && packetType != PacketType::EntityPhysics) {
+            PendingEdit wholeMessage;
+            wholeMessage.messageIndex = i;
+            wholeMessage.wholeMessage = true;
+            pendingEdits.push_back(wholeMessage);
+            lastEditToEntity.clear();
+            continue;
+        }
 
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
-            EntityItemPointer entityToClone;
-            if (isClone) {
-                QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
-                    if (entityToClone) {
-                        properties = entityToClone->getProperties();
+        while (message.getBytesLeftToRead() > 0) {
+            const unsigned char* editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+            int processedBytes = 0;
+            EntityItemID unusedCloneID;
+
+            PendingEdit edit;
+            edit.messageIndex = i;
+            edit.packetType = packetType;
+            edit.valid = decodeEditPacketData(packetType, editData, message.getBytesLeftToRead(), processedBytes,
+                                              edit.entityID, edit.properties, unusedCloneID);
+            stats.editsReceived++;
+            stats.editsPerMessage[i]++;
+
+            if (edit.valid) {
+                auto previousIndex = lastEditToEntity.find(edit.entityID);
+                if (previousIndex != lastEditToEntity.end()) {
+                    PendingEdit& previous = pendingEdits[previousIndex.value()];
+                    if (previous.packetType == packetType && messages[previous.messageIndex].first == messages[i].first &&
+                        !previous.properties.simulationOwnerChanged() && !edit.properties.simulationOwnerChanged()) {
+                        previous.coalesced = true;
                     }
                 }
-            } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
+                lastEditToEntity[edit.entityID] = pendingEdits.size();
             }
+            pendingEdits.push_back(edit);
+
+            if (processedBytes <= 0) {
+                break;
+            }
+            message.seek(message.getPosition() + processedBytes);
+        }
+    }
 
-            endDecode = usecTimestampNow();
+    quint64 startLock = usecTimestampNow();
+    withWriteLock([&] {
+        quint64 startProcess = usecTimestampNow();
+
+        // checked edits waiting to be folded into the next edit to the same entity
+        QHash<EntityItemID, EntityItemProperties> heldEdits;
+        for (auto& edit : pendingEdits) {
+            const auto& messagePair = messages[edit.messageIndex];
+            if (edit.wholeMessage) {
+                int editsInMessage = processEditMessage(*messagePair.second, messagePair.first);
+                stats.editsPerMessage[edit.messageIndex] += editsInMessage;
+                stats.editsReceived += editsInMessage;
+                stats.editsApplied += editsInMessage;
+                continue;
+            }
+            if (!edit.valid) {
+                continue;
+            }
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
+            quint64 startLookup = usecTimestampNow();
+            EntityItemPointer existingEntity = findEntityByEntityItemID(edit.entityID);
+            _totalLookupTime += usecTimestampNow() - startLookup;
+            auto held = heldEdits.find(edit.entityID);
+            if (!existingEntity) {
+                if (held != heldEdits.end()) {
+                    heldEdits.erase(held);
                 }
+                continue;
             }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+            validateEditProperties(edit.packetType, existingEntity, edit.properties, messagePair.first);
 
-                bool wasDeletedBecauseOfClientScript = false;
+            // a filter may have cleared the simulation owner, in which case the held edit goes in on its own first
+            bool changesSimulationOwner = edit.properties.simulationOwnerChanged();
+            if (held != heldEdits.end()) {
+                if (changesSimulationOwner) {
+                    applyValidatedEdit(edit.packetType, existingEntity, held.value(), messagePair.first);
+                    stats.editsApplied++;
+                } else {
+                    EntityItemProperties merged = held.value();
+                    merged.merge(edit.properties);
+                    merged.setLastEdited(edit.properties.getLastEdited());
+                    edit.properties = merged;
+                }
+                heldEdits.erase(held);
+            }
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+            if (edit.coalesced && !changesSimulationOwner) {
+                heldEdits.insert(edit.entityID, edit.properties);
+                continue;
+            }
+            applyValidatedEdit(edit.packetType, existingEntity, edit.properties, messagePair.first);
+            stats.editsApplied++;
+        }
+        stats.lockWaitUsecs = startProcess - startLock;
+        stats.lockHoldUsecs = usecTimestampNow() - startProcess;
+    });
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
+    return stats;
+}
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+bool EntityTree::decodeEditPacketData(PacketType packetType, const unsigned char* editData, int maxLength,
+                                      int& processedBytes, EntityItemID& entityItemID, EntityItemProperties& properties,
+                                      EntityItemID& entityIDToClone) {
+    _totalEditMessages++;
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+    quint64 startDecode = usecTimestampNow();
+    bool validEditPacket = false;
+    if (packetType == PacketType::EntityClone) {
+        QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
+        if (validEditPacket) {
+            EntityItemPointer entityToClone = findEntityByEntityItemID(entityIDToClone);
+            if (entityToClone) {
+                properties = entityToClone->getProperties();
+            }
+        }
+    } else {
+        validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
+    }
+    _totalDecodeTime += usecTimestampNow() - startDecode;
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+    return validEditPacket;
+}
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
+void EntityTree::applyEditPacketData(PacketType packetType, const EntityItemID& entityItemID, EntityItemProperties& properties,
+                                     const EntityItemID& entityIDToClone, const SharedNodePointer& senderNode) {
+    bool isClone = packetType == PacketType::EntityClone;
+    bool isAdd = isClone || packetType == PacketType::EntityAdd;
+
+    if (!isAdd) {
+        // search for the entity by EntityItemID
+        quint64 startLookup = usecTimestampNow();
+        EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
+        _totalLookupTime += usecTimestampNow() - startLookup;
+
+        // this is not an add-entity operation, so we can only edit an entity we know about
+        if (existingEntity) {
+            validateEditProperties(packetType, existingEntity, properties, senderNode);
+            applyValidatedEdit(packetType, existingEntity, properties, senderNode);
+        }
+        return;
+    }
+
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startFilter = 0, endFilter = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    bool validEditPacket = true;
+    EntityItemPointer entityToClone;
+    if (isClone) {
+        entityToClone = findEntityByEntityItemID(entityIDToClone);
+    }
+
+    if (!_entityScriptSourceWhitelist.isEmpty()) {
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty() && !isScriptInWhitelist(properties.getScript())) {
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID()
+                    << "] attempting to set entity script not on whitelist, edit rejected";
             }
+            validEditPacket = false;
+        }
 
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
-                if (wantEditLogging()) {
-                    qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
-                }
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty() && !isScriptInWhitelist(properties.getServerScripts())) {
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID()
+                    << "] attempting to set server entity script not on whitelist, edit rejected";
+            }
+            validEditPacket = false;
+        }
+
+        // we also want to tell the client that sent this edit that the entity was not added
+        if (!validEditPacket) {
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+        }
+    }
+
+    if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
 
-                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                if (isAdd) {
-                    QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                    _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    validEditPacket = false;
+        // we also want to tell the client that sent this add that the entity was not added
+        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+        validEditPacket = false;
+    }
+
+    if (!isClone) {
+        capTmpEntityLifetime(properties, senderNode, true);
+
+        if (properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
+
+    // If we got a valid add packet, then this is a new entity
+    if (validEditPacket) {
+        startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter.
+        bool allowed = senderNode->isAllowedEditor() ||
+            filterProperties(EntityItemPointer(), properties, properties, wasChanged, FilterType::Add);
+        if (!allowed) {
+            // the update failed and we need to convey that fact to the sender
+            // our method is to re-assert the current properties and bump the lastEdited timestamp
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
+
+        bool failedAdd = !allowed;
+        bool isCertified = !properties.getCertificateID().isEmpty();
+        bool isCloneable = properties.getCloneable();
+        int cloneLimit = properties.getCloneLimit();
+        if (!allowed) {
+            qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+        } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+            failedAdd = true;
+            qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                << "] attempted to add an uncertified entity with ID:" << entityItemID;
+        } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+            failedAdd = true;
+            qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                << "] attempted to add a certified entity with ID:" << entityItemID;
+        } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
+            failedAdd = true;
+            qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+        } else if (isClone && !isCloneable) {
+            failedAdd = true;
+            qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+        } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+            failedAdd = true;
+            qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+        } else {
+            if (isClone) {
+                properties.convertToCloneProperties(entityIDToClone);
+            }
+
+            // this is a new entity... assign a new entityID
+            properties.setLastEditedBy(senderNode->getUUID());
+            startCreate = usecTimestampNow();
+            EntityItemPointer newEntity = addEntity(entityItemID, properties);
+            endCreate = usecTimestampNow();
+            _totalCreates++;
+
+            if (newEntity && isCertified && getIsServer()) {
+                if (!properties.verifyStaticCertificateProperties()) {
+                    qCDebug(entities) << "User" << senderNode->getUUID()
+                        << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                        << "static certificate verification.";
+                    // Delete the entity we just added if it doesn't pass static certificate verification
+                    deleteEntity(entityItemID, true);
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    validatePop(properties.getCertificateID(), entityItemID, senderNode);
                 }
             }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                    (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
-                }
-
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
-                }
+            if (newEntity && isClone) {
+                entityToClone->addCloneID(newEntity->getEntityItemID());
+                newEntity->setCloneOriginID(entityIDToClone);
             }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
+            if (newEntity) {
+                newEntity->markAsChangedOnServer();
+                notifyNewlyCreatedEntity(*newEntity, senderNode);
+
+                startLogging = usecTimestampNow();
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                      << newEntity->getEntityItemID();
+                    qCDebug(entities) << "   properties:" << properties;
                 }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
+                if (wantTerseEditLogging()) {
+                    QList<QString> changedProperties = properties.listChangedProperties();
+                    fixupTerseEditLogging(properties, changedProperties);
+                    qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                 }
-                endFilter = usecTimestampNow();
+                endLogging = usecTimestampNow();
 
-                if (existingEntity && !isAdd) {
+            } else {
+                failedAdd = true;
+                qCDebug(entities) << "Add entity failed ID:" << entityItemID;
+            }
+        }
+        if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+        }
+    }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += endFilter - startFilter;
+}
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+void EntityTree::capTmpEntityLifetime(EntityItemProperties& properties, const SharedNodePointer& senderNode, bool isAdd) {
+    if ((isAdd || properties.lifetimeChanged()) &&
+        ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+        (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+        // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+        if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+            properties.getLifetime() > _maxTmpEntityLifetime) {
+            properties.setLifetime(_maxTmpEntityLifetime);
+            bumpTimestamp(properties);
+        }
+    }
+}
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
-                    }
+void EntityTree::validateEditProperties(PacketType packetType, const EntityItemPointer& existingEntity,
+                                        EntityItemProperties& properties, const SharedNodePointer& senderNode) {
+    bool isPhysics = packetType == PacketType::EntityPhysics;
 
-                    // if the EntityItem exists, then update it
-                    startLogging = usecTimestampNow();
-                    if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
-                        qCDebug(entities) << "   properties:" << properties;
-                    }
-                    if (wantTerseEditLogging()) {
-                        QList<QString> changedProperties = properties.listChangedProperties();
-                        fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
-                    }
-                    endLogging = usecTimestampNow();
+    // check the entity scripts to make sure their URLs are in the whitelist, an edit keeps the current ones instead
+    bool suppressDisallowedClientScript = false;
+    bool suppressDisallowedServerScript = false;
+    if (!_entityScriptSourceWhitelist.isEmpty()) {
+        if (!properties.getScript().isEmpty() && !isScriptInWhitelist(properties.getScript())) {
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID()
+                    << "] attempting to set entity script not on whitelist, edit rejected";
+            }
+            suppressDisallowedClientScript = true;
+        }
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
+        if (!properties.getServerScripts().isEmpty() && !isScriptInWhitelist(properties.getServerScripts())) {
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID()
+                    << "] attempting to set server entity script not on whitelist, edit rejected";
+            }
+            suppressDisallowedServerScript = true;
+        }
+    }
 
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
-                        }
+    bool suppressDisallowedPrivateUserData = false;
+    if (!properties.getPrivateUserData().isEmpty() && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
+        suppressDisallowedPrivateUserData = true;
+    }
 
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
+    capTmpEntityLifetime(properties, senderNode, false);
 
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
+    quint64 startFilter = usecTimestampNow();
+    bool wasChanged = false;
+    // Having (un)lock rights bypasses the filter, unless it's a physics result.
+    FilterType filterType = isPhysics ? FilterType::Physics : FilterType::Edit;
+    bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+    if (!allowed) {
+        // the update failed and we need to convey that fact to the sender
+        // our method is to re-assert the current properties and bump the lastEdited timestamp
+        auto timestamp = properties.getLastEdited();
+        properties = EntityItemProperties();
+        properties.setLastEdited(timestamp);
+    }
+    if (!allowed || wasChanged) {
+        bumpTimestamp(properties);
+        // For now, free ownership on any modification.
+        properties.clearSimulationOwner();
+    }
+    _totalFilterTime += usecTimestampNow() - startFilter;
 
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
-                } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
-                }
-            }
+    if (suppressDisallowedClientScript) {
+        bumpTimestamp(properties);
+        properties.setScript(existingEntity->getScript());
+    }
 
+    if (suppressDisallowedServerScript) {
+        bumpTimestamp(properties);
+        properties.setServerScripts(existingEntity->getServerScripts());
+    }
 
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
+    if (suppressDisallowedPrivateUserData) {
+        bumpTimestamp(properties);
+        properties.setPrivateUserData(existingEntity->getPrivateUserData());
+    }
+}
 
-            break;
-        }
+void EntityTree::applyValidatedEdit(PacketType packetType, const EntityItemPointer& existingEntity,
+                                    EntityItemProperties& properties, const SharedNodePointer& senderNode) {
+    quint64 startLogging = usecTimestampNow();
+    if (wantEditLogging()) {
+        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << existingEntity->getEntityItemID();
+        qCDebug(entities) << "   properties:" << properties;
+    }
+    if (wantTerseEditLogging()) {
+        QList<QString> changedProperties = properties.listChangedProperties();
+        fixupTerseEditLogging(properties, changedProperties);
+        qCDebug(entities) << senderNode->getUUID() << "edit" <<
+            existingEntity->getDebugName() << changedProperties;
+    }
+    quint64 startUpdate = usecTimestampNow();
+    _totalLoggingTime += startUpdate - startLogging;
 
-        default:
-            processedBytes = 0;
-            break;
+    if (packetType != PacketType::EntityPhysics) {
+        properties.setLastEditedBy(senderNode->getUUID());
     }
-    return processedBytes;
+    updateEntity(existingEntity, properties, senderNode);
+    existingEntity->markAsChangedOnServer();
+    _totalUpdateTime += usecTimestampNow() - startUpdate;
+    _totalUpdates++;
 }
 
 
@@ -2555,11 +2902,31 @@ void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
         return;
     }
     _entityMap.insert(id, entity);
+    _queryIndex.insert(entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
     QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
+    _queryIndex.remove(id);
+}
+
+void EntityTree::updateEntityQueryIndex(const EntityItemPointer& entity) {
+    QWriteLocker locker(&_entityMapLock);
+    _queryIndex.update(entity);
+}
+
+void EntityTree::findEntitiesMatchingJSONFilters(const QJsonObject& jsonFilters,
+                                                 QVector<EntityItemPointer>& foundEntities) const {
+    QReadLocker locker(&_entityMapLock);
+    QSet<EntityItemID> candidates = _queryIndex.findCandidates(jsonFilters);
+    foundEntities.reserve(foundEntities.size() + candidates.size());
+    foreach(const EntityItemID& entityID, candidates) {
+        EntityItemPointer entity = _entityMap.value(entityID);
+        if (entity && entity->matchesJSONFilters(jsonFilters)) {
+            foundEntities.push_back(entity);
+        }
+    }
 }
 
 void EntityTree::debugDumpMap() {
@@ -2638,6 +3005,36 @@ void EntityTree::pruneTree() {
     recurseTreeWithOperator(&theOperator);
 }
 
+class PruneContainingOperator : public RecurseOctreeOperator {
+public:
+    PruneContainingOperator(const std::vector<AACube>& cubes) : _cubes(cubes) { }
+    virtual bool preRecursion(const OctreeElementPointer& element) override;
+    virtual bool postRecursion(const OctreeElementPointer& element) override;
+private:
+    const std::vector<AACube>& _cubes;
+};
+
+bool PruneContainingOperator::preRecursion(const OctreeElementPointer& element) {
+    const AACube& elementCube = element->getAACube();
+    return std::any_of(_cubes.begin(), _cubes.end(), [&](const AACube& cube) {
+        return elementCube.contains(cube);
+    });
+}
+
+bool PruneContainingOperator::postRecursion(const OctreeElementPointer& element) {
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+    entityTreeElement->pruneChildren();
+    return true;
+}
+
+void EntityTree::pruneElementsContaining(const std::vector<AACube>& cubes) {
+    if (cubes.empty()) {
+        return;
+    }
+    PruneContainingOperator theOperator(cubes);
+    recurseTreeWithOperator(&theOperator);
+}
+
 
 QByteArray EntityTree::remapActionDataIDs(QByteArray actionData, QHash<EntityItemID, EntityItemID>& map) {
     if (actionData.isEmpty()) {
@@ -2692,17 +3089,38 @@ QVector<EntityItemID> EntityTree::sendEntities(EntityEditPacketSender* packetSen
     QHash<EntityItemID, EntityItemID> map;
 
     args.map = &map;
+    std::vector<std::pair<EntityItemID, EntityItemProperties>> newEntityProperties;
+    args.newEntityProperties = &newEntityProperties;
     withReadLock([&] {
         recurseTreeWithOperation(sendEntitiesOperation, &args);
     });
 
+    // also update the local tree instantly (note: this is not our tree, but an alternate tree), all at once
+    if (localTree) {
+        localTree->withWriteLock([&] {
+            std::vector<EntityItemPointer> newEntities;
+            newEntities.reserve(newEntityProperties.size());
+            for (const auto& newEntity : newEntityProperties) {
+                EntityItemPointer entity = localTree->createEntity(newEntity.first, newEntity.second);
+                // else: there was an error adding this entity
+                if (entity) {
+                    newEntities.push_back(entity);
+                }
+            }
+            localTree->addEntities(newEntities);
+            for (const auto& entity : newEntities) {
+                entity->deserializeActions();
+            }
+        });
+    }
+
     // The values from map are used as the list of successfully "sent" entities.  If some didn't actually make it,
     // pull them out.  Bogus entries could happen if part of the imported data makes some reference to an entity
     // that isn't in the data being imported.  For those that made it, fix up their queryAACubes and send an
     // add-entity packet to the server.
 
     // fix the queryAACubes of any children that were read in before their parents, get them into the correct element
-    MovingEntitiesOperator moveOperator;
+    std::vector<EntityItemPointer> entitiesToRelocate;
     QHash<EntityItemID, EntityItemID>::iterator i = map.begin();
     while (i != map.end()) {
         EntityItemID newID = i.value();
@@ -2713,15 +3131,17 @@ QVector<EntityItemID> EntityTree::sendEntities(EntityEditPacketSender* packetSen
             }
             entity->forceQueryAACubeUpdate();
             entity->updateQueryAACube();
-            moveOperator.addEntityToMoveList(entity, entity->getQueryAACube());
+            entitiesToRelocate.push_back(entity);
             i++;
         } else {
             i = map.erase(i);
         }
     }
-    if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        localTree->recurseTreeWithOperator(&moveOperator);
+    if (!entitiesToRelocate.empty()) {
+        PerformanceTimer perfTimer("relocateEntities");
+        localTree->withWriteLock([&] {
+            localTree->relocateEntities(entitiesToRelocate);
+        });
     }
 
     if (!_serverlessDomain) {
@@ -2771,7 +3191,7 @@ bool EntityTree::sendEntitiesOperation(const OctreeElementPointer& element, void
         return iter.value();
     };
 
-    entityTreeElement->forEachEntity([&args, &getMapped, &element](EntityItemPointer item) {
+    entityTreeElement->forEachEntity([&args, &getMapped](EntityItemPointer item) {
         EntityItemID oldID = item->getEntityItemID();
         EntityItemID newID = getMapped(oldID);
         EntityItemProperties properties = item->getProperties();
@@ -2818,19 +3238,8 @@ bool EntityTree::sendEntitiesOperation(const OctreeElementPointer& element, void
         // set creation time to "now" for imported entities
         properties.setCreated(usecTimestampNow());
 
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        EntityTreePointer tree = entityTreeElement->getTree();
-
-        // also update the local tree instantly (note: this is not our tree, but an alternate tree)
-        if (args->otherTree) {
-            args->otherTree->withWriteLock([&] {
-                EntityItemPointer entity = args->otherTree->addEntity(newID, properties);
-                if (entity) {
-                    entity->deserializeActions();
-                }
-                // else: there was an error adding this entity
-            });
-        }
+        // the local tree is updated in bulk by sendEntities once the whole tree has been visited
+        args->newEntityProperties->emplace_back(newID, properties);
         return newID;
     });
 
@@ -2994,171 +3403,219 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
     // to add the new entity to the EntityTree.
     QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
+    // Converting to EntityItemProperties is the expensive part, so on the server where no avatar joints need
+    // resolving it is spread across the thread pool with a script engine per job.
+    quint64 convertStart = usecTimestampNow();
+    int numEntities = entitiesQList.length();
+    std::vector<EntityItemID> entityItemIDs(numEntities);
+    std::vector<EntityItemProperties> entityProperties(numEntities);
+    // looked up once here, the jobs must not go through the DependencyManager from the pool threads. Tools that
+    // load content without a NodeList have no session for avatar entities to belong to.
+    const QUuid sessionID = DependencyManager::isSet<NodeList>() ? DependencyManager::get<NodeList>()->getSessionUUID() : QUuid();
+    auto convertEntities = [&](int begin, int end) {
+        QScriptEngine scriptEngine;
+        for (int i = begin; i < end; ++i) {
+            entityPropertiesFromVariant(entitiesQList.at(i), contentVersion, sessionID, scriptEngine,
+                                        entityItemIDs[i], entityProperties[i]);
+        }
+    };
+
+    if (_myAvatar || numEntities <= ENTITIES_PER_CONVERT_JOB) {
+        convertEntities(0, numEntities);
+    } else {
+        std::vector<QFuture<void>> jobs;
+        for (int begin = 0; begin < numEntities; begin += ENTITIES_PER_CONVERT_JOB) {
+            int end = std::min(begin + ENTITIES_PER_CONVERT_JOB, numEntities);
+            jobs.push_back(QtConcurrent::run(QThreadPool::globalInstance(), [&convertEntities, begin, end] {
+                convertEntities(begin, end);
+            }));
+        }
+        for (auto& job : jobs) {
+            job.waitForFinished();
+        }
+    }
+    _lastLoadTimings.convertUsecs = usecTimestampNow() - convertStart;
+
+    // Entity --> tree, all at once
+    quint64 buildStart = usecTimestampNow();
     QMap<QUuid, QVector<QUuid>> cloneIDs;
+    QSet<EntityItemID> newEntityIDs;
+    std::vector<EntityItemPointer> newEntities;
+    newEntities.reserve(numEntities);
 
     bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
+    for (int i = 0; i < numEntities; ++i) {
+        const EntityItemID& entityItemID = entityItemIDs[i];
+        const EntityItemProperties& properties = entityProperties[i];
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+        EntityItemPointer entity;
+        if (!newEntityIDs.contains(entityItemID)) {
+            entity = createEntity(entityItemID, properties, false, isImport);
+        }
+        if (!entity) {
+            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+            success = false;
+            continue;
+        }
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+        newEntityIDs.insert(entityItemID);
+        newEntities.push_back(entity);
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
         }
+    }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    addEntities(newEntities);
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
         }
+    }
+    _lastLoadTimings.buildUsecs = usecTimestampNow() - buildStart;
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
-            }
-        }
+    return success;
+}
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
+void EntityTree::entityPropertiesFromVariant(const QVariant& entityVariant, int contentVersion, const QUuid& sessionID,
+                                             QScriptEngine& scriptEngine, EntityItemID& entityItemID,
+                                             EntityItemProperties& properties) const {
+    // QVariantMap --> QScriptValue --> EntityItemProperties
+    QVariantMap entityMap = entityVariant.toMap();
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
-            }
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
         }
+    }
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        properties.setOwningAvatarID(sessionID);
+    }
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
         }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
-
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
             }
         }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
         }
+    }
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
-        }
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
             }
-        }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
-            success = false;
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
         }
+    }
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
         }
     }
 
-    for (const auto& entityID : cloneIDs.keys()) {
-        auto entity = findEntityByID(entityID);
-        if (entity) {
-            entity->setCloneIDs(cloneIDs.value(entityID));
-        }
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
     }
 
-    return success;
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
 }
 
 bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
@@ -21,6 +21,7 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntityQueryIndex.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
@@ -44,6 +45,7 @@ public:
     EntityTree* ourTree;
     EntityTreePointer otherTree;
     QHash<EntityItemID, EntityItemID>* map;
+    std::vector<std::pair<EntityItemID, EntityItemProperties>>* newEntityProperties;
 };
 
 class EntityTree : public Octree, public SpatialParentTree {
@@ -90,6 +92,7 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual EditBatchStats processEditPacketBatch(const std::vector<NodeSharedReceivedMessagePair>& messages) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -120,6 +123,20 @@ public:
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false, const bool isImport = false);
 
+    // validates and constructs a new entity without adding it to the tree, see addEntities()
+    EntityItemPointer createEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false, const bool isImport = false);
+
+    // adds many entities created by createEntity() at once, sorted by octal code rather than recursing per entity
+    void addEntities(const std::vector<EntityItemPointer>& entities);
+
+    // moves entities already in the tree into the elements that best fit their current queryAACubes
+    void relocateEntities(const std::vector<EntityItemPointer>& entities);
+
+    // relocates up to a fixed number of misplaced entities and prunes the elements they left, takes the locks
+    // itself so it can run from a background thread, returns the number of entities relocated. Entities that
+    // can't be placed any better are skipped on later passes until their queryAACube changes.
+    virtual int rebalanceTree() override;
+
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
 
@@ -145,6 +162,9 @@ public:
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
 
+    /// finds the entities matching a JSON query filter using the query index, see EntityQueryIndex::canQuery()
+    void findEntitiesMatchingJSONFilters(const QJsonObject& jsonFilters, QVector<EntityItemPointer>& foundEntities) const;
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -171,6 +191,8 @@ public:
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    // called by the EntityItem setters of the properties EntityQueryIndex keys on, whatever path changed them
+    void updateEntityQueryIndex(const EntityItemPointer& entity);
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -329,6 +351,7 @@ protected:
 
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
+    EntityQueryIndex _queryIndex; // guarded by _entityMapLock
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
@@ -361,6 +384,30 @@ protected:
     quint64 _maxEditDelta = 0;
     quint64 _treeResetTime = 0;
 
+    // returns the cubes of the elements entities were moved out of. Unlike AddEntityOperator, an entity with no
+    // best fit element is kept in the deepest element containing it rather than left out of the tree.
+    std::vector<AACube> placeEntities(const std::vector<EntityItemPointer>& entities);
+    void pruneElementsContaining(const std::vector<AACube>& cubes);
+    QHash<EntityItemID, AACube> _unplaceableEntities; // only touched by rebalanceTree()
+    void postAddEntities(const std::vector<EntityItemPointer>& entities);
+
+    // processEditPacketData() split into decoding, which doesn't need the tree lock, and applying
+    bool decodeEditPacketData(PacketType packetType, const unsigned char* editData, int maxLength, int& processedBytes,
+                              EntityItemID& entityItemID, EntityItemProperties& properties, EntityItemID& entityIDToClone);
+    void applyEditPacketData(PacketType packetType, const EntityItemID& entityItemID, EntityItemProperties& properties,
+                             const EntityItemID& entityIDToClone, const SharedNodePointer& senderNode);
+
+    // applying an edit to an existing entity is split again into the whitelist, permission and filter checks,
+    // which can adjust the properties, and the update itself, so that a batch can check every edit before folding
+    void capTmpEntityLifetime(EntityItemProperties& properties, const SharedNodePointer& senderNode, bool isAdd);
+    void validateEditProperties(PacketType packetType, const EntityItemPointer& existingEntity,
+                                EntityItemProperties& properties, const SharedNodePointer& senderNode);
+    void applyValidatedEdit(PacketType packetType, const EntityItemPointer& existingEntity,
+                            EntityItemProperties& properties, const SharedNodePointer& senderNode);
+    void entityPropertiesFromVariant(const QVariant& entityVariant, int contentVersion, const QUuid& sessionID,
+                                     QScriptEngine& scriptEngine, EntityItemID& entityItemID,
+                                     EntityItemProperties& properties) const;
+
     void fixupNeedsParentFixups(); // try to hook members of _needsParentFixup to parent instances
     QVector<EntityItemWeakPointer> _needsParentFixup; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _needsParentFixupLock;
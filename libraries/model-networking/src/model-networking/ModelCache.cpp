@@ -271,6 +271,7 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _geometryResource = modelCache->getResource(url, QUrl(), &extra, std::hash<GeometryExtra>()(extra)).staticCast<GeometryResource>();
             // Avoid caching nested resources - their references will be held by the parent
             _geometryResource->_isCacheable = false;
+            _geometryResource->setLoadPriorities(_loadPriorities);
 
             if (_geometryResource->isLoaded()) {
                 onGeometryMappingLoaded(!_geometryResource->getURL().isEmpty());
@@ -291,6 +292,20 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
     }
 }
 
+void GeometryResource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    Resource::setLoadPriority(owner, priority);
+    if (_geometryResource) {
+        _geometryResource->setLoadPriority(owner, priority);
+    }
+}
+
+void GeometryResource::clearLoadPriority(const QPointer<QObject>& owner) {
+    Resource::clearLoadPriority(owner);
+    if (_geometryResource) {
+        _geometryResource->clearLoadPriority(owner);
+    }
+}
+
 void GeometryResource::onGeometryMappingLoaded(bool success) {
     if (success && _geometryResource) {
         _hfmModel = _geometryResource->_hfmModel;
@@ -88,6 +88,10 @@ public:
 
     virtual void deleter() override;
 
+    // the priorities of a mapping are those of the model it loads
+    void setLoadPriority(const QPointer<QObject>& owner, float priority) override;
+    void clearLoadPriority(const QPointer<QObject>& owner) override;
+
     virtual void downloadFinished(const QByteArray& data) override;
     void setExtra(void* extra) override;
 
@@ -132,6 +136,7 @@ public:
     void setResource(GeometryResource::Pointer resource);
 
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
+    GeometryResource::Pointer getResource() const { return _resource; }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
 
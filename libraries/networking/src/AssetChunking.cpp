@@ -0,0 +1,118 @@
+//
+//  AssetChunking.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunking.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QHash>
+
+namespace {
+
+// the random values the gear hash adds for each byte, the same on every machine
+std::array<uint64_t, 256> makeGearTable() {
+    std::array<uint64_t, 256> table;
+    uint64_t state = 0x2545f4914f6cdd1dULL;
+    for (auto& value : table) {
+        // splitmix64
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+const std::array<uint64_t, 256> GEAR_TABLE = makeGearTable();
+
+// The top bits of the hash depend on the most bytes.  Cut points are harder to find before the average chunk size
+// than after it, so that chunk sizes stay close to the average.
+const uint64_t HARD_CUT_MASK = ((1ULL << 18) - 1) << (64 - 18);
+const uint64_t EASY_CUT_MASK = ((1ULL << 14) - 1) << (64 - 14);
+
+}
+
+namespace AssetUtils {
+
+size_t findChunkSize(const char* data, size_t size) {
+    if (size <= MIN_CHUNK_SIZE) {
+        return size;
+    }
+
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t normalSize = std::min(size, AVERAGE_CHUNK_SIZE);
+    size_t maxSize = std::min(size, MAX_CHUNK_SIZE);
+
+    uint64_t hash = 0;
+    size_t i = MIN_CHUNK_SIZE;
+    for (; i < normalSize; ++i) {
+        hash = (hash << 1) + GEAR_TABLE[bytes[i]];
+        if (!(hash & HARD_CUT_MASK)) {
+            return i + 1;
+        }
+    }
+    for (; i < maxSize; ++i) {
+        hash = (hash << 1) + GEAR_TABLE[bytes[i]];
+        if (!(hash & EASY_CUT_MASK)) {
+            return i + 1;
+        }
+    }
+    return maxSize;
+}
+
+std::vector<AssetChunk> chunkData(const QByteArray& data) {
+    std::vector<AssetChunk> chunks;
+    size_t offset = 0;
+    size_t size = data.size();
+    while (offset < size) {
+        size_t chunkSize = findChunkSize(data.constData() + offset, size - offset);
+        auto hash = QCryptographicHash::hash(QByteArray::fromRawData(data.constData() + offset, (int)chunkSize),
+                                             QCryptographicHash::Sha256);
+        chunks.push_back({ hash, (uint32_t)chunkSize });
+        offset += chunkSize;
+    }
+    return chunks;
+}
+
+std::vector<ByteRange> reuseChunks(const QByteArray& base, const std::vector<AssetChunk>& chunks, QByteArray& data) {
+    QHash<QByteArray, qint64> baseOffsets;
+    qint64 baseOffset = 0;
+    for (auto& chunk : chunkData(base)) {
+        baseOffsets.insert(chunk.hash, baseOffset);
+        baseOffset += chunk.size;
+    }
+
+    qint64 size = 0;
+    for (auto& chunk : chunks) {
+        size += chunk.size;
+    }
+    data.resize((int)size);
+
+    std::vector<ByteRange> missingRanges;
+    qint64 offset = 0;
+    for (auto& chunk : chunks) {
+        auto it = baseOffsets.find(chunk.hash);
+        if (it != baseOffsets.end()) {
+            memcpy(data.data() + offset, base.constData() + it.value(), chunk.size);
+        } else if (!missingRanges.empty() && missingRanges.back().toExclusive == offset) {
+            missingRanges.back().toExclusive += chunk.size;
+        } else {
+            missingRanges.push_back({ offset, offset + chunk.size });
+        }
+        offset += chunk.size;
+    }
+    return missingRanges;
+}
+
+} // namespace AssetUtils
@@ -0,0 +1,47 @@
+//
+//  AssetChunking.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunking_h
+#define hifi_AssetChunking_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "ByteRange.h"
+
+namespace AssetUtils {
+
+// Assets are split into chunks at boundaries found from their content, with a rolling hash, rather than at fixed
+// offsets.  An edit to an asset then only changes the chunks around it, and the other chunks are shared with the
+// asset's previous versions, whether an edit inserted or removed bytes or not.
+const size_t MIN_CHUNK_SIZE = 16 * 1024;
+const size_t AVERAGE_CHUNK_SIZE = 64 * 1024;
+const size_t MAX_CHUNK_SIZE = 256 * 1024;
+
+struct AssetChunk {
+    QByteArray hash; // the SHA-256 of the chunk, not hex encoded
+    uint32_t size;
+};
+
+// returns the size of the chunk data starts with
+size_t findChunkSize(const char* data, size_t size);
+
+std::vector<AssetChunk> chunkData(const QByteArray& data);
+
+// Copies the chunks of an asset that a previous version of it, the base, has too into data, resized to the size of
+// the asset.  Returns the ranges of the asset left to get, adjacent chunks the base doesn't have merged in one range.
+std::vector<ByteRange> reuseChunks(const QByteArray& base, const std::vector<AssetChunk>& chunks, QByteArray& data);
+
+} // namespace AssetUtils
+
+#endif // hifi_AssetChunking_h
@@ -14,11 +14,13 @@
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
 #include <QtNetwork/QNetworkDiskCache>
 
+#include <SettingHandle.h>
 #include <shared/GlobalAppProperties.h>
 #include <shared/MiniPromises.h>
 
@@ -49,6 +51,8 @@ AssetClient::AssetClient() {
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetInfoReply));
     packetReceiver.registerListener(PacketType::AssetGetReply,
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetReply), true);
+    packetReceiver.registerListener(PacketType::AssetGetBatchReply,
+        PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetBatchReply));
     packetReceiver.registerListener(PacketType::AssetUploadReply,
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadReply));
 
@@ -83,6 +87,18 @@ void AssetClient::initCaching() {
                 << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
     }
 
+    if (!_diskCache) {
+        if (_cacheDir.isEmpty()) {
+            _cacheDir = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache())->cacheDirectory();
+        }
+        Setting::Handle<int> maxSizeHandle(ResourceDiskCache::SETTING_MAX_SIZE_NAME, ResourceDiskCache::DEFAULT_MAX_SIZE_MB);
+        auto diskCache = std::make_shared<ResourceDiskCache>(QDir(_cacheDir).filePath("resources").toStdString());
+        diskCache->initialize();
+        diskCache->setMaxSize((size_t)std::max(maxSizeHandle.get(), 0) * BYTES_PER_MEGABYTES);
+        std::atomic_store(&_diskCache, diskCache);
+        qInfo() << "ResourceManager resource cache setup at" << QString::fromStdString(diskCache->getDirpath())
+                << "(size:" << maxSizeHandle.get() << "MB)";
+    }
 }
 
 namespace {
@@ -318,6 +334,11 @@ void AssetClient::clearCache() {
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
+
+    // the resources in use are kept, the entries of the HTTP resources removed go when they are next looked up
+    if (auto diskCache = getDiskCache()) {
+        diskCache->wipe();
+    }
 }
 
 void AssetClient::handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -370,8 +391,9 @@ GetMappingRequest* AssetClient::createGetMappingRequest(const AssetUtils::AssetP
     return request;
 }
 
-GetAllMappingsRequest* AssetClient::createGetAllMappingsRequest() {
-    auto request = new GetAllMappingsRequest();
+GetAllMappingsRequest* AssetClient::createGetAllMappingsRequest(const AssetUtils::AssetPath& prefix,
+                                                               const AssetUtils::AssetPath& startAfter, uint32_t limit) {
+    auto request = new GetAllMappingsRequest(prefix, startAfter, limit);
 
     request->moveToThread(thread());
 
@@ -410,6 +432,14 @@ SetBakingEnabledRequest* AssetClient::createSetBakingEnabledRequest(const AssetU
     return bakingEnabledRequest;
 }
 
+GetBakingQueueRequest* AssetClient::createGetBakingQueueRequest() {
+    auto request = new GetBakingQueueRequest();
+
+    request->moveToThread(thread());
+
+    return request;
+}
+
 AssetRequest* AssetClient::createRequest(const AssetUtils::AssetHash& hash, const ByteRange& byteRange) {
     auto request = new AssetRequest(hash, byteRange);
 
@@ -451,27 +481,102 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
 
         auto messageID = ++_currentID;
 
-        auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(start) + sizeof(end);
-        auto packet = NLPacket::create(PacketType::AssetGet, payloadSize, true);
-
         qCDebug(asset_client) << "Requesting data from" << start << "to" << end << "of" << hash << "from asset-server.";
 
-        packet->writePrimitive(messageID);
+        _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback,
+                                                     QByteArray::fromHex(hash.toLatin1()), start, end };
 
-        packet->write(QByteArray::fromHex(hash.toLatin1()));
+        queueGet(assetServer, messageID);
 
-        packet->writePrimitive(start);
-        packet->writePrimitive(end);
+        return messageID;
+    }
 
-        if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
-            _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback };
+    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+    return INVALID_MESSAGE_ID;
+}
 
-            return messageID;
+void AssetClient::queueGet(const SharedNodePointer& assetServer, MessageID messageID) {
+    // a scene loading makes many gets at once, they go out together when the event loop gets back to the queue
+    if (_queuedGets.empty()) {
+        QMetaObject::invokeMethod(this, "sendQueuedGets", Qt::QueuedConnection);
+    }
+    _queuedGets.push_back({ assetServer, messageID });
+}
+
+void AssetClient::sendQueuedGets() {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    std::vector<std::pair<SharedNodePointer, MessageID>> queuedGets;
+    queuedGets.swap(_queuedGets);
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+
+    size_t index = 0;
+    while (index < queuedGets.size()) {
+        // gets for the same asset server, up to a batch of them
+        auto assetServer = queuedGets[index].first;
+        auto messageMapIt = _pendingRequests.find(assetServer);
+        std::vector<AssetUtils::BatchedGet> gets;
+        for (; index < queuedGets.size() && queuedGets[index].first == assetServer &&
+               gets.size() < (size_t)AssetUtils::MAX_BATCHED_GETS; ++index) {
+            // the gets of an asset server that was killed since were already failed
+            if (messageMapIt == _pendingRequests.end()) {
+                continue;
+            }
+            auto& messageCallbackMap = messageMapIt->second;
+            auto requestIt = messageCallbackMap.find(queuedGets[index].second);
+            if (requestIt != messageCallbackMap.end()) {
+                auto& request = requestIt->second;
+                gets.push_back({ requestIt->first, request.hash, request.start, request.end });
+            }
+        }
+
+        if (gets.size() == 1) {
+            if (!sendGet(assetServer, gets.front())) {
+                failGet(assetServer, gets.front().messageID);
+            }
+        } else if (gets.size() > 1) {
+            auto packetList = NLPacketList::create(PacketType::AssetGetBatch, QByteArray(), true, true);
+            AssetUtils::writeBatchedGets(*packetList, gets);
+
+            qCDebug(asset_client) << "Requesting a batch of" << gets.size() << "assets from asset-server.";
+            if (nodeList->sendPacketList(std::move(packetList), *assetServer) == -1) {
+                for (auto& get : gets) {
+                    failGet(assetServer, get.messageID);
+                }
+            }
         }
     }
+}
 
-    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
-    return INVALID_MESSAGE_ID;
+bool AssetClient::sendGet(const SharedNodePointer& assetServer, const AssetUtils::BatchedGet& get) {
+    auto payloadSize = sizeof(get.messageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(get.start) + sizeof(get.end);
+    auto packet = NLPacket::create(PacketType::AssetGet, payloadSize, true);
+
+    packet->writePrimitive(get.messageID);
+
+    packet->write(get.hash);
+
+    packet->writePrimitive(get.start);
+    packet->writePrimitive(get.end);
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    return nodeList->sendPacket(std::move(packet), *assetServer) != -1;
+}
+
+void AssetClient::failGet(const SharedNodePointer& assetServer, MessageID messageID) {
+    auto messageMapIt = _pendingRequests.find(assetServer);
+    if (messageMapIt == _pendingRequests.end()) {
+        return;
+    }
+
+    auto& messageCallbackMap = messageMapIt->second;
+    auto requestIt = messageCallbackMap.find(messageID);
+    if (requestIt != messageCallbackMap.end()) {
+        auto callback = requestIt->second.completeCallback;
+        messageCallbackMap.erase(requestIt);
+        callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+    }
 }
 
 MessageID AssetClient::getAssetInfo(const QString& hash, GetInfoCallback callback) {
@@ -600,6 +705,50 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     }
 }
 
+void AssetClient::handleAssetGetBatchReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    std::vector<MessageID> messageIDs;
+    auto replies = AssetUtils::readBatchedGetReplies(*message, messageIDs);
+    qCDebug(asset_client) << "Got a batch reply for" << replies.size() << "assets";
+
+    // Check if we have any pending requests for this node
+    auto messageMapIt = _pendingRequests.find(senderNode);
+    if (messageMapIt == _pendingRequests.end()) {
+        return;
+    }
+    auto& messageCallbackMap = messageMapIt->second;
+
+    for (auto& reply : replies) {
+        // gets canceled since they were sent are no longer there
+        auto requestIt = messageCallbackMap.find(reply.messageID);
+        if (requestIt == messageCallbackMap.end()) {
+            continue;
+        }
+
+        if (reply.error == AssetUtils::AssetServerError::NoError && !reply.isIncluded) {
+            // the asset didn't fit in the reply, the asset server sends it in an AssetGetReply of its own
+            continue;
+        }
+
+        if (reply.error) {
+            qCWarning(asset_client) << "Failure getting asset: " << reply.error;
+        }
+
+        auto callback = requestIt->second.completeCallback;
+        messageCallbackMap.erase(requestIt);
+        callback(true, reply.error, reply.data);
+    }
+
+    // the gets a truncated reply left out won't be answered
+    if (replies.size() < messageIDs.size()) {
+        qCWarning(asset_client) << "Got a truncated batch reply, failing" << messageIDs.size() - replies.size() << "gets";
+        for (size_t i = replies.size(); i < messageIDs.size(); ++i) {
+            failGet(senderNode, messageIDs[i]);
+        }
+    }
+}
+
 void AssetClient::handleProgressCallback(const QWeakPointer<Node>& node, MessageID messageID,
                                          qint64 size, AssetUtils::DataOffset length) {
     auto senderNode = node.toStrongRef();
@@ -701,7 +850,8 @@ MessageID AssetClient::getAssetMapping(const AssetUtils::AssetPath& path, Mappin
     return INVALID_MESSAGE_ID;
 }
 
-MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
+MessageID AssetClient::getAllAssetMappings(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter,
+                                           uint32_t limit, MappingOperationCallback callback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     auto nodeList = DependencyManager::get<LimitedNodeList>();
@@ -715,6 +865,10 @@ MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
 
         packetList->writePrimitive(AssetUtils::AssetMappingOperationType::GetAll);
 
+        packetList->writeString(prefix);
+        packetList->writeString(startAfter);
+        packetList->writePrimitive(limit);
+
         if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
             _pendingMappingRequests[assetServer][messageID] = callback;
 
@@ -841,6 +995,58 @@ MessageID AssetClient::setBakingEnabled(const AssetUtils::AssetPathList& paths,
     return INVALID_MESSAGE_ID;
 }
 
+MessageID AssetClient::getBakingQueue(MappingOperationCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetMappingOperation, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        packetList->writePrimitive(AssetUtils::AssetMappingOperationType::GetBakingQueue);
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingMappingRequests[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, QSharedPointer<ReceivedMessage>());
+    return INVALID_MESSAGE_ID;
+}
+
+MessageID AssetClient::getAssetChunks(const AssetUtils::AssetHash& hash, MappingOperationCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetMappingOperation, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        packetList->writePrimitive(AssetUtils::AssetMappingOperationType::GetAssetChunks);
+
+        packetList->write(QByteArray::fromHex(hash.toUtf8()));
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingMappingRequests[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, QSharedPointer<ReceivedMessage>());
+    return INVALID_MESSAGE_ID;
+}
+
 bool AssetClient::cancelMappingRequest(MessageID id) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -912,6 +1118,12 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
 
         uint64_t size = data.length();
         packetList->writePrimitive(size);
+
+        // with the hash declared, the asset server doesn't need the data if it has the asset already
+        bool hasDeclaredHash = true;
+        packetList->writePrimitive(hasDeclaredHash);
+        packetList->write(AssetUtils::hashData(data));
+
         packetList->write(data.constData(), size);
 
         if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
@@ -17,16 +17,19 @@
 #include <QString>
 
 #include <map>
+#include <memory>
 
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetGetBatch.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
 #include "ReceivedMessage.h"
+#include "ResourceDiskCache.h"
 
 class GetMappingRequest;
 class SetMappingRequest;
@@ -34,6 +37,7 @@ class GetAllMappingsRequest;
 class DeleteMappingsRequest;
 class RenameMappingRequest;
 class SetBakingEnabledRequest;
+class GetBakingQueueRequest;
 class AssetRequest;
 class AssetUpload;
 
@@ -54,15 +58,23 @@ public:
     AssetClient();
 
     Q_INVOKABLE GetMappingRequest* createGetMappingRequest(const AssetUtils::AssetPath& path);
-    Q_INVOKABLE GetAllMappingsRequest* createGetAllMappingsRequest();
+    // with a prefix, only the mappings of the paths starting with it, and with a limit, a page of that many mappings
+    // coming after startAfter
+    Q_INVOKABLE GetAllMappingsRequest* createGetAllMappingsRequest(const AssetUtils::AssetPath& prefix = AssetUtils::AssetPath(),
+                                                                   const AssetUtils::AssetPath& startAfter = AssetUtils::AssetPath(),
+                                                                   uint32_t limit = 0);
     Q_INVOKABLE DeleteMappingsRequest* createDeleteMappingsRequest(const AssetUtils::AssetPathList& paths);
     Q_INVOKABLE SetMappingRequest* createSetMappingRequest(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
     Q_INVOKABLE RenameMappingRequest* createRenameMappingRequest(const AssetUtils::AssetPath& oldPath, const AssetUtils::AssetPath& newPath);
     Q_INVOKABLE SetBakingEnabledRequest* createSetBakingEnabledRequest(const AssetUtils::AssetPathList& path, bool enabled);
+    Q_INVOKABLE GetBakingQueueRequest* createGetBakingQueueRequest();
     Q_INVOKABLE AssetRequest* createRequest(const AssetUtils::AssetHash& hash, const ByteRange& byteRange = ByteRange());
     Q_INVOKABLE AssetUpload* createUpload(const QString& filename);
     Q_INVOKABLE AssetUpload* createUpload(const QByteArray& data);
 
+    // the disk cache of ATP and HTTP resources, null until initCaching ran
+    std::shared_ptr<ResourceDiskCache> getDiskCache() const { return std::atomic_load(&_diskCache); }
+
 public slots:
     void initCaching();
 
@@ -77,18 +89,24 @@ private slots:
     void handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetGetBatchReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
 
+    void sendQueuedGets();
+
 private:
     MessageID getAssetMapping(const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
-    MessageID getAllAssetMappings(MappingOperationCallback callback);
+    MessageID getAllAssetMappings(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter, uint32_t limit,
+                                  MappingOperationCallback callback);
     MessageID setAssetMapping(const QString& path, const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
     MessageID deleteAssetMappings(const AssetUtils::AssetPathList& paths, MappingOperationCallback callback);
     MessageID renameAssetMapping(const AssetUtils::AssetPath& oldPath, const AssetUtils::AssetPath& newPath, MappingOperationCallback callback);
     MessageID setBakingEnabled(const AssetUtils::AssetPathList& paths, bool enabled, MappingOperationCallback callback);
+    MessageID getBakingQueue(MappingOperationCallback callback);
+    MessageID getAssetChunks(const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
 
     MessageID getAssetInfo(const QString& hash, GetInfoCallback callback);
     MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
@@ -103,12 +121,19 @@ private:
     void handleProgressCallback(const QWeakPointer<Node>& node, MessageID messageID, qint64 size, AssetUtils::DataOffset length);
     void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length);
 
+    void queueGet(const SharedNodePointer& assetServer, MessageID messageID);
+    bool sendGet(const SharedNodePointer& assetServer, const AssetUtils::BatchedGet& get);
+    void failGet(const SharedNodePointer& assetServer, MessageID messageID);
+
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
         ProgressCallback progressCallback;
+        QByteArray hash; // what was asked for, to send once the gets of the pass are batched
+        AssetUtils::DataOffset start;
+        AssetUtils::DataOffset end;
     };
 
     static MessageID _currentID;
@@ -117,7 +142,11 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
 
+    // the gets made in this pass of the event loop, sent together once it is done
+    std::vector<std::pair<SharedNodePointer, MessageID>> _queuedGets;
+
     QString _cacheDir;
+    std::shared_ptr<ResourceDiskCache> _diskCache;
 
     friend class AssetRequest;
     friend class AssetUpload;
@@ -128,6 +157,7 @@ private:
     friend class DeleteMappingsRequest;
     friend class RenameMappingRequest;
     friend class SetBakingEnabledRequest;
+    friend class GetBakingQueueRequest;
 };
 
 #endif
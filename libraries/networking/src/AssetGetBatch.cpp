@@ -0,0 +1,107 @@
+//
+//  AssetGetBatch.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetGetBatch.h"
+
+#include "NLPacketList.h"
+#include "ReceivedMessage.h"
+
+namespace AssetUtils {
+
+void writeBatchedGets(NLPacketList& packetList, const std::vector<BatchedGet>& gets) {
+    packetList.writePrimitive((uint32_t)gets.size());
+    for (auto& get : gets) {
+        packetList.writePrimitive(get.messageID);
+        packetList.write(get.hash);
+        packetList.writePrimitive(get.start);
+        packetList.writePrimitive(get.end);
+    }
+}
+
+std::vector<BatchedGet> readBatchedGets(ReceivedMessage& message) {
+    const qint64 GET_SIZE = sizeof(MessageID) + SHA256_HASH_LENGTH + 2 * sizeof(DataOffset);
+
+    uint32_t count = 0;
+    message.readPrimitive(&count);
+
+    // a message too short for the count it claims is malformed
+    std::vector<BatchedGet> gets;
+    if (count > (uint32_t)MAX_BATCHED_GETS || message.getBytesLeftToRead() < count * GET_SIZE) {
+        return gets;
+    }
+
+    gets.resize(count);
+    for (auto& get : gets) {
+        message.readPrimitive(&get.messageID);
+        get.hash = message.read(SHA256_HASH_LENGTH);
+        message.readPrimitive(&get.start);
+        message.readPrimitive(&get.end);
+    }
+    return gets;
+}
+
+void writeBatchedGetRepliesHeader(NLPacketList& packetList, const std::vector<BatchedGet>& gets) {
+    packetList.writePrimitive((uint32_t)gets.size());
+    for (auto& get : gets) {
+        packetList.writePrimitive(get.messageID);
+    }
+}
+
+void writeBatchedGetReply(NLPacketList& packetList, const BatchedGetReply& reply) {
+    packetList.writePrimitive(reply.messageID);
+    packetList.writePrimitive(reply.error);
+    if (reply.error == AssetServerError::NoError) {
+        packetList.writePrimitive(reply.isIncluded);
+        if (reply.isIncluded) {
+            packetList.writePrimitive((DataOffset)reply.data.size());
+            packetList.write(reply.data);
+        }
+    }
+}
+
+std::vector<BatchedGetReply> readBatchedGetReplies(ReceivedMessage& message, std::vector<MessageID>& messageIDs) {
+    uint32_t count = 0;
+    message.readPrimitive(&count);
+
+    messageIDs.clear();
+    for (uint32_t i = 0; i < count && message.getBytesLeftToRead() >= (qint64)sizeof(MessageID); ++i) {
+        MessageID messageID;
+        message.readPrimitive(&messageID);
+        messageIDs.push_back(messageID);
+    }
+
+    // the replies are read up to where the message ends, if it ends early
+    std::vector<BatchedGetReply> replies;
+    while (replies.size() < messageIDs.size()) {
+        BatchedGetReply reply;
+        if (message.readPrimitive(&reply.messageID) != sizeof(reply.messageID) ||
+            message.readPrimitive(&reply.error) != sizeof(reply.error)) {
+            break;
+        }
+        if (reply.error == AssetServerError::NoError) {
+            if (message.readPrimitive(&reply.isIncluded) != sizeof(reply.isIncluded)) {
+                break;
+            }
+            if (reply.isIncluded) {
+                DataOffset length = 0;
+                if (message.readPrimitive(&length) != sizeof(length) ||
+                    length < 0 || length > message.getBytesLeftToRead()) {
+                    break;
+                }
+                reply.data = message.read(length);
+            }
+        }
+        replies.push_back(reply);
+    }
+    return replies;
+}
+
+} // namespace AssetUtils
@@ -0,0 +1,60 @@
+//
+//  AssetGetBatch.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetGetBatch_h
+#define hifi_AssetGetBatch_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "AssetUtils.h"
+#include "ClientServerUtils.h"
+
+class NLPacketList;
+class ReceivedMessage;
+
+namespace AssetUtils {
+
+// The asset gets a client makes in the same pass of its event loop are sent in one AssetGetBatch message, and the
+// asset server replies to them in one AssetGetBatchReply message, with the assets back to back.  An asset too large for
+// a batch, or that would make the reply too large, is left out of it and sent in an AssetGetReply of its own, which
+// reports progress and is streamed from disk.
+const int MAX_BATCHED_GETS = 256;
+const qint64 MAX_BATCHED_ASSET_SIZE = 256 * 1024;
+const qint64 MAX_BATCH_REPLY_SIZE = 4 * 1024 * 1024;
+
+struct BatchedGet {
+    MessageID messageID; // the ID of the get, the client tells the replies apart by it
+    QByteArray hash; // not hex encoded
+    DataOffset start;
+    DataOffset end;
+};
+
+struct BatchedGetReply {
+    MessageID messageID;
+    AssetServerError error { AssetServerError::NoError };
+    bool isIncluded { false }; // whether the data is in the reply, or comes in an AssetGetReply of its own
+    QByteArray data;
+};
+
+void writeBatchedGets(NLPacketList& packetList, const std::vector<BatchedGet>& gets);
+std::vector<BatchedGet> readBatchedGets(ReceivedMessage& message);
+
+// The reply starts with the message IDs of all the gets it answers, so that the gets a truncated reply leaves out can
+// be failed
+void writeBatchedGetRepliesHeader(NLPacketList& packetList, const std::vector<BatchedGet>& gets);
+void writeBatchedGetReply(NLPacketList& packetList, const BatchedGetReply& reply);
+std::vector<BatchedGetReply> readBatchedGetReplies(ReceivedMessage& message, std::vector<MessageID>& messageIDs);
+
+} // namespace AssetUtils
+
+#endif // hifi_AssetGetBatch_h
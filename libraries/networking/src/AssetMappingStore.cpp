@@ -0,0 +1,408 @@
+//
+//  AssetMappingStore.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMappingStore.h"
+
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include "NetworkLogging.h"
+
+namespace {
+
+const QString JOURNAL_FILE_SUFFIX = ".journal";
+
+// each journal entry is its size and checksum, then the edits
+const int JOURNAL_ENTRY_HEADER_SIZE = sizeof(quint32) + sizeof(quint16);
+
+const int MAP_FILE_WRITE_SIZE = 1024 * 1024;
+
+// The map files written here are a flat object of strings, which is read without a QJsonDocument since one can't hold
+// as many mappings as a large domain has.  Anything else is left to QJsonDocument.
+class MapFileReader {
+public:
+    MapFileReader(const QByteArray& json) : _position(json.constData()), _end(json.constData() + json.size()) {}
+
+    bool read(std::vector<std::pair<QString, QString>>& members) {
+        if (!consume('{')) {
+            return false;
+        }
+        if (!consume('}')) {
+            do {
+                QString key;
+                QString value;
+                if (!readString(key) || !consume(':') || !readString(value)) {
+                    return false;
+                }
+                members.emplace_back(key, value);
+            } while (consume(','));
+
+            if (!consume('}')) {
+                return false;
+            }
+        }
+        skipWhitespace();
+        return _position == _end;
+    }
+
+private:
+    void skipWhitespace() {
+        while (_position < _end && (*_position == ' ' || *_position == '\n' || *_position == '\r' || *_position == '\t')) {
+            ++_position;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (_position < _end && *_position == c) {
+            ++_position;
+            return true;
+        }
+        return false;
+    }
+
+    bool readString(QString& string) {
+        if (!consume('"')) {
+            return false;
+        }
+
+        const char* run = _position;
+        auto endRun = [&] {
+            string += QString::fromUtf8(run, (int)(_position - run));
+        };
+        while (_position < _end) {
+            char c = *_position;
+            if (c == '"') {
+                endRun();
+                ++_position;
+                return true;
+            } else if (c == '\\') {
+                endRun();
+                if (++_position == _end) {
+                    return false;
+                }
+                switch (*_position) {
+                    case '"': string += QChar('"'); break;
+                    case '\\': string += QChar('\\'); break;
+                    case '/': string += QChar('/'); break;
+                    case 'b': string += QChar('\b'); break;
+                    case 'f': string += QChar('\f'); break;
+                    case 'n': string += QChar('\n'); break;
+                    case 'r': string += QChar('\r'); break;
+                    case 't': string += QChar('\t'); break;
+                    case 'u': {
+                        bool ok = _end - _position > 4;
+                        ushort code = ok ? QByteArray(_position + 1, 4).toUShort(&ok, 16) : 0;
+                        if (!ok) {
+                            return false;
+                        }
+                        // surrogate pairs come out as their two halves, which is what a QString holds
+                        string += QChar(code);
+                        _position += 4;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                run = ++_position;
+            } else if ((unsigned char)c < 0x20) {
+                return false;
+            } else {
+                ++_position;
+            }
+        }
+        return false;
+    }
+
+    const char* _position;
+    const char* _end;
+};
+
+void appendJsonString(QByteArray& json, const QString& string) {
+    json.append('"');
+    // the bytes of multi-byte UTF-8 characters never need escaping
+    for (char c : string.toUtf8()) {
+        if (c == '"' || c == '\\') {
+            json.append('\\');
+            json.append(c);
+        } else if ((unsigned char)c < 0x20) {
+            json.append(QString::asprintf("\\u%04x", (unsigned)c).toLatin1());
+        } else {
+            json.append(c);
+        }
+    }
+    json.append('"');
+}
+
+}
+
+bool AssetMappingStore::load(const QString& mapFilePath) {
+    _mapFilePath = mapFilePath;
+    _mappings.clear();
+    _hashReferences.clear();
+
+    if (!readMapFile() || !readJournal()) {
+        return false;
+    }
+
+    qCInfo(networking) << "Loaded" << _mappings.size() << "mappings from map file at" << _mapFilePath << "and"
+        << _journalEdits << "edits from its journal";
+
+    // start from an empty journal, there is no need to replay the same edits at every start
+    if (_journalEdits > 0) {
+        compact();
+    }
+    return true;
+}
+
+bool AssetMappingStore::readMapFile() {
+    QFile mapFile { _mapFilePath };
+    if (!mapFile.exists()) {
+        qCInfo(networking) << "No existing mappings loaded from file since no file was found at" << _mapFilePath;
+        return true;
+    }
+    if (!mapFile.open(QIODevice::ReadOnly)) {
+        qCCritical(networking) << "Failed to read mapping file at" << _mapFilePath;
+        return false;
+    }
+
+    auto json = mapFile.readAll();
+
+    std::vector<std::pair<QString, QString>> members;
+    if (!MapFileReader(json).read(members)) {
+        // a map file written by hand, or with values that aren't strings
+        members.clear();
+
+        QJsonParseError error;
+        auto jsonDocument = QJsonDocument::fromJson(json, &error);
+        if (error.error != QJsonParseError::NoError) {
+            qCCritical(networking) << "Failed to read mapping file at" << _mapFilePath << "-" << error.errorString();
+            return false;
+        }
+        if (!jsonDocument.isObject()) {
+            qCWarning(networking) << "Failed to read mapping file, root value in" << _mapFilePath << "is not an object";
+            return false;
+        }
+
+        auto root = jsonDocument.object();
+        for (auto it = root.begin(); it != root.end(); ++it) {
+            if (!it.value().isString()) {
+                qCWarning(networking) << "Skipping" << it.key() << ":" << it.value() << "because it is not a string";
+                continue;
+            }
+            members.emplace_back(it.key(), it.value().toString());
+        }
+    }
+
+    for (auto& member : members) {
+        if (!AssetUtils::isValidFilePath(member.first)) {
+            qCWarning(networking) << "Will not keep mapping for" << member.first << "since it is not a valid path.";
+            continue;
+        }
+        if (!AssetUtils::isValidHash(member.second)) {
+            qCWarning(networking) << "Will not keep mapping for" << member.first << "since it does not have a valid hash.";
+            continue;
+        }
+
+        // map files are written in path order, which makes each insert constant time
+        auto sizeBefore = _mappings.size();
+        _mappings.emplace_hint(_mappings.end(), member.first, member.second);
+        if (_mappings.size() > sizeBefore) {
+            addReference(member.second);
+        }
+    }
+    return true;
+}
+
+bool AssetMappingStore::readJournal() {
+    _journal.reset(new QFile(_mapFilePath + JOURNAL_FILE_SUFFIX));
+    _journalEdits = 0;
+    if (!_journal->open(QIODevice::ReadWrite)) {
+        qCCritical(networking) << "Failed to open mapping journal at" << _journal->fileName();
+        _journal.reset();
+        return false;
+    }
+
+    auto journal = _journal->readAll();
+    int position = 0;
+    while (journal.size() - position >= JOURNAL_ENTRY_HEADER_SIZE) {
+        quint32 entrySize;
+        quint16 checksum;
+        QDataStream header(QByteArray::fromRawData(journal.constData() + position, JOURNAL_ENTRY_HEADER_SIZE));
+        header >> entrySize >> checksum;
+        if (entrySize > (quint32)(journal.size() - position - JOURNAL_ENTRY_HEADER_SIZE)) {
+            break;
+        }
+
+        const char* entry = journal.constData() + position + JOURNAL_ENTRY_HEADER_SIZE;
+        if (qChecksum(entry, entrySize) != checksum) {
+            break;
+        }
+
+        QDataStream stream(QByteArray::fromRawData(entry, (int)entrySize));
+        quint32 numEdits;
+        stream >> numEdits;
+        Edits edits;
+        for (quint32 i = 0; i < numEdits && stream.status() == QDataStream::Ok; ++i) {
+            Edit edit;
+            stream >> edit.path >> edit.hash;
+            edits.push_back(edit);
+        }
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        for (auto& edit : edits) {
+            applyEdit(edit);
+        }
+        _journalEdits += (int)edits.size();
+        position += JOURNAL_ENTRY_HEADER_SIZE + (int)entrySize;
+    }
+
+    if (position < journal.size()) {
+        qCWarning(networking) << "Dropping" << journal.size() - position << "bytes of an incomplete entry at the end of"
+            << _journal->fileName();
+        _journal->resize(position);
+    }
+    _journal->seek(position);
+    return true;
+}
+
+bool AssetMappingStore::apply(const Edits& edits) {
+    if (!_journal) {
+        qCWarning(networking) << "Can't edit mappings that weren't loaded";
+        return false;
+    }
+    if (edits.empty()) {
+        return true;
+    }
+
+    QByteArray entry;
+    QDataStream stream(&entry, QIODevice::WriteOnly);
+    stream << (quint32)edits.size();
+    for (auto& edit : edits) {
+        stream << edit.path << edit.hash;
+    }
+
+    QByteArray header;
+    QDataStream headerStream(&header, QIODevice::WriteOnly);
+    headerStream << (quint32)entry.size() << qChecksum(entry.constData(), entry.size());
+
+    auto journalSize = _journal->pos();
+    if (_journal->write(header + entry) != header.size() + entry.size() || !_journal->flush()) {
+        qCWarning(networking) << "Failed to write to mapping journal at" << _journal->fileName() << "-"
+            << _journal->errorString();
+        _journal->resize(journalSize);
+        _journal->seek(journalSize);
+        return false;
+    }
+
+    for (auto& edit : edits) {
+        applyEdit(edit);
+    }
+    _journalEdits += (int)edits.size();
+
+    if (_journalEdits >= std::max((size_t)MIN_COMPACTION_EDITS, _mappings.size() / 4)) {
+        // the edits are safe in the journal if this fails, it will be tried again after the next ones
+        compact();
+    }
+    return true;
+}
+
+bool AssetMappingStore::compact() {
+    QSaveFile mapFile { _mapFilePath };
+    if (!mapFile.open(QIODevice::WriteOnly)) {
+        qCWarning(networking) << "Failed to open map file at" << _mapFilePath;
+        return false;
+    }
+
+    // the same layout QJsonDocument writes, without building one
+    QByteArray json = "{\n";
+    for (auto it = _mappings.cbegin(); it != _mappings.cend(); ++it) {
+        json.append("    ");
+        appendJsonString(json, it->first);
+        json.append(": ");
+        appendJsonString(json, it->second);
+        json.append(std::next(it) != _mappings.cend() ? ",\n" : "\n");
+
+        if (json.size() >= MAP_FILE_WRITE_SIZE) {
+            mapFile.write(json);
+            json.clear();
+        }
+    }
+    json.append("}\n");
+    mapFile.write(json);
+
+    if (!mapFile.commit()) {
+        qCWarning(networking) << "Failed to write JSON mappings to file at" << _mapFilePath << "-" << mapFile.errorString();
+        return false;
+    }
+
+    // replaying the journal over the new map file would give the same mappings, so a crash before this is harmless
+    if (_journal) {
+        _journal->resize(0);
+        _journal->seek(0);
+    }
+    _journalEdits = 0;
+
+    qCDebug(networking) << "Wrote" << _mappings.size() << "JSON mappings to file at" << _mapFilePath;
+    return true;
+}
+
+AssetMappingStore::const_iterator AssetMappingStore::lowerBound(const AssetUtils::AssetPath& prefix,
+                                                                const AssetUtils::AssetPath& startAfter) const {
+    if (!startAfter.isEmpty() && prefix < startAfter) {
+        return _mappings.upper_bound(startAfter);
+    }
+    return _mappings.lower_bound(prefix);
+}
+
+std::pair<AssetMappingStore::const_iterator, AssetMappingStore::const_iterator> AssetMappingStore::findPrefix(
+        const AssetUtils::AssetPath& prefix) const {
+    auto first = _mappings.lower_bound(prefix);
+    auto last = first;
+    while (last != _mappings.cend() && last->first.startsWith(prefix)) {
+        ++last;
+    }
+    return { first, last };
+}
+
+void AssetMappingStore::applyEdit(const Edit& edit) {
+    auto it = _mappings.find(edit.path);
+    if (edit.hash.isEmpty()) {
+        if (it != _mappings.end()) {
+            removeReference(it->second);
+            _mappings.erase(it);
+        }
+    } else if (it == _mappings.end()) {
+        _mappings.emplace(edit.path, edit.hash);
+        addReference(edit.hash);
+    } else if (it->second != edit.hash) {
+        removeReference(it->second);
+        it->second = edit.hash;
+        addReference(edit.hash);
+    }
+}
+
+void AssetMappingStore::addReference(const AssetUtils::AssetHash& hash) {
+    ++_hashReferences[hash];
+}
+
+void AssetMappingStore::removeReference(const AssetUtils::AssetHash& hash) {
+    auto it = _hashReferences.find(hash);
+    if (it != _hashReferences.end() && --it.value() <= 0) {
+        _hashReferences.erase(it);
+    }
+}
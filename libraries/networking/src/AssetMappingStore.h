@@ -0,0 +1,86 @@
+//
+//  AssetMappingStore.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMappingStore_h
+#define hifi_AssetMappingStore_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include "AssetUtils.h"
+
+// The asset server's path to hash mappings, sorted by path, persisted to a JSON map file.
+// Edits are appended to a journal next to the map file instead of rewriting it, and the journal is folded into the
+// map file once it holds as many edits as a quarter of the mappings, so that an edit costs about the same however
+// many mappings there are.  A journal entry cut short by a crash is dropped when the mappings are loaded again.
+// Reads go through the same members as a std::map.  Not thread safe.
+class AssetMappingStore {
+public:
+    using const_iterator = AssetUtils::Mappings::const_iterator;
+
+    static const int MIN_COMPACTION_EDITS = 1000;
+
+    // an edit with an empty hash removes the mapping of the path
+    struct Edit {
+        AssetUtils::AssetPath path;
+        AssetUtils::AssetHash hash;
+    };
+    using Edits = std::vector<Edit>;
+
+    // reads the map file and replays its journal, a missing map file is no mappings
+    bool load(const QString& mapFilePath);
+
+    // persists all the edits as one journal entry and then applies them, or leaves the mappings as they were if they
+    // couldn't be persisted
+    bool apply(const Edits& edits);
+    bool set(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) { return apply({ { path, hash } }); }
+
+    // writes the mappings to the map file and empties the journal
+    bool compact();
+
+    const AssetUtils::Mappings& getMappings() const { return _mappings; }
+    size_t size() const { return _mappings.size(); }
+    const_iterator begin() const { return _mappings.cbegin(); }
+    const_iterator end() const { return _mappings.cend(); }
+    const_iterator cbegin() const { return _mappings.cbegin(); }
+    const_iterator cend() const { return _mappings.cend(); }
+    const_iterator find(const AssetUtils::AssetPath& path) const { return _mappings.find(path); }
+
+    // the first mapping of a path starting with prefix and coming after startAfter, if startAfter isn't empty
+    const_iterator lowerBound(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter = QString()) const;
+    // the mappings of the paths starting with prefix, in path order
+    std::pair<const_iterator, const_iterator> findPrefix(const AssetUtils::AssetPath& prefix) const;
+
+    // whether any path maps to the hash
+    bool isMapped(const AssetUtils::AssetHash& hash) const { return _hashReferences.contains(hash); }
+
+    int getJournalEdits() const { return _journalEdits; }
+
+private:
+    bool readMapFile();
+    bool readJournal();
+    void applyEdit(const Edit& edit);
+    void addReference(const AssetUtils::AssetHash& hash);
+    void removeReference(const AssetUtils::AssetHash& hash);
+
+    QString _mapFilePath;
+    std::unique_ptr<QFile> _journal;
+    int _journalEdits { 0 };
+
+    AssetUtils::Mappings _mappings;
+    QHash<AssetUtils::AssetHash, int> _hashReferences; // how many paths map to each hash
+};
+
+#endif // hifi_AssetMappingStore_h
@@ -18,6 +18,7 @@
 #include <StatTracker.h>
 #include <Trace.h>
 
+#include "AssetChunking.h"
 #include "AssetClient.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
@@ -38,6 +39,10 @@ AssetRequest::~AssetRequest() {
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_chunksRequestID) {
+        assetClient->cancelMappingRequest(_chunksRequestID);
+    }
+    cancelRangeRequests();
 }
 
 void AssetRequest::start() {
@@ -60,11 +65,27 @@ void AssetRequest::start() {
         return;
     }
     
-    // Try to load from cache
+    // Try to load from cache, where assets are kept whole
     _data = AssetUtils::loadFromCache(getUrl());
     if (!_data.isNull()) {
         _error = NoError;
 
+        if (_byteRange.isSet()) {
+            // cut the range out the way the asset server does
+            auto byteRange = _byteRange;
+            qint64 size = _data.size();
+            if (byteRange.isValid()) {
+                byteRange.fixupRange(size);
+            }
+            if (!byteRange.isValid() || size < byteRange.fromInclusive || size < byteRange.toExclusive) {
+                _error = InvalidByteRange;
+                _data.clear();
+            } else {
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : size + byteRange.fromInclusive;
+                _data = _data.mid((int)offset, (int)byteRange.size());
+            }
+        }
+
         _loadedFromCache = true;
 
         _state = Finished;
@@ -75,6 +96,20 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (!_deltaBaseHash.isEmpty() && _deltaBaseHash != _hash && !_byteRange.isSet()) {
+        auto baseData = AssetUtils::loadFromCache(AssetUtils::getATPUrl(_deltaBaseHash));
+        if (!baseData.isEmpty()) {
+            requestChunks(baseData);
+            return;
+        }
+    }
+
+    requestWholeAsset();
+}
+
+void AssetRequest::requestWholeAsset() {
+    _totalReceived = 0;
+
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -135,6 +170,138 @@ void AssetRequest::start() {
     });
 }
 
+void AssetRequest::requestChunks(const QByteArray& baseData) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    _chunksRequestID = assetClient->getAssetChunks(_hash,
+        [this, that, baseData](bool responseReceived, AssetUtils::AssetServerError serverError,
+                               QSharedPointer<ReceivedMessage> message) {
+
+        if (!that) {
+            return;
+        }
+        _chunksRequestID = INVALID_MESSAGE_ID;
+
+        // assets the server stores whole, and servers that don't know about chunks, are downloaded whole
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            requestWholeAsset();
+            return;
+        }
+
+        int64_t size;
+        uint32_t numChunks;
+        message->readPrimitive(&size);
+        message->readPrimitive(&numChunks);
+        if (message->getBytesLeftToRead() < (qint64)numChunks * (AssetUtils::SHA256_HASH_LENGTH + sizeof(uint32_t))) {
+            requestWholeAsset();
+            return;
+        }
+
+        std::vector<AssetUtils::AssetChunk> chunks;
+        chunks.reserve(numChunks);
+        for (uint32_t i = 0; i < numChunks; ++i) {
+            AssetUtils::AssetChunk chunk;
+            chunk.hash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+            message->readPrimitive(&chunk.size);
+            chunks.push_back(chunk);
+        }
+
+        auto missingRanges = AssetUtils::reuseChunks(baseData, chunks, _deltaData);
+        if (_deltaData.size() != size) {
+            _deltaData.clear();
+            requestWholeAsset();
+            return;
+        }
+        qint64 missingSize = 0;
+        for (auto& range : missingRanges) {
+            missingSize += range.size();
+        }
+        qCDebug(asset_client) << "Reusing" << size - missingSize << "of" << size << "bytes of" << _hash
+            << "from" << _deltaBaseHash;
+
+        _totalReceived = size - missingSize;
+        emit progress(_totalReceived, size);
+
+        requestMissingRanges(missingRanges);
+    });
+}
+
+void AssetRequest::requestMissingRanges(const std::vector<ByteRange>& missingRanges) {
+    if (missingRanges.empty()) {
+        finishDelta();
+        return;
+    }
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    // the ranges are all asked for at once, the asset client sends gets made together in one batch
+    for (auto& range : missingRanges) {
+        _rangeRequestIDs.insert(range.fromInclusive, INVALID_MESSAGE_ID);
+    }
+    for (auto& range : missingRanges) {
+        auto rangeRequestID = assetClient->getAsset(_hash, range.fromInclusive, range.toExclusive,
+            [this, that, range](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+
+            if (!that || !_rangeRequestIDs.remove(range.fromInclusive)) {
+                return;
+            }
+
+            if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError || data.size() != range.size()) {
+                cancelRangeRequests();
+                _deltaData.clear();
+                requestWholeAsset();
+                return;
+            }
+
+            memcpy(_deltaData.data() + range.fromInclusive, data.constData(), data.size());
+            _totalReceived += data.size();
+            emit progress(_totalReceived, _deltaData.size());
+
+            if (_rangeRequestIDs.isEmpty()) {
+                finishDelta();
+            }
+        }, [](qint64, qint64) {});
+
+        // a get that failed straight away has already given up on the ranges
+        auto it = _rangeRequestIDs.find(range.fromInclusive);
+        if (it == _rangeRequestIDs.end()) {
+            return;
+        }
+        it.value() = rangeRequestID;
+    }
+}
+
+void AssetRequest::finishDelta() {
+    // the chunks are only kept if they add up to the asset
+    if (AssetUtils::hashData(_deltaData).toHex() == _hash) {
+        _data = _deltaData;
+        _deltaData.clear();
+        AssetUtils::saveToCache(getUrl(), _data);
+
+        _state = Finished;
+        emit finished(this);
+    } else {
+        qCWarning(asset_client) << "Chunks of asset" << _hash << "didn't match, downloading all of it";
+        _deltaData.clear();
+        requestWholeAsset();
+    }
+}
+
+void AssetRequest::cancelRangeRequests() {
+    if (_rangeRequestIDs.isEmpty()) {
+        return;
+    }
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto rangeRequestID : _rangeRequestIDs) {
+        if (rangeRequestID != INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(rangeRequestID);
+        }
+    }
+    _rangeRequestIDs.clear();
+}
+
 
 const QString AssetRequest::getErrorString() const {
     QString result;
@@ -12,7 +12,10 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <vector>
+
 #include <QByteArray>
+#include <QHash>
 #include <QObject>
 #include <QString>
 
@@ -46,6 +49,10 @@ public:
     AssetRequest(const QString& hash, const ByteRange& byteRange = ByteRange());
     virtual ~AssetRequest() override;
 
+    // To be called before start.  If the cache has the asset that had the same path before, the asset is put
+    // together from the chunks the two versions share, and only the chunks that changed are downloaded.
+    void setDeltaBase(const AssetUtils::AssetHash& baseHash) { _deltaBaseHash = baseHash; }
+
     Q_INVOKABLE void start();
 
     const QByteArray& getData() const { return _data; }
@@ -62,6 +69,12 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    void requestWholeAsset();
+    void requestChunks(const QByteArray& baseData);
+    void requestMissingRanges(const std::vector<ByteRange>& missingRanges);
+    void finishDelta();
+    void cancelRangeRequests();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -72,6 +85,11 @@ private:
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
+
+    AssetUtils::AssetHash _deltaBaseHash;
+    MessageID _chunksRequestID { INVALID_MESSAGE_ID };
+    QHash<qint64, MessageID> _rangeRequestIDs; // by the start of the range, of the missing ranges still to arrive
+    QByteArray _deltaData; // the asset being put together
 };
 
 #endif
@@ -12,6 +12,7 @@
 #include "AssetResourceRequest.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
 
 #include <Trace.h>
 #include <Profile.h>
@@ -24,6 +25,10 @@
 
 static const int DOWNLOAD_PROGRESS_LOG_INTERVAL_SECONDS = 5;
 
+// the hashes ATP paths were last mapped to
+static QMutex lastMappedHashesMutex;
+static QHash<AssetUtils::AssetPath, AssetUtils::AssetHash> lastMappedHashes;
+
 AssetResourceRequest::AssetResourceRequest(
     const QUrl& url,
     const bool isObservable,
@@ -104,7 +109,13 @@ void AssetResourceRequest::requestMappingForPath(const AssetUtils::AssetPath& pa
                     _result = RedirectFail;
                     failed = true;
                 } else {
-                    requestHash(request->getHash());
+                    AssetUtils::AssetHash previousHash;
+                    {
+                        QMutexLocker locker(&lastMappedHashesMutex);
+                        previousHash = lastMappedHashes.value(path);
+                        lastMappedHashes[path] = request->getHash();
+                    }
+                    requestHash(request->getHash(), previousHash);
                 }
 
                 break;
@@ -144,10 +155,13 @@ void AssetResourceRequest::requestMappingForPath(const AssetUtils::AssetPath& pa
     _assetMappingRequest->start();
 }
 
-void AssetResourceRequest::requestHash(const AssetUtils::AssetHash& hash) {
+void AssetResourceRequest::requestHash(const AssetUtils::AssetHash& hash, const AssetUtils::AssetHash& previousHash) {
     // Make request to atp
     auto assetClient = DependencyManager::get<AssetClient>();
     _assetRequest = assetClient->createRequest(hash, _byteRange);
+    if (!previousHash.isEmpty() && previousHash != hash) {
+        _assetRequest->setDeltaBase(previousHash);
+    }
 
     connect(_assetRequest, &AssetRequest::progress, this, &AssetResourceRequest::onDownloadProgress);
     connect(_assetRequest, &AssetRequest::finished, this, [this](AssetRequest* req) {
@@ -39,7 +39,8 @@ private:
     static bool urlIsAssetHash(const QUrl& url);
 
     void requestMappingForPath(const AssetUtils::AssetPath& path);
-    void requestHash(const AssetUtils::AssetHash& hash);
+    // an asset the path mapped to before is used as the base to only download the chunks that changed
+    void requestHash(const AssetUtils::AssetHash& hash, const AssetUtils::AssetHash& previousHash = AssetUtils::AssetHash());
 
     GetMappingRequest* _assetMappingRequest { nullptr };
     AssetRequest* _assetRequest { nullptr };
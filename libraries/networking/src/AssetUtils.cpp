@@ -23,6 +23,7 @@
 #include "NetworkingConstants.h"
 #include "MetaverseAPI.h"
 
+#include "AssetClient.h"
 #include "ResourceManager.h"
 
 namespace AssetUtils {
@@ -63,12 +64,32 @@ QByteArray hashData(const QByteArray& data) {
     return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 }
 
+static std::shared_ptr<ResourceDiskCache> getDiskCache() {
+    return DependencyManager::isSet<AssetClient>() ? DependencyManager::get<AssetClient>()->getDiskCache() : nullptr;
+}
+
 QByteArray loadFromCache(const QUrl& url) {
+    auto hash = extractAssetHash(url.toString());
+    auto diskCache = getDiskCache();
+    if (diskCache && !hash.isEmpty()) {
+        auto data = diskCache->load(hash);
+        if (!data.isNull()) {
+            return data;
+        }
+    }
+
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
 
         // caller is responsible for the deletion of the ioDevice, hence the unique_ptr
         if (auto ioDevice = std::unique_ptr<QIODevice>(cache->data(url))) {
-            return ioDevice->readAll();
+            auto data = ioDevice->readAll();
+
+            // assets cached before the resource disk cache was there move to it
+            if (diskCache && !hash.isEmpty() && diskCache->store(hash, data)) {
+                ioDevice.reset();
+                cache->remove(url);
+            }
+            return data;
         }
 
     }
@@ -77,6 +98,13 @@ QByteArray loadFromCache(const QUrl& url) {
 }
 
 bool saveToCache(const QUrl& url, const QByteArray& file) {
+    // assets are stored under their hash, where every request for them finds them
+    auto hash = extractAssetHash(url.toString());
+    auto diskCache = getDiskCache();
+    if (diskCache && !hash.isEmpty()) {
+        return diskCache->store(hash, file);
+    }
+
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
         if (!cache->metaData(url).isValid()) {
             QNetworkCacheMetaData metaData;
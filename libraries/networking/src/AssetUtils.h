@@ -15,6 +15,7 @@
 #include <cstdint>
 
 #include <map>
+#include <vector>
 
 #include <QtCore/QByteArray>
 #include <QtCore/QUrl>
@@ -55,7 +56,9 @@ enum AssetMappingOperationType : uint8_t {
     Set,
     Delete,
     Rename,
-    SetBakingEnabled
+    SetBakingEnabled,
+    GetBakingQueue,
+    GetAssetChunks
 };
 
 enum BakingStatus {
@@ -73,6 +76,22 @@ struct MappingInfo {
     QString bakingErrors;
 };
 
+struct BakeInfo {
+    AssetPath path;
+    AssetHash hash;
+    int64_t size;
+    int64_t msecs; // how long the bake took, or has been running for
+};
+
+// the state of the asset server's baking queue
+struct BakingQueueInfo {
+    uint32_t numQueued { 0 };
+    uint32_t maxConcurrentBakes { 0 };
+    int64_t etaMsecs { 0 }; // when all the queued and running bakes are expected to be done
+    std::vector<BakeInfo> running;
+    std::vector<BakeInfo> recent; // the last bakes that finished, most recent first
+};
+
 using AssetMappings = std::map<AssetPath, MappingInfo>;
 using Mappings = std::map<AssetPath, AssetHash>;
 
@@ -81,6 +100,7 @@ AssetHash extractAssetHash(const QString& input);
 
 QByteArray hashData(const QByteArray& data);
 
+// assets are cached in the resource disk cache of the AssetClient, other URLs in the network cache
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
 
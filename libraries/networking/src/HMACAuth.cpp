@@ -18,10 +18,90 @@
 #include "NetworkLogging.h"
 #include <cassert>
 
+namespace {
+
+const int SIPHASH_KEY_BYTES = 16;
+const int SIPHASH_TAG_BYTES = 16;
+
+inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t readLittleEndian64(const unsigned char* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+inline void writeLittleEndian64(unsigned char* bytes, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+struct SipState {
+    uint64_t v0, v1, v2, v3;
+
+    void round() {
+        v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);
+        v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);
+    }
+
+    void compress(uint64_t message) {
+        v3 ^= message;
+        round();
+        round();
+        v0 ^= message;
+    }
+
+    uint64_t finalize() {
+        round();
+        round();
+        round();
+        round();
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+};
+
+// SipHash-2-4 with the 128-bit output variant
+void sipHash128(uint64_t k0, uint64_t k1, const unsigned char* data, int dataLen, unsigned char* tag) {
+    SipState state {
+        0x736f6d6570736575ULL ^ k0,
+        0x646f72616e646f6dULL ^ k1 ^ 0xee,
+        0x6c7967656e657261ULL ^ k0,
+        0x7465646279746573ULL ^ k1
+    };
+
+    const unsigned char* end = data + (dataLen - dataLen % 8);
+    for (; data != end; data += 8) {
+        state.compress(readLittleEndian64(data));
+    }
+
+    uint64_t last = (uint64_t)dataLen << 56;
+    for (int i = dataLen % 8 - 1; i >= 0; --i) {
+        last |= (uint64_t)data[i] << (8 * i);
+    }
+    state.compress(last);
+
+    state.v2 ^= 0xee;
+    writeLittleEndian64(tag, state.finalize());
+    state.v1 ^= 0xdd;
+    writeLittleEndian64(tag + 8, state.finalize());
+}
+
+}
+
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
 HMACAuth::HMACAuth(AuthMethod authMethod)
     : _hmacContext(HMAC_CTX_new())
-    , _authMethod(authMethod) { }
+    , _authMethod(authMethod) {
+    _sipKey[0] = 0;
+    _sipKey[1] = 0;
+}
 
 HMACAuth::~HMACAuth()
 {
@@ -34,6 +114,8 @@ HMACAuth::HMACAuth(AuthMethod authMethod)
     : _hmacContext(new HMAC_CTX())
     , _authMethod(authMethod) {
     HMAC_CTX_init(_hmacContext);
+    _sipKey[0] = 0;
+    _sipKey[1] = 0;
 }
 
 HMACAuth::~HMACAuth() {
@@ -43,6 +125,16 @@ HMACAuth::~HMACAuth() {
 #endif
 
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
+    if (_authMethod == SIPHASH) {
+        // SipHash takes exactly 16 key bytes - fold longer keys in and leave shorter ones zero padded
+        unsigned char key[SIPHASH_KEY_BYTES] = { 0 };
+        for (int i = 0; i < keyLen; ++i) {
+            key[i % SIPHASH_KEY_BYTES] ^= (unsigned char)keyValue[i];
+        }
+        storeSipKey(readLittleEndian64(key), readLittleEndian64(key + 8));
+        return true;
+    }
+
     const EVP_MD* sslStruct = nullptr;
 
     switch (_authMethod) {
@@ -81,10 +173,22 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
 
 bool HMACAuth::addData(const char* data, int dataLen) {
     QMutexLocker lock(&_lock);
+    if (_authMethod == SIPHASH) {
+        _sipPendingData.append(data, dataLen);
+        return true;
+    }
     return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
 }
 
 HMACAuth::HMACHash HMACAuth::result() {
+    if (_authMethod == SIPHASH) {
+        HMACHash hashValue;
+        QMutexLocker lock(&_lock);
+        calculateSipHash(hashValue, _sipPendingData.constData(), _sipPendingData.size());
+        _sipPendingData.clear();
+        return hashValue;
+    }
+
     HMACHash hashValue(EVP_MAX_MD_SIZE);
     unsigned int hashLen;
     QMutexLocker lock(&_lock);
@@ -105,6 +209,11 @@ HMACAuth::HMACHash HMACAuth::result() {
 }
 
 bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
+    if (_authMethod == SIPHASH) {
+        calculateSipHash(hashResult, data, dataLen);
+        return true;
+    }
+
     QMutexLocker lock(&_lock);
     if (!addData(data, dataLen)) {
         qCWarning(networking) << "Error occured calling HMACAuth::addData()";
@@ -115,3 +224,51 @@ bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen
     hashResult = result();
     return true;
 }
+
+bool HMACAuth::calculateHashes(std::vector<HMACHash>& hashResults, const std::vector<HashInput>& inputs) {
+    hashResults.resize(inputs.size());
+
+    if (_authMethod == SIPHASH) {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            calculateSipHash(hashResults[i], inputs[i].first, inputs[i].second);
+        }
+        return true;
+    }
+
+    QMutexLocker lock(&_lock);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!calculateHash(hashResults[i], inputs[i].first, inputs[i].second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HMACAuth::calculateSipHash(HMACHash& hashResult, const char* data, int dataLen) const {
+    uint64_t k0, k1;
+    loadSipKey(k0, k1);
+    hashResult.resize(SIPHASH_TAG_BYTES);
+    sipHash128(k0, k1, reinterpret_cast<const unsigned char*>(data), dataLen, hashResult.data());
+}
+
+void HMACAuth::storeSipKey(uint64_t k0, uint64_t k1) {
+    // writers take the lock so that only one of them is between the two sequence increments
+    QMutexLocker lock(&_lock);
+    uint32_t sequence = _sipKeySequence.load(std::memory_order_relaxed);
+    _sipKeySequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _sipKey[0].store(k0, std::memory_order_relaxed);
+    _sipKey[1].store(k1, std::memory_order_relaxed);
+    _sipKeySequence.store(sequence + 2, std::memory_order_release);
+}
+
+void HMACAuth::loadSipKey(uint64_t& k0, uint64_t& k1) const {
+    // read again if a key was being written, or was written while this one was read
+    uint32_t sequence;
+    do {
+        sequence = _sipKeySequence.load(std::memory_order_acquire);
+        k0 = _sipKey[0].load(std::memory_order_relaxed);
+        k1 = _sipKey[1].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) || sequence != _sipKeySequence.load(std::memory_order_relaxed));
+}
@@ -12,24 +12,35 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <utility>
+#include <QtCore/QByteArray>
 #include <QtCore/QMutex>
 
 class QUuid;
 
+// SIPHASH is keyed SipHash-2-4 with a 128-bit tag, so it fits the 16 byte hash in a verified NLPacket header.
+// It keeps no context between calls, so calculateHash() for it takes no lock and can be called from any
+// number of threads at once.  The HMAC methods go through a single OpenSSL context guarded by a mutex.
 class HMACAuth {
 public:
-    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160 };
+    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160, SIPHASH };
     using HMACHash = std::vector<unsigned char>;
+    using HashInput = std::pair<const char*, int>;
     
     explicit HMACAuth(AuthMethod authMethod = MD5);
     ~HMACAuth();
 
+    AuthMethod getAuthMethod() const { return _authMethod; }
+
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
     // Calculate complete hash in one.
     bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
+    // Calculate the hashes of several inputs, taking the lock at most once.
+    bool calculateHashes(std::vector<HMACHash>& hashResults, const std::vector<HashInput>& inputs);
 
     // Append to data to be hashed.
     bool addData(const char* data, int dataLen);
@@ -39,9 +50,19 @@ public:
     HMACHash result();
 
 private:
+    void calculateSipHash(HMACHash& hashResult, const char* data, int dataLen) const;
+    void storeSipKey(uint64_t k0, uint64_t k1);
+    void loadSipKey(uint64_t& k0, uint64_t& k1) const;
+
     QMutex _lock { QMutex::Recursive };
     struct hmac_ctx_st* _hmacContext;
     AuthMethod _authMethod;
+
+    // SipHash key, published through a sequence lock so that a thread hashing while the key changes
+    // reads either the old key or the new one, never half of each.  The sequence is odd while a key is written.
+    std::atomic<uint32_t> _sipKeySequence { 0 };
+    std::atomic<uint64_t> _sipKey[2];
+    QByteArray _sipPendingData; // collects addData() input for SIPHASH, guarded by _lock
 };
 
 #endif  // hifi_HMACAuth_h
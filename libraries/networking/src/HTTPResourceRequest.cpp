@@ -11,6 +11,7 @@
 
 #include "HTTPResourceRequest.h"
 
+#include <QDateTime>
 #include <QFile>
 #include <QNetworkReply>
 #include <QNetworkRequest>
@@ -19,6 +20,7 @@
 #include <SharedUtil.h>
 #include <StatTracker.h>
 
+#include "AssetClient.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NetworkingConstants.h"
@@ -51,13 +53,51 @@ void HTTPResourceRequest::cleanupTimer() {
 }
 
 void HTTPResourceRequest::doSend() {
-    DependencyManager::get<StatTracker>()->incrementStat(STAT_HTTP_REQUEST_STARTED);
+    auto statTracker = DependencyManager::get<StatTracker>();
+    statTracker->incrementStat(STAT_HTTP_REQUEST_STARTED);
+
+    if (_cacheEnabled && !_byteRange.isSet() && DependencyManager::isSet<AssetClient>()) {
+        _diskCache = DependencyManager::get<AssetClient>()->getDiskCache();
+    }
+
+    // a fresh response is used without asking the server
+    if (_diskCache && _diskCache->getHTTPEntry(_url, _cacheEntry) &&
+        _cacheEntry.isFresh(QDateTime::currentMSecsSinceEpoch())) {
+
+        _data = _diskCache->load(_cacheEntry.hash);
+        if (!_data.isNull()) {
+            _loadedFromCache = true;
+            _webMediaType = QString::fromLatin1(_cacheEntry.contentType.split(';')[0]);
+            _result = Success;
+            _state = Finished;
+            emit finished();
+
+            statTracker->incrementStat(STAT_HTTP_REQUEST_SUCCESS);
+            statTracker->incrementStat(STAT_HTTP_REQUEST_CACHE);
+            return;
+        }
+        _cacheEntry = ResourceDiskCache::HTTPEntry();
+    }
 
+    sendRequest();
+}
+
+void HTTPResourceRequest::sendRequest() {
     QNetworkRequest networkRequest(_url);
     networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, NetworkingConstants::VIRCADIA_USER_AGENT);
 
-    if (_cacheEnabled) {
+    if (_diskCache) {
+        // the resource disk cache keeps the response, and revalidates it when it has one
+        networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+        networkRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+        if (!_cacheEntry.etag.isEmpty()) {
+            networkRequest.setRawHeader("If-None-Match", _cacheEntry.etag);
+        }
+        if (!_cacheEntry.lastModified.isEmpty()) {
+            networkRequest.setRawHeader("If-Modified-Since", _cacheEntry.lastModified);
+        }
+    } else if (_cacheEnabled) {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
     } else {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
@@ -125,10 +165,27 @@ void HTTPResourceRequest::onRequestFinished() {
         return { true, contentTypeParts[0] };
     };
 
+    bool isRevalidated = false;
     switch(_reply->error()) {
         case QNetworkReply::NoError:
-            _data = _reply->readAll();
-            _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+            if (_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304 && !_cacheEntry.hash.isEmpty()) {
+                // what is cached is still current
+                _data = _diskCache->load(_cacheEntry.hash);
+                if (_data.isNull()) {
+                    // the data was evicted since its entry was read, ask for all of it
+                    _reply->disconnect(this);
+                    _reply->deleteLater();
+                    _reply = nullptr;
+                    _cacheEntry = ResourceDiskCache::HTTPEntry();
+                    sendRequest();
+                    return;
+                }
+                _loadedFromCache = true;
+                isRevalidated = true;
+            } else {
+                _data = _reply->readAll();
+                _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+            }
             _result = Success;
 
             if (_byteRange.isSet()) {
@@ -152,7 +209,8 @@ void HTTPResourceRequest::onRequestFinished() {
             }
 
             {
-                auto contentTypeHeader = _reply->rawHeader("Content-Type");
+                auto contentTypeHeader = isRevalidated && !_reply->hasRawHeader("Content-Type") ?
+                    _cacheEntry.contentType : _reply->rawHeader("Content-Type");
                 bool success;
                 QString mediaType;
                 std::tie(success, mediaType) = parseMediaType(contentTypeHeader);
@@ -161,7 +219,13 @@ void HTTPResourceRequest::onRequestFinished() {
                 }
             }
 
-            recordBytesDownloadedInStats(STAT_HTTP_RESOURCE_TOTAL_BYTES, _data.size());
+            if (_diskCache) {
+                storeInDiskCache(isRevalidated);
+            }
+
+            if (!isRevalidated) {
+                recordBytesDownloadedInStats(STAT_HTTP_RESOURCE_TOTAL_BYTES, _data.size());
+            }
 
             break;
 
@@ -216,6 +280,35 @@ void HTTPResourceRequest::onRequestFinished() {
     }
 }
 
+void HTTPResourceRequest::storeInDiskCache(bool isRevalidated) {
+    // a revalidated response updates the headers it has
+    auto header = [this, isRevalidated](const QByteArray& name, const QByteArray& cached) {
+        return isRevalidated && !_reply->hasRawHeader(name) ? cached : _reply->rawHeader(name);
+    };
+    auto etag = header("ETag", _cacheEntry.etag);
+    auto lastModified = header("Last-Modified", _cacheEntry.lastModified);
+
+    auto lifetime = ResourceDiskCache::getFreshnessLifetime(_reply->rawHeader("Cache-Control"), _reply->rawHeader("Expires"),
+                                                            _reply->rawHeader("Date"), lastModified);
+    if (lifetime < 0 || (lifetime == 0 && etag.isEmpty() && lastModified.isEmpty())) {
+        // the response can't be stored, or could never be used again without downloading it
+        if (!_cacheEntry.hash.isEmpty()) {
+            _diskCache->removeHTTPEntry(_url);
+        }
+        return;
+    }
+
+    ResourceDiskCache::HTTPEntry entry;
+    entry.hash = isRevalidated ? _cacheEntry.hash : _diskCache->store(_data);
+    entry.etag = etag;
+    entry.lastModified = lastModified;
+    entry.contentType = header("Content-Type", _cacheEntry.contentType);
+    entry.freshUntil = QDateTime::currentMSecsSinceEpoch() + lifetime;
+    if (!entry.hash.isEmpty()) {
+        _diskCache->setHTTPEntry(_url, entry);
+    }
+}
+
 void HTTPResourceRequest::onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal) {
     Q_ASSERT(_state == InProgress);
     
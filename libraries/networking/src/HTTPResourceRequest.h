@@ -16,6 +16,7 @@
 #include <QUrl>
 #include <QTimer>
 
+#include "ResourceDiskCache.h"
 #include "ResourceRequest.h"
 
 class HTTPResourceRequest : public ResourceRequest {
@@ -38,11 +39,17 @@ private slots:
     void onRequestFinished();
 
 private:
+    void sendRequest();
     void setupTimer();
     void cleanupTimer();
+    void storeInDiskCache(bool isRevalidated);
 
     QTimer* _sendTimer { nullptr };
     QNetworkReply* _reply { nullptr };
+
+    // whole responses are kept in the resource disk cache, which then has the entry of the URL if it had it before
+    std::shared_ptr<ResourceDiskCache> _diskCache;
+    ResourceDiskCache::HTTPEntry _cacheEntry;
 };
 
 #endif
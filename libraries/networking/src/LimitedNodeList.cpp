@@ -45,6 +45,7 @@
 #endif
 
 static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.LocalPort", 0);
+static Setting::Handle<QString> LIMITED_NODELIST_CONGESTION_CONTROL("LimitedNodeList.CongestionControl", "vegas");
 
 using namespace std::chrono_literals;
 static const std::chrono::milliseconds CONNECTION_RATE_INTERVAL_MS = 1s;
@@ -115,8 +116,18 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
 
+    // pick the congestion control for our reliable connections, "vegas" unless set otherwise
+    auto congestionControl = LIMITED_NODELIST_CONGESTION_CONTROL.get();
+    auto congestionControlFactory = udt::createCongestionControlFactory(congestionControl);
+    if (congestionControlFactory) {
+        _nodeSocket.setCongestionControlFactory(std::move(congestionControlFactory));
+    } else {
+        qCWarning(networking) << "Unknown congestion control" << congestionControl << "- using the default";
+    }
+
     // handle when a socket connection has its receiver side reset - might need to emit clientConnectionToNodeReset
     connect(&_nodeSocket, &udt::Socket::clientHandshakeRequestComplete, this, &LimitedNodeList::clientConnectionToSockAddrReset);
+    connect(&_nodeSocket, &udt::Socket::replayFinished, this, &LimitedNodeList::packetReplayFinished);
 
     if (_stunSockAddr.getAddress().isNull()) {
         // we don't know the stun server socket yet, add it to unfiltered once known
@@ -397,6 +408,29 @@ void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAut
     }
 }
 
+void LimitedNodeList::fillPacketListHeaders(NLPacketList& packetList, HMACAuth* hmacAuth) {
+    // every packet in a list has the same type, so they are either all verified or none are
+    std::vector<const NLPacket*> verifiedPackets;
+    verifiedPackets.reserve(packetList._packets.size());
+
+    for (std::unique_ptr<udt::Packet>& packet : packetList._packets) {
+        NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
+        if (!PacketTypeEnum::getNonSourcedPackets().contains(nlPacket->getType())) {
+            nlPacket->writeSourceID(getSessionLocalID());
+
+            if (_useAuthentication && hmacAuth
+                && !PacketTypeEnum::getNonVerifiedPackets().contains(nlPacket->getType())) {
+                verifiedPackets.push_back(nlPacket);
+            }
+        }
+    }
+
+    // sign the whole list in one pass
+    if (!verifiedPackets.empty()) {
+        NLPacket::writeVerificationHashes(verifiedPackets, *hmacAuth);
+    }
+}
+
 static const qint64 ERROR_SENDING_PACKET_BYTES = -1;
 
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode) {
@@ -516,6 +550,12 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
         fillPacketHeader(*nlPacket);
     }
 
+    if (packetList->hasStreamedData()) {
+        packetList->setStreamedPacketFinisher([this](udt::Packet& packet) {
+            fillPacketHeader(static_cast<NLPacket&>(packet));
+        });
+    }
+
     return _nodeSocket.writePacketList(std::move(packetList), sockAddr);
 }
 
@@ -525,9 +565,14 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
         // close the last packet in the list
         packetList->closeCurrentPacket();
 
-        for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
-            NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
-            fillPacketHeader(*nlPacket, destinationNode.getAuthenticateHash());
+        fillPacketListHeaders(*packetList, destinationNode.getAuthenticateHash());
+
+        if (packetList->hasStreamedData()) {
+            // the streamed packets are made as the list is sent, so hold on to the node for its authentication hash
+            SharedNodePointer node = nodeWithUUID(destinationNode.getUUID());
+            packetList->setStreamedPacketFinisher([this, node](udt::Packet& packet) {
+                fillPacketHeader(static_cast<NLPacket&>(packet), node ? node->getAuthenticateHash() : nullptr);
+            });
         }
 
         return _nodeSocket.writePacketList(std::move(packetList), *activeSocket);
@@ -584,10 +629,7 @@ SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
  }
 
 SharedNodePointer LimitedNodeList::nodeWithLocalID(Node::LocalID localID) const {
-    QReadLocker readLocker(&_nodeMutex);
-
-    LocalIDMapping::const_iterator idIter = _localIDMap.find(localID);
-    return idIter == _localIDMap.cend() ? nullptr : idIter->second;
+    return _nodeTable.nodeWithLocalID(localID);
 }
 
 void LimitedNodeList::eraseAllNodes(QString reason) {
@@ -606,7 +648,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
                 killedNodes.push_back(pair.second);
             }
         }
-        _localIDMap.clear();
+        _nodeTable.clear();
         _nodeHash.clear();
     }
 
@@ -631,7 +673,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
     if (matchingNode) {
         {
             QWriteLocker writeLocker(&_nodeMutex);
-            _localIDMap.unsafe_erase(matchingNode->getLocalID());
+            _nodeTable.remove(matchingNode);
             _nodeHash.unsafe_erase(matchingNode->getUUID());
         }
 
@@ -651,6 +693,10 @@ void LimitedNodeList::processKillNode(ReceivedMessage& message) {
 }
 
 void LimitedNodeList::handleNodeKill(const SharedNodePointer& node, ConnectionID nextConnectionID) {
+    // iterating the nodes doesn't hold _nodeMutex anymore, so wait out any eachNode() that started
+    // before the node was removed and could still hand it to a callback, before tearing it down
+    _nodeTable.waitForReaders();
+
     _nodeDisconnectTimestamp = usecTimestampNow();
     qCDebug(networking) << "Killed" << *node;
     node->stopPingTimer();
@@ -682,7 +728,13 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         matchingNode->setConnectionSecret(connectionSecret);
         matchingNode->setIsReplicated(isReplicated);
         matchingNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
-        matchingNode->setLocalID(localID);
+        if (matchingNode->getLocalID() != localID) {
+            // re-index the node under its new local ID
+            QWriteLocker writeLocker(&_nodeMutex);
+            _nodeTable.remove(matchingNode);
+            matchingNode->setLocalID(localID);
+            _nodeTable.insert(matchingNode);
+        }
 
         return matchingNode;
     }
@@ -691,7 +743,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         if (node) {
             {
                 QWriteLocker writeLocker(&_nodeMutex);
-                _localIDMap.unsafe_erase(node->getLocalID());
+                _nodeTable.remove(node);
                 _nodeHash.unsafe_erase(node->getUUID());
             }
             handleNodeKill(node);
@@ -736,7 +788,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         QReadLocker readLocker(&_nodeMutex);
         // insert the new node and release our read lock
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
-        _localIDMap.insert({ localID, newNodePointer });
+        _nodeTable.insert(newNodePointer);
     }
 
     qCDebug(networking) << "Added" << *newNode;
@@ -901,7 +953,7 @@ void LimitedNodeList::removeSilentNodes() {
         if (!node->isForcedNeverSilent()
             && (usecTimestampNow() - node->getLastHeardMicrostamp()) > (NODE_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC)) {
             // call the NodeHash erase to get rid of this node
-            _localIDMap.unsafe_erase(node->getLocalID());
+            _nodeTable.remove(node);
             it = _nodeHash.unsafe_erase(it);
 
             killedNodes.insert(node);
@@ -1285,23 +1337,15 @@ void LimitedNodeList::sendPeerQueryToIceServer(const HifiSockAddr& iceServerSock
 }
 
 SharedNodePointer LimitedNodeList::findNodeWithAddr(const HifiSockAddr& addr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&addr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == addr
-            || pair.second->getLocalSocket() == addr
-            || pair.second->getSymmetricSocket() == addr;
+    return nodeMatchingPredicate([&addr](const SharedNodePointer& node) {
+        return node->getPublicSocket() == addr
+            || node->getLocalSocket() == addr
+            || node->getSymmetricSocket() == addr;
     });
-    return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
 }
 
 bool LimitedNodeList::sockAddrBelongsToNode(const HifiSockAddr& sockAddr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&sockAddr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == sockAddr
-            || pair.second->getLocalSocket() == sockAddr
-            || pair.second->getSymmetricSocket() == sockAddr;
-    });
-    return it != std::end(_nodeHash);
+    return !findNodeWithAddr(sockAddr).isNull();
 }
 
 void LimitedNodeList::sendPacketToIceServer(PacketType packetType, const HifiSockAddr& iceServerSockAddr,
@@ -1355,6 +1399,20 @@ bool LimitedNodeList::getLocalServerPortFromSharedMemory(const QString key, quin
     }
 }
 
+void LimitedNodeList::startPacketCapture(const QString& path, qint64 maxSize) {
+    QMetaObject::invokeMethod(&_nodeSocket, [this, path, maxSize] {
+        _nodeSocket.startCapture(path, maxSize);
+    });
+}
+
+void LimitedNodeList::startPacketReplay(const QString& path, float speed) {
+    QMetaObject::invokeMethod(&_nodeSocket, [this, path, speed] {
+        if (!_nodeSocket.startReplay(path, speed)) {
+            emit packetReplayFinished();
+        }
+    });
+}
+
 void LimitedNodeList::flagTimeForConnectionStep(ConnectionStep connectionStep) {
     QMetaObject::invokeMethod(this, "flagTimeForConnectionStep",
                               Q_ARG(ConnectionStep, connectionStep),
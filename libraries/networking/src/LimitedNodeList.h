@@ -42,6 +42,7 @@
 #include "Node.h"
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "NodeTable.h"
 #include "PacketReceiver.h"
 #include "ReceivedMessage.h"
 #include "udt/ControlPacket.h"
@@ -168,7 +169,7 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return _nodeTable.size(); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
     SharedNodePointer nodeWithLocalID(Node::LocalID localID) const;
@@ -207,73 +208,62 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // Cede control of iteration over a single snapshot of the nodes (e.g. for use by thread pools)
+    // Use this for nested loops instead of nesting eachNode calls!
+    //   The iterators stay valid until the functor returns, so the threads of a pool
+    //   can share them while nodes are added and killed
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
                     int* nodeTransformOut = nullptr,
                     int* functorOut = nullptr) {
-        quint64 start, endTransform, endFunctor;
+        quint64 start, endSnapshot, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
+        NodeTable::ReadGuard snapshot(_nodeTable);
+        endSnapshot = usecTimestampNow();
 
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        // there is no lock to wait for and no copy of the nodes to make anymore, report taking the snapshot
+        if (lockWaitOut) {
+            *lockWaitOut = (endSnapshot - start);
+        }
+        if (nodeTransformOut) {
+            *nodeTransformOut = 0;
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(snapshot->nodes.cbegin(), snapshot->nodes.cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
-            *functorOut = (endFunctor - endTransform);
+            *functorOut = (endFunctor - endSnapshot);
         }
     }
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTable::ReadGuard snapshot(_nodeTable);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : snapshot->nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTable::ReadGuard snapshot(_nodeTable);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : snapshot->nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTable::ReadGuard snapshot(_nodeTable);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : snapshot->nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -281,25 +271,22 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTable::ReadGuard snapshot(_nodeTable);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : snapshot->nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
         return SharedNodePointer();
     }
 
-    // This is unsafe because it does not take a lock
-    // Must only be called when you know that a read lock on the node mutex is held
-    // and will be held for the duration of your iteration
+    // Iterating the node snapshot doesn't take a lock anymore, so this is the same as eachNode.
+    // A node that is being killed is only torn down once no iteration that could still see it is running.
     template<typename NodeLambda>
     void unsafeEachNode(NodeLambda functor) {
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
-        }
+        eachNode(functor);
     }
 
     void putLocalPortIntoSharedMemory(const QString key, QObject* parent, quint16 localPort);
@@ -313,6 +300,10 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // capture the datagrams the node socket receives, or replay a capture in their place (see udt::Socket)
+    void startPacketCapture(const QString& path, qint64 maxSize);
+    void startPacketReplay(const QString& path, float speed);
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
@@ -378,6 +369,8 @@ signals:
 
     void clientConnectionToNodeReset(SharedNodePointer);
 
+    void packetReplayFinished();
+
     void localSockAddrChanged(const HifiSockAddr& localSockAddr);
     void publicSockAddrChanged(const HifiSockAddr& publicSockAddr);
 
@@ -418,6 +411,7 @@ protected:
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode,
                       const HifiSockAddr& overridenSockAddr);
     void fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth = nullptr);
+    void fillPacketListHeaders(NLPacketList& packetList, HMACAuth* hmacAuth);
 
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
@@ -438,8 +432,9 @@ protected:
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
-    NodeHash _nodeHash;
+    NodeHash _nodeHash; // by UUID, writers also update the node table
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    NodeTable _nodeTable; // by local ID, and iterated without a lock
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     HifiSockAddr _localSockAddr;
@@ -486,8 +481,6 @@ private slots:
 private:
     mutable QReadWriteLock _sessionUUIDLock;
     QUuid _sessionUUID;
-    using LocalIDMapping = tbb::concurrent_unordered_map<Node::LocalID, SharedNodePointer>;
-    LocalIDMapping _localIDMap;
     Node::LocalID _sessionLocalID { 0 };
     bool _flagTimeForConnectionStep { false }; // only keep track in interface
 
@@ -103,9 +103,18 @@ void GetMappingRequest::doStart() {
     });
 };
 
+GetAllMappingsRequest::GetAllMappingsRequest(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter,
+                                             uint32_t limit) :
+    _prefix(prefix),
+    _startAfter(startAfter),
+    _limit(limit)
+{
+
+};
+
 void GetAllMappingsRequest::doStart() {
     auto assetClient = DependencyManager::get<AssetClient>();
-    _mappingRequestID = assetClient->getAllAssetMappings(
+    _mappingRequestID = assetClient->getAllAssetMappings(_prefix, _startAfter, _limit,
             [this, assetClient](bool responseReceived, AssetUtils::AssetServerError error, QSharedPointer<ReceivedMessage> message) {
 
         _mappingRequestID = INVALID_MESSAGE_ID;
@@ -138,6 +147,7 @@ void GetAllMappingsRequest::doStart() {
                 }
                 _mappings[path] = { hash, status, lastBakeErrors };
             }
+            _nextStartAfter = message->readString();
         }
         emit finished(this);
     });
@@ -314,3 +324,47 @@ void SetBakingEnabledRequest::doStart() {
         emit finished(this);
     });
 };
+
+void GetBakingQueueRequest::doStart() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    _mappingRequestID = assetClient->getBakingQueue(
+            [this, assetClient](bool responseReceived, AssetUtils::AssetServerError error, QSharedPointer<ReceivedMessage> message) {
+
+        _mappingRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived) {
+            _error = NetworkError;
+        } else {
+            switch (error) {
+                case AssetUtils::AssetServerError::NoError:
+                    _error = NoError;
+                    break;
+                default:
+                    _error = UnknownError;
+                    break;
+            }
+        }
+
+        if (!_error) {
+            message->readPrimitive(&_bakingQueueInfo.numQueued);
+            message->readPrimitive(&_bakingQueueInfo.maxConcurrentBakes);
+            message->readPrimitive(&_bakingQueueInfo.etaMsecs);
+
+            auto readBakes = [&message](std::vector<AssetUtils::BakeInfo>& bakes) {
+                uint32_t numberOfBakes;
+                message->readPrimitive(&numberOfBakes);
+                for (uint32_t i = 0; i < numberOfBakes; ++i) {
+                    AssetUtils::BakeInfo bake;
+                    bake.path = message->readString();
+                    bake.hash = message->read(AssetUtils::SHA256_HASH_LENGTH).toHex();
+                    message->readPrimitive(&bake.size);
+                    message->readPrimitive(&bake.msecs);
+                    bakes.push_back(bake);
+                }
+            };
+            readBakes(_bakingQueueInfo.running);
+            readBakes(_bakingQueueInfo.recent);
+        }
+        emit finished(this);
+    });
+};
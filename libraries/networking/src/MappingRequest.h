@@ -120,15 +120,26 @@ private:
 class GetAllMappingsRequest : public MappingRequest {
     Q_OBJECT
 public:
+    GetAllMappingsRequest(const AssetUtils::AssetPath& prefix = AssetUtils::AssetPath(),
+                          const AssetUtils::AssetPath& startAfter = AssetUtils::AssetPath(), uint32_t limit = 0);
+
     AssetUtils::AssetMappings getMappings() const { return _mappings;  }
 
+    // where the next page starts, for a request with a limit, empty once there are no more mappings
+    AssetUtils::AssetPath getNextStartAfter() const { return _nextStartAfter; }
+
 signals:
     void finished(GetAllMappingsRequest* thisRequest);
 
 private:
     virtual void doStart() override;
 
+    AssetUtils::AssetPath _prefix;
+    AssetUtils::AssetPath _startAfter;
+    uint32_t _limit;
+
     AssetUtils::AssetMappings _mappings;
+    AssetUtils::AssetPath _nextStartAfter;
 };
 
 class SetBakingEnabledRequest : public MappingRequest {
@@ -146,5 +157,18 @@ private:
     bool _enabled;
 };
 
+class GetBakingQueueRequest : public MappingRequest {
+    Q_OBJECT
+public:
+    const AssetUtils::BakingQueueInfo& getBakingQueueInfo() const { return _bakingQueueInfo; }
+
+signals:
+    void finished(GetBakingQueueRequest* thisRequest);
+
+private:
+    virtual void doStart() override;
+
+    AssetUtils::BakingQueueInfo _bakingQueueInfo;
+};
 
 #endif // hifi_MappingRequest_h
@@ -11,8 +11,25 @@
 
 #include "NLPacket.h"
 
+#include <algorithm>
+
 #include "HMACAuth.h"
 
+namespace {
+
+int verificationHashOffset(const udt::Packet& packet) {
+    return udt::Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion) +
+        NLPacket::NUM_BYTES_LOCALID;
+}
+
+// the hash covers everything after the hash itself
+HMACAuth::HashInput hashedData(const udt::Packet& packet) {
+    int offset = verificationHashOffset(packet) + NUM_BYTES_MD5_HASH;
+    return { packet.getData() + offset, (int)packet.getDataSize() - offset };
+}
+
+}
+
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = PacketTypeEnum::getNonSourcedPackets().contains(type);
     bool nonVerified = PacketTypeEnum::getNonVerifiedPackets().contains(type);
@@ -153,17 +170,36 @@ QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
 }
 
 QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash) {
-    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
-        + NUM_BYTES_LOCALID + NUM_BYTES_MD5_HASH;
+    auto input = hashedData(packet);
     
     // add the packet payload and the connection UUID
     HMACAuth::HMACHash hashResult;
-    if (!hash.calculateHash(hashResult, packet.getData() + offset, packet.getDataSize() - offset)) {
+    if (!hash.calculateHash(hashResult, input.first, input.second)) {
         return QByteArray();
     }
     return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
 }
 
+void NLPacket::writeVerificationHashes(const std::vector<const NLPacket*>& packets, HMACAuth& hmacAuth) {
+    std::vector<HMACAuth::HashInput> inputs;
+    inputs.reserve(packets.size());
+    for (auto packet : packets) {
+        Q_ASSERT(!PacketTypeEnum::getNonSourcedPackets().contains(packet->getType()) &&
+                 !PacketTypeEnum::getNonVerifiedPackets().contains(packet->getType()));
+        inputs.push_back(hashedData(*packet));
+    }
+
+    std::vector<HMACAuth::HMACHash> hashResults;
+    if (!hmacAuth.calculateHashes(hashResults, inputs)) {
+        return;
+    }
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        memcpy(packets[i]->_packet.get() + verificationHashOffset(*packets[i]), hashResults[i].data(),
+               std::min(hashResults[i].size(), (size_t)NUM_BYTES_MD5_HASH));
+    }
+}
+
 void NLPacket::writeTypeAndVersion() {
     auto headerOffset = Packet::totalHeaderSize(isPartOfMessage());
     
@@ -12,6 +12,8 @@
 #ifndef hifi_NLPacket_h
 #define hifi_NLPacket_h
 
+#include <vector>
+
 #include <QtCore/QSharedPointer>
 
 #include <UUID.h>
@@ -72,6 +74,8 @@ public:
     static LocalID sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
     static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash);
+    // signs several packets for the same destination in one pass
+    static void writeVerificationHashes(const std::vector<const NLPacket*>& packets, HMACAuth& hmacAuth);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -13,6 +13,38 @@
 
 #include "udt/Packet.h"
 
+namespace {
+
+// the scheduling class a list of this type gets unless its sender picks one
+udt::PacketList::Priority defaultPriorityForType(PacketType packetType) {
+    switch (packetType) {
+        case PacketType::DomainList:
+        case PacketType::DomainSettings:
+        case PacketType::NodeIgnoreRequest:
+        case PacketType::OctreeDataNack:
+            return udt::PacketList::Priority::Urgent;
+        case PacketType::AvatarIdentity:
+        case PacketType::ReplicatedAvatarIdentity:
+        case PacketType::SetAvatarTraits:
+        case PacketType::AssetMappingOperation:
+        case PacketType::AssetMappingOperationReply:
+        case PacketType::EntityScriptCallMethod:
+        case PacketType::MessagesData:
+        case PacketType::MessagesSubscribe:
+        case PacketType::MessagesUnsubscribe:
+            return udt::PacketList::Priority::High;
+        case PacketType::AssetGetReply:
+        case PacketType::AssetUpload:
+        case PacketType::OctreeDataFileReply:
+        case PacketType::OctreeDataPersist:
+        case PacketType::NodeJsonStats:
+            return udt::PacketList::Priority::Bulk;
+        default:
+            return udt::PacketList::Priority::Normal;
+    }
+}
+
+}
 
 std::unique_ptr<NLPacketList> NLPacketList::create(PacketType packetType, QByteArray extendedHeader,
                                                    bool isReliable, bool isOrdered) {
@@ -25,6 +57,7 @@ std::unique_ptr<NLPacketList> NLPacketList::create(PacketType packetType, QByteA
 NLPacketList::NLPacketList(PacketType packetType, QByteArray extendedHeader, bool isReliable, bool isOrdered) :
     PacketList(packetType, extendedHeader, isReliable, isOrdered)
 {
+    _priority = defaultPriorityForType(packetType);
 }
 
 NLPacketList::NLPacketList(PacketList&& other) : PacketList(std::move(other)) {
@@ -213,7 +213,7 @@ void Node::setConnectionSecret(const QUuid& connectionSecret) {
     }
 
     if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
+        _authenticateHash.reset(new HMACAuth(HMACAuth::SIPHASH));
     }
 
     _connectionSecret = connectionSecret;
@@ -61,6 +61,7 @@ public:
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
     void setConnectionSecret(const QUuid& connectionSecret);
+    // created with the first secret and re-keyed in place after, so other threads can keep hashing with it
     HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
@@ -0,0 +1,245 @@
+//
+//  NodeTable.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeTable.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// Every thread that reads a NodeTable gets a slot holding the epoch it entered in, or 0 while it isn't reading.
+// A snapshot replaced in epoch E can be freed once no slot holds an epoch at or before E.
+const int MAX_READER_SLOTS = 1024;
+
+struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch { 0 };
+    std::atomic<bool> isTaken { false };
+};
+
+ReaderSlot readerSlots[MAX_READER_SLOTS];
+std::atomic<int> numReaderSlotsUsed { 0 };
+std::atomic<int> numReadersWithoutSlot { 0 }; // nothing is freed while these are reading
+std::atomic<uint64_t> globalEpoch { 1 };
+
+const int NO_SLOT_CLAIMED = -1;
+const int NO_SLOT_FREE = -2;
+
+struct ThreadReader {
+    ~ThreadReader() {
+        if (slot >= 0) {
+            readerSlots[slot].isTaken.store(false, std::memory_order_release);
+        }
+    }
+
+    int slot { NO_SLOT_CLAIMED };
+    int depth { 0 }; // guards can nest, only the outermost one enters and leaves the epoch
+};
+
+thread_local ThreadReader threadReader;
+
+void claimReaderSlot() {
+    threadReader.slot = NO_SLOT_FREE;
+    for (int i = 0; i < MAX_READER_SLOTS; ++i) {
+        bool isTaken = false;
+        if (readerSlots[i].isTaken.compare_exchange_strong(isTaken, true, std::memory_order_acquire)) {
+            threadReader.slot = i;
+
+            int used = numReaderSlotsUsed.load();
+            while (used < i + 1 && !numReaderSlotsUsed.compare_exchange_weak(used, i + 1)) {}
+            return;
+        }
+    }
+}
+
+void enterEpoch() {
+    if (threadReader.depth++ > 0) {
+        return;
+    }
+    if (threadReader.slot == NO_SLOT_CLAIMED) {
+        claimReaderSlot();
+    }
+
+    // both sequentially consistent, so that a writer that swapped the snapshot after we loaded it sees our epoch
+    if (threadReader.slot >= 0) {
+        readerSlots[threadReader.slot].epoch.store(globalEpoch.load());
+    } else {
+        numReadersWithoutSlot.fetch_add(1);
+    }
+}
+
+// returns true if the thread is no longer reading
+bool leaveEpoch() {
+    if (--threadReader.depth > 0) {
+        return false;
+    }
+    if (threadReader.slot >= 0) {
+        readerSlots[threadReader.slot].epoch.store(0, std::memory_order_release);
+    } else {
+        numReadersWithoutSlot.fetch_sub(1, std::memory_order_release);
+    }
+    return true;
+}
+
+// a thread that is reading itself can skip its own slot, so that it doesn't wait on itself
+uint64_t getOldestReaderEpoch(bool skipOwnSlot = false) {
+    int ownReadersWithoutSlot = skipOwnSlot && threadReader.depth > 0 && threadReader.slot < 0 ? 1 : 0;
+    if (numReadersWithoutSlot.load() > ownReadersWithoutSlot) {
+        return 0;
+    }
+
+    int ownSlot = skipOwnSlot ? threadReader.slot : NO_SLOT_CLAIMED;
+    uint64_t oldestEpoch = std::numeric_limits<uint64_t>::max();
+    int used = numReaderSlotsUsed.load();
+    for (int i = 0; i < used; ++i) {
+        if (i == ownSlot) {
+            continue;
+        }
+        uint64_t epoch = readerSlots[i].epoch.load();
+        if (epoch != 0 && epoch < oldestEpoch) {
+            oldestEpoch = epoch;
+        }
+    }
+    return oldestEpoch;
+}
+
+}
+
+const SharedNodePointer* NodeTable::Snapshot::find(Node::LocalID localID) const {
+    const auto& page = pages[localID / PAGE_SIZE];
+    if (!page) {
+        return nullptr;
+    }
+    const auto& node = (*page)[localID % PAGE_SIZE];
+    return node ? &node : nullptr;
+}
+
+NodeTable::ReadGuard::ReadGuard(const NodeTable& table) : _table(table) {
+    enterEpoch();
+    _snapshot = table._snapshot.load();
+}
+
+NodeTable::ReadGuard::~ReadGuard() {
+    if (leaveEpoch() && _table._hasRetiredSnapshots.load(std::memory_order_relaxed)) {
+        // don't leave replaced snapshots, and the nodes they hold, waiting for the next write
+        _table.tryReclaim();
+    }
+}
+
+NodeTable::NodeTable() : _snapshot(new Snapshot()) {
+}
+
+NodeTable::~NodeTable() {
+    for (auto& retired : _retiredSnapshots) {
+        delete retired.second;
+    }
+    delete _snapshot.load();
+}
+
+SharedNodePointer NodeTable::nodeWithLocalID(Node::LocalID localID) const {
+    ReadGuard snapshot(*this);
+    auto node = snapshot->find(localID);
+    return node ? *node : SharedNodePointer();
+}
+
+size_t NodeTable::size() const {
+    ReadGuard snapshot(*this);
+    return snapshot->nodes.size();
+}
+
+void NodeTable::setIndexedNode(Snapshot& snapshot, Node::LocalID localID, const SharedNodePointer& node) {
+    auto& page = snapshot.pages[localID / PAGE_SIZE];
+    std::shared_ptr<Page> newPage = page ? std::make_shared<Page>(*page) : std::make_shared<Page>();
+    (*newPage)[localID % PAGE_SIZE] = node;
+    page = std::move(newPage);
+}
+
+void NodeTable::insert(const SharedNodePointer& node) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+
+    std::unique_ptr<Snapshot> snapshot { new Snapshot(*_snapshot.load()) };
+    Node::LocalID localID = node->getLocalID();
+    snapshot->nodes.push_back(node);
+    snapshot->localIDs.push_back(localID);
+    if (localID != Node::NULL_LOCAL_ID) {
+        setIndexedNode(*snapshot, localID, node);
+    }
+
+    publish(std::move(snapshot));
+}
+
+void NodeTable::remove(const SharedNodePointer& node) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+
+    const Snapshot* current = _snapshot.load();
+    auto it = std::find(current->nodes.cbegin(), current->nodes.cend(), node);
+    if (it == current->nodes.cend()) {
+        return;
+    }
+
+    std::unique_ptr<Snapshot> snapshot { new Snapshot(*current) };
+    size_t index = it - current->nodes.cbegin();
+    Node::LocalID localID = snapshot->localIDs[index];
+    snapshot->nodes[index] = std::move(snapshot->nodes.back());
+    snapshot->nodes.pop_back();
+    snapshot->localIDs[index] = snapshot->localIDs.back();
+    snapshot->localIDs.pop_back();
+
+    auto indexedNode = snapshot->find(localID);
+    if (localID != Node::NULL_LOCAL_ID && indexedNode && *indexedNode == node) {
+        // if another node still has this local ID, it can be found by it again
+        auto other = std::find(snapshot->localIDs.cbegin(), snapshot->localIDs.cend(), localID);
+        setIndexedNode(*snapshot, localID, other != snapshot->localIDs.cend() ?
+                       snapshot->nodes[other - snapshot->localIDs.cbegin()] : SharedNodePointer());
+    }
+
+    publish(std::move(snapshot));
+}
+
+void NodeTable::clear() {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    publish(std::unique_ptr<Snapshot>(new Snapshot()));
+}
+
+void NodeTable::publish(std::unique_ptr<Snapshot> snapshot) {
+    const Snapshot* replaced = _snapshot.exchange(snapshot.release());
+    _retiredSnapshots.emplace_back(globalEpoch.fetch_add(1), replaced);
+    _hasRetiredSnapshots.store(true, std::memory_order_relaxed);
+    reclaim();
+}
+
+void NodeTable::reclaim() const {
+    uint64_t oldestReaderEpoch = getOldestReaderEpoch();
+    auto end = std::remove_if(_retiredSnapshots.begin(), _retiredSnapshots.end(), [&](const std::pair<uint64_t, const Snapshot*>& retired) {
+        if (retired.first < oldestReaderEpoch) {
+            delete retired.second;
+            return true;
+        }
+        return false;
+    });
+    _retiredSnapshots.erase(end, _retiredSnapshots.end());
+    _hasRetiredSnapshots.store(!_retiredSnapshots.empty(), std::memory_order_relaxed);
+}
+
+void NodeTable::waitForReaders() const {
+    // readers that entered from here on load a snapshot published before this call or later
+    uint64_t epoch = globalEpoch.load();
+    while (getOldestReaderEpoch(true) < epoch) {
+        std::this_thread::yield();
+    }
+}
+
+void NodeTable::tryReclaim() const {
+    std::unique_lock<std::mutex> lock(_writeMutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+        reclaim();
+    }
+}
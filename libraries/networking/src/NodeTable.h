@@ -0,0 +1,94 @@
+//
+//  NodeTable.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeTable_h
+#define hifi_NodeTable_h
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Node.h"
+
+// The nodes of a LimitedNodeList, in a flat list for iteration and in a table indexed by local ID for the
+// per-packet source lookup.
+// Writers copy the current snapshot, change the copy and publish it.  Readers pin the snapshot that is current
+// with a ReadGuard, which only records the reader's epoch and never takes a lock.  A replaced snapshot is freed
+// once no reader that could have seen it is left, so readers can use the nodes of their snapshot for as long as
+// they hold the guard, even while nodes are being added and killed.
+class NodeTable {
+public:
+    static const int PAGE_SIZE = 256;
+    static const int NUM_PAGES = ((int)std::numeric_limits<Node::LocalID>::max() + 1) / PAGE_SIZE;
+    using Page = std::array<SharedNodePointer, PAGE_SIZE>;
+
+    struct Snapshot {
+        const SharedNodePointer* find(Node::LocalID localID) const;
+
+        std::vector<SharedNodePointer> nodes;
+        std::vector<Node::LocalID> localIDs; // the local ID each node is indexed under, parallel to nodes
+        std::array<std::shared_ptr<const Page>, NUM_PAGES> pages; // pages that don't change are shared between snapshots
+    };
+
+    class ReadGuard {
+    public:
+        ReadGuard(const NodeTable& table);
+        ~ReadGuard();
+
+        const Snapshot& operator*() const { return *_snapshot; }
+        const Snapshot* operator->() const { return _snapshot; }
+
+    private:
+        ReadGuard(const ReadGuard& other) = delete;
+        ReadGuard& operator=(const ReadGuard& other) = delete;
+
+        const NodeTable& _table;
+        const Snapshot* _snapshot;
+    };
+
+    NodeTable();
+    ~NodeTable();
+
+    SharedNodePointer nodeWithLocalID(Node::LocalID localID) const;
+    size_t size() const;
+
+    // indexes the node under its current local ID, a node already indexed under that ID is no longer found by it
+    void insert(const SharedNodePointer& node);
+    void remove(const SharedNodePointer& node);
+    void clear();
+
+    // blocks until every reader that could still see a snapshot from before the call has let go of it, except
+    // for the calling thread's own guards. Must not be called while holding a lock such a reader could wait on.
+    void waitForReaders() const;
+
+private:
+    NodeTable(const NodeTable& other) = delete;
+    NodeTable& operator=(const NodeTable& other) = delete;
+
+    static void setIndexedNode(Snapshot& snapshot, Node::LocalID localID, const SharedNodePointer& node);
+
+    // these require the write mutex
+    void publish(std::unique_ptr<Snapshot> snapshot);
+    void reclaim() const;
+
+    void tryReclaim() const;
+
+    std::atomic<const Snapshot*> _snapshot;
+
+    mutable std::mutex _writeMutex;
+    mutable std::vector<std::pair<uint64_t, const Snapshot*>> _retiredSnapshots; // with the epoch they were replaced in
+    mutable std::atomic<bool> _hasRetiredSnapshots { false };
+};
+
+#endif // hifi_NodeTable_h
@@ -12,6 +12,8 @@
 
 #include "PacketReceiver.h"
 
+#include <thread>
+
 #include <QtCore/QMetaObject>
 #include <QtCore/QMutexLocker>
 
@@ -134,17 +136,70 @@ void PacketReceiver::unregisterListener(QObject* listener) {
     _directlyConnectedObjects.remove(listener);
 }
 
+void PacketReceiver::registerPacketViewQueue(const PacketTypeList& types, PacketViewQueue* queue) {
+    Q_ASSERT_X(queue, "PacketReceiver::registerPacketViewQueue", "No queue to register");
+
+    for (auto type : types) {
+        auto& route = _packetViewRoutes[(size_t)type];
+        route.isSourced = !PacketTypeEnum::getNonSourcedPackets().contains(type);
+        route.headerSize = NLPacket::totalHeaderSize(type);
+
+        qCDebug(networking) << "Registering a packet view queue for packet type" << type;
+        route.queue.store(queue, std::memory_order_release);
+    }
+}
+
+void PacketReceiver::unregisterPacketViewQueue(PacketViewQueue* queue) {
+    Q_ASSERT_X(queue, "PacketReceiver::unregisterPacketViewQueue", "No queue to unregister");
+
+    for (auto& route : _packetViewRoutes) {
+        PacketViewQueue* expected = queue;
+        route.queue.compare_exchange_strong(expected, nullptr);
+    }
+
+    // wait for a packet that was already on its way to the queue
+    while (_packetViewDispatchesInFlight.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+bool PacketReceiver::dispatchPacketView(std::unique_ptr<udt::Packet>& packet) {
+    PacketType type = NLPacket::typeInHeader(*packet);
+    auto& route = _packetViewRoutes[(size_t)type];
+
+    _packetViewDispatchesInFlight.fetch_add(1);
+    PacketViewQueue* queue = route.queue.load();
+    if (!queue) {
+        _packetViewDispatchesInFlight.fetch_sub(1);
+        return false;
+    }
+
+    SharedNodePointer sourceNode;
+    if (route.isSourced) {
+        sourceNode = DependencyManager::get<LimitedNodeList>()->nodeWithLocalID(NLPacket::sourceIDInHeader(*packet));
+    }
+    queue->push(ReceivedPacketView(std::move(packet), type, route.headerSize, std::move(sourceNode)));
+
+    _packetViewDispatchesInFlight.fetch_sub(1);
+    return true;
+}
+
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     // if we're supposed to drop this packet then break out here
     if (_shouldDropPackets) {
         return;
     }
+
+    // packets of fast path types go straight to their queue
+    if (dispatchPacketView(packet)) {
+        return;
+    }
     
     auto nodeList = DependencyManager::get<LimitedNodeList>();
     
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
 
     handleVerifiedMessage(receivedMessage, true);
 }
@@ -157,15 +212,15 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
     QSharedPointer<ReceivedMessage> message;
 
     if (it == _pendingMessages.end()) {
-        // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        // Create message, it takes over the packet's buffer rather than copying it
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
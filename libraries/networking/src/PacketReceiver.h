@@ -13,6 +13,9 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <array>
+#include <atomic>
+#include <limits>
 #include <vector>
 #include <unordered_map>
 
@@ -25,6 +28,7 @@
 
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "PacketViewQueue.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
@@ -75,6 +79,13 @@ public:
     bool registerListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
     void unregisterListener(QObject* listener);
+
+    // Opts packet types in to the fast path: their single packets skip ReceivedMessage and the Qt event queue, and are
+    // pushed as ReceivedPacketViews onto the queue, for the listener to drain from its own thread.
+    // Packets of these types that are part of a larger message still go to the listener registered for the type.
+    void registerPacketViewQueue(const PacketTypeList& types, PacketViewQueue* queue);
+    // once this returns the network thread no longer touches the queue
+    void unregisterPacketViewQueue(PacketViewQueue* queue);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -112,7 +123,14 @@ private:
         bool deliverPending;
     };
 
+    struct PacketViewRoute {
+        std::atomic<PacketViewQueue*> queue { nullptr };
+        bool isSourced { false };
+        int headerSize { 0 };
+    };
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
+    bool dispatchPacketView(std::unique_ptr<udt::Packet>& packet);
 
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
     // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
@@ -130,6 +148,10 @@ private:
     QSet<QObject*> _directlyConnectedObjects;
 
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
+
+    // indexed by packet type, read by the network thread without a lock
+    std::array<PacketViewRoute, std::numeric_limits<std::underlying_type<PacketType>::type>::max() + 1> _packetViewRoutes;
+    std::atomic<int> _packetViewDispatchesInFlight { 0 };
     
     friend class EntityEditPacketSender;
     friend class OctreePacketProcessor;
@@ -0,0 +1,75 @@
+//
+//  PacketViewQueue.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketViewQueue.h"
+
+// Each cell carries a sequence number that tells whose turn it is: a cell at position p can be pushed into when its
+// sequence is p, and popped from when it is p + 1.  Popping hands the cell to the push one lap later.
+
+PacketViewQueue::PacketViewQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    _mask = size - 1;
+    _cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool PacketViewQueue::push(ReceivedPacketView&& view) {
+    size_t position = _pushPosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &_cells[position & _mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            _droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = _pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->view = std::move(view);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    _pushedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool PacketViewQueue::pop(ReceivedPacketView& view) {
+    size_t position = _popPosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &_cells[position & _mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+        if (difference == 0) {
+            if (_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = _popPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    view = std::move(cell->view);
+    cell->sequence.store(position + _mask + 1, std::memory_order_release);
+    return true;
+}
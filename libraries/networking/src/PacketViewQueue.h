@@ -0,0 +1,82 @@
+//
+//  PacketViewQueue.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketViewQueue_h
+#define hifi_PacketViewQueue_h
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "ReceivedPacketView.h"
+
+// A bounded, lock-free queue of received packets, filled by the network thread and drained by a fast path listener
+// from its own thread.  Any number of threads can push and pop, nothing is allocated once the queue is constructed.
+class PacketViewQueue {
+public:
+    static const size_t DEFAULT_CAPACITY = 4096;
+
+    PacketViewQueue(size_t capacity = DEFAULT_CAPACITY); // rounded up to a power of two
+
+    // returns false, and drops the packet, if the queue is full
+    bool push(ReceivedPacketView&& view);
+    bool pop(ReceivedPacketView& view);
+
+    size_t getCapacity() const { return _mask + 1; }
+    uint64_t getPushedCount() const { return _pushedCount.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return _droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        ReceivedPacketView view;
+    };
+
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+
+    // keep the producer and consumer positions on cache lines of their own
+    char _padding0[CACHE_LINE_SIZE];
+    std::atomic<size_t> _pushPosition { 0 };
+    char _padding1[CACHE_LINE_SIZE];
+    std::atomic<size_t> _popPosition { 0 };
+    char _padding2[CACHE_LINE_SIZE];
+
+    std::atomic<uint64_t> _pushedCount { 0 };
+    std::atomic<uint64_t> _droppedCount { 0 };
+};
+
+// The time fast path packets took once they were received, summed by their handler over a stats period
+struct PacketViewTimings {
+    uint64_t numPackets { 0 };
+    uint64_t endToEndUsecs { 0 }; // from the network thread to the end of handling
+    uint64_t handlingUsecs { 0 }; // spent handling, on whichever threads did
+
+    void add(p_high_resolution_clock::time_point receiveTime, p_high_resolution_clock::time_point handleStart,
+             p_high_resolution_clock::time_point handleEnd) {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        ++numPackets;
+        endToEndUsecs += duration_cast<microseconds>(handleEnd - receiveTime).count();
+        handlingUsecs += duration_cast<microseconds>(handleEnd - handleStart).count();
+    }
+
+    PacketViewTimings& operator+=(const PacketViewTimings& other) {
+        numPackets += other.numPackets;
+        endToEndUsecs += other.endToEndUsecs;
+        handlingUsecs += other.handlingUsecs;
+        return *this;
+    }
+};
+
+#endif // hifi_PacketViewQueue_h
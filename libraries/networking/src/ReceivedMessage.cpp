@@ -13,9 +13,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 
 #include "QSharedPointer"
 
+#include "ReceivedPacketView.h"
+
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
 int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<ReceivedMessage>>("QSharedPointer<ReceivedMessage>");
 
@@ -24,34 +27,45 @@ static const int HEAD_DATA_SIZE = 512;
 using namespace std::chrono;
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
-    : _data(packetList.getMessage()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(packetList.getNumPackets()),
+    : _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr())
 {
+    appendSegment(packetList.getMessage());
+    _headData = copyRange(0, std::min<qint64>(_size, HEAD_DATA_SIZE));
     _firstPacketReceiveTime = duration_cast<microseconds>(packetList.getFirstPacketReceiveTime().time_since_epoch()).count();
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
-    : _data(packet.readAll()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(1),
+    : _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
       _packetVersion(packet.getVersion()),
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    appendSegment(packet.readAll());
+    _headData = copyRange(0, std::min<qint64>(_size, HEAD_DATA_SIZE));
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 }
 
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    _firstPacketReceiveTime = duration_cast<microseconds>(packet->getReceiveTime().time_since_epoch()).count();
+    appendSegment(std::move(packet));
+    _headData = copyRange(0, std::min<qint64>(_size, HEAD_DATA_SIZE));
+}
+
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                 const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID) :
-    _data(byteArray),
-    _headData(_data.mid(0, HEAD_DATA_SIZE)),
     _numPackets(1),
     _firstPacketReceiveTime(0),
     _sourceID(sourceID),
@@ -60,6 +74,45 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
     _senderSockAddr(senderSockAddr),
     _isComplete(true)
 {
+    appendSegment(byteArray);
+    _headData = copyRange(0, std::min<qint64>(_size, HEAD_DATA_SIZE));
+}
+
+ReceivedMessage::ReceivedMessage(ReceivedPacketView& view) {
+    reset(view);
+}
+
+void ReceivedMessage::reset(ReceivedPacketView& view) {
+    Q_ASSERT(view.isValid());
+
+    _numPackets = 1;
+    _firstPacketReceiveTime = duration_cast<microseconds>(view.getReceiveTime().time_since_epoch()).count();
+    _sourceID = view.getSourceID();
+    _packetType = view.getType();
+    _packetVersion = view.getVersion();
+    _senderSockAddr = view.getSenderSockAddr();
+    _isComplete = true;
+    _failed = false;
+    _position = 0;
+
+    const char* data = view.getPayload();
+    qint64 size = std::max<qint64>(view.getPayloadSize(), 0);
+    {
+        QMutexLocker locker(&_flattenLock);
+        _segments.clear();
+        _retiredSegments.clear();
+        _lastSegmentIndex = 0;
+        _hasLentData = false;
+        if (size > 0) {
+            _segments.push_back({ 0, size, data, view.takePacket(), QByteArray() });
+        }
+        _size = size;
+    }
+
+    // the head goes in the buffer the last one was in
+    qint64 headSize = std::min<qint64>(size, HEAD_DATA_SIZE);
+    _headData.resize((int)headSize);
+    copyOut(0, _headData.data(), headSize);
 }
 
 void ReceivedMessage::setFailed() {
@@ -68,25 +121,61 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
+void ReceivedMessage::appendSegment(QByteArray bytes) {
+    if (bytes.isEmpty()) {
+        return;
+    }
+    qint64 size = bytes.size();
+    const char* data = bytes.constData();
+    QMutexLocker locker(&_flattenLock);
+    _segments.push_back({ _size, size, data, nullptr, std::move(bytes) });
+    _size += size;
+}
+
+void ReceivedMessage::appendSegment(std::unique_ptr<NLPacket> packet) {
+    // the payload starts at the packet's read position, like readAll() would
+    qint64 size = packet->bytesLeftToRead();
+    if (size <= 0) {
+        return;
+    }
+    const char* data = packet->getPayload() + packet->pos();
+    QMutexLocker locker(&_flattenLock);
+    _segments.push_back({ _size, size, data, std::move(packet), QByteArray() });
+    _size += size;
+}
+
 void ReceivedMessage::appendPacket(NLPacket& packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
+    appendSegment(QByteArray(packet.getPayload(), packet.getPayloadSize()));
+    packetAppended(packet.getPacketPosition(), packet.getReceiveTime());
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
+               "We should not be appending to a complete message");
+
+    auto packetPosition = packet->getPacketPosition();
+    auto receiveTime = packet->getReceiveTime();
+    appendSegment(std::move(packet));
+    packetAppended(packetPosition, receiveTime);
+}
+
+void ReceivedMessage::packetAppended(NLPacket::PacketPosition packetPosition,
+                                     p_high_resolution_clock::time_point receiveTime) {
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
-
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
 
-    auto packetPosition = packet.getPacketPosition();
     if ((packetPosition == NLPacket::PacketPosition::FIRST) ||
         (packetPosition == NLPacket::PacketPosition::ONLY)) {
-        _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
+        _firstPacketReceiveTime = duration_cast<microseconds>(receiveTime.time_since_epoch()).count();
     }
 
     if (packetPosition == NLPacket::PacketPosition::LAST) {
@@ -95,17 +184,108 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 }
 
+int ReceivedMessage::getNumSegments() const {
+    QMutexLocker locker(&_flattenLock);
+    return (int)_segments.size();
+}
+
+const ReceivedMessage::Segment& ReceivedMessage::findSegment(qint64 position) const {
+    Q_ASSERT(position >= 0 && position < _size);
+
+    // reads are mostly sequential, so try the segment we used last and the one after it before searching
+    for (size_t index = _lastSegmentIndex; index < _segments.size() && index <= _lastSegmentIndex + 1; ++index) {
+        const auto& segment = _segments[index];
+        if (position >= segment.offset && position < segment.offset + segment.size) {
+            _lastSegmentIndex = index;
+            return segment;
+        }
+    }
+
+    auto it = std::upper_bound(_segments.begin(), _segments.end(), position, [](qint64 value, const Segment& segment) {
+        return value < segment.offset;
+    });
+    --it;
+    _lastSegmentIndex = it - _segments.begin();
+    return *it;
+}
+
+void ReceivedMessage::copyOut(qint64 position, char* data, qint64 size) const {
+    while (size > 0) {
+        const auto& segment = findSegment(position);
+        qint64 segmentPosition = position - segment.offset;
+        qint64 sizeCopied = std::min(size, segment.size - segmentPosition);
+        memcpy(data, segment.data + segmentPosition, sizeCopied);
+        data += sizeCopied;
+        position += sizeCopied;
+        size -= sizeCopied;
+    }
+}
+
+QByteArray ReceivedMessage::copyRange(qint64 position, qint64 size) const {
+    size = std::min(size, _size - position);
+    if (size <= 0 || position < 0) {
+        return QByteArray();
+    }
+
+    const auto& segment = findSegment(position);
+    if (!segment.packet && position == segment.offset && size == segment.size) {
+        // the range is exactly a buffer we already own, share it
+        return segment.bytes;
+    }
+
+    QByteArray bytes(size, Qt::Uninitialized);
+    copyOut(position, bytes.data(), size);
+    return bytes;
+}
+
+void ReceivedMessage::flatten() const {
+    QMutexLocker locker(&_flattenLock);
+
+    if (_segments.size() == 1 && !_segments.front().packet) {
+        return;
+    }
+
+    QByteArray bytes(_size, Qt::Uninitialized);
+    for (const auto& segment : _segments) {
+        memcpy(bytes.data() + segment.offset, segment.data, segment.size);
+    }
+
+    // the joined buffer replaces the chain, letting go of the packets unless data lent out still points into them
+    if (_hasLentData) {
+        std::move(_segments.begin(), _segments.end(), std::back_inserter(_retiredSegments));
+    }
+    _segments.clear();
+    _segments.push_back({ 0, bytes.size(), bytes.constData(), nullptr, bytes });
+    _lastSegmentIndex = 0;
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    flatten();
+    return _segments.front().bytes;
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    {
+        QMutexLocker locker(&_flattenLock);
+        if (_segments.size() == 1) {
+            // a single segment is already contiguous, even when it is a packet's buffer
+            _hasLentData = true;
+            return _segments.front().data;
+        }
+    }
+    flatten();
+    _hasLentData = true;
+    return _segments.front().data;
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    qint64 sizeRead = std::max<qint64>(std::min(size, getBytesLeftToRead()), 0);
+    copyOut(_position, data, sizeRead);
     return sizeRead;
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    qint64 sizeRead = peek(data, size);
     _position += sizeRead;
     return sizeRead;
 }
@@ -119,11 +299,11 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    return copyRange(_position, size);
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = copyRange(_position, size);
     _position += size;
     return data;
 }
@@ -142,17 +322,74 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
-    _position += size;
+    auto string = QString::fromUtf8(referenceRange(size));
     return string;
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    auto data = referenceRange(size);
+    _hasLentData = true;
+    return data;
+}
+
+// Reads a range of the message as a reference into its buffers, for data that is used before the message is read again
+QByteArray ReceivedMessage::referenceRange(qint64 size) {
+    size = std::max<qint64>(std::min(size, getBytesLeftToRead()), 0);
+    if (size == 0) {
+        return QByteArray();
+    }
+
+    const Segment* segment = &findSegment(_position);
+    if (_position + size > segment->offset + segment->size) {
+        // the range crosses into the next segment, it can only be referenced once the message is in one buffer
+        flatten();
+        segment = &_segments.front();
+    }
+
+    QByteArray data { QByteArray::fromRawData(segment->data + (_position - segment->offset), size) };
     _position += size;
     return data;
 }
 
+qint64 ReceivedMessage::readSegments(qint64 size, const SegmentReader& reader) {
+    size = std::max<qint64>(std::min(size, getBytesLeftToRead()), 0);
+
+    qint64 position = _position;
+    qint64 end = position + size;
+    while (position < end) {
+        const auto& segment = findSegment(position);
+        qint64 segmentPosition = position - segment.offset;
+        qint64 sizeRead = std::min(end - position, segment.size - segmentPosition);
+        reader(segment.data + segmentPosition, sizeRead);
+        position += sizeRead;
+    }
+
+    _position = end;
+    return size;
+}
+
+qint64 ReceivedMessage::readArrived(const SegmentReader& reader) {
+    // take what arrived out of the chain, and read it without holding up the packets still arriving
+    std::deque<Segment> arrived;
+    {
+        QMutexLocker locker(&_flattenLock);
+        arrived.swap(_segments);
+        _lastSegmentIndex = 0;
+    }
+
+    qint64 sizeRead = 0;
+    for (const auto& segment : arrived) {
+        // skip what was already read, like a header read with readHead()
+        qint64 segmentPosition = std::max<qint64>(_position - segment.offset, 0);
+        if (segmentPosition < segment.size) {
+            reader(segment.data + segmentPosition, segment.size - segmentPosition);
+            sizeRead += segment.size - segmentPosition;
+            _position = segment.offset + segment.size;
+        }
+    }
+    return sizeRead;
+}
+
 void ReceivedMessage::onComplete() {
     _isComplete = true;
     emit completed();
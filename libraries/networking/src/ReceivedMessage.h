@@ -13,22 +13,45 @@
 #define hifi_ReceivedMessage_h
 
 #include <QByteArray>
+#include <QMutex>
 #include <QObject>
 
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "NLPacketList.h"
 
+class ReceivedPacketView;
+
+// A message is kept as a chain of segments, one per packet it arrived in, so that assembling a large message
+// neither copies nor reallocates.  read() and peek() copy straight out of the chain, and readSegments() hands the
+// segments to a consumer without copying at all.  Asking for the message as one contiguous buffer (getMessage(),
+// getRawMessage(), or readWithoutCopy() across a segment boundary) joins the chain into one buffer, once.
+// Apart from readHead() and readArrived(), a message should only be read once it is complete.
 class ReceivedMessage : public QObject {
     Q_OBJECT
 public:
+    using SegmentReader = std::function<void(const char* data, qint64 size)>;
+
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    // takes over the packet, its payload becomes the first segment of the message without being copied
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
+    // takes over the packet of the view, like reset()
+    ReceivedMessage(ReceivedPacketView& view);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // Makes this the message of the packet of the view, taken over without a copy, so that a handler of a stream of
+    // single packets can parse them all with one message instead of allocating one each.  Data read from the
+    // message without a copy before is no longer valid.
+    void reset(ReceivedPacketView& view);
+
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -36,6 +59,7 @@ public:
     void setFailed();
 
     void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -50,9 +74,12 @@ public:
 
     qint64 getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
+
+    qint64 getBytesLeftToRead() const { return _size -  _position; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    // Get the number of separate buffers the message is currently held in
+    int getNumSegments() const;
 
     void seek(qint64 position) { _position = position; }
 
@@ -76,6 +103,16 @@ public:
     // exceed that of the ReceivedMessage.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Streams the next size bytes of the message to reader, one segment at a time, without copying them.
+    // The data passed to reader is only valid for the duration of the call. Returns the number of bytes read.
+    qint64 readSegments(qint64 size, const SegmentReader& reader);
+
+    // Streams the bytes that arrived since the last call, from the read position on, to reader and lets go of them,
+    // so that a large message delivered while pending never has to be held whole.  Safe to call from any thread
+    // while packets are being appended, but once it was called the message can only be read with readHead() and
+    // readArrived().  Returns the number of bytes read.
+    qint64 readArrived(const SegmentReader& reader);
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -89,7 +126,34 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    struct Segment {
+        qint64 offset; // position of the first byte of the segment in the message
+        qint64 size;
+        const char* data;
+        std::unique_ptr<udt::Packet> packet; // owns the data of a segment taken over from a packet
+        QByteArray bytes; // owns the data of any other segment
+    };
+
+    void appendSegment(QByteArray bytes);
+    void appendSegment(std::unique_ptr<NLPacket> packet);
+    void packetAppended(NLPacket::PacketPosition packetPosition, p_high_resolution_clock::time_point receiveTime);
+
+    const Segment& findSegment(qint64 position) const;
+    void copyOut(qint64 position, char* data, qint64 size) const;
+    QByteArray copyRange(qint64 position, qint64 size) const;
+    QByteArray referenceRange(qint64 size);
+    void flatten() const;
+
+    // the chain is only changed by appending, by flatten() once the message is being read, or by readArrived()
+    mutable std::deque<Segment> _segments;
+    mutable size_t _lastSegmentIndex { 0 };
+    mutable QMutex _flattenLock;
+
+    // once data was handed out without a copy, flatten() keeps the segments it replaces for the life of the message
+    mutable std::atomic<bool> _hasLentData { false };
+    mutable std::vector<Segment> _retiredSegments;
+    std::atomic<qint64> _size { 0 };
+
     QByteArray _headData;
 
     std::atomic<qint64> _position { 0 };
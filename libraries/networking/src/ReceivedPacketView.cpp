@@ -0,0 +1,32 @@
+//
+//  ReceivedPacketView.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedPacketView.h"
+
+#include "ReceivedMessage.h"
+
+ReceivedPacketView::ReceivedPacketView(std::unique_ptr<udt::Packet> packet, PacketType type, int headerSize,
+                                       SharedNodePointer sourceNode) :
+    _packet(std::move(packet)),
+    _type(type),
+    _headerSize(headerSize),
+    _sourceNode(std::move(sourceNode))
+{
+}
+
+NLPacket::LocalID ReceivedPacketView::getSourceID() const {
+    return PacketTypeEnum::getNonSourcedPackets().contains(_type) ? NLPacket::NULL_LOCAL_ID : NLPacket::sourceIDInHeader(*_packet);
+}
+
+QSharedPointer<ReceivedMessage> ReceivedPacketView::toReceivedMessage() {
+    Q_ASSERT(_packet);
+    return QSharedPointer<ReceivedMessage>::create(NLPacket::fromBase(std::move(_packet)));
+}
@@ -0,0 +1,63 @@
+//
+//  ReceivedPacketView.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedPacketView_h
+#define hifi_ReceivedPacketView_h
+
+#include <memory>
+
+#include "NLPacket.h"
+#include "Node.h"
+
+class ReceivedMessage;
+
+// A single received packet, as handed to fast path listeners through a PacketViewQueue
+// (see PacketReceiver::registerPacketViewQueue).  Unlike a ReceivedMessage it is neither a QObject nor reference
+// counted: it owns the packet and reads the payload where the packet was received into.
+class ReceivedPacketView {
+public:
+    ReceivedPacketView() {}
+    ReceivedPacketView(std::unique_ptr<udt::Packet> packet, PacketType type, int headerSize, SharedNodePointer sourceNode);
+
+    ReceivedPacketView(ReceivedPacketView&& other) = default;
+    ReceivedPacketView& operator=(ReceivedPacketView&& other) = default;
+
+    bool isValid() const { return (bool)_packet; }
+
+    PacketType getType() const { return _type; }
+    PacketVersion getVersion() const { return NLPacket::versionInHeader(*_packet); }
+    NLPacket::LocalID getSourceID() const;
+    const SharedNodePointer& getSourceNode() const { return _sourceNode; }
+
+    const HifiSockAddr& getSenderSockAddr() const { return _packet->getSenderSockAddr(); }
+    p_high_resolution_clock::time_point getReceiveTime() const { return _packet->getReceiveTime(); }
+
+    const char* getPayload() const { return _packet->getData() + _headerSize; }
+    qint64 getPayloadSize() const { return _packet->getDataSize() - _headerSize; }
+
+    // hands the packet over to a ReceivedMessage, for handlers that parse one, which leaves the view empty.  Handlers
+    // of many views should rather reuse one message with ReceivedMessage::reset().
+    QSharedPointer<ReceivedMessage> toReceivedMessage();
+
+    // hands the packet over, which leaves the view empty
+    std::unique_ptr<udt::Packet> takePacket() { return std::move(_packet); }
+
+private:
+    ReceivedPacketView(const ReceivedPacketView& other) = delete;
+    ReceivedPacketView& operator=(const ReceivedPacketView& other) = delete;
+
+    std::unique_ptr<udt::Packet> _packet;
+    PacketType _type { PacketType::Unknown };
+    int _headerSize { 0 };
+    SharedNodePointer _sourceNode;
+};
+
+#endif // hifi_ReceivedPacketView_h
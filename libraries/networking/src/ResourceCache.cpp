@@ -29,15 +29,139 @@
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+const qint64 ResourceCacheSharedItems::BANDWIDTH_REQUEST_BYTES_LIMIT = -1;
+const qint64 ResourceCacheSharedItems::NO_REQUEST_BYTES_LIMIT = 0;
+
+// requests go through whatever their sizes until this many are in flight, and past the request limit up to this many
+// times it
+static const uint32_t MIN_REQUEST_LIMIT = 2;
+static const uint32_t SMALL_REQUESTS_LIMIT_FACTOR = 4;
+static const qint64 LARGE_REQUEST_BYTES = 512 * 1024;
+static const quint64 BANDWIDTH_WINDOW_USECS = 100 * USECS_PER_MSEC;
+static const quint64 BANDWIDTH_SAMPLE_USECS = 250 * USECS_PER_MSEC;
+// the bandwidth measured goes up with the first sample that is higher, and down slowly
+static const float BANDWIDTH_SAMPLE_WEIGHT = 0.25f;
+static const float LATENCY_SAMPLE_WEIGHT = 0.1f;
+static const float REQUEST_BYTES_SAMPLE_WEIGHT = 0.1f;
+
+bool ResourceCacheSharedItems::PendingKey::operator<(const PendingKey& other) const {
+    // highest first
+    if (isFile != other.isFile) {
+        return isFile;
+    }
+    if (priority != other.priority) {
+        return priority > other.priority;
+    }
+    return order > other.order;
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    if (canStartRequest()) {
+        auto now = usecTimestampNow();
+        if (_loadingRequests.isEmpty()) {
+            _sampleStart = now;
+            _sampleBytes = 0;
+        }
+        LoadingRequest request;
+        request.resource = resource;
+        request.startTime = now;
+        _loadingRequests.append(request);
         return true;
-    } else {
-        _pendingRequests.append(resource);
+    }
+
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+    // a resource freed while pending can leave its key to one allocated at the same address
+    removePendingRequest(locked.data());
+    PendingKey key { locked->getURL().scheme() == HIFI_URL_SCHEME_FILE, locked->getLoadPriority(), _nextPendingOrder++ };
+    _pendingRequests[key] = { resource, locked.data() };
+    _pendingKeys.insert(locked.data(), key);
+    return false;
+}
+
+void ResourceCacheSharedItems::reprioritizeRequest(QSharedPointer<Resource> resource) {
+    Lock lock(_mutex);
+    auto keyIter = _pendingKeys.find(resource.data());
+    if (keyIter == _pendingKeys.end()) {
+        return;
+    }
+
+    auto iter = _pendingRequests.find(keyIter.value());
+    if (iter == _pendingRequests.end() || iter->second.resource.data() != resource.data()) {
+        removePendingRequest(resource.data());
+        return;
+    }
+
+    PendingKey key = keyIter.value();
+    key.priority = resource->getLoadPriority();
+    auto request = iter->second;
+    _pendingRequests.erase(iter);
+    _pendingRequests[key] = request;
+    keyIter.value() = key;
+}
+
+void ResourceCacheSharedItems::removePendingRequest(Resource* resource) {
+    auto keyIter = _pendingKeys.find(resource);
+    if (keyIter != _pendingKeys.end()) {
+        _pendingRequests.erase(keyIter.value());
+        _pendingKeys.erase(keyIter);
+    }
+}
+
+void ResourceCacheSharedItems::updateRequestProgress(QWeakPointer<Resource> resource, qint64 bytesReceived,
+                                                     qint64 bytesTotal) {
+    Lock lock(_mutex);
+    auto now = usecTimestampNow();
+    for (auto& request : _loadingRequests) {
+        if (request.resource.data() == resource.data()) {
+            if (request.bytesTotal == 0 && bytesTotal > 0) {
+                auto latency = now - request.startTime;
+                _latencyUsecs = _latencyUsecs == 0 ? latency :
+                    (quint64)glm::mix((float)_latencyUsecs, (float)latency, LATENCY_SAMPLE_WEIGHT);
+            }
+            // a resource can make another request, for more of its data
+            _sampleBytes += bytesReceived >= request.bytesReceived ? bytesReceived - request.bytesReceived : bytesReceived;
+            request.bytesReceived = bytesReceived;
+            request.bytesTotal = bytesTotal;
+            break;
+        }
+    }
+
+    if (now - _sampleStart >= BANDWIDTH_SAMPLE_USECS) {
+        qint64 bytesPerSecond = _sampleBytes * (qint64)USECS_PER_SECOND / (qint64)(now - _sampleStart);
+        _bytesPerSecond = std::max(bytesPerSecond,
+            (qint64)glm::mix((float)_bytesPerSecond, (float)bytesPerSecond, BANDWIDTH_SAMPLE_WEIGHT));
+        _sampleStart = now;
+        _sampleBytes = 0;
+    }
+}
+
+bool ResourceCacheSharedItems::canStartRequest() const {
+    Lock lock(_mutex);
+    uint32_t numLoading = (uint32_t)_loadingRequests.size();
+    if (_requestBytesLimit == NO_REQUEST_BYTES_LIMIT) {
+        return numLoading < _requestLimit;
+    }
+    if (numLoading < std::min(MIN_REQUEST_LIMIT, _requestLimit)) {
+        return true;
+    }
+
+    float numSlots = 0.0f;
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        qint64 bytesLeft = request.bytesTotal - request.bytesReceived;
+        numSlots += request.bytesTotal > 0 ? std::max(1.0f, (float)bytesLeft / LARGE_REQUEST_BYTES) : 1.0f;
+    }
+    if (numSlots + 1.0f <= _requestLimit) {
+        return true;
+    }
+
+    if (numLoading >= _requestLimit * SMALL_REQUESTS_LIMIT_FACTOR) {
         return false;
     }
+    return getLoadingRequestsBytes() + _averageRequestBytes <= getCurrentRequestBytesLimit();
 }
 
 void ResourceCacheSharedItems::setRequestLimit(uint32_t limit) {
@@ -50,12 +174,31 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setRequestBytesLimit(qint64 limit) {
+    Lock lock(_mutex);
+    _requestBytesLimit = limit;
+}
+
+qint64 ResourceCacheSharedItems::getRequestBytesLimit() const {
+    Lock lock(_mutex);
+    return _requestBytesLimit;
+}
+
+qint64 ResourceCacheSharedItems::getCurrentRequestBytesLimit() const {
+    if (_requestBytesLimit != BANDWIDTH_REQUEST_BYTES_LIMIT) {
+        return _requestBytesLimit;
+    }
+    // until the bandwidth is known, as many requests as the limit of an average size
+    quint64 usecs = _latencyUsecs + BANDWIDTH_WINDOW_USECS;
+    return std::max(_requestLimit * DEFAULT_REQUEST_BYTES, _bytesPerSecond * (qint64)usecs / (qint64)USECS_PER_SECOND);
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
+    for (auto& request : _pendingRequests) {
+        auto locked = request.second.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -66,15 +209,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingRequests.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -88,6 +231,16 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+qint64 ResourceCacheSharedItems::getLoadingRequestsBytes() const {
+    Lock lock(_mutex);
+    qint64 bytes = 0;
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        bytes += request.bytesTotal > 0 ? std::max(request.bytesTotal - request.bytesReceived, (qint64)0) :
+            _averageRequestBytes;
+    }
+    return bytes;
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
 
@@ -95,9 +248,13 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto& request = _loadingRequests.at(i);
         // Clear our resource and any freed resources
-        if (!request || request.data() == resource.data()) {
+        if (!request.resource || request.resource.data() == resource.data()) {
+            if (request.bytesTotal > 0) {
+                _averageRequestBytes = (qint64)glm::mix((float)_averageRequestBytes, (float)request.bytesTotal,
+                                                        REQUEST_BYTES_SAMPLE_WEIGHT);
+            }
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -106,44 +263,40 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    bool currentHighestIsFile = false;
+    while (!_pendingRequests.empty()) {
+        auto iter = _pendingRequests.begin();
+        PendingKey key = iter->first;
+        auto request = iter->second;
+        _pendingRequests.erase(iter);
+        _pendingKeys.remove(request.key);
 
-    for (int i = 0; i < _pendingRequests.size();) {
         // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
             continue;
         }
 
-        // Check load priority
+        // a priority only changes without the request being moved when one of its owners is freed, which can only
+        // lower it, so the first request whose priority is still the same is the highest
         float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        if (priority != key.priority) {
+            key.priority = priority;
+            _pendingRequests[key] = request;
+            _pendingKeys.insert(request.key, key);
+            continue;
         }
-        i++;
-    }
-
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+        return resource;
     }
 
-    return highestResource;
+    return QSharedPointer<Resource>();
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
+    _pendingKeys.clear();
     _loadingRequests.clear();
 }
 
@@ -345,8 +498,10 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     sharedItems->setRequestLimit(limit);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+    while (sharedItems->canStartRequest() && sharedItems->getPendingRequestsCount() > 0) {
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -547,8 +702,10 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+    while (sharedItems->canStartRequest() && sharedItems->getPendingRequestsCount() > 0) {
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -607,6 +764,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        reprioritize();
     }
 }
 
@@ -618,11 +776,20 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    reprioritize();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        reprioritize();
+    }
+}
+
+void Resource::reprioritize() {
+    auto self = _self.lock();
+    if (self && !_loaded && DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->reprioritizeRequest(self);
     }
 }
 
@@ -774,6 +941,7 @@ void Resource::makeRequest() {
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
+    DependencyManager::get<ResourceCacheSharedItems>()->updateRequestProgress(_self, bytesReceived, bytesTotal);
 }
 
 void Resource::handleReplyFinished() {
@@ -13,6 +13,7 @@
 #define hifi_ResourceCache_h
 
 #include <atomic>
+#include <map>
 #include <mutex>
 
 #include <QtCore/QHash>
@@ -59,6 +60,12 @@ static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
 // object instead
+//
+// Pending requests are kept ordered by priority, file URLs first, so the highest is found without going through them
+// all; resources whose priority is set while pending are moved in place.  Requests in flight take a slot of the
+// request limit each, and large ones a slot per LARGE_REQUEST_BYTES they have left, so fewer large requests share the
+// link at once.  Past the limit, more requests are let through while those in flight have less left to download than
+// the link downloads in its latency and a tenth of a second, so small requests don't wait on each other's latency.
 class ResourceCacheSharedItems : public Dependency  {
     SINGLETON_DEPENDENCY
 
@@ -66,25 +73,69 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
+    // request bytes limits: following the bandwidth measured, or none, letting through the request limit whatever
+    // the sizes of the requests
+    static const qint64 BANDWIDTH_REQUEST_BYTES_LIMIT;
+    static const qint64 NO_REQUEST_BYTES_LIMIT;
+
     bool appendRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
+    // moves a pending request to where its load priority now puts it
+    void reprioritizeRequest(QSharedPointer<Resource> request);
+    void updateRequestProgress(QWeakPointer<Resource> request, qint64 bytesReceived, qint64 bytesTotal);
+    bool canStartRequest() const;
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    void setRequestBytesLimit(qint64 limit);
+    qint64 getRequestBytesLimit() const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
     uint32_t getLoadingRequestsCount() const;
+    qint64 getLoadingRequestsBytes() const;
     void clear();
 
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingKey {
+        bool isFile;
+        float priority;
+        uint64_t order; // among equal priorities, the latest request goes first
+
+        bool operator<(const PendingKey& other) const;
+    };
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key; // to find it once the resource is freed
+    };
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        quint64 startTime { 0 };
+        qint64 bytesReceived { 0 };
+        qint64 bytesTotal { 0 }; // 0 until the response tells
+    };
+
+    void removePendingRequest(Resource* resource);
+    qint64 getCurrentRequestBytesLimit() const;
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    std::map<PendingKey, PendingRequest> _pendingRequests;
+    QHash<Resource*, PendingKey> _pendingKeys;
+    uint64_t _nextPendingOrder { 0 };
+    QList<LoadingRequest> _loadingRequests;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    qint64 _requestBytesLimit { BANDWIDTH_REQUEST_BYTES_LIMIT };
+
+    // what requests whose sizes aren't known yet are counted as
+    const qint64 DEFAULT_REQUEST_BYTES = 64 * 1024;
+    qint64 _averageRequestBytes { DEFAULT_REQUEST_BYTES };
+    qint64 _bytesPerSecond { 0 }; // measured while requests are in flight
+    quint64 _latencyUsecs { 0 }; // until responses start
+    quint64 _sampleStart { 0 };
+    qint64 _sampleBytes { 0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -562,6 +613,7 @@ private:
     
     void retry();
     void reinsert();
+    void reprioritize();
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
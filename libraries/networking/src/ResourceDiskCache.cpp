@@ -0,0 +1,208 @@
+//
+//  ResourceDiskCache.cpp
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceDiskCache.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLocale>
+#include <QtCore/QSaveFile>
+
+#include <NumericalConstants.h>
+
+#include "AssetUtils.h"
+#include "NetworkLogging.h"
+
+const char* ResourceDiskCache::SETTING_MAX_SIZE_NAME = "hifi.resource_cache.max_size_mb";
+const int ResourceDiskCache::DEFAULT_MAX_SIZE_MB = 10 * 1024;
+
+static const std::string DATA_EXT = "data";
+static const QString ENTRIES_DIRNAME = "entries";
+static const QString ENTRY_EXT = ".json";
+
+// responses that only have a Last-Modified are fresh for a tenth of their age, up to a day, like browsers do
+static const qint64 MAX_HEURISTIC_FRESHNESS_MSECS = 24 * 60 * 60 * MSECS_PER_SECOND;
+
+static const QByteArray MAX_AGE_DIRECTIVE = "max-age=";
+
+static const QString URL_KEY = "url";
+static const QString HASH_KEY = "hash";
+static const QString ETAG_KEY = "etag";
+static const QString LAST_MODIFIED_KEY = "lastModified";
+static const QString CONTENT_TYPE_KEY = "contentType";
+static const QString FRESH_UNTIL_KEY = "freshUntil";
+
+static QDateTime parseHttpDate(const QByteArray& date) {
+    auto dateTime = QLocale::c().toDateTime(QString::fromLatin1(date).trimmed(), "ddd, dd MMM yyyy hh:mm:ss 'GMT'");
+    dateTime.setTimeSpec(Qt::UTC);
+    return dateTime;
+}
+
+static bool readEntry(const QString& path, QString& url, ResourceDiskCache::HTTPEntry& entry) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    auto object = QJsonDocument::fromJson(file.readAll()).object();
+    url = object[URL_KEY].toString();
+    entry.hash = object[HASH_KEY].toString();
+    entry.etag = object[ETAG_KEY].toString().toLatin1();
+    entry.lastModified = object[LAST_MODIFIED_KEY].toString().toLatin1();
+    entry.contentType = object[CONTENT_TYPE_KEY].toString().toLatin1();
+    entry.freshUntil = (qint64)object[FRESH_UNTIL_KEY].toDouble();
+    return AssetUtils::isValidHash(entry.hash);
+}
+
+qint64 ResourceDiskCache::getFreshnessLifetime(const QByteArray& cacheControl, const QByteArray& expires,
+                                               const QByteArray& date, const QByteArray& lastModified) {
+    bool isNoCache = false;
+    qint64 maxAge = -1;
+    for (auto directive : cacheControl.split(',')) {
+        directive = directive.trimmed().toLower();
+        if (directive == "no-store") {
+            return -1;
+        } else if (directive == "no-cache") {
+            isNoCache = true;
+        } else if (directive.startsWith(MAX_AGE_DIRECTIVE)) {
+            bool ok;
+            qint64 seconds = directive.mid(MAX_AGE_DIRECTIVE.size()).toLongLong(&ok);
+            if (ok) {
+                maxAge = std::max(seconds, (qint64)0) * (qint64)MSECS_PER_SECOND;
+            }
+        }
+    }
+    if (isNoCache) {
+        return 0;
+    }
+    if (maxAge >= 0) {
+        return maxAge;
+    }
+
+    auto responseDate = parseHttpDate(date);
+    if (!responseDate.isValid()) {
+        responseDate = QDateTime::currentDateTimeUtc();
+    }
+
+    if (!expires.isEmpty()) {
+        // an Expires that isn't a date, like 0, means the response is already stale
+        auto expiresDate = parseHttpDate(expires);
+        return expiresDate.isValid() ? std::max(responseDate.msecsTo(expiresDate), (qint64)0) : 0;
+    }
+
+    auto lastModifiedDate = parseHttpDate(lastModified);
+    if (lastModifiedDate.isValid()) {
+        return std::min(std::max(lastModifiedDate.msecsTo(responseDate), (qint64)0) / 10, MAX_HEURISTIC_FRESHNESS_MSECS);
+    }
+    return 0;
+}
+
+ResourceDiskCache::ResourceDiskCache(const std::string& dir) :
+    FileCache(dir, DATA_EXT),
+    _entriesPath(QDir(QString::fromStdString(getDirpath())).filePath(ENTRIES_DIRNAME))
+{
+
+}
+
+void ResourceDiskCache::initialize() {
+    FileCache::initialize();
+
+    QDir entriesDir(_entriesPath);
+    if (!entriesDir.exists()) {
+        entriesDir.mkpath(".");
+        return;
+    }
+
+    // an entry is only of use while the data it points to is cached
+    int numRemoved = 0;
+    for (auto& fileName : entriesDir.entryList({ "*" + ENTRY_EXT }, QDir::Files)) {
+        auto path = entriesDir.filePath(fileName);
+        QString url;
+        HTTPEntry entry;
+        if (!readEntry(path, url, entry) || !hasFile(entry.hash.toStdString())) {
+            QFile::remove(path);
+            ++numRemoved;
+        }
+    }
+    if (numRemoved > 0) {
+        qCDebug(networking) << "Removed" << numRemoved << "resource cache entries whose data was evicted";
+    }
+}
+
+QByteArray ResourceDiskCache::load(const QString& hash) {
+    auto file = getFile(hash.toStdString());
+    if (!file) {
+        return QByteArray();
+    }
+
+    QFile dataFile(QString::fromStdString(file->getFilepath()));
+    if (!dataFile.open(QIODevice::ReadOnly)) {
+        qCWarning(networking) << "Failed to read cached resource" << hash << "-" << dataFile.errorString();
+        return QByteArray();
+    }
+    return dataFile.readAll();
+}
+
+QString ResourceDiskCache::store(const QByteArray& data) {
+    QString hash = AssetUtils::hashData(data).toHex();
+    return store(hash, data) ? hash : QString();
+}
+
+bool ResourceDiskCache::store(const QString& hash, const QByteArray& data) {
+    auto key = hash.toStdString();
+    if (hasFile(key)) {
+        return true;
+    }
+    // the file can be evicted as soon as it is written, it isn't in use
+    return (bool)writeFile(data.constData(), Metadata(key, data.size()));
+}
+
+bool ResourceDiskCache::getHTTPEntry(const QUrl& url, HTTPEntry& entry) {
+    auto path = getEntryPath(url);
+    QString entryUrl;
+    if (!QFile::exists(path) || !readEntry(path, entryUrl, entry) || entryUrl != url.toString()) {
+        return false;
+    }
+
+    if (!hasFile(entry.hash.toStdString())) {
+        QFile::remove(path);
+        return false;
+    }
+    return true;
+}
+
+bool ResourceDiskCache::setHTTPEntry(const QUrl& url, const HTTPEntry& entry) {
+    QJsonObject object;
+    object[URL_KEY] = url.toString();
+    object[HASH_KEY] = entry.hash;
+    object[ETAG_KEY] = QString::fromLatin1(entry.etag);
+    object[LAST_MODIFIED_KEY] = QString::fromLatin1(entry.lastModified);
+    object[CONTENT_TYPE_KEY] = QString::fromLatin1(entry.contentType);
+    object[FRESH_UNTIL_KEY] = (double)entry.freshUntil;
+
+    QSaveFile file(getEntryPath(url));
+    return file.open(QIODevice::WriteOnly) && file.write(QJsonDocument(object).toJson(QJsonDocument::Compact)) > 0 &&
+        file.commit();
+}
+
+void ResourceDiskCache::removeHTTPEntry(const QUrl& url) {
+    QFile::remove(getEntryPath(url));
+}
+
+QString ResourceDiskCache::getEntryPath(const QUrl& url) const {
+    auto urlHash = QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha256).toHex();
+    return QDir(_entriesPath).filePath(QString(urlHash) + ENTRY_EXT);
+}
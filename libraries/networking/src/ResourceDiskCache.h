@@ -0,0 +1,74 @@
+//
+//  ResourceDiskCache.h
+//  libraries/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceDiskCache_h
+#define hifi_ResourceDiskCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+#include <shared/FileCache.h>
+
+// A disk cache of downloaded resources, stored under the SHA-256 hash of their data.  ATP assets are found by their
+// hash without asking the asset server, and data downloaded under several URLs is only stored once.
+// HTTP responses are found through an entry per URL holding the hash of their data, their validators and until when
+// they are fresh: fresh ones are loaded without a request, stale ones are revalidated with a conditional request.
+// The least recently used data is evicted the way FileCache does, once the cache is over its size or the disk is
+// short of space.  Thread safe.
+class ResourceDiskCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    static const char* SETTING_MAX_SIZE_NAME; // in MB
+    static const int DEFAULT_MAX_SIZE_MB;
+
+    // what is known of the response to an HTTP URL
+    struct HTTPEntry {
+        QString hash; // of the data, hex encoded
+        QByteArray etag;
+        QByteArray lastModified;
+        QByteArray contentType;
+        qint64 freshUntil { 0 }; // msecs since epoch
+
+        bool isFresh(qint64 now) const { return now < freshUntil; }
+        bool hasValidators() const { return !etag.isEmpty() || !lastModified.isEmpty(); }
+    };
+
+    // how long an HTTP response stays fresh, in msecs, from its headers: -1 when it is not to be stored at all
+    static qint64 getFreshnessLifetime(const QByteArray& cacheControl, const QByteArray& expires, const QByteArray& date,
+                                       const QByteArray& lastModified);
+
+    ResourceDiskCache(const std::string& dir);
+
+    // also removes the HTTP entries whose data isn't in the cache anymore
+    void initialize() override;
+
+    // a null array if the data with the hash isn't cached
+    QByteArray load(const QString& hash);
+
+    // returns the hash the data is stored under, or an empty string if it couldn't be stored
+    QString store(const QByteArray& data);
+    // for data whose hash was already checked
+    bool store(const QString& hash, const QByteArray& data);
+
+    // returns false if the URL has no entry, or the entry's data isn't cached anymore
+    bool getHTTPEntry(const QUrl& url, HTTPEntry& entry);
+    bool setHTTPEntry(const QUrl& url, const HTTPEntry& entry);
+    void removeHTTPEntry(const QUrl& url);
+
+private:
+    QString getEntryPath(const QUrl& url) const;
+
+    const QString _entriesPath;
+};
+
+#endif // hifi_ResourceDiskCache_h
@@ -11,6 +11,8 @@
 
 #include "ThreadedAssignment.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
@@ -29,6 +31,10 @@ ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     _domainServerTimer(this),
     _statsTimer(this)
 {
+    for (auto& bucket : _frameTimeBuckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
     // use <mixer-type> as a temporary targetName name until commonInit can be called later
     LogHandler::getInstance().setTargetName(QString("<%1>").arg(getTypeName()));
 
@@ -54,6 +60,46 @@ ThreadedAssignment::~ThreadedAssignment() {
     platform::destroy();
 }
 
+void ThreadedAssignment::recordFrameTime(std::chrono::microseconds duration) {
+    uint64_t usecs = std::max<int64_t>(duration.count(), 0);
+    int bucket = (int)std::min<uint64_t>(usecs / FRAME_TIME_BUCKET_USECS, NUM_FRAME_TIME_BUCKETS - 1);
+    _frameTimeBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _numFrames.fetch_add(1, std::memory_order_relaxed);
+    _totalFrameTime.fetch_add(usecs, std::memory_order_relaxed);
+
+    uint64_t maxFrameTime = _maxFrameTime.load(std::memory_order_relaxed);
+    while (usecs > maxFrameTime && !_maxFrameTime.compare_exchange_weak(maxFrameTime, usecs, std::memory_order_relaxed)) {}
+}
+
+QJsonObject ThreadedAssignment::getFrameTimeStats() const {
+    QJsonObject stats;
+    uint64_t numFrames = _numFrames.load(std::memory_order_relaxed);
+    uint64_t maxFrameTime = _maxFrameTime.load(std::memory_order_relaxed);
+    stats["frames"] = (qint64)numFrames;
+    if (numFrames == 0) {
+        return stats;
+    }
+    stats["mean_us"] = (double)_totalFrameTime.load(std::memory_order_relaxed) / numFrames;
+    stats["max_us"] = (qint64)maxFrameTime;
+
+    // a percentile is reported as the upper bound of the bucket it falls in
+    static const std::array<std::pair<const char*, double>, 4> PERCENTILES { {
+        { "p50_us", 0.5 }, { "p90_us", 0.9 }, { "p99_us", 0.99 }, { "p999_us", 0.999 }
+    } };
+    for (auto& percentile : PERCENTILES) {
+        uint64_t rank = std::max<uint64_t>((uint64_t)(percentile.second * numFrames), 1);
+        uint64_t numBelow = 0;
+        for (int i = 0; i < NUM_FRAME_TIME_BUCKETS; ++i) {
+            numBelow += _frameTimeBuckets[i].load(std::memory_order_relaxed);
+            if (numBelow >= rank) {
+                stats[percentile.first] = (qint64)std::min<uint64_t>((i + 1) * FRAME_TIME_BUCKET_USECS, maxFrameTime);
+                break;
+            }
+        }
+    }
+    return stats;
+}
+
 void ThreadedAssignment::setFinished(bool isFinished) {
     if (_isFinished != isFinished) {
          _isFinished = isFinished;
@@ -12,6 +12,11 @@
 #ifndef hifi_ThreadedAssignment_h
 #define hifi_ThreadedAssignment_h
 
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
 
 #include "ReceivedMessage.h"
@@ -27,6 +32,12 @@ public:
     virtual void aboutToFinish() { };
     void addPacketStatsAndSendStatsPacket(QJsonObject statsObject);
 
+    // records how long one frame of the assignment's work took, from whichever thread does it
+    void recordFrameTime(std::chrono::microseconds duration);
+
+    // the distribution of the frame times recorded so far, in usecs
+    QJsonObject getFrameTimeStats() const;
+
 public slots:
     /// threaded run of assignment
     virtual void run() = 0;
@@ -54,6 +65,15 @@ protected slots:
 
 private slots:
     void checkInWithDomainServerOrExit();
+
+private:
+    static const int FRAME_TIME_BUCKET_USECS = 50;
+    static const int NUM_FRAME_TIME_BUCKETS = 2000; // frames longer than 100 ms all go in the last one
+
+    std::array<std::atomic<uint32_t>, NUM_FRAME_TIME_BUCKETS> _frameTimeBuckets;
+    std::atomic<uint64_t> _numFrames { 0 };
+    std::atomic<uint64_t> _totalFrameTime { 0 };
+    std::atomic<uint64_t> _maxFrameTime { 0 };
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
@@ -0,0 +1,263 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2 / ln(2), the smallest gain that doubles the delivery rate every round trip in startup
+static const double HIGH_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+static const double PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+static const int PACING_GAIN_CYCLE_LENGTH = 8;
+static const double PACING_GAIN_CYCLE[PACING_GAIN_CYCLE_LENGTH] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const microseconds MIN_RTT_WINDOW = seconds(10);
+static const microseconds PROBE_RTT_DURATION = milliseconds(200);
+
+static const int MIN_CONGESTION_WINDOW = 4;
+static const int INITIAL_CONGESTION_WINDOW = 16;
+
+BBRCC::BBRCC() {
+    _packetSendPeriod = 0.0; // not paced until we have a bandwidth estimate
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW;
+    _pacingGain = HIGH_GAIN;
+    _congestionWindowGain = HIGH_GAIN;
+    _roundMaxDeliveryRates.fill(0.0);
+}
+
+void BBRCC::onDeliveryRateSample(const DeliveryRateSample& sample) {
+    if (!sample.isValid) {
+        return;
+    }
+
+    auto now = p_high_resolution_clock::now();
+    _inFlight = sample.inFlight;
+
+    if (sample.rtt > 0) {
+        updateRTTEstimate(sample.rtt);
+    }
+
+    updateRound(sample);
+    updateBandwidth(sample);
+    checkFullBandwidth();
+    updateMinRTT(sample, now);
+    updateMode(sample, now);
+    updatePacingAndWindow(sample);
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    // the model does not treat loss as congestion, but lost packets still need to be re-sent:
+    // like Reno, take the third duplicate ACK to mean that ack + 1 was lost
+    static const int FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+    bool wasDuplicateACK = (ack == _lastACK);
+    _lastACK = ack;
+
+    if (!wasDuplicateACK) {
+        _duplicateACKCount = 0;
+    } else if (++_duplicateACKCount == FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        _duplicateACKCount = 0;
+        return true;
+    }
+
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // nothing was ACKed for a whole timeout, start over from a minimal window that then grows with what gets delivered
+    _congestionWindowSize = MIN_CONGESTION_WINDOW;
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+void BBRCC::updateRTTEstimate(int rtt) {
+    // Jacobson's RTT estimation, as in TCPVegasCC
+    static const int RTT_ESTIMATION_ALPHA = 8;
+    static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + std::abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+}
+
+void BBRCC::updateRound(const DeliveryRateSample& sample) {
+    // a round trip ends when a packet sent after it started is ACKed
+    _isRoundStart = sample.priorDelivered >= _nextRoundDelivered;
+
+    if (_isRoundStart) {
+        _nextRoundDelivered = sample.delivered;
+        ++_roundCount;
+        _roundMaxDeliveryRates[_roundCount % BANDWIDTH_WINDOW_ROUNDS] = 0.0;
+    }
+}
+
+void BBRCC::updateBandwidth(const DeliveryRateSample& sample) {
+    auto& roundMax = _roundMaxDeliveryRates[_roundCount % BANDWIDTH_WINDOW_ROUNDS];
+    roundMax = std::max(roundMax, (double)sample.deliveryRate);
+}
+
+double BBRCC::getBandwidth() const {
+    return *std::max_element(_roundMaxDeliveryRates.begin(), _roundMaxDeliveryRates.end());
+}
+
+int BBRCC::getBandwidthDelayProduct(double gain) const {
+    double bandwidth = getBandwidth();
+    if (_minRTT < 0 || bandwidth <= 0.0) {
+        return INITIAL_CONGESTION_WINDOW;
+    }
+    return std::max(MIN_CONGESTION_WINDOW, (int)std::ceil(gain * bandwidth * _minRTT / USECS_PER_SECOND));
+}
+
+void BBRCC::checkFullBandwidth() {
+    if (_isPipeFull || !_isRoundStart) {
+        return;
+    }
+
+    // the pipe is full once the bandwidth has not grown by a quarter for a few rounds in a row
+    double bandwidth = getBandwidth();
+    if (bandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+        _fullBandwidth = bandwidth;
+        _fullBandwidthRounds = 0;
+    } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+        _isPipeFull = true;
+    }
+}
+
+void BBRCC::updateMinRTT(const DeliveryRateSample& sample, p_high_resolution_clock::time_point now) {
+    bool isMinRTTExpired = _minRTT >= 0 && now - _minRTTTimestamp > MIN_RTT_WINDOW;
+
+    if (sample.rtt > 0 && (_minRTT < 0 || sample.rtt <= _minRTT || isMinRTTExpired)) {
+        _minRTT = sample.rtt;
+        _minRTTTimestamp = now;
+    }
+
+    if (isMinRTTExpired && _mode != Mode::ProbeRTT) {
+        // we haven't seen the min RTT in a while, empty the queues for a moment to measure it again
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _priorCongestionWindowSize = _congestionWindowSize;
+        _probeRTTDoneTimestamp = p_high_resolution_clock::time_point();
+    }
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _congestionWindowGain = PROBE_BANDWIDTH_WINDOW_GAIN;
+
+    // start the cycle after the drain phase, so that we don't drain right after draining the startup queue
+    _cycleIndex = 2;
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+    _cycleTimestamp = now;
+}
+
+void BBRCC::updateMode(const DeliveryRateSample& sample, p_high_resolution_clock::time_point now) {
+    switch (_mode) {
+        case Mode::Startup:
+            if (_isPipeFull) {
+                _mode = Mode::Drain;
+                _pacingGain = DRAIN_GAIN;
+                _congestionWindowGain = HIGH_GAIN;
+            }
+            break;
+        case Mode::Drain:
+            if (_inFlight <= getBandwidthDelayProduct(1.0)) {
+                enterProbeBandwidth(now);
+            }
+            break;
+        case Mode::ProbeBandwidth: {
+            // each phase lasts a min RTT, except that probing up goes on until it has put a full gain of packets in
+            // flight and probing down stops as soon as the queue is drained
+            bool isFullLength = now - _cycleTimestamp > microseconds(std::max(_minRTT, 0));
+            bool shouldAdvance;
+            if (_pacingGain > 1.0) {
+                shouldAdvance = isFullLength && _inFlight >= getBandwidthDelayProduct(_pacingGain);
+            } else if (_pacingGain < 1.0) {
+                shouldAdvance = isFullLength || _inFlight <= getBandwidthDelayProduct(1.0);
+            } else {
+                shouldAdvance = isFullLength;
+            }
+
+            if (shouldAdvance) {
+                _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+                _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+                _cycleTimestamp = now;
+            }
+            break;
+        }
+        case Mode::ProbeRTT:
+            if (_probeRTTDoneTimestamp == p_high_resolution_clock::time_point()) {
+                if (_inFlight <= MIN_CONGESTION_WINDOW) {
+                    // the queue is drained, hold here for a while and at least a round trip
+                    _probeRTTDoneTimestamp = now + PROBE_RTT_DURATION;
+                    _probeRTTRoundDone = false;
+                    _nextRoundDelivered = sample.delivered;
+                }
+            } else {
+                _probeRTTRoundDone = _probeRTTRoundDone || _isRoundStart;
+
+                if (_probeRTTRoundDone && now > _probeRTTDoneTimestamp) {
+                    _minRTTTimestamp = now;
+                    _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+
+                    if (_isPipeFull) {
+                        enterProbeBandwidth(now);
+                    } else {
+                        _mode = Mode::Startup;
+                        _pacingGain = HIGH_GAIN;
+                        _congestionWindowGain = HIGH_GAIN;
+                    }
+                }
+            }
+            break;
+    }
+}
+
+void BBRCC::updatePacingAndWindow(const DeliveryRateSample& sample) {
+    double bandwidth = getBandwidth();
+    if (bandwidth > 0.0) {
+        setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * bandwidth));
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = std::min(_congestionWindowSize, MIN_CONGESTION_WINDOW);
+        return;
+    }
+
+    int targetWindowSize = getBandwidthDelayProduct(_congestionWindowGain);
+    if (_isPipeFull) {
+        _congestionWindowSize = std::min(_congestionWindowSize + sample.newlyDelivered, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || sample.delivered < INITIAL_CONGESTION_WINDOW) {
+        // in startup the window only grows, by what was just delivered
+        _congestionWindowSize += sample.newlyDelivered;
+    }
+
+    _congestionWindowSize = std::max(MIN_CONGESTION_WINDOW,
+                                     std::min(_congestionWindowSize, udt::MAX_PACKETS_IN_FLIGHT));
+}
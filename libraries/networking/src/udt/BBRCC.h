@@ -0,0 +1,101 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <array>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Model-based congestion control after BBR (https://queue.acm.org/detail.cfm?id=3022184).
+// Instead of reacting to loss or queueing delay like TCPVegasCC, it keeps estimates of the bottleneck bandwidth
+// (the max delivery rate over the last few round trips) and of the round trip propagation time (the min RTT over the
+// last ten seconds), then paces packets out at that bandwidth and caps the packets in flight at a multiple of their
+// product.  The pacing gain cycles above and below 1 to probe for more bandwidth and drain the queue that creates.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual void onDeliveryRateSample(const DeliveryRateSample& sample) override;
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override;
+
+    virtual int estimatedTimeout() const override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup, // doubling the sending rate every round trip until the bandwidth stops growing
+        Drain, // draining the queue built up in startup
+        ProbeBandwidth, // cycling the pacing gain around the bottleneck bandwidth
+        ProbeRTT // dropping to a minimal window for a moment, to measure the min RTT with empty queues
+    };
+
+    void updateRound(const DeliveryRateSample& sample);
+    void updateBandwidth(const DeliveryRateSample& sample);
+    void updateMinRTT(const DeliveryRateSample& sample, p_high_resolution_clock::time_point now);
+    void checkFullBandwidth();
+    void updateMode(const DeliveryRateSample& sample, p_high_resolution_clock::time_point now);
+    void updateRTTEstimate(int rtt);
+    void updatePacingAndWindow(const DeliveryRateSample& sample);
+
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+
+    double getBandwidth() const; // bottleneck bandwidth estimate, packets per second
+    int getBandwidthDelayProduct(double gain) const; // in packets
+
+    static const int BANDWIDTH_WINDOW_ROUNDS = 10;
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    // max delivery rate seen in each of the last rounds, indexed by round count
+    std::array<double, BANDWIDTH_WINDOW_ROUNDS> _roundMaxDeliveryRates;
+
+    int64_t _roundCount { 0 };
+    int64_t _nextRoundDelivered { 0 }; // delivered count that ends the current round
+    bool _isRoundStart { false };
+
+    int _minRTT { -1 }; // microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp;
+
+    double _fullBandwidth { 0.0 }; // bandwidth at the last time it grew by a quarter in startup
+    int _fullBandwidthRounds { 0 }; // rounds since then
+    bool _isPipeFull { false };
+
+    int _cycleIndex { 0 }; // current phase of the pacing gain cycle
+    p_high_resolution_clock::time_point _cycleTimestamp;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTimestamp;
+    bool _probeRTTRoundDone { false };
+    int _priorCongestionWindowSize { 0 }; // restored after probe RTT
+
+    int _inFlight { 0 };
+
+    int _ewmaRTT { -1 };
+    int _rttVariance { 0 };
+
+    SequenceNumber _lastACK;
+    int _duplicateACKCount { 0 };
+};
+
+}
+
+#endif // hifi_BBRCC_h
@@ -13,7 +13,9 @@
 
 #include <random>
 
+#include "BBRCC.h"
 #include "Packet.h"
+#include "TCPVegasCC.h"
 
 using namespace udt;
 using namespace std::chrono;
@@ -39,3 +41,12 @@ void CongestionControl::setPacketSendPeriod(double newSendPeriod) {
         _packetSendPeriod = newSendPeriod;
     }
 }
+
+std::unique_ptr<CongestionControlVirtualFactory> udt::createCongestionControlFactory(const QString& name) {
+    if (name.compare("vegas", Qt::CaseInsensitive) == 0) {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<TCPVegasCC>());
+    } else if (name.compare("bbr", Qt::CaseInsensitive) == 0) {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>());
+    }
+    return nullptr;
+}
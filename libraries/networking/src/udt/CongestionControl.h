@@ -16,8 +16,11 @@
 #include <memory>
 #include <vector>
 
+#include <QtCore/QString>
+
 #include <PortableHighResolutionClock.h>
 
+#include "DeliveryRateSampler.h"
 #include "LossList.h"
 #include "SequenceNumber.h"
 
@@ -42,6 +45,9 @@ public:
     // return value specifies if connection should perform a fast re-transmit of ACK + 1 (used in TCP style congestion control)
     virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) { return false; }
 
+    // called for every ACK that covers new packets, before onACK
+    virtual void onDeliveryRateSample(const DeliveryRateSample& sample) {}
+
     virtual void onTimeout() {}
 
     virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {}
@@ -81,6 +87,9 @@ public:
     virtual ~CongestionControlFactory() {}
     virtual std::unique_ptr<CongestionControl> create() override { return std::unique_ptr<T>(new T()); }
 };
+
+// returns the factory for the congestion control with this name, "vegas" or "bbr", or nullptr if there is none
+std::unique_ptr<CongestionControlVirtualFactory> createCongestionControlFactory(const QString& name);
     
 }
 
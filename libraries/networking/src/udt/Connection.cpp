@@ -67,21 +67,15 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
+    if (auto sendQueue = std::move(_sendQueue)) {
         // tell the send queue to stop and be deleted
         
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
 
-        sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
+        // deleting the send queue waits for the transport engine to finish any step it is taking
+        sendQueue.reset();
     }
 }
 
@@ -124,6 +118,9 @@ SendQueue& Connection::getSendQueue() {
 
         // give the randomized sequence number to the congestion control object
         _congestionControl->setInitialSendSequenceNumber(_sendQueue->getCurrentSequenceNumber());
+
+        // packets sent by a previous send queue will never be ACKed
+        _deliveryRateSampler.reset();
     }
     
     return *_sendQueue;
@@ -190,6 +187,7 @@ void Connection::recordSentPackets(int wireSize, int payloadSize,
                                    SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
     _stats.recordSentPackets(payloadSize, wireSize);
 
+    _deliveryRateSampler.onPacketSent(seqNum, wireSize, timePoint);
     _congestionControl->onPacketSent(wireSize, seqNum, timePoint);
 }
 
@@ -197,6 +195,7 @@ void Connection::recordRetransmission(int wireSize, int payloadSize,
                                       SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
     _stats.recordRetransmittedPackets(payloadSize, wireSize);
 
+    _deliveryRateSampler.onPacketReSent(seqNum);
     _congestionControl->onPacketReSent(wireSize, seqNum, timePoint);
 }
 
@@ -254,6 +253,15 @@ bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, in
         return false;
     }
     
+    // a sender can't be more than a flow window past what we have ACKed, drop a packet that claims to be
+    // rather than report everything before it as lost
+    if (seqoff(nextACK(), sequenceNumber) > MAX_PACKETS_IN_FLIGHT) {
+#ifdef UDT_CONNECTION_DEBUG
+        qCDebug(networking) << "Received packet" << (uint32_t)sequenceNumber << "beyond the flow window, dropping it";
+#endif
+        return false;
+    }
+
     // mark our last receive time as now (to push the potential expiry farther)
     _lastReceiveTime = p_high_resolution_clock::now();
     
@@ -350,6 +358,14 @@ void Connection::processACK(ControlPacketPointer controlPacket) {
 
     // give this ACK to the congestion control and update the send queue parameters
     updateCongestionControlAndSendQueue([this, ack, &controlPacket] {
+        auto sample = _deliveryRateSampler.onACK(ack, controlPacket->getReceiveTime());
+        if (sample.isValid) {
+            if (sample.deliveryRate > 0) {
+                _stats.recordDeliveryRate(sample.deliveryRate, sample.deliveryRateBytes);
+            }
+            _congestionControl->onDeliveryRateSample(sample);
+        }
+
         if (_congestionControl->onACK(ack, controlPacket->getReceiveTime())) {
             // the congestion control has told us it needs a fast re-transmit of ack + 1, add that now
             _sendQueue->fastRetransmit(ack + 1);
@@ -456,23 +472,34 @@ void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
         _numPackets = packet->getMessagePartNumber() + 1;
     }
 
-    // Insert into the packets list in sorted order. Because we generally expect to receive packets in order, begin
-    // searching from the end of the list.
+    // Parts arrive close to in order, so they go straight into their slot in a window that starts at the next
+    // part we are waiting for.
     auto messagePartNumber = packet->getMessagePartNumber();
-    auto it = std::find_if(_packets.rbegin(), _packets.rend(),
-        [&](const std::unique_ptr<Packet>& value) { return messagePartNumber >= value->getMessagePartNumber(); });
+    if (messagePartNumber < _nextPartNumber) {
+        qCDebug(networking) << "PendingReceivedMessage::enqueuePacket: This is a duplicate packet";
+        return;
+    }
+
+    size_t index = messagePartNumber - _nextPartNumber;
+    if (index >= (size_t)MAX_PACKETS_IN_FLIGHT) {
+        // the sender can't have this many packets of ours in flight, so this part number is bogus
+        qCDebug(networking) << "PendingReceivedMessage::enqueuePacket: Dropping message part" << messagePartNumber
+            << "too far ahead of part" << _nextPartNumber;
+        return;
+    }
 
-    if (it != _packets.rend() && ((*it)->getMessagePartNumber() == messagePartNumber)) {
+    if (index >= _packets.size()) {
+        _packets.resize(index + 1);
+    } else if (_packets[index]) {
         qCDebug(networking) << "PendingReceivedMessage::enqueuePacket: This is a duplicate packet";
         return;
     }
     
-    _packets.insert(it.base(), std::move(packet));
+    _packets[index] = std::move(packet);
 }
 
 bool PendingReceivedMessage::hasAvailablePackets() const {
-    return _packets.size() > 0
-        && _nextPartNumber == _packets.front()->getMessagePartNumber();
+    return !_packets.empty() && _packets.front();
 }
 
 std::unique_ptr<Packet> PendingReceivedMessage::removeNextPacket() {
@@ -12,7 +12,7 @@
 #ifndef hifi_Connection_h
 #define hifi_Connection_h
 
-#include <list>
+#include <deque>
 #include <memory>
 
 #include <QtCore/QObject>
@@ -21,6 +21,7 @@
 
 #include "ConnectionStats.h"
 #include "Constants.h"
+#include "DeliveryRateSampler.h"
 #include "LossList.h"
 #include "SendQueue.h"
 #include "../HifiSockAddr.h"
@@ -38,10 +39,10 @@ public:
     void enqueuePacket(std::unique_ptr<Packet> packet);
     bool hasAvailablePackets() const;
     std::unique_ptr<Packet> removeNextPacket();
-    
-    std::list<std::unique_ptr<Packet>> _packets;
 
 private:
+    // slot i holds message part _nextPartNumber + i, or null if that part hasn't arrived yet
+    std::deque<std::unique_ptr<Packet>> _packets;
     bool _hasLastPacket { false };
     Packet::MessagePartNumber _nextPartNumber = 0;
     unsigned int _numPackets { 0 };
@@ -127,6 +128,7 @@ private:
     HifiSockAddr _destination;
    
     std::unique_ptr<CongestionControl> _congestionControl;
+    DeliveryRateSampler _deliveryRateSampler; // fed with the packets our send queue sends and the ACKs for them
    
     std::unique_ptr<SendQueue> _sendQueue;
     
@@ -11,6 +11,8 @@
 
 #include "ConnectionStats.h"
 
+#include <algorithm>
+
 #include <QtCore/QDebug>
 
 using namespace udt;
@@ -24,6 +26,13 @@ ConnectionStats::ConnectionStats() {
 ConnectionStats::Stats ConnectionStats::sample() {
     Stats sample = _currentSample;
     _currentSample = Stats();
+
+    if (sample.deliveryRateSamples > 0) {
+        sample.deliveryRate = _deliveryRateTotal / sample.deliveryRateSamples;
+        sample.deliveryRateBytes = _deliveryRateBytesTotal / sample.deliveryRateSamples;
+    }
+    _deliveryRateTotal = 0;
+    _deliveryRateBytesTotal = 0;
     
     auto now = duration_cast<microseconds>(system_clock::now().time_since_epoch());
     sample.endTime = now;
@@ -90,6 +99,13 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
 }
 
+void ConnectionStats::recordDeliveryRate(int64_t packetsPerSecond, int64_t bytesPerSecond) {
+    ++_currentSample.deliveryRateSamples;
+    _currentSample.maxDeliveryRate = std::max(_currentSample.maxDeliveryRate, packetsPerSecond);
+    _deliveryRateTotal += packetsPerSecond;
+    _deliveryRateBytesTotal += bytesPerSecond;
+}
+
 QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "Connection stats:\n";
 #define HIFI_LOG_EVENT(x) << "    " #x " events: " << stats.events[ConnectionStats::Stats::Event::x] << "\n"
@@ -106,6 +122,8 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    debug << "\n     Delivery rate samples: " << stats.deliveryRateSamples;
+    debug << "\n     Delivery rate (P/s): " << stats.deliveryRate << "\n";
     return debug;
 }
@@ -68,6 +68,12 @@ public:
         int rtt { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+
+        // delivery rate samples taken from the ACKs received, see DeliveryRateSampler
+        int deliveryRateSamples { 0 };
+        int64_t deliveryRate { 0 }; // average of the samples, packets per second
+        int64_t maxDeliveryRate { 0 }; // packets per second
+        int64_t deliveryRateBytes { 0 }; // average of the samples, bytes per second
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
         Stats() { events.fill(0); }
@@ -93,9 +99,15 @@ public:
 
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+
+    void recordDeliveryRate(int64_t packetsPerSecond, int64_t bytesPerSecond);
     
 private:
     Stats _currentSample;
+
+    // totals of the delivery rate samples in the current sample, averaged when it is taken
+    int64_t _deliveryRateTotal { 0 };
+    int64_t _deliveryRateBytesTotal { 0 };
 };
     
 }
@@ -0,0 +1,104 @@
+//
+//  DeliveryRateSampler.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DeliveryRateSampler.h"
+
+#include <algorithm>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const int64_t USECS_PER_SECOND = 1000000;
+
+void DeliveryRateSampler::reset() {
+    _sentPackets.clear();
+}
+
+void DeliveryRateSampler::onPacketSent(SequenceNumber seqNum, int wireSize,
+                                       p_high_resolution_clock::time_point timePoint) {
+    if (!_sentPackets.empty() && seqNum != _sentPackets.back().sequenceNumber + 1) {
+        // a gap in the sequence numbers means the send queue was replaced, start over
+        _sentPackets.clear();
+    }
+
+    if (_sentPackets.empty()) {
+        // nothing in flight, the delivery interval for this packet starts now
+        _firstSentTime = timePoint;
+        _deliveredTime = timePoint;
+    }
+
+    SentPacket packet;
+    packet.sequenceNumber = seqNum;
+    packet.wireSize = wireSize;
+    packet.sendTime = timePoint;
+    packet.firstSentTime = _firstSentTime;
+    packet.deliveredTime = _deliveredTime;
+    packet.delivered = _delivered;
+    packet.deliveredBytes = _deliveredBytes;
+    _sentPackets.push_back(packet);
+}
+
+void DeliveryRateSampler::onPacketReSent(SequenceNumber seqNum) {
+    if (_sentPackets.empty()) {
+        return;
+    }
+
+    int index = seqoff(_sentPackets.front().sequenceNumber, seqNum);
+    if (index >= 0 && index < (int)_sentPackets.size()) {
+        _sentPackets[index].wasResent = true;
+    }
+}
+
+DeliveryRateSample DeliveryRateSampler::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    DeliveryRateSample sample;
+
+    if (_sentPackets.empty() || ack < _sentPackets.front().sequenceNumber) {
+        // nothing new is covered by this ACK
+        return sample;
+    }
+
+    int count = std::min(seqoff(_sentPackets.front().sequenceNumber, ack) + 1, (int)_sentPackets.size());
+    for (int i = 0; i < count - 1; ++i) {
+        _deliveredBytes += _sentPackets.front().wireSize;
+        _sentPackets.pop_front();
+    }
+
+    // the most recently sent packet of those ACKed gives the sample
+    SentPacket acked = _sentPackets.front();
+    _sentPackets.pop_front();
+    _deliveredBytes += acked.wireSize;
+
+    _delivered += count;
+    _deliveredTime = receiveTime;
+    _firstSentTime = acked.sendTime;
+
+    sample.isValid = true;
+    sample.newlyDelivered = count;
+    sample.delivered = _delivered;
+    sample.priorDelivered = acked.delivered;
+    sample.inFlight = (int)_sentPackets.size();
+
+    if (!acked.wasResent) {
+        sample.rtt = std::max(1, (int)duration_cast<microseconds>(receiveTime - acked.sendTime).count());
+    }
+
+    // the slower of the send and ACK rates over the interval, so that a burst of ACKs can't inflate the estimate
+    auto sendInterval = duration_cast<microseconds>(acked.sendTime - acked.firstSentTime).count();
+    auto ackInterval = duration_cast<microseconds>(receiveTime - acked.deliveredTime).count();
+    auto interval = std::max(sendInterval, ackInterval);
+
+    if (interval > 0) {
+        sample.deliveryRate = (_delivered - acked.delivered) * USECS_PER_SECOND / interval;
+        sample.deliveryRateBytes = (_deliveredBytes - acked.deliveredBytes) * USECS_PER_SECOND / interval;
+    }
+
+    return sample;
+}
@@ -0,0 +1,73 @@
+//
+//  DeliveryRateSampler.h
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DeliveryRateSampler_h
+#define hifi_DeliveryRateSampler_h
+
+#include <cstdint>
+#include <deque>
+
+#include <PortableHighResolutionClock.h>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+struct DeliveryRateSample {
+    bool isValid { false }; // false for duplicate ACKs and ACKs that cover no packet we know of
+
+    int64_t deliveryRate { 0 }; // packets per second delivered while the ACKed packet was in flight, 0 if unknown
+    int64_t deliveryRateBytes { 0 }; // same in bytes per second, counting packet headers
+    int rtt { -1 }; // microseconds, -1 if the ACKed packet was re-sent and the RTT would be ambiguous
+
+    int newlyDelivered { 0 }; // packets covered by this ACK and not by a previous one
+    int64_t delivered { 0 }; // packets delivered on the connection, including this ACK
+    int64_t priorDelivered { 0 }; // packets delivered when the ACKed packet was sent
+    int inFlight { 0 }; // packets sent and not yet ACKed, after this ACK
+};
+
+// Estimates the rate at which packets get through to the receiver, from the packets each cumulative ACK covers.
+// Each sent packet is stamped with the number of packets delivered when it left, so when it is ACKed the packets
+// delivered in the meantime, over the time that took, give a rate that does not depend on how fast we were sending.
+class DeliveryRateSampler {
+public:
+    void reset();
+
+    void onPacketSent(SequenceNumber seqNum, int wireSize, p_high_resolution_clock::time_point timePoint);
+    void onPacketReSent(SequenceNumber seqNum);
+
+    DeliveryRateSample onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime);
+
+    int getInFlight() const { return (int)_sentPackets.size(); }
+
+private:
+    struct SentPacket {
+        SequenceNumber sequenceNumber;
+        int wireSize;
+        p_high_resolution_clock::time_point sendTime;
+        p_high_resolution_clock::time_point firstSentTime; // send time of the last packet delivered when this was sent
+        p_high_resolution_clock::time_point deliveredTime; // time of the last delivery when this was sent
+        int64_t delivered; // packets delivered when this was sent
+        int64_t deliveredBytes;
+        bool wasResent { false };
+    };
+
+    std::deque<SentPacket> _sentPackets; // in sequence number order, sequence numbers are consecutive
+
+    int64_t _delivered { 0 };
+    int64_t _deliveredBytes { 0 };
+    p_high_resolution_clock::time_point _deliveredTime;
+    p_high_resolution_clock::time_point _firstSentTime;
+};
+
+}
+
+#endif // hifi_DeliveryRateSampler_h
@@ -11,154 +11,167 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+#include <bitset>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Constants.h"
 #include "ControlPacket.h"
 
 using namespace udt;
-using namespace std;
+
+namespace {
+
+using Word = uint64_t;
+
+const int INITIAL_CAPACITY = 4096; // bits, enough for a few round trips of losses on a fast link
+const uint32_t MAX_CAPACITY = 32768; // bits, the smallest power of two that holds a full flow window
+static_assert(MAX_CAPACITY > (uint32_t)MAX_PACKETS_IN_FLIGHT, "LossList can't hold a full flow window");
+
+inline int countBits(Word word) {
+    return (int)std::bitset<64>(word).count();
+}
+
+inline int lowestBit(Word word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+inline int highestBit(Word word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+// mask of count bits starting at bit, count in [1, 64 - bit]
+inline Word spanMask(int bit, int count) {
+    return (count == 64 ? ~Word(0) : ((Word(1) << count) - 1)) << bit;
+}
+
+}
+
+void LossList::clear() {
+    if (_length > 0) {
+        updateRange(_first, seqlen(_first, _last), false);
+        _length = 0;
+    }
+}
 
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(isEmpty() || (_last < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
-    if (getLength() > 0 && _lossList.back().second + 1 == seq) {
-        ++_lossList.back().second;
-    } else {
-        _lossList.push_back(make_pair(seq, seq));
+    if (isEmpty()) {
+        _first = seq;
     }
+    if (!reserve(_first, seq)) {
+        return;
+    }
+    updateRange(seq, 1, true);
+    _last = seq;
     _length += 1;
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(isEmpty() || (_last < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
                "LossList::append(SequenceNumber, SequenceNumber)", "Range start greater than range end");
 
-    if (getLength() > 0 && _lossList.back().second + 1 == start) {
-        _lossList.back().second = end;
-    } else {
-        _lossList.push_back(make_pair(start, end));
+    if (isEmpty()) {
+        _first = start;
+    }
+    if (!reserve(_first, end)) {
+        return;
     }
-    _length += seqlen(start, end);
+    int count = seqlen(start, end);
+    updateRange(start, count, true);
+    _last = end;
+    _length += count;
 }
 
 void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
-    
-    if (it == _lossList.end() || end < it->first) {
-        // No overlap, simply insert
-        _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
-    } else {
-        // If it starts before segment, extend segment
-        if (start < it->first) {
-            _length += seqlen(start, it->first - 1);
-            it->first = start;
-        }
-        
-        // If it ends after segment, extend segment
-        if (end > it->second) {
-            _length += seqlen(it->second + 1, end);
-            it->second = end;
-        }
-        
-        auto it2 = it;
-        ++it2;
-        // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
-            // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
-            }
-            
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
-        }
+    SequenceNumber first = (isEmpty() || start < _first) ? start : _first;
+    SequenceNumber last = (isEmpty() || _last < end) ? end : _last;
+    
+    if (!reserve(first, last)) {
+        return;
     }
+    _length += updateRange(start, seqlen(start, end), true);
+    _first = first;
+    _last = last;
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
-    
-    if (it != end(_lossList)) {
-        if (it->first == it->second) {
-            _lossList.erase(it);
-        } else if (seq == it->first) {
-            ++it->first;
-        } else if (seq == it->second) {
-            --it->second;
-        } else {
-            auto temp = it->second;
-            it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
-        }
-        _length -= 1;
-        
-        // this sequence number was found in the loss list, return true
-        return true;
-    } else {
+    if (isEmpty() || seq < _first || _last < seq || updateRange(seq, 1, false) == 0) {
         // this sequence number was not found in the loss list, return false
         return false;
     }
+    
+    _length -= 1;
+    
+    if (!isEmpty()) {
+        if (seq == _first) {
+            int count = seqlen(seq, _last) - 1;
+            _first = (seq + 1) + findFirst(seq + 1, count, true);
+        } else if (seq == _last) {
+            _last = _first + findLastSet(_first, seqlen(_first, seq) - 1);
+        }
+    }
+    
+    // this sequence number was found in the loss list, return true
+    return true;
 }
 
 void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
-    // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
     
-    // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
-        }
-        
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
-        }
+    if (isEmpty() || end < _first || _last < start) {
+        return;
+    }
+    
+    // only the part of the range between the first and last losses can hold anything
+    if (start < _first) {
+        start = _first;
+    }
+    if (_last < end) {
+        end = _last;
+    }
+    
+    _length -= updateRange(start, seqlen(start, end), false);
+    
+    if (isEmpty()) {
+        return;
+    }
+    
+    if (start == _first) {
+        int count = seqlen(end, _last) - 1;
+        _first = (end + 1) + findFirst(end + 1, count, true);
+    } else if (end == _last) {
+        _last = _first + findLastSet(_first, seqlen(_first, start) - 1);
     }
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return _first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
@@ -168,17 +181,142 @@ SequenceNumber LossList::popFirstSequenceNumber() {
 }
 
 void LossList::write(ControlPacket& packet, int maxPairs) {
+    if (isEmpty()) {
+        return;
+    }
+    
     int writtenPairs = 0;
+    SequenceNumber start = _first;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    while (true) {
+        // every range starts on a loss and runs until the next sequence number that was not lost
+        int remaining = seqlen(start, _last);
+        int rangeLength = findFirst(start, remaining, false);
+        
+        packet.writePrimitive(start);
+        packet.writePrimitive(start + (rangeLength - 1));
         
         ++writtenPairs;
         
-        // check if we've written the maximum number we were told to write
-        if (maxPairs != -1 && writtenPairs >= maxPairs) {
+        // check if we've written the last range or the maximum number we were told to write
+        if (rangeLength == remaining || (maxPairs != -1 && writtenPairs >= maxPairs)) {
             break;
         }
+        
+        SequenceNumber afterRange = start + rangeLength;
+        start = afterRange + findFirst(afterRange, remaining - rangeLength, true);
+    }
+}
+
+bool LossList::reserve(SequenceNumber first, SequenceNumber last) {
+    uint32_t capacity = (uint32_t)_bits.size() * BITS_PER_WORD;
+    uint32_t needed = (uint32_t)seqlen(first, last);
+    
+    if (needed <= capacity) {
+        return true;
+    }
+    if (needed > MAX_CAPACITY) {
+        // more than a flow window apart, these can't both be losses of a peer that follows the protocol
+        return false;
+    }
+    
+    uint32_t newCapacity = std::max(capacity, (uint32_t)INITIAL_CAPACITY);
+    while (newCapacity < needed) {
+        newCapacity *= 2;
+    }
+    
+    std::vector<Word> bits(newCapacity / BITS_PER_WORD, 0);
+    
+    if (!isEmpty()) {
+        // the ring size always divides the sequence number space, so a loss moves to its sequence number
+        // modulo the new size, found from its distance to the first loss
+        uint32_t oldMask = capacity - 1;
+        uint32_t newMask = newCapacity - 1;
+        uint32_t firstPosition = getPosition(_first);
+        uint32_t firstValue = (SequenceNumber::UType)_first;
+        
+        for (size_t i = 0; i < _bits.size(); ++i) {
+            Word word = _bits[i];
+            while (word != 0) {
+                int bit = lowestBit(word);
+                word &= word - 1;
+                
+                uint32_t offset = ((uint32_t)i * BITS_PER_WORD + bit - firstPosition) & oldMask;
+                uint32_t position = (firstValue + offset) & newMask;
+                bits[position / BITS_PER_WORD] |= Word(1) << (position % BITS_PER_WORD);
+            }
+        }
     }
+    
+    _bits.swap(bits);
+    return true;
+}
+
+int LossList::updateRange(SequenceNumber start, int count, bool set) {
+    int changed = 0;
+    uint32_t position = getPosition(start);
+    uint32_t mask = (uint32_t)_bits.size() * BITS_PER_WORD - 1;
+    
+    while (count > 0) {
+        int bit = position % BITS_PER_WORD;
+        int span = std::min(BITS_PER_WORD - bit, count);
+        Word spanBits = spanMask(bit, span);
+        Word& word = _bits[position / BITS_PER_WORD];
+        
+        if (set) {
+            changed += span - countBits(word & spanBits);
+            word |= spanBits;
+        } else {
+            changed += countBits(word & spanBits);
+            word &= ~spanBits;
+        }
+        
+        position = (position + span) & mask;
+        count -= span;
+    }
+    
+    return changed;
+}
+
+int LossList::findFirst(SequenceNumber start, int count, bool set) const {
+    uint32_t position = getPosition(start);
+    uint32_t mask = (uint32_t)_bits.size() * BITS_PER_WORD - 1;
+    int offset = 0;
+    
+    while (offset < count) {
+        int bit = position % BITS_PER_WORD;
+        int span = std::min(BITS_PER_WORD - bit, count - offset);
+        Word word = _bits[position / BITS_PER_WORD];
+        Word found = (set ? word : ~word) & spanMask(bit, span);
+        
+        if (found != 0) {
+            return offset + lowestBit(found) - bit;
+        }
+        
+        position = (position + span) & mask;
+        offset += span;
+    }
+    
+    return count;
+}
+
+int LossList::findLastSet(SequenceNumber start, int count) const {
+    uint32_t mask = (uint32_t)_bits.size() * BITS_PER_WORD - 1;
+    uint32_t position = (getPosition(start) + count - 1) & mask;
+    int remaining = count;
+    
+    while (remaining > 0) {
+        int bit = position % BITS_PER_WORD;
+        int span = std::min(bit + 1, remaining);
+        Word found = _bits[position / BITS_PER_WORD] & spanMask(bit - span + 1, span);
+        
+        if (found != 0) {
+            return remaining - 1 - (bit - highestBit(found));
+        }
+        
+        position = (position - span) & mask;
+        remaining -= span;
+    }
+    
+    return -1;
 }
@@ -12,25 +12,30 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <cstdint>
+#include <vector>
 
 #include "SequenceNumber.h"
 
 namespace udt {
 
 class ControlPacket;
-    
+
+// Set of lost sequence numbers, kept as a ring of bits indexed by sequence number modulo the ring size.
+// The ring only has to span the sequence numbers between the first and last losses, so it stays small and
+// every operation touches a few contiguous words instead of walking a list of ranges.  It never grows past a flow
+// window of sequence numbers, losses that would make it span more than that are dropped.
 class LossList {
 public:
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear();
     
-    // must always add at the end - faster than insert
+    // must always add at the end
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -41,10 +46,30 @@ public:
     SequenceNumber getFirstSequenceNumber() const;
     SequenceNumber popFirstSequenceNumber();
     
+    // writes the losses as (first, last) pairs of consecutive sequence numbers
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    // grows the ring if needed so that it can hold every sequence number from first to last, returns false if it can't
+    bool reserve(SequenceNumber first, SequenceNumber last);
+
+    // sets or clears count bits from start, returns the number of bits that changed
+    int updateRange(SequenceNumber start, int count, bool set);
+
+    // returns the offset from start of the first bit equal to set among the next count bits, or count if there is none
+    int findFirst(SequenceNumber start, int count, bool set) const;
+    // returns the offset from start of the last set bit among the next count bits, or -1 if there is none
+    int findLastSet(SequenceNumber start, int count) const;
+
+    uint32_t getPosition(SequenceNumber seq) const {
+        return (SequenceNumber::UType)seq & (uint32_t)(_bits.size() * BITS_PER_WORD - 1);
+    }
+
+    static const int BITS_PER_WORD = 64;
+
+    std::vector<uint64_t> _bits; // one bit per sequence number, set if it was lost
+    SequenceNumber _first; // first lost sequence number, only valid if the list is not empty
+    SequenceNumber _last; // last lost sequence number, only valid if the list is not empty
     int _length { 0 };
 };
     
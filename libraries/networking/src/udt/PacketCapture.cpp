@@ -0,0 +1,190 @@
+//
+//  PacketCapture.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCapture.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
+#include <NumericalConstants.h>
+
+#include "../NetworkLogging.h"
+
+using namespace udt;
+
+namespace {
+
+const qint64 SEGMENT_HEADER_SIZE = sizeof(quint32) + sizeof(quint16) + sizeof(quint64);
+const qint64 RECORD_HEADER_SIZE = sizeof(quint32) + sizeof(quint32) + sizeof(quint16) + sizeof(quint16);
+
+// the first segment, and the two most recent ones, are kept
+const int NUM_KEPT_SEGMENTS = 3;
+const qint64 MIN_SEGMENT_SIZE = 1024 * 1024;
+
+const quint64 FLUSH_INTERVAL_USECS = USECS_PER_SECOND;
+
+QString segmentPath(const QString& path, int index) {
+    return path + "." + QString::number(index);
+}
+
+}
+
+PacketCapture::PacketCapture(const QString& path, qint64 maxSize) :
+    _path(path),
+    _segmentMaxSize(std::max(maxSize / NUM_KEPT_SEGMENTS, MIN_SEGMENT_SIZE))
+{
+    // don't mix the segments of an earlier capture at the same path into this one
+    for (auto& oldSegment : segmentPaths(path)) {
+        QFile::remove(oldSegment);
+    }
+    _stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+PacketCapture::~PacketCapture() {
+    flush();
+}
+
+void PacketCapture::write(quint64 timestamp, const HifiSockAddr& senderSockAddr, const char* data, qint64 size) {
+    if (_segmentIndex < 0 || _segmentSize >= _segmentMaxSize ||
+        timestamp - _segmentStartTime > std::numeric_limits<quint32>::max()) {
+        if (!openSegment(timestamp)) {
+            return;
+        }
+    }
+
+    _stream << (quint32)(timestamp - _segmentStartTime);
+    _stream << (quint32)senderSockAddr.getAddress().toIPv4Address();
+    _stream << senderSockAddr.getPort();
+    _stream << (quint16)size;
+    _stream.writeRawData(data, (int)size);
+    _segmentSize += RECORD_HEADER_SIZE + size;
+
+    // a capture is most useful when something went wrong, so don't leave much of it in the buffer
+    if (timestamp - _lastFlushTime > FLUSH_INTERVAL_USECS) {
+        flush();
+        _lastFlushTime = timestamp;
+    }
+}
+
+void PacketCapture::flush() {
+    if (_file.isOpen()) {
+        _file.flush();
+    }
+}
+
+bool PacketCapture::openSegment(quint64 timestamp) {
+    if (_file.isOpen()) {
+        _file.close();
+    }
+
+    ++_segmentIndex;
+    int droppedSegment = _segmentIndex - (NUM_KEPT_SEGMENTS - 1);
+    if (droppedSegment > 0) {
+        QFile::remove(segmentPath(_path, droppedSegment));
+    }
+
+    _file.setFileName(segmentPath(_path, _segmentIndex));
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(networking) << "Could not open packet capture segment" << _file.fileName() << "-" << _file.errorString();
+        return false;
+    }
+
+    _stream.setDevice(&_file);
+    _segmentStartTime = timestamp;
+    _stream << MAGIC << FORMAT_VERSION << _segmentStartTime;
+    _segmentSize = SEGMENT_HEADER_SIZE;
+    return true;
+}
+
+QStringList PacketCapture::segmentPaths(const QString& path) {
+    QFileInfo info(path);
+    QString prefix = info.fileName() + ".";
+
+    std::vector<std::pair<int, QString>> segments;
+    for (auto& entry : info.dir().entryInfoList({ prefix + "*" }, QDir::Files)) {
+        bool ok = false;
+        int index = entry.fileName().mid(prefix.length()).toInt(&ok);
+        if (ok) {
+            segments.emplace_back(index, entry.filePath());
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+
+    QStringList paths;
+    for (auto& segment : segments) {
+        paths << segment.second;
+    }
+    return paths;
+}
+
+bool PacketCaptureReader::open(const QString& path) {
+    _segmentPaths = PacketCapture::segmentPaths(path);
+    _nextSegment = 0;
+    _stream.setByteOrder(QDataStream::LittleEndian);
+    return openNextSegment();
+}
+
+bool PacketCaptureReader::readNext(Record& record) {
+    while (_file.isOpen()) {
+        quint32 offset;
+        quint32 address;
+        quint16 port;
+        quint16 size;
+        _stream >> offset >> address >> port >> size;
+
+        if (_stream.status() == QDataStream::Ok) {
+            auto data = std::unique_ptr<char[]>(new char[size]);
+            if (_stream.readRawData(data.get(), size) == size) {
+                record.timestamp = _segmentStartTime + offset;
+                record.senderSockAddr = HifiSockAddr(QHostAddress(address), port);
+                record.data = std::move(data);
+                record.size = size;
+                record.startsSegment = _isAtSegmentStart;
+                _isAtSegmentStart = false;
+                return true;
+            }
+        }
+
+        // the end of this segment, or a record cut short by the process that wrote it exiting
+        _file.close();
+        openNextSegment();
+    }
+    return false;
+}
+
+bool PacketCaptureReader::openNextSegment() {
+    while (_nextSegment < _segmentPaths.size()) {
+        _file.setFileName(_segmentPaths[_nextSegment++]);
+        if (!_file.open(QIODevice::ReadOnly)) {
+            qCWarning(networking) << "Could not open packet capture segment" << _file.fileName() << "-" << _file.errorString();
+            continue;
+        }
+
+        _stream.setDevice(&_file);
+        _stream.resetStatus();
+
+        quint32 magic;
+        quint16 version;
+        _stream >> magic >> version >> _segmentStartTime;
+        if (_stream.status() != QDataStream::Ok || magic != PacketCapture::MAGIC || version != PacketCapture::FORMAT_VERSION) {
+            qCWarning(networking) << _file.fileName() << "is not a packet capture segment this version can read";
+            _file.close();
+            continue;
+        }
+
+        _isAtSegmentStart = true;
+        return true;
+    }
+    return false;
+}
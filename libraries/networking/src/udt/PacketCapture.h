@@ -0,0 +1,94 @@
+//
+//  PacketCapture.h
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCapture_h
+#define hifi_PacketCapture_h
+
+#include <memory>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Writes the datagrams a Socket receives to disk, to be fed back into a process later by a PacketReplay.
+//
+// A capture is a set of segment files next to each other: <path>.0, <path>.1, ...  Each segment starts with a header
+// (magic, format version, the time the segment was started in usecs since the epoch) followed by records of
+// (usecs since the segment was started, sender IPv4 address, sender port, datagram size, datagram).
+// The first segment, which holds the packets that set a session up, is always kept.  After that only the last two
+// segments are, so that a capture left running takes at most about its maximum size on disk.
+class PacketCapture {
+public:
+    static const quint32 MAGIC = 0x48465043; // "HFPC"
+    static const quint16 FORMAT_VERSION = 1;
+    static const qint64 DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    PacketCapture(const QString& path, qint64 maxSize = DEFAULT_MAX_SIZE);
+    ~PacketCapture();
+
+    bool isOpen() const { return _file.isOpen(); }
+    const QString& getPath() const { return _path; }
+
+    void write(quint64 timestamp, const HifiSockAddr& senderSockAddr, const char* data, qint64 size);
+    void flush();
+
+    // the segments of the capture at path, oldest first
+    static QStringList segmentPaths(const QString& path);
+
+private:
+    bool openSegment(quint64 timestamp);
+
+    QString _path;
+    qint64 _segmentMaxSize;
+
+    QFile _file;
+    QDataStream _stream;
+    int _segmentIndex { -1 };
+    qint64 _segmentSize { 0 }; // tracked here, asking the file would flush it
+    quint64 _segmentStartTime { 0 };
+    quint64 _lastFlushTime { 0 };
+};
+
+// Reads the datagrams of a capture back, in the order they were received.
+class PacketCaptureReader {
+public:
+    struct Record {
+        quint64 timestamp { 0 }; // usecs since the epoch
+        HifiSockAddr senderSockAddr;
+        std::unique_ptr<char[]> data;
+        qint64 size { 0 };
+        bool startsSegment { false }; // there may be a gap in time before the first record of a ring segment
+    };
+
+    bool open(const QString& path);
+
+    // returns false once every segment has been read
+    bool readNext(Record& record);
+
+private:
+    bool openNextSegment();
+
+    QStringList _segmentPaths;
+    int _nextSegment { 0 };
+    bool _isAtSegmentStart { false };
+
+    QFile _file;
+    QDataStream _stream;
+    quint64 _segmentStartTime { 0 };
+};
+
+}
+
+#endif // hifi_PacketCapture_h
@@ -27,7 +27,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::StunResponse:
             return 17;
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::HasConnectReason);
+            return static_cast<PacketVersion>(DomainListVersion::HasKeyedPacketHash);
         case PacketType::EntityAdd:
         case PacketType::EntityClone:
         case PacketType::EntityEdit:
@@ -63,8 +63,10 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetMappingOperationReply:
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
+        case PacketType::AssetGetBatch:
+        case PacketType::AssetGetBatchReply:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::BakingTextureMeta);
+            return static_cast<PacketVersion>(AssetServerPacketVersion::GetBatches);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
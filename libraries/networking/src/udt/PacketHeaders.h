@@ -137,6 +137,8 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        AssetGetBatch,
+        AssetGetBatchReply,
         NUM_PACKET_TYPE
     };
 
@@ -196,6 +198,7 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
             << PacketTypeEnum::Value::AssetGet
+            << PacketTypeEnum::Value::AssetGetBatch
             << PacketTypeEnum::Value::AssetUpload;
         return DOMAIN_SOURCED_PACKETS;
     }
@@ -204,6 +207,7 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_IGNORED_VERIFICATION_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperationReply
             << PacketTypeEnum::Value::AssetGetReply
+            << PacketTypeEnum::Value::AssetGetBatchReply
             << PacketTypeEnum::Value::AssetUploadReply;
         return DOMAIN_IGNORED_VERIFICATION_PACKETS;
     }
@@ -307,7 +311,12 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    BakingQueueInfo,
+    AssetChunkLists,
+    MappingPages,
+    DeclaredUploadHashes,
+    GetBatches
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -382,7 +391,8 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasKeyedPacketHash
 };
 
 enum class AudioVersion : PacketVersion {
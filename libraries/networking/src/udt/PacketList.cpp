@@ -13,7 +13,9 @@
 
 #include "../NetworkLogging.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <QDebug>
 
 using namespace udt;
@@ -48,7 +50,13 @@ PacketList::PacketList(PacketList&& other) :
     _packetType(other._packetType),
     _packets(std::move(other._packets)),
     _isOrdered(other._isOrdered),
+    _priority(other._priority),
+    _deadline(other._deadline),
     _isReliable(other._isReliable),
+    _streamedData(std::move(other._streamedData)),
+    _streamedPacketFinisher(std::move(other._streamedPacketFinisher)),
+    _streamedPacketCapacity(other._streamedPacketCapacity),
+    _streamedOffset(other._streamedOffset),
     _extendedHeader(std::move(other._extendedHeader))
 {
 }
@@ -66,7 +74,7 @@ void PacketList::endSegment() {
 }
 
 size_t PacketList::getDataSize() const {
-    size_t totalBytes = 0;
+    size_t totalBytes = _streamedData ? _streamedData->size() - _streamedOffset : 0;
     for (const auto& packet : _packets) {
         totalBytes += packet->getDataSize();
     }
@@ -79,7 +87,7 @@ size_t PacketList::getDataSize() const {
 }
 
 size_t PacketList::getMessageSize() const {
-    size_t totalBytes = 0;
+    size_t totalBytes = _streamedData ? _streamedData->size() - _streamedOffset : 0;
     for (const auto& packet: _packets) {
         totalBytes += packet->getPayloadSize();
     }
@@ -142,21 +150,90 @@ QByteArray PacketList::getMessage() const {
 }
 
 void PacketList::preparePackets(MessageNumber messageNumber) {
-    Q_ASSERT(_packets.size() > 0);
-    
-    if (_packets.size() == 1) {
-        _packets.front()->writeMessageNumber(messageNumber, Packet::PacketPosition::ONLY, 0);
+    _messageNumber = messageNumber;
+    _nextMessagePartNumber = 0;
+    _numMessageParts = _packets.size() + getNumStreamedPacketsLeft();
+    Q_ASSERT(_numMessageParts > 0);
+
+    for (auto& packet : _packets) {
+        writeMessagePosition(*packet);
+    }
+}
+
+void PacketList::writeMessagePosition(Packet& packet) {
+    auto messagePartNumber = _nextMessagePartNumber++;
+
+    Packet::PacketPosition position = Packet::PacketPosition::MIDDLE;
+    if (_numMessageParts == 1) {
+        position = Packet::PacketPosition::ONLY;
+    } else if (messagePartNumber == 0) {
+        position = Packet::PacketPosition::FIRST;
+    } else if (messagePartNumber == _numMessageParts - 1) {
+        position = Packet::PacketPosition::LAST;
+    }
+    packet.writeMessageNumber(_messageNumber, position, messagePartNumber);
+}
+
+void PacketList::setStreamedData(StreamedDataPointer streamedData) {
+    Q_ASSERT_X(_isReliable && _isOrdered, "PacketList::setStreamedData", "Only reliable ordered lists can stream data");
+
+    // the streamed data starts in a packet of its own
+    closeCurrentPacket();
+
+    _streamedPacketCapacity = createPacketWithExtendedHeader()->bytesAvailableForWrite();
+    _streamedOffset = 0;
+    _streamedData = std::move(streamedData);
+}
+
+size_t PacketList::getNumStreamedPacketsLeft() const {
+    if (!_streamedData || _streamedPacketCapacity <= 0) {
+        return 0;
+    }
+    qint64 sizeLeft = _streamedData->size() - _streamedOffset;
+    return sizeLeft > 0 ? (size_t)((sizeLeft + _streamedPacketCapacity - 1) / _streamedPacketCapacity) : 0;
+}
+
+PacketList::PacketPointer PacketList::takeStreamedPacket(StreamedRead& read) {
+    if (getNumStreamedPacketsLeft() == 0) {
+        return PacketPointer();
+    }
+
+    auto packet = createPacketWithExtendedHeader();
+    read.data = _streamedData;
+    read.finisher = _streamedPacketFinisher;
+    read.offset = _streamedOffset;
+    read.size = std::min(_streamedPacketCapacity, _streamedData->size() - _streamedOffset);
+    _streamedOffset += read.size;
+    // the queue drops the list along with its last packet
+    read.list = getNumStreamedPacketsLeft() > 0 ? this : nullptr;
+
+    if (_isOrdered) {
+        writeMessagePosition(*packet);
+    }
+    return packet;
+}
+
+bool PacketList::StreamedRead::readInto(Packet& packet) const {
+    // read straight into the payload, rather than into a buffer that is then written to it
+    auto pos = packet.pos();
+    bool isRead = data->read(offset, packet.getPayload() + pos, size);
+    if (isRead) {
+        packet.setPayloadSize(pos + size);
+        packet.seek(pos + size);
     } else {
-        const auto second = ++_packets.begin();
-        const auto last = --_packets.end();
-        Packet::MessagePartNumber messagePartNumber = 0;
-        std::for_each(second, last, [&](const PacketPointer& packet) {
-            packet->writeMessageNumber(messageNumber, Packet::PacketPosition::MIDDLE, ++messagePartNumber);
-        });
-        
-        _packets.front()->writeMessageNumber(messageNumber, Packet::PacketPosition::FIRST, 0);
-        _packets.back()->writeMessageNumber(messageNumber, Packet::PacketPosition::LAST, ++messagePartNumber);
+        // the message ends here, short of the size it was sent with, so that the receiver fails it rather than
+        // taking what couldn't be read for data
+        qCWarning(networking) << "Could not read" << size << "bytes of streamed data at" << offset
+            << "- ending the message early";
+        auto messagePartNumber = packet.getMessagePartNumber();
+        packet.writeMessageNumber(packet.getMessageNumber(), messagePartNumber == 0 ? Packet::PacketPosition::ONLY :
+                                  Packet::PacketPosition::LAST, messagePartNumber);
+    }
+
+    if (finisher) {
+        finisher(packet);
     }
+    return isRead;
 }
 
 const qint64 PACKET_LIST_WRITE_ERROR = -1;
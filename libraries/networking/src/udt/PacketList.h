@@ -12,6 +12,7 @@
 #ifndef hifi_PacketList_h
 #define hifi_PacketList_h
 
+#include <functional>
 #include <memory>
 
 #include "../ExtendedIODevice.h"
@@ -29,6 +30,33 @@ class PacketList : public ExtendedIODevice {
 public:
     using MessageNumber = uint32_t;
     using PacketPointer = std::unique_ptr<Packet>;
+
+    // How the PacketQueue of a connection schedules this list against the other lists queued on it.
+    // Higher classes are served first, but a lower class that keeps getting passed over is eventually served anyway.
+    enum class Priority : uint8_t {
+        Urgent, // small control messages that other work waits on
+        High,
+        Normal,
+        Bulk // large transfers that should only use the bandwidth left over
+    };
+    static const int NUM_PRIORITIES = (int)Priority::Bulk + 1;
+
+    // Data sent after what was written to a list, read a packet at a time as the list's packets are sent, so that a
+    // large message is never held in memory in full.  It is read from the thread of the socket sending the list, and
+    // a read that fails ends the message early, short of the size its sender gave it.
+    class StreamedData {
+    public:
+        virtual ~StreamedData() = default;
+
+        virtual qint64 size() const = 0;
+
+        // reads size bytes starting at offset into data, returns false if they could not be read
+        virtual bool read(qint64 offset, char* data, qint64 size) = 0;
+    };
+    using StreamedDataPointer = std::shared_ptr<StreamedData>;
+
+    // called on each packet made from streamed data before it is sent, to fill in what a sender fills in on written packets
+    using StreamedPacketFinisher = std::function<void(Packet&)>;
     
     static std::unique_ptr<PacketList> create(PacketType packetType, QByteArray extendedHeader = QByteArray(),
                                               bool isReliable = false, bool isOrdered = false);
@@ -37,8 +65,16 @@ public:
     PacketType getType() const { return _packetType; }
     bool isReliable() const { return _isReliable; }
     bool isOrdered() const { return _isOrdered; }
+
+    Priority getPriority() const { return _priority; }
+    void setPriority(Priority priority) { _priority = priority; }
+
+    // lists with a deadline are sent ahead of the other lists of their priority, earliest deadline first
+    bool hasDeadline() const { return _deadline != p_high_resolution_clock::time_point::max(); }
+    p_high_resolution_clock::time_point getDeadline() const { return _deadline; }
+    void setDeadline(p_high_resolution_clock::time_point deadline) { _deadline = deadline; }
     
-    size_t getNumPackets() const { return _packets.size() + (_currentPacket ? 1 : 0); }
+    size_t getNumPackets() const { return _packets.size() + (_currentPacket ? 1 : 0) + getNumStreamedPacketsLeft(); }
     size_t getDataSize() const;
     size_t getMessageSize() const;
     QByteArray getMessage() const;
@@ -51,6 +87,13 @@ public:
     virtual qint64 getMaxSegmentSize() const { return Packet::maxPayloadSize(_isOrdered); }
 
     HifiSockAddr getSenderSockAddr() const;
+
+    // Ends the list with data that is streamed into its packets as they are sent, rather than written now.  Only
+    // reliable ordered lists can stream data, and nothing can be written to the list afterwards.
+    void setStreamedData(StreamedDataPointer streamedData);
+    bool hasStreamedData() const { return (bool)_streamedData; }
+    size_t getNumStreamedPacketsLeft() const;
+    void setStreamedPacketFinisher(StreamedPacketFinisher finisher) { _streamedPacketFinisher = std::move(finisher); }
     
     void closeCurrentPacket(bool shouldSendEmpty = false);
 
@@ -77,6 +120,8 @@ protected:
     std::list<std::unique_ptr<Packet>> _packets;
 
     bool _isOrdered = false;
+    Priority _priority { Priority::Normal };
+    p_high_resolution_clock::time_point _deadline { p_high_resolution_clock::time_point::max() };
     
 private:
     friend class ::LimitedNodeList;
@@ -89,13 +134,40 @@ private:
     
     // Takes the first packet of the list and returns it.
     template<typename T> std::unique_ptr<T> takeFront();
+
+    // What a packet made from the streamed data still needs: its data is read once the packet is taken from the
+    // queue, outside of the queue's lock
+    struct StreamedRead {
+        StreamedDataPointer data;
+        StreamedPacketFinisher finisher;
+        PacketList* list { nullptr }; // to abort, if the packet isn't its last
+        qint64 offset { 0 };
+        qint64 size { 0 };
+
+        // returns false if the data could not be read, the packet is then made the last of its message, empty
+        bool readInto(Packet& packet) const;
+    };
+
+    // Makes the next packet of the streamed data, once the list has been prepared, and what its data is read with
+    PacketPointer takeStreamedPacket(StreamedRead& read);
+    // Drops the streamed data not made into packets yet, once a read of it failed
+    void abortStreamedData() { _streamedData.reset(); }
+
+    void writeMessagePosition(Packet& packet);
     
     // Creates a new packet, can be overriden to change return underlying type
     virtual std::unique_ptr<Packet> createPacket();
     std::unique_ptr<Packet> createPacketWithExtendedHeader();
     
     Packet::MessageNumber _messageNumber;
+    Packet::MessagePartNumber _nextMessagePartNumber { 0 };
+    size_t _numMessageParts { 0 };
     bool _isReliable = false;
+
+    StreamedDataPointer _streamedData;
+    StreamedPacketFinisher _streamedPacketFinisher;
+    qint64 _streamedPacketCapacity { 0 };
+    qint64 _streamedOffset { 0 };
     
     std::unique_ptr<Packet> _currentPacket;
     
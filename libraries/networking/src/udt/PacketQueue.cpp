@@ -15,9 +15,18 @@
 
 using namespace udt;
 
+namespace {
+
+// how many channels of a priority are sent concurrently before going back to the first one
+const unsigned int MAX_CHANNELS_SENT_CONCURRENTLY = 16;
+
+// how many packets in a row can be taken from higher priorities while a lower one has packets waiting
+const unsigned int MAX_PACKETS_SKIPPED = 16;
+
+}
+
 PacketQueue::PacketQueue(MessageNumber messageNumber) : _currentMessageNumber(messageNumber) {
-    _channels.emplace_front(new std::list<PacketPointer>());
-    _currentChannel = _channels.begin();
+    _classes[(int)MAIN_CHANNEL_PRIORITY].channels.emplace_back(new Channel());
 }
 
 MessageNumber PacketQueue::getNextMessageNumber() {
@@ -26,62 +35,159 @@ MessageNumber PacketQueue::getNextMessageNumber() {
     return _currentMessageNumber;
 }
 
+bool PacketQueue::isClassEmpty(int priority) const {
+    auto& channels = _classes[priority].channels;
+    size_t firstListChannel = getFirstListChannel(priority);
+    return channels.size() == firstListChannel && (firstListChannel == 0 || channels.front()->packets.empty());
+}
+
 bool PacketQueue::isEmpty() const {
     LockGuard locker(_packetsLock);
 
-    // Only the main channel and it is empty
-    return _channels.size() == 1 && _channels.front()->empty();
+    for (int priority = 0; priority < PacketList::NUM_PRIORITIES; ++priority) {
+        if (!isClassEmpty(priority)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int PacketQueue::getNextPriority() const {
+    // a priority that has been passed over too many times in a row goes first, so bulk transfers keep moving
+    for (int priority = 0; priority < PacketList::NUM_PRIORITIES; ++priority) {
+        if (_classes[priority].skippedCount >= MAX_PACKETS_SKIPPED && !isClassEmpty(priority)) {
+            return priority;
+        }
+    }
+    for (int priority = 0; priority < PacketList::NUM_PRIORITIES; ++priority) {
+        if (!isClassEmpty(priority)) {
+            return priority;
+        }
+    }
+    return -1;
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
-    LockGuard locker(_packetsLock);
+    PacketList::StreamedRead streamedRead;
+    PacketPointer packet;
+    {
+        LockGuard locker(_packetsLock);
+        packet = takeNextPacket(streamedRead);
+    }
+
+    // streamed data is read outside of the lock, so that a slow read from disk doesn't hold up queueing packets.
+    // Only this thread takes packets, so the list of a packet that isn't its last is still queued.
+    if (packet && streamedRead.data && !streamedRead.readInto(*packet) && streamedRead.list) {
+        LockGuard locker(_packetsLock);
+        abortStreamedList(streamedRead.list);
+    }
+    return packet;
+}
 
+PacketQueue::PacketPointer PacketQueue::takeNextPacket(PacketList::StreamedRead& streamedRead) {
     if (isEmpty()) {
         return PacketPointer();
     }
 
-    // handle the case where we are looking at the first channel and it is empty
-    if (_currentChannel == _channels.begin() && (*_currentChannel)->empty()) {
-        ++_currentChannel;
+    // serve the highest priority with packets waiting, deadlines only order the lists within a priority so that a
+    // late bulk transfer can't hold up the urgent messages of the connection
+    int priority = getNextPriority();
+    Q_ASSERT(priority >= 0);
+
+    auto& priorityClass = _classes[priority];
+    size_t firstListChannel = getFirstListChannel(priority);
+    size_t channelIndex = 0;
+    bool isRoundRobin = false;
+    if (priorityClass.channels.size() > firstListChannel && priorityClass.channels[firstListChannel]->hasDeadline()) {
+        // lists with a deadline are sent one at a time, earliest deadline first
+        channelIndex = firstListChannel;
+    } else {
+        // handle the case where we are looking at the main channel and it is empty
+        if (priorityClass.currentChannel == 0 && firstListChannel == 1 && priorityClass.channels.front()->packets.empty()) {
+            ++priorityClass.currentChannel;
+        }
+        channelIndex = priorityClass.currentChannel;
+        isRoundRobin = true;
     }
 
-    // at this point the current channel should always not be at the end and should also not be empty
-    Q_ASSERT(_currentChannel != _channels.end());
+    // at this point the channel should always not be at the end and should also not be empty
+    Q_ASSERT(channelIndex < priorityClass.channels.size());
 
-    auto& channel = *_currentChannel;
+    auto& channel = priorityClass.channels[channelIndex];
 
-    Q_ASSERT(!channel->empty());
+    Q_ASSERT(!channel->isEmpty());
 
-    // Take front packet
-    auto packet = std::move(channel->front());
-    channel->pop_front();
+    // Take front packet, the written packets of a list go before the ones made from its streamed data
+    PacketPointer packet;
+    if (!channel->packets.empty()) {
+        packet = std::move(channel->packets.front());
+        channel->packets.pop_front();
+    } else {
+        packet = channel->streamedList->takeStreamedPacket(streamedRead);
+    }
 
     // Remove now empty channel (Don't remove the main channel)
-    if (channel->empty() && _currentChannel != _channels.begin()) {
-        // erase the current channel and slide the iterator to the next channel
-        _currentChannel = _channels.erase(_currentChannel);
-    } else {
-        ++_currentChannel;
+    if (channel->isEmpty() && channelIndex >= getFirstListChannel(priority)) {
+        removeChannel(priority, channelIndex);
+    } else if (isRoundRobin) {
+        ++priorityClass.currentChannel;
     }
 
     // push forward our number of channels taken from
-    ++_channelsVisitedCount;
+    ++priorityClass.channelsVisitedCount;
 
-    // check if we need to restart back at the front channel (main)
+    // check if we need to restart back at the front channel
     // to respect our capped number of channels considered concurrently
-    static const int MAX_CHANNELS_SENT_CONCURRENTLY = 16;
+    if (priorityClass.currentChannel >= priorityClass.channels.size() ||
+        priorityClass.channelsVisitedCount >= MAX_CHANNELS_SENT_CONCURRENTLY) {
+        priorityClass.channelsVisitedCount = 0;
+        priorityClass.currentChannel = 0;
+    }
 
-    if (_currentChannel == _channels.end() || _channelsVisitedCount >= MAX_CHANNELS_SENT_CONCURRENTLY) {
-        _channelsVisitedCount = 0;
-        _currentChannel = _channels.begin();
+    // every lower priority still waiting was passed over once more
+    priorityClass.skippedCount = 0;
+    for (int lowerPriority = priority + 1; lowerPriority < PacketList::NUM_PRIORITIES; ++lowerPriority) {
+        if (!isClassEmpty(lowerPriority)) {
+            ++_classes[lowerPriority].skippedCount;
+        }
     }
 
     return packet;
 }
 
+void PacketQueue::removeChannel(int priority, size_t channelIndex) {
+    auto& priorityClass = _classes[priority];
+    // erase the channel, which slides the next channel into its place
+    priorityClass.channels.erase(priorityClass.channels.begin() + channelIndex);
+    if (channelIndex < priorityClass.currentChannel) {
+        --priorityClass.currentChannel;
+    }
+}
+
+void PacketQueue::abortStreamedList(const PacketList* list) {
+    for (int priority = 0; priority < PacketList::NUM_PRIORITIES; ++priority) {
+        auto& priorityClass = _classes[priority];
+        for (size_t channelIndex = 0; channelIndex < priorityClass.channels.size(); ++channelIndex) {
+            auto& channel = priorityClass.channels[channelIndex];
+            if (channel->streamedList.get() != list) {
+                continue;
+            }
+
+            channel->streamedList->abortStreamedData();
+            if (channel->isEmpty()) {
+                removeChannel(priority, channelIndex);
+                if (priorityClass.currentChannel >= priorityClass.channels.size()) {
+                    priorityClass.currentChannel = 0;
+                }
+            }
+            return;
+        }
+    }
+}
+
 void PacketQueue::queuePacket(PacketPointer packet) {
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    _classes[(int)MAIN_CHANNEL_PRIORITY].channels.front()->packets.push_back(std::move(packet));
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -89,7 +195,38 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
         packetList->preparePackets(getNextMessageNumber());
     }
 
+    std::unique_ptr<Channel> channel { new Channel() };
+    channel->deadline = packetList->getDeadline();
+    for (auto& packet : packetList->_packets) {
+        channel->packets.push_back(std::move(packet));
+    }
+    packetList->_packets.clear();
+
+    int priority = (int)packetList->getPriority();
+    if (packetList->hasStreamedData()) {
+        channel->streamedList = std::move(packetList);
+    }
+
+    if (channel->isEmpty()) {
+        return;
+    }
+
     LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    auto& priorityClass = _classes[priority];
+    auto& channels = priorityClass.channels;
+
+    if (!channel->hasDeadline()) {
+        channels.push_back(std::move(channel));
+        return;
+    }
+
+    // keep the channels with a deadline in front, sorted by deadline
+    size_t index = getFirstListChannel(priority);
+    while (index < channels.size() && channels[index]->deadline <= channel->deadline) {
+        ++index;
+    }
+    if (index <= priorityClass.currentChannel && priorityClass.currentChannel < channels.size()) {
+        ++priorityClass.currentChannel;
+    }
+    channels.insert(channels.begin() + index, std::move(channel));
 }
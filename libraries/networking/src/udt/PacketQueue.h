@@ -12,17 +12,17 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
-#include <list>
+#include <array>
+#include <deque>
 #include <vector>
 #include <memory>
 #include <mutex>
 
 #include "Packet.h"
+#include "PacketList.h"
 
 namespace udt {
     
-class PacketList;
-    
 using MessageNumber = uint32_t;
     
 class PacketQueue {
@@ -30,9 +30,26 @@ class PacketQueue {
     using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
-    using RawChannel = std::list<PacketPointer>;
-    using Channel = std::unique_ptr<RawChannel>;
-    using Channels = std::list<Channel>;
+    using RawChannel = std::deque<PacketPointer>;
+    using Priority = PacketList::Priority;
+
+    struct Channel {
+        bool hasDeadline() const { return deadline != p_high_resolution_clock::time_point::max(); }
+        bool isEmpty() const { return packets.empty() && (!streamedList || streamedList->getNumStreamedPacketsLeft() == 0); }
+
+        RawChannel packets;
+        PacketListPointer streamedList; // makes the rest of the channel's packets as they are taken, if it streams data
+        p_high_resolution_clock::time_point deadline { p_high_resolution_clock::time_point::max() };
+    };
+    using Channels = std::vector<std::unique_ptr<Channel>>;
+
+    // The channels of one priority, kept with the channels that have a deadline first, earliest deadline first
+    struct PriorityClass {
+        Channels channels;
+        size_t currentChannel { 0 }; // index of the next channel to take a packet from, round robin
+        unsigned int channelsVisitedCount { 0 };
+        unsigned int skippedCount { 0 }; // packets taken from higher classes since this one was last served
+    };
     
 public:
     PacketQueue(MessageNumber messageNumber = 0);
@@ -47,15 +64,22 @@ public:
     MessageNumber getCurrentMessageNumber() const { return _currentMessageNumber; }
     
 private:
+    // single packets go to a main channel that is never removed, served with the High priority lists
+    static const Priority MAIN_CHANNEL_PRIORITY = Priority::High;
+
     MessageNumber getNextMessageNumber();
 
+    size_t getFirstListChannel(int priority) const { return priority == (int)MAIN_CHANNEL_PRIORITY ? 1 : 0; }
+    bool isClassEmpty(int priority) const;
+    int getNextPriority() const;
+    PacketPointer takeNextPacket(PacketList::StreamedRead& streamedRead);
+    void removeChannel(int priority, size_t channelIndex);
+    void abortStreamedList(const PacketList* list);
+
     MessageNumber _currentMessageNumber { 0 };
     
     mutable Mutex _packetsLock; // Protects the packets to be sent.
-    Channels _channels; // One channel per packet list + Main channel
-
-    Channels::iterator _currentChannel;
-    unsigned int _channelsVisitedCount { 0 };
+    std::array<PriorityClass, PacketList::NUM_PRIORITIES> _classes; // One channel per packet list + Main channel
 };
 
 }
@@ -0,0 +1,83 @@
+//
+//  PacketReplay.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketReplay.h"
+
+#include <SharedUtil.h>
+
+#include "../NetworkLogging.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// a segment that starts later than this after the one before it follows a gap in the capture
+static const microseconds MAX_SEGMENT_GAP { 1000000 };
+
+PacketReplay::PacketReplay(const QString& path, float speed, DatagramHandler handler, QObject* parent) :
+    QObject(parent),
+    _path(path),
+    _speed(speed > 0.0f ? speed : 1.0f),
+    _handler(handler)
+{
+    _timer.setSingleShot(true);
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &PacketReplay::replayDueDatagrams);
+}
+
+bool PacketReplay::start() {
+    if (!_reader.open(_path) || !(_hasNextRecord = _reader.readNext(_nextRecord))) {
+        qCWarning(networking) << "No datagrams to replay in packet capture" << _path;
+        return false;
+    }
+
+    qCDebug(networking) << "Replaying packet capture" << _path << "at" << _speed << "times the captured speed";
+
+    _captureStartTime = _nextRecord.timestamp;
+    _replayStartTime = p_high_resolution_clock::now();
+    _timer.start(0);
+    return true;
+}
+
+p_high_resolution_clock::time_point PacketReplay::getDueTime(quint64 timestamp) const {
+    return _replayStartTime + microseconds((qint64)((timestamp - _captureStartTime) / _speed));
+}
+
+void PacketReplay::replayDueDatagrams() {
+    auto now = p_high_resolution_clock::now();
+
+    while (_hasNextRecord) {
+        if (_nextRecord.startsSegment && getDueTime(_nextRecord.timestamp) > now + MAX_SEGMENT_GAP) {
+            // carry on from the next segment straight away
+            _captureStartTime = _nextRecord.timestamp;
+            _replayStartTime = now;
+        }
+
+        auto dueTime = getDueTime(_nextRecord.timestamp);
+        if (dueTime > now) {
+            _timer.start((int)duration_cast<milliseconds>(dueTime - now).count());
+            return;
+        }
+
+        // have the wall clock read the time the datagram was captured at, plus however late we are to replay it
+        auto captureNow = _captureStartTime + (quint64)(duration_cast<microseconds>(now - _replayStartTime).count() * _speed);
+        auto realNow = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+        usecTimestampNowForceClockSkew((qint64)captureNow - realNow);
+
+        _handler(std::move(_nextRecord.data), _nextRecord.size, _nextRecord.senderSockAddr);
+        ++_numReplayedDatagrams;
+
+        _hasNextRecord = _reader.readNext(_nextRecord);
+    }
+
+    // the wall clock keeps the skew it has now, going back in time would confuse whatever is still running
+    qCDebug(networking) << "Finished replaying" << _numReplayedDatagrams << "datagrams from packet capture" << _path;
+    emit finished();
+}
@@ -0,0 +1,70 @@
+//
+//  PacketReplay.h
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketReplay_h
+#define hifi_PacketReplay_h
+
+#include <functional>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <PortableHighResolutionClock.h>
+
+#include "PacketCapture.h"
+
+namespace udt {
+
+// Feeds the datagrams of a PacketCapture back to a handler, normally a Socket, with the time between them kept or
+// scaled down by the replay speed.
+// While replaying, usecTimestampNow() follows the time the datagrams were captured at, so timestamps inside the
+// packets and the times nodes were last heard from stay consistent with each other.  Gaps in the capture, where
+// segments were dropped from its ring, are skipped over.
+class PacketReplay : public QObject {
+    Q_OBJECT
+public:
+    using DatagramHandler = std::function<void(std::unique_ptr<char[]>, qint64, const HifiSockAddr&)>;
+
+    PacketReplay(const QString& path, float speed, DatagramHandler handler, QObject* parent = nullptr);
+
+    // returns false if the capture has no datagrams to replay
+    bool start();
+
+    quint64 getNumReplayedDatagrams() const { return _numReplayedDatagrams; }
+
+signals:
+    void finished();
+
+private slots:
+    void replayDueDatagrams();
+
+private:
+    p_high_resolution_clock::time_point getDueTime(quint64 timestamp) const;
+
+    QString _path;
+    float _speed;
+    DatagramHandler _handler;
+
+    PacketCaptureReader _reader;
+    PacketCaptureReader::Record _nextRecord;
+    bool _hasNextRecord { false };
+
+    // the capture time that plays at the replay start time
+    quint64 _captureStartTime { 0 };
+    p_high_resolution_clock::time_point _replayStartTime;
+
+    QTimer _timer { this };
+    quint64 _numReplayedDatagrams { 0 };
+};
+
+}
+
+#endif // hifi_PacketReplay_h
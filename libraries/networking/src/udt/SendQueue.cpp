@@ -12,12 +12,9 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -29,6 +26,7 @@
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
 #include "Socket.h"
+#include "TransportEngine.h"
 #include <Trace.h>
 #include <Profile.h>
 
@@ -37,30 +35,6 @@
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
-
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
@@ -71,19 +45,8 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
+    // the queue stays on the creating thread for its signals and slots, its sending is driven by the transport engine
+    TransportEngine::getInstance().addQueue(queue.get());
     
     return queue;
 }
@@ -103,41 +66,38 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSe
 }
 
 SendQueue::~SendQueue() {
+    // make sure the transport engine is done with us before we go away
+    TransportEngine::getInstance().removeQueue(this);
+}
+
+void SendQueue::wake() {
+    TransportEngine::getInstance().wakeQueue(this);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // make sure the queue is stepped, in case it is waiting for packets
+    wake();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // make sure the queue is stepped, in case it is waiting for packets
+    wake();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // step once more so the transport engine sees we are stopped and stops scheduling us
+    wake();
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
-    _lastPacketSentAt = std::chrono::high_resolution_clock::now();
+    _lastPacketSentAt = p_high_resolution_clock::now();
     return _socket->writeDatagram(packet.getData(), packet.getDataSize(), _destination);
 }
     
@@ -164,8 +124,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting with a full congestion window
+    wake();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -174,35 +134,25 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    // we haven't received a handshake ACK from the client, send another now
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // start sending right away, instead of at the next handshake re-send
+    wake();
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -225,9 +175,8 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     {
         // Insert the packet we have just sent in the sent list
         QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
+        auto& entry = _sentPackets.insert(newPacket->getSequenceNumber());
+        entry.packet.swap(newPacket);
     }
     Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
 
@@ -246,38 +195,48 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
-    if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+p_high_resolution_clock::time_point SendQueue::step(p_high_resolution_clock::time_point now) {
+    static const auto NO_NEXT_STEP = p_high_resolution_clock::time_point::max();
+
+    // don't monopolize the transport thread when there is no send period to pace us
+    static const int MAX_PACKETS_PER_STEP = 16;
+
+    if (_state == State::NotStarted) {
+        _state = State::Running;
     }
-    
-    _state = State::Running;
-    
+    if (_state != State::Running) {
+        return NO_NEXT_STEP;
+    }
+
+    if (_hasNewDestination) {
+        std::lock_guard<std::mutex> locker(_destinationLock);
+        _destination = _newDestination;
+        _hasNewDestination = false;
+    }
+
     // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeAt) {
+            sendHandshake();
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+            // we wait for the ACK (which wakes us up) or the re-send interval to expire
+            static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+            _nextHandshakeAt = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+
+        // no packets will be sent until the handshake ACK has been received
+        _nextPacketTimestamp = now;
+        return _nextHandshakeAt;
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    for (int packetsSent = 0; _state == State::Running; ++packetsSent) {
+        if (_packetSendPeriod > 0 && now < _nextPacketTimestamp) {
+            return _nextPacketTimestamp;
+        }
+        if (packetsSent == MAX_PACKETS_PER_STEP) {
+            return now;
+        }
 
-    while (_state == State::Running) {
         bool attemptedToSendPacket = maybeResendPacket();
         
         // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
@@ -287,72 +246,127 @@ void SendQueue::run() {
             newPacketCount = maybeSendNewPacket();
             attemptedToSendPacket = (newPacketCount > 0);
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+
+        if (!attemptedToSendPacket) {
+            return stepWhileIdle(now);
+        }
+
+        if (_isIdle) {
+            // we have been waiting for something to send, don't try to catch up on the time spent waiting
+            _isIdle = false;
+            _nextPacketTimestamp = now;
         }
 
         if (_packetSendPeriod > 0) {
             // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
-
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+            auto nextPacketDelta = std::chrono::microseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+            _nextPacketTimestamp += nextPacketDelta;
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
-
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
-
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
+            // we use nextPacketTimestamp so that we don't fall behind, not to force long waits
+            // we'll never allow nextPacketTimestamp to force us to wait for more than nextPacketDelta
+            if (_nextPacketTimestamp - now > nextPacketDelta) {
+                _nextPacketTimestamp = now + nextPacketDelta;
             }
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
+            // we're seeing SendQueues wait for a long period of time here, for now we guard this by capping the wait
+            const microseconds MAX_SEND_QUEUE_WAIT_USECS { 2000000 };
+            if (nextPacketDelta > MAX_SEND_QUEUE_WAIT_USECS) {
+                qWarning() << "udt::SendQueue wanted to wait for" << nextPacketDelta.count() << "microseconds";
+                qWarning() << "Capping wait to" << MAX_SEND_QUEUE_WAIT_USECS.count();
+                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta.count()
+                << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
                 << "NOW:" << now.time_since_epoch().count();
 
                 // alright, we're in a weird state
                 // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+                // send some details up to the API (if the user allows us) that indicate how we could such a large wait
                 static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
 
                 // setup a json object with the details we want
                 QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+                longSleepObject["timeToSleep"] = qint64(nextPacketDelta.count());
                 longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
+                longSleepObject["nextPacketDelta"] = qint64(nextPacketDelta.count());
+                longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
                 longSleepObject["then"] = qint64(now.time_since_epoch().count());
 
                 // hopefully send this event using the user activity logger
                 UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+
+                _nextPacketTimestamp = now + MAX_SEND_QUEUE_WAIT_USECS;
             }
-            
-            std::this_thread::sleep_for(timeToSleep);
+        }
+
+        now = p_high_resolution_clock::now();
+    }
+
+    return NO_NEXT_STEP;
+}
+
+p_high_resolution_clock::time_point SendQueue::stepWhileIdle(p_high_resolution_clock::time_point now) {
+    // During this step we didn't send any packets, so either the packet queue and loss list are empty, or the flow
+    // window is full. We wait until we are woken up by new data, an ACK or a NAK, or until a timeout.
+
+    bool allPacketsACKed = uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber);
+
+    microseconds waitTimeout;
+    if (allPacketsACKed) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+        waitTimeout = EMPTY_QUEUES_INACTIVE_TIMEOUT;
+    } else {
+        // We think the client is still waiting for data (based on the sequence number gap)
+        // Let's wait either for a response from the client or until the estimated timeout
+        // (plus the sync interval to allow the client to respond) has elapsed
+        waitTimeout = std::chrono::microseconds(_estimatedTimeout);
+
+        // Clamp timeout beween 10 ms and 5 s
+        waitTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, waitTimeout));
+    }
+
+    if (!_isIdle) {
+        _isIdle = true;
+        _idleTimeoutAt = now + waitTimeout;
+        return _idleTimeoutAt;
+    }
+
+    // when we are stepped again check if we're "stuck" either if we've waited for the timeout
+    // or it has been that long since the last time we sent a packet
+    bool timedOut = now >= _idleTimeoutAt || (!allPacketsACKed && now - _lastPacketSentAt > waitTimeout);
+    if (!timedOut) {
+        // we were woken up without anything to send, start waiting again
+        _idleTimeoutAt = now + waitTimeout;
+        return _idleTimeoutAt;
+    }
+
+    _isIdle = false;
+
+    if (allPacketsACKed) {
+#ifdef UDT_CONNECTION_DEBUG
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+            << waitTimeout.count() << "microseconds and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
+#endif
+
+        // Deactivate queue
+        deactivate();
+        return p_high_resolution_clock::time_point::max();
+    }
+
+    {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        std::lock_guard<std::mutex> nakLocker(_naksLock);
+        if (_naks.isEmpty() && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+            _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
         }
     }
+
+    emit timeout();
+
+    // re-send what was lost straight away
+    return now;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -395,20 +409,19 @@ bool SendQueue::maybeResendPacket() {
             QReadLocker sentLocker(&_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            auto entry = _sentPackets.find(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (entry) {
 
-                auto& entry = it->second;
                 // we found the packet - grab it
-                auto& resendPacket = *(entry.second);
-                ++entry.first; // Add 1 resend
+                auto& resendPacket = *(entry->packet);
+                ++entry->resendCount; // Add 1 resend
 
-                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry.first < 2 ? 0 : (entry.first - 2) % 4);
+                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry->resendCount < 2 ? 0 : (entry->resendCount - 2) % 4);
 
                 auto wireSize = resendPacket.getWireSize();
                 auto payloadSize = resendPacket.getPayloadSize();
-                auto sequenceNumber = it->first;
+                auto sequenceNumber = entry->sequenceNumber;
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -463,90 +476,6 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
-
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-
-#ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
-#endif
-
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
-
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-
-                auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
-
-                // Clamp timeout beween 10 ms and 5 s
-                estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
-
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, estimatedTimeout);
-
-                // when we wake-up check if we're "stuck" either if we've slept for the estimated timeout
-                // or it has been that long since the last time we sent a packet
-
-                // we are stuck if all of the following are true
-                // - there are no new packets to send or the flow window is full and we can't send any new packets
-                // - there are no packets to resend
-                // - the client has yet to ACK some sent packets
-                auto now = std::chrono::high_resolution_clock::now();
-
-                if ((cvStatus == std::cv_status::timeout || (now - _lastPacketSentAt > estimatedTimeout))
-                    && (_packets.isEmpty() || isFlowWindowFull())
-                    && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
-        }
-    }
-    
-    return false;
-}
-
 void SendQueue::deactivate() {
     // this queue is inactive - emit that signal and stop the while
     emit queueInactive();
@@ -559,5 +488,10 @@ bool SendQueue::isFlowWindowFull() const {
 }
 
 void SendQueue::updateDestinationAddress(HifiSockAddr newAddress) {
-    _destination = newAddress;
+    {
+        std::lock_guard<std::mutex> locker(_destinationLock);
+        _newDestination = newAddress;
+        _hasNewDestination = true;
+    }
+    wake();
 }
@@ -13,12 +13,10 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -31,6 +29,7 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SentPacketWindow.h"
 
 namespace udt {
     
@@ -39,7 +38,10 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
+class TransportEngine;
     
+// Paces the reliable packets of a Connection.  SendQueues don't have threads of their own - the TransportEngine
+// steps them on its I/O threads whenever they are due to send, or are woken up by new packets, ACKs or NAKs.
 class SendQueue : public QObject {
     Q_OBJECT
     
@@ -85,15 +87,20 @@ signals:
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    friend class TransportEngine;
+
+
     SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
+    // called by the TransportEngine - sends whatever is due and returns when the queue next wants to be stepped
+    p_high_resolution_clock::time_point step(p_high_resolution_clock::time_point now);
+    p_high_resolution_clock::time_point stepWhileIdle(p_high_resolution_clock::time_point now);
+    void wake();
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -102,7 +109,6 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -131,16 +137,22 @@ private:
     LossList _naks; // Sequence numbers of packets to resend
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SentPacketWindow _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
 
-    std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
+    std::mutex _destinationLock; // Protects the new destination address, which is picked up on the next step
+    HifiSockAddr _newDestination;
+    std::atomic<bool> _hasNewDestination { false };
+
+    // the following are only touched from step(), on the TransportEngine thread driving this queue
+    p_high_resolution_clock::time_point _lastPacketSentAt;
+    p_high_resolution_clock::time_point _nextPacketTimestamp; // when the next packet should go out, per the send period
+    p_high_resolution_clock::time_point _nextHandshakeAt;
+    p_high_resolution_clock::time_point _idleTimeoutAt; // when the current wait for something to send runs out
+    bool _isIdle { false };
+
+    std::atomic<int> _transportWorker { -1 }; // the TransportEngine thread stepping this queue
 
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
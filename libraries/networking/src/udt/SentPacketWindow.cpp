@@ -0,0 +1,67 @@
+//
+//  SentPacketWindow.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindow.h"
+
+#include "Packet.h"
+
+using namespace udt;
+
+// a power of two, so that the slab size always divides the sequence number space and indices survive the wrap around
+static const size_t INITIAL_SLOT_COUNT = 1024;
+static const size_t MAX_SLOT_COUNT = (size_t)SequenceNumber::MAX + 1;
+
+SentPacketWindow::Entry& SentPacketWindow::insert(SequenceNumber sequenceNumber) {
+    if (_slots.empty()) {
+        _slots.resize(INITIAL_SLOT_COUNT);
+    }
+
+    while (_slots[getIndex(sequenceNumber)].packet &&
+           _slots[getIndex(sequenceNumber)].sequenceNumber != sequenceNumber &&
+           _slots.size() < MAX_SLOT_COUNT) {
+        grow();
+    }
+
+    auto& entry = _slots[getIndex(sequenceNumber)];
+    if (!entry.packet) {
+        ++_size;
+    }
+    entry.sequenceNumber = sequenceNumber;
+    entry.resendCount = 0;
+    return entry;
+}
+
+SentPacketWindow::Entry* SentPacketWindow::find(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        return nullptr;
+    }
+
+    auto& entry = _slots[getIndex(sequenceNumber)];
+    return (entry.packet && entry.sequenceNumber == sequenceNumber) ? &entry : nullptr;
+}
+
+void SentPacketWindow::erase(SequenceNumber sequenceNumber) {
+    auto entry = find(sequenceNumber);
+    if (entry) {
+        entry->packet.reset();
+        --_size;
+    }
+}
+
+void SentPacketWindow::grow() {
+    std::vector<Entry> slots(_slots.size() * 2);
+    for (auto& entry : _slots) {
+        if (entry.packet) {
+            slots[(SequenceNumber::UType)entry.sequenceNumber & (slots.size() - 1)] = std::move(entry);
+        }
+    }
+    _slots.swap(slots);
+}
@@ -0,0 +1,60 @@
+//
+//  SentPacketWindow.h
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindow_h
+#define hifi_SentPacketWindow_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+class Packet;
+
+// Packets sent on a connection and waiting for an ACK, in a slab of slots indexed by sequence number modulo
+// the slab size.  Packets in flight have consecutive sequence numbers, so as long as the slab is larger than the
+// flight window no two of them share a slot; if they ever do, the slab doubles in size.
+class SentPacketWindow {
+public:
+    struct Entry {
+        SequenceNumber sequenceNumber;
+        uint8_t resendCount { 0 }; // number of times the packet was re-sent
+        std::unique_ptr<Packet> packet; // null if the slot is free
+    };
+
+    // returns the free slot for this sequence number, the caller fills in the packet
+    Entry& insert(SequenceNumber sequenceNumber);
+
+    // returns nullptr if there is no packet for this sequence number
+    Entry* find(SequenceNumber sequenceNumber);
+
+    void erase(SequenceNumber sequenceNumber);
+
+    int getSize() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+
+private:
+    size_t getIndex(SequenceNumber sequenceNumber) const {
+        return (SequenceNumber::UType)sequenceNumber & (_slots.size() - 1);
+    }
+
+    void grow();
+
+    std::vector<Entry> _slots;
+    int _size { 0 };
+};
+
+}
+
+#endif // hifi_SentPacketWindow_h
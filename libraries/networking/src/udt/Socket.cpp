@@ -19,6 +19,7 @@
 
 #include <shared/QtHelpers.h>
 #include <LogHandler.h>
+#include <SharedUtil.h>
 
 #include "../NetworkLogging.h"
 #include "Connection.h"
@@ -27,6 +28,8 @@
 #include "../NLPacket.h"
 #include "../NLPacketList.h"
 #include "PacketList.h"
+#include "PacketReplay.h"
+#include "TransportEngine.h"
 #include <Trace.h>
 
 using namespace udt;
@@ -56,6 +59,17 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    TransportEngine::getInstance().acquire();
+}
+
+Socket::~Socket() {
+    {
+        // the send queues of our connections have to leave the transport threads before we let go of them
+        Lock connectionsLock(_connectionsHashMutex);
+        _connectionsHash.clear();
+    }
+    TransportEngine::getInstance().release();
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
@@ -236,6 +250,11 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const HifiSockAddr&
 
 qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
 
+    // a replay stands in for the network, the peers the datagram would go to aren't listening
+    if (_isReplaying) {
+        return datagram.size();
+    }
+
     // don't attempt to write the datagram if we're unbound.  Just drop it.
     // _udpSocket.writeDatagram will return an error anyway, but there are
     // potential crashes in Qt when that happens.
@@ -410,78 +429,115 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        if (_isReplaying) {
+            // only the datagrams being replayed are processed
+            continue;
+        }
+
+        if (_capture) {
+            _capture->write(usecTimestampNow(), senderSockAddr, buffer.get(), packetSizeWithHeader);
+        }
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
 
-            continue;
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        return;
+    }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
-            }
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
+                    return;
                 }
+            } else if (connection) {
+                connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                            packet->getPayloadSize());
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
 }
 
+void Socket::startCapture(const QString& path, qint64 maxSize) {
+    qCDebug(networking) << "Capturing received datagrams to" << path << "- keeping at most" << maxSize << "bytes";
+    _capture.reset(new PacketCapture(path, maxSize));
+}
+
+void Socket::stopCapture() {
+    _capture.reset();
+}
+
+bool Socket::startReplay(const QString& path, float speed) {
+    if (_replay) {
+        _replay->deleteLater();
+    }
+
+    _replay = new PacketReplay(path, speed, [this](std::unique_ptr<char[]> buffer, qint64 size, const HifiSockAddr& senderSockAddr) {
+        processDatagram(std::move(buffer), size, senderSockAddr, p_high_resolution_clock::now());
+    }, this);
+    connect(_replay, &PacketReplay::finished, this, &Socket::replayFinished);
+
+    _isReplaying = _replay->start();
+    return _isReplaying;
+}
+
 void Socket::connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, const char* slot) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(destinationAddr);
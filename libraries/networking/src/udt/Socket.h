@@ -14,6 +14,7 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
@@ -26,6 +27,7 @@
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "PacketCapture.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -36,6 +38,7 @@ namespace udt {
 class BasePacket;
 class Packet;
 class PacketList;
+class PacketReplay;
 class SequenceNumber;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
@@ -56,6 +59,7 @@ public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -89,12 +93,22 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    // writes every datagram received from now on to a PacketCapture, must be called on the Socket thread
+    void startCapture(const QString& path, qint64 maxSize = PacketCapture::DEFAULT_MAX_SIZE);
+    void stopCapture();
+
+    // processes the datagrams of a capture as if they were received, instead of the ones that really are.
+    // Nothing is sent while replaying.  Must be called on the Socket thread, returns false if there is nothing to replay
+    bool startReplay(const QString& path, float speed = 1.0f);
+    bool isReplaying() const { return _isReplaying; }
+
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
 #endif
 
 signals:
     void clientHandshakeRequestComplete(const HifiSockAddr& sockAddr);
+    void replayFinished();
 
 public slots:
     void cleanupConnection(HifiSockAddr sockAddr);
@@ -110,6 +124,8 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void processDatagram(std::unique_ptr<char[]> buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
@@ -146,7 +162,11 @@ private:
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
-    
+
+    std::unique_ptr<PacketCapture> _capture;
+    PacketReplay* _replay { nullptr };
+    std::atomic<bool> _isReplaying { false }; // read by the threads that write to the socket
+
     friend UDTTest;
 };
     
@@ -0,0 +1,321 @@
+//
+//  TransportEngine.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TransportEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QThread>
+
+#include <PortableHighResolutionClock.h>
+
+#include "SendQueue.h"
+
+using namespace udt;
+
+namespace {
+
+using Clock = p_high_resolution_clock;
+using TimePoint = Clock::time_point;
+
+const TimePoint NO_DEADLINE = TimePoint::max();
+
+// entries of rescheduled queues stay in the heap until they come up, it is rebuilt once they outnumber the queues
+const size_t MIN_DEADLINES_BEFORE_COMPACTING = 64;
+
+const int MAX_TRANSPORT_THREADS = 4;
+
+}
+
+class TransportEngine::Worker : public QThread {
+public:
+    Worker(int index);
+
+    void add(SendQueue* queue);
+    void remove(SendQueue* queue);
+    void wake(SendQueue* queue);
+    void stop();
+
+    int getQueueCount() const { return _queueCount; }
+
+protected:
+    void run() override;
+
+private:
+    struct Entry {
+        SendQueue* queue;
+        uint64_t generation;
+        TimePoint deadline;
+
+        // orders the heap with the earliest deadline on top
+        bool operator<(const Entry& other) const { return deadline > other.deadline; }
+    };
+
+    struct QueueState {
+        uint64_t generation { 0 }; // only the deadline entry with the current generation is live
+        bool ready { false };
+    };
+
+    void makeReady(SendQueue* queue, QueueState& state);
+    void schedule(SendQueue* queue, QueueState& state, TimePoint deadline);
+    void collectDueQueues(TimePoint now);
+    TimePoint findEarliestDeadline();
+    void popDeadDeadlines();
+    bool isLive(const Entry& entry) const;
+
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _stepFinishedCondition;
+
+    std::vector<Entry> _deadlines; // a heap, see Entry::operator<
+
+    std::unordered_map<SendQueue*, QueueState> _queues;
+    std::deque<SendQueue*> _readyQueues;
+    uint64_t _nextGeneration { 1 };
+    std::atomic<int> _queueCount { 0 };
+
+    SendQueue* _steppingQueue { nullptr };
+    bool _steppingQueueWoken { false };
+    bool _stopped { false };
+};
+
+TransportEngine::Worker::Worker(int index) {
+    setObjectName("Networking: Transport " + QString::number(index));
+}
+
+void TransportEngine::Worker::add(SendQueue* queue) {
+    std::lock_guard<std::mutex> locker(_mutex);
+    auto& state = _queues[queue];
+    ++_queueCount;
+    makeReady(queue, state);
+}
+
+void TransportEngine::Worker::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> locker(_mutex);
+    _stepFinishedCondition.wait(locker, [&] { return _steppingQueue != queue; });
+
+    if (_queues.erase(queue) > 0) {
+        --_queueCount;
+        // deadline entries die with the state, but a stale pointer in the ready list could match a new queue at the same address
+        _readyQueues.erase(std::remove(_readyQueues.begin(), _readyQueues.end(), queue), _readyQueues.end());
+    }
+}
+
+void TransportEngine::Worker::wake(SendQueue* queue) {
+    std::lock_guard<std::mutex> locker(_mutex);
+    if (_steppingQueue == queue) {
+        // the step in progress may already have decided it has nothing to do, so it has to run again
+        _steppingQueueWoken = true;
+        return;
+    }
+    auto it = _queues.find(queue);
+    if (it != _queues.end() && !it->second.ready) {
+        makeReady(queue, it->second);
+    }
+}
+
+void TransportEngine::Worker::stop() {
+    {
+        std::lock_guard<std::mutex> locker(_mutex);
+        _stopped = true;
+    }
+    _wakeCondition.notify_one();
+}
+
+void TransportEngine::Worker::makeReady(SendQueue* queue, QueueState& state) {
+    state.generation = _nextGeneration++; // drops the queue's deadline entry, if it has one
+    state.ready = true;
+    _readyQueues.push_back(queue);
+    _wakeCondition.notify_one();
+}
+
+void TransportEngine::Worker::schedule(SendQueue* queue, QueueState& state, TimePoint deadline) {
+    if (deadline == NO_DEADLINE) {
+        // nothing to do until the queue is woken up
+        state.generation = _nextGeneration++;
+        return;
+    }
+    if (deadline <= Clock::now()) {
+        makeReady(queue, state);
+        return;
+    }
+    state.generation = _nextGeneration++;
+    _deadlines.push_back({ queue, state.generation, deadline });
+    std::push_heap(_deadlines.begin(), _deadlines.end());
+
+    if (_deadlines.size() > std::max(MIN_DEADLINES_BEFORE_COMPACTING, 2 * _queues.size())) {
+        _deadlines.erase(std::remove_if(_deadlines.begin(), _deadlines.end(), [this](const Entry& entry) {
+            return !isLive(entry);
+        }), _deadlines.end());
+        std::make_heap(_deadlines.begin(), _deadlines.end());
+    }
+}
+
+bool TransportEngine::Worker::isLive(const Entry& entry) const {
+    auto it = _queues.find(entry.queue);
+    return it != _queues.end() && it->second.generation == entry.generation;
+}
+
+void TransportEngine::Worker::popDeadDeadlines() {
+    while (!_deadlines.empty() && !isLive(_deadlines.front())) {
+        std::pop_heap(_deadlines.begin(), _deadlines.end());
+        _deadlines.pop_back();
+    }
+}
+
+void TransportEngine::Worker::collectDueQueues(TimePoint now) {
+    for (popDeadDeadlines(); !_deadlines.empty() && _deadlines.front().deadline <= now; popDeadDeadlines()) {
+        SendQueue* queue = _deadlines.front().queue;
+        std::pop_heap(_deadlines.begin(), _deadlines.end());
+        _deadlines.pop_back();
+
+        auto& state = _queues[queue];
+        state.ready = true;
+        _readyQueues.push_back(queue);
+    }
+}
+
+TimePoint TransportEngine::Worker::findEarliestDeadline() {
+    popDeadDeadlines();
+    return _deadlines.empty() ? NO_DEADLINE : _deadlines.front().deadline;
+}
+
+void TransportEngine::Worker::run() {
+    std::unique_lock<std::mutex> locker(_mutex);
+
+    while (!_stopped) {
+        collectDueQueues(Clock::now());
+
+        if (_readyQueues.empty()) {
+            auto deadline = findEarliestDeadline();
+            if (deadline == NO_DEADLINE) {
+                _wakeCondition.wait(locker);
+            } else {
+                _wakeCondition.wait_until(locker, deadline);
+            }
+            continue;
+        }
+
+        SendQueue* queue = _readyQueues.front();
+        _readyQueues.pop_front();
+
+        auto it = _queues.find(queue);
+        if (it == _queues.end()) {
+            continue;
+        }
+        it->second.ready = false;
+
+        _steppingQueue = queue;
+        _steppingQueueWoken = false;
+        locker.unlock();
+
+        auto nextStep = stepQueue(queue, Clock::now());
+
+        locker.lock();
+        _steppingQueue = nullptr;
+
+        // remove() waits for the step to finish, so the queue is still ours
+        it = _queues.find(queue);
+        if (it != _queues.end()) {
+            if (_steppingQueueWoken) {
+                makeReady(queue, it->second);
+            } else {
+                schedule(queue, it->second, nextStep);
+            }
+        }
+        _stepFinishedCondition.notify_all();
+    }
+}
+
+TimePoint TransportEngine::stepQueue(SendQueue* queue, TimePoint now) {
+    return queue->step(now);
+}
+
+TransportEngine& TransportEngine::getInstance() {
+    static TransportEngine instance { std::max(1, std::min(QThread::idealThreadCount() / 2, MAX_TRANSPORT_THREADS)) };
+    return instance;
+}
+
+TransportEngine::TransportEngine(int numThreads) : _numThreads(numThreads) {
+}
+
+TransportEngine::~TransportEngine() {
+    // only reached with threads still running if a Socket outlived the engine
+    stopWorkers();
+}
+
+void TransportEngine::acquire() {
+    std::lock_guard<std::mutex> locker(_usersMutex);
+    if (_numUsers++ == 0) {
+        startWorkers();
+    }
+}
+
+void TransportEngine::release() {
+    std::lock_guard<std::mutex> locker(_usersMutex);
+    Q_ASSERT(_numUsers > 0);
+    if (--_numUsers == 0) {
+        Q_ASSERT_X(getQueueCount() == 0, "TransportEngine::release()", "Queues left when the last Socket went away");
+        stopWorkers();
+    }
+}
+
+void TransportEngine::startWorkers() {
+    for (int i = 0; i < _numThreads; ++i) {
+        _workers.emplace_back(new Worker(i));
+        _workers.back()->start();
+    }
+}
+
+void TransportEngine::stopWorkers() {
+    for (auto& worker : _workers) {
+        worker->stop();
+        worker->wait();
+    }
+    _workers.clear();
+}
+
+void TransportEngine::addQueue(SendQueue* queue) {
+    Q_ASSERT(queue->_transportWorker == -1);
+    Q_ASSERT_X(!_workers.empty(), "TransportEngine::addQueue()", "Adding a queue while no Socket holds the engine");
+
+    auto leastLoaded = std::min_element(_workers.begin(), _workers.end(), [](const auto& a, const auto& b) {
+        return a->getQueueCount() < b->getQueueCount();
+    });
+    queue->_transportWorker = (int)(leastLoaded - _workers.begin());
+    (*leastLoaded)->add(queue);
+}
+
+void TransportEngine::removeQueue(SendQueue* queue) {
+    if (queue->_transportWorker != -1) {
+        _workers[queue->_transportWorker]->remove(queue);
+        queue->_transportWorker = -1;
+    }
+}
+
+void TransportEngine::wakeQueue(SendQueue* queue) {
+    if (queue->_transportWorker != -1) {
+        _workers[queue->_transportWorker]->wake(queue);
+    }
+}
+
+int TransportEngine::getQueueCount() const {
+    int count = 0;
+    for (const auto& worker : _workers) {
+        count += worker->getQueueCount();
+    }
+    return count;
+}
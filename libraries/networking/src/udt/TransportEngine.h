@@ -0,0 +1,71 @@
+//
+//  TransportEngine.h
+//  libraries/networking/src/udt
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TransportEngine_h
+#define hifi_TransportEngine_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Drives every SendQueue in the process from a small, fixed set of I/O threads, instead of giving each reliable
+// connection a thread of its own.  Each thread keeps its queues in a min-heap keyed by the time the queue next
+// wants to send, so idle queues cost nothing until they are woken up or one of their timeouts comes around.
+// The threads run while a Socket is using the engine, they are started by the first one and joined after the last.
+class TransportEngine {
+public:
+    static TransportEngine& getInstance();
+
+    TransportEngine(int numThreads);
+    ~TransportEngine();
+
+    // called by each Socket when it is made and destroyed, the threads only run while a Socket holds the engine
+    void acquire();
+    void release();
+
+    // starts stepping a queue on the least loaded thread, the engine must be held by the queue's Socket
+    void addQueue(SendQueue* queue);
+
+    // stops stepping a queue, waiting for a step already in progress to finish
+    void removeQueue(SendQueue* queue);
+
+    // asks for a queue to be stepped as soon as possible, for example because it has new packets or ACKs
+    void wakeQueue(SendQueue* queue);
+
+    int getThreadCount() const { return (int)_workers.size(); }
+    int getQueueCount() const;
+
+private:
+    class Worker;
+
+    static p_high_resolution_clock::time_point stepQueue(SendQueue* queue, p_high_resolution_clock::time_point now);
+
+    void startWorkers();
+    void stopWorkers();
+
+    const int _numThreads;
+
+    std::mutex _usersMutex;
+    int _numUsers { 0 };
+
+    // only changes while no Socket holds the engine, so no queue can be using it
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+}
+
+#endif // hifi_TransportEngine_h
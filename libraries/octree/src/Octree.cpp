@@ -44,6 +44,7 @@
 #include <ResourceManager.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
+#include <ReceivedMessage.h>
 #include <ViewFrustum.h>
 
 #include "OctreeConstants.h"
@@ -404,6 +405,41 @@ void Octree::readBitstreamToTree(const unsigned char * bitstream, uint64_t buffe
     }
 }
 
+Octree::EditBatchStats Octree::processEditPacketBatch(const std::vector<NodeSharedReceivedMessagePair>& messages) {
+    EditBatchStats stats;
+    stats.editsPerMessage.resize(messages.size(), 0);
+
+    quint64 startLock = usecTimestampNow();
+    withWriteLock([&] {
+        quint64 startProcess = usecTimestampNow();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            stats.editsPerMessage[i] = processEditMessage(*messages[i].second, messages[i].first);
+            stats.editsReceived += stats.editsPerMessage[i];
+        }
+        stats.lockWaitUsecs = startProcess - startLock;
+        stats.lockHoldUsecs = usecTimestampNow() - startProcess;
+    });
+    stats.editsApplied = stats.editsReceived;
+
+    return stats;
+}
+
+int Octree::processEditMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode) {
+    int editsInMessage = 0;
+    while (message.getBytesLeftToRead() > 0) {
+        const unsigned char* editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+        int editDataBytesRead = processEditPacketData(message, editData, message.getBytesLeftToRead(), sourceNode);
+        ++editsInMessage;
+        if (editDataBytesRead <= 0) {
+            break;
+        }
+
+        // skip to next edit record in the packet
+        message.seek(message.getPosition() + editDataBytesRead);
+    }
+    return editsInMessage;
+}
+
 void Octree::eraseAllOctreeElements(bool createNewRoot) {
     if (createNewRoot) {
         _rootElement = createNewElement();
@@ -700,6 +736,7 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
+    quint64 decompressStart = usecTimestampNow();
     QByteArray compressedJsonData = file.readAll();
     QByteArray jsonData;
 
@@ -707,11 +744,15 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "json File not in gzip format: " << qFileName;
         return false;
     }
+    compressedJsonData.clear();
+    quint64 decompressUsecs = usecTimestampNow() - decompressStart;
 
     QDataStream jsonStream(jsonData);
     QUrl relativeURL = QUrl::fromLocalFile(qFileName).adjusted(QUrl::RemoveFilename);
 
-    return readJSONFromStream(-1, jsonStream, "", false, relativeURL);
+    bool success = readJSONFromStream(-1, jsonStream, "", false, relativeURL);
+    _lastLoadTimings.decompressUsecs = decompressUsecs;
+    return success;
 }
 
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
@@ -848,22 +889,31 @@ bool Octree::readJSONFromStream(
     const bool isImport,
     const QUrl& relativeURL
 ) {
+    _lastLoadTimings = LoadTimings();
+    quint64 parseStart = usecTimestampNow();
+
     // if the data is gzipped we may not have a useful bytesAvailable() result, so just keep reading until
     // we get an eof.  Leave streamLength parameter for consistency.
 
     QByteArray jsonBuffer;
-    char* rawData = new char[READ_JSON_BUFFER_SIZE];
-    while (!inputStream.atEnd()) {
-        int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
-        if (got < 0) {
-            qCritical() << "error while reading from json stream";
-            delete[] rawData;
-            return false;
-        }
-        if (got == 0) {
-            break;
+    QIODevice* device = inputStream.device();
+    if (device) {
+        jsonBuffer = device->readAll();
+    } else {
+        char* rawData = new char[READ_JSON_BUFFER_SIZE];
+        while (!inputStream.atEnd()) {
+            int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
+            if (got < 0) {
+                qCritical() << "error while reading from json stream";
+                delete[] rawData;
+                return false;
+            }
+            if (got == 0) {
+                break;
+            }
+            jsonBuffer += QByteArray(rawData, got);
         }
-        jsonBuffer += QByteArray(rawData, got);
+        delete[] rawData;
     }
 
     OctreeEntitiesFileParser octreeParser;
@@ -875,14 +925,15 @@ bool Octree::readJSONFromStream(
         qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
         return false;
     }
+    jsonBuffer.clear();
 
     if (!marketplaceID.isEmpty()) {
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
+    _lastLoadTimings.parseUsecs = usecTimestampNow() - parseStart;
 
-    bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
-    return success;
+    // readFromMap fills in the convert and build stages
+    return readFromMap(asMap, isImport);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
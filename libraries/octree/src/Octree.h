@@ -138,6 +138,20 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    class EditBatchStats {
+    public:
+        int editsReceived { 0 };
+        int editsApplied { 0 }; // after coalescing
+        quint64 lockWaitUsecs { 0 };
+        quint64 lockHoldUsecs { 0 };
+        std::vector<int> editsPerMessage;
+    };
+
+    /// Applies every edit in a batch of edit messages, each positioned at its first edit, in one write lock.
+    /// Subclasses may decode edits before taking the lock and coalesce edits to the same target, provided each
+    /// target ends up as if its edits were applied one at a time in arrival order.
+    virtual EditBatchStats processEditPacketBatch(const std::vector<NodeSharedReceivedMessagePair>& messages);
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -215,6 +229,16 @@ public:
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
 
     // Octree importers
+    class LoadTimings {
+    public:
+        quint64 decompressUsecs { 0 };
+        quint64 parseUsecs { 0 };
+        quint64 convertUsecs { 0 };
+        quint64 buildUsecs { 0 };
+    };
+    /// Time spent in each stage of the most recent JSON import
+    const LoadTimings& getLastLoadTimings() const { return _lastLoadTimings; }
+
     bool readFromFile(const char* filename);
     bool readFromURL(const QString& url, const bool isObservable = true, const qint64 callerId = -1, const bool isImport = false); // will support file urls as well...
     bool readFromByteArray(const QString& url, const QByteArray& byteArray);
@@ -245,6 +269,7 @@ public:
 
     virtual void dumpTree() { }
     virtual void pruneTree() { }
+    virtual int rebalanceTree() { return 0; }
 
     void setOctreeVersionInfo(QUuid id, int64_t dataVersion) {
         _persistID = id;
@@ -263,6 +288,9 @@ public:
 
 
 protected:
+    // applies every edit left in an edit message through processEditPacketData(), returns the number of edits
+    int processEditMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
+
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
 
     static bool countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData);
@@ -277,6 +305,8 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
+    LoadTimings _lastLoadTimings;
+
     bool _isDirty;
     bool _shouldReaverage;
 
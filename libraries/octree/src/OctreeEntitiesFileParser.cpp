@@ -18,6 +18,8 @@
 #include <QUuid>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
 
 
 using std::string;
@@ -214,12 +216,17 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
+// Entities per parse job - large enough that QJsonDocument dominates the cost of the job.
+const size_t ENTITIES_PER_PARSE_JOB = 256;
+
 bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
     if (nextToken() != '[') {
         _errorString = "Entities entry is not an array";
         return false;
     }
 
+    // Find the extent of each entity object first, this is a cheap serial scan.
+    std::vector<EntitySpan> spans;
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -231,112 +238,153 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
+        spans.push_back({ _position - 1, matchingBrace - _position + 1 });
+        _position = matchingBrace;
+        char c = nextToken();
+        if (c == ']') {
+            break;
+        } else if (c != ',') {
+            _errorString = "Entity array item incorrectly terminated";
             return false;
         }
+    }
+
+    // Then hand runs of entities to the thread pool for the expensive JSON parse.
+    int badEntity = -1;
+    if (!_parallelParsing || spans.size() <= ENTITIES_PER_PARSE_JOB) {
+        badEntity = parseEntitySpans(_entitiesContents, _relativeURL, spans, 0, spans.size(), entitiesArray);
+    } else {
+        size_t numJobs = (spans.size() + ENTITIES_PER_PARSE_JOB - 1) / ENTITIES_PER_PARSE_JOB;
+        std::vector<QVariantList> jobResults(numJobs);
+        std::vector<QFuture<int>> jobs;
+        jobs.reserve(numJobs);
+        for (size_t i = 0; i < numJobs; ++i) {
+            size_t begin = i * ENTITIES_PER_PARSE_JOB;
+            size_t end = std::min(begin + ENTITIES_PER_PARSE_JOB, spans.size());
+            QVariantList& result = jobResults[i];
+            jobs.push_back(QtConcurrent::run(QThreadPool::globalInstance(), [this, &spans, &result, begin, end] {
+                return parseEntitySpans(_entitiesContents, _relativeURL, spans, begin, end, result);
+            }));
+        }
+
+        entitiesArray.reserve((int)spans.size());
+        for (size_t i = 0; i < numJobs; ++i) {
+            int jobBadEntity = jobs[i].result();
+            if (jobBadEntity >= 0 && badEntity < 0) {
+                badEntity = jobBadEntity;
+            }
+            entitiesArray.append(jobResults[i]);
+        }
+    }
+
+    if (badEntity >= 0) {
+        _position = spans[badEntity].start;
+        _errorString = "Ill-formed entity";
+        return false;
+    }
+
+    return true;
+}
+
+int OctreeEntitiesFileParser::parseEntitySpans(const QByteArray& contents, const QUrl& relativeURL,
+                                               const std::vector<EntitySpan>& spans, size_t begin, size_t end,
+                                               QVariantList& entitiesArray) {
+    entitiesArray.reserve(entitiesArray.size() + (int)(end - begin));
+    for (size_t i = begin; i < end; ++i) {
+        const EntitySpan& span = spans[i];
+        QJsonDocument entity = QJsonDocument::fromJson(QByteArray::fromRawData(contents.constData() + span.start,
+                                                                               span.length));
+        if (entity.isNull()) {
+            return (int)i;
+        }
 
         QJsonObject entityObject = entity.object();
 
         // resolve urls starting with ./ or ../ 
-        if (!_relativeURL.isEmpty()) {
-            bool isDirty = false;
-
-            const QStringList urlKeys { 
-                // model
-                "modelURL",
-                "animation.url",
-                "textures",
-                // image
-                "imageURL",
-                // web
-                "sourceUrl",
-                "scriptURL",
-                // zone
-                "ambientLight.ambientURL",
-                "skybox.url",
-                // particles
-                //"textures",  Already specified for model entity type.
-                // materials
-                "materialURL",
-                // ...shared
-                "href",
-                "script",
-                "serverScripts",
-                "collisionSoundURL",
-                "compoundShapeURL",
-                // TODO: deal with materialData and userData
-            };
+        if (!relativeURL.isEmpty()) {
+            resolveRelativeURLs(relativeURL, entityObject);
+        }
 
-            for (const QString& key : urlKeys) {
-                if (key.contains('.')) {
-                    // url is inside another object
-                    const QStringList keyPair = key.split('.');
-                    const QString entityKey = keyPair[0];
-                    const QString childKey = keyPair[1];
+        entitiesArray.append(entityObject);
+    }
 
-                    if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
-                        QJsonObject childObject = entityObject[entityKey].toObject();
+    return -1;
+}
 
-                        if (childObject.contains(childKey) && childObject[childKey].isString()) {
-                            const QString url = childObject[childKey].toString();
+void OctreeEntitiesFileParser::resolveRelativeURLs(const QUrl& relativeURL, QJsonObject& entityObject) {
+    static const QStringList urlKeys { 
+        // model
+        "modelURL",
+        "animation.url",
+        "textures",
+        // image
+        "imageURL",
+        // web
+        "sourceUrl",
+        "scriptURL",
+        // zone
+        "ambientLight.ambientURL",
+        "skybox.url",
+        // particles
+        //"textures",  Already specified for model entity type.
+        // materials
+        "materialURL",
+        // ...shared
+        "href",
+        "script",
+        "serverScripts",
+        "collisionSoundURL",
+        "compoundShapeURL",
+        // TODO: deal with materialData and userData
+    };
 
-                            if (url.startsWith("./") || url.startsWith("../")) {
-                                childObject[childKey] = _relativeURL.resolved(url).toString();
-                                entityObject[entityKey] = childObject;
-                                isDirty = true;
-                            }
-                        }
+    for (const QString& key : urlKeys) {
+        if (key.contains('.')) {
+            // url is inside another object
+            const QStringList keyPair = key.split('.');
+            const QString entityKey = keyPair[0];
+            const QString childKey = keyPair[1];
+
+            if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
+                QJsonObject childObject = entityObject[entityKey].toObject();
+
+                if (childObject.contains(childKey) && childObject[childKey].isString()) {
+                    const QString url = childObject[childKey].toString();
+
+                    if (url.startsWith("./") || url.startsWith("../")) {
+                        childObject[childKey] = relativeURL.resolved(url).toString();
+                        entityObject[entityKey] = childObject;
                     }
-                } else {
-                    if (entityObject.contains(key) && entityObject[key].isString()) {
-                        const QString value = entityObject[key].toString();
-
-                        if (value.startsWith("./") || value.startsWith("../")) {
-                            // URL value.
-                            entityObject[key] = _relativeURL.resolved(value).toString();
-                            isDirty = true;
-                        } else if (value.startsWith("{")) {
-                            // Object with URL values.
-                            auto document = QJsonDocument::fromJson(value.toUtf8());
-                            if (!document.isNull()) {
-                                auto object = document.object();
-                                bool isObjectUpdated = false;
-                                for (const QString& key : object.keys()) {
-                                    auto value = object[key].toString();
-                                    if (value.startsWith("./") || value.startsWith("../")) {
-                                        object[key] = _relativeURL.resolved(value).toString();
-                                        isObjectUpdated = true;
-                                    }
-                                }
-                                if (isObjectUpdated) {
-                                    entityObject[key] = QString(QJsonDocument(object).toJson());
-                                    isDirty = true;
-                                }
+                }
+            }
+        } else {
+            if (entityObject.contains(key) && entityObject[key].isString()) {
+                const QString value = entityObject[key].toString();
+
+                if (value.startsWith("./") || value.startsWith("../")) {
+                    // URL value.
+                    entityObject[key] = relativeURL.resolved(value).toString();
+                } else if (value.startsWith("{")) {
+                    // Object with URL values.
+                    auto document = QJsonDocument::fromJson(value.toUtf8());
+                    if (!document.isNull()) {
+                        auto object = document.object();
+                        bool isObjectUpdated = false;
+                        for (const QString& key : object.keys()) {
+                            auto value = object[key].toString();
+                            if (value.startsWith("./") || value.startsWith("../")) {
+                                object[key] = relativeURL.resolved(value).toString();
+                                isObjectUpdated = true;
                             }
                         }
+                        if (isObjectUpdated) {
+                            entityObject[key] = QString(QJsonDocument(object).toJson());
+                        }
                     }
                 }
             }
-
-            if (isDirty) {
-                entity.setObject(entityObject);
-            }
-        }
-
-        entitiesArray.append(entityObject);
-        _position = matchingBrace;
-        char c = nextToken();
-        if (c == ']') {
-            return true;
-        } else if (c != ',') {
-            _errorString = "Entity array item incorrectly terminated";
-            return false;
         }
     }
-    return true;
 }
 
 int OctreeEntitiesFileParser::findMatchingBrace() const {
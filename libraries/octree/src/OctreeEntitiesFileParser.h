@@ -10,11 +10,15 @@
 //
 
 // Parse the top-level of the Models object ourselves - use QJsonDocument for each Entity object.
+// The Entities array is split into runs of entity objects which are parsed on the global thread pool.
 
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <vector>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
@@ -22,22 +26,34 @@ class OctreeEntitiesFileParser {
 public:
     void setEntitiesString(const QByteArray& entitiesContents);
     void setRelativeURL(const QUrl& relativeURL) { _relativeURL = relativeURL; }
+    void setParallelParsing(bool parallelParsing) { _parallelParsing = parallelParsing; }
     bool parseEntities(QVariantMap& parsedEntities);
     std::string getErrorString() const;
 
 private:
+    struct EntitySpan {
+        int start;
+        int length;
+    };
+
     int nextToken();
     std::string readString();
     int readInteger();
     bool readEntitiesArray(QVariantList& entitiesArray);
     int findMatchingBrace() const;
 
+    // Parse entities[begin, end) into entitiesArray, returns the index of the first ill-formed entity or -1 on success.
+    static int parseEntitySpans(const QByteArray& contents, const QUrl& relativeURL, const std::vector<EntitySpan>& spans,
+                                size_t begin, size_t end, QVariantList& entitiesArray);
+    static void resolveRelativeURLs(const QUrl& relativeURL, QJsonObject& entityObject);
+
     QByteArray _entitiesContents;
     QUrl _relativeURL;
     int _position { 0 };
     int _line { 1 };
     int _entitiesLength { 0 };
     std::string _errorString;
+    bool _parallelParsing { true };
 };
 
 #endif  // hifi_OctreeEntitiesFileParser_h
@@ -39,6 +39,7 @@
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
+constexpr std::chrono::seconds TIME_BETWEEN_REBALANCING { 60 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
@@ -110,13 +111,11 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     bool includesNewData;
     message->readPrimitive(&includesNewData);
-    QByteArray replacementData;
     OctreeUtils::RawOctreeData data;
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
-        replacementData = message->readAll();
-        replaceData(replacementData);
+        replaceData(*message);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
@@ -150,6 +149,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    Octree::LoadTimings loadTimings;
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
@@ -161,11 +161,19 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
         _tree->pruneTree();
+        loadTimings = _tree->getLastLoadTimings();
     });
+    {
+        std::lock_guard<std::mutex> lock(_loadTimingsMutex);
+        _loadTimings = loadTimings;
+    }
 
     _cachedJSONData.clear();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
+    qCDebug(octree) << "Load time breakdown (usecs): decompress" << loadTimings.decompressUsecs
+        << "parse" << loadTimings.parseUsecs << "convert" << loadTimings.convertUsecs
+        << "build" << loadTimings.buildUsecs;
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
@@ -191,8 +199,9 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    _lastRebalance = _lastPersistCheck;
 
-    if (replacementData.isNull()) {
+    if (!includesNewData) {
         sendLatestEntityDataToDS();
     }
 
@@ -223,6 +232,21 @@ void OctreePersistThread::replaceData(QByteArray data) {
     }
 }
 
+void OctreePersistThread::replaceData(ReceivedMessage& message) {
+    backupCurrentFile();
+
+    QFile currentFile { _filename };
+    if (currentFile.open(QIODevice::WriteOnly)) {
+        // write the packets of the reply out as they are, rather than joining them into one buffer first
+        message.readSegments(message.getBytesLeftToRead(), [&currentFile](const char* data, qint64 size) {
+            currentFile.write(data, size);
+        });
+        qDebug() << "Wrote replacement data";
+    } else {
+        qWarning() << "Failed to write replacement data";
+    }
+}
+
 // Return true if current file is backed up successfully or doesn't exist.
 bool OctreePersistThread::backupCurrentFile() {
     // first take the current models file and move it to a different filename, appended with the timestamp
@@ -254,6 +278,16 @@ void OctreePersistThread::process() {
         persist();
     }
 
+    // move entities whose queryAACube changed without a move back into their best fit elements. Each pass
+    // relocates a bounded number of them and only prunes the elements they left, not the whole tree.
+    if (_initialLoadComplete && now - _lastRebalance > TIME_BETWEEN_REBALANCING) {
+        _lastRebalance = now;
+        int relocatedCount = _tree->rebalanceTree();
+        if (relocatedCount > 0) {
+            qCDebug(octree) << "Rebalanced octree, relocated" << relocatedCount << "entities";
+        }
+    }
+
     QTimer::singleShot(TIME_BETWEEN_PROCESSING.count(), this, &OctreePersistThread::process);
 }
 
@@ -263,6 +297,11 @@ void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
+Octree::LoadTimings OctreePersistThread::getLoadTimings() const {
+    std::lock_guard<std::mutex> lock(_loadTimingsMutex);
+    return _loadTimings;
+}
+
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
     QFile file(_filename);
@@ -14,6 +14,8 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <mutex>
+
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
@@ -40,6 +42,7 @@ public:
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
+    Octree::LoadTimings getLoadTimings() const;
 
     QString getPersistFilename() const { return _filename; }
     QString getPersistFileMimeType() const;
@@ -63,6 +66,7 @@ protected:
     void cleanupOldReplacementBackups();
 
     void replaceData(QByteArray data);
+    void replaceData(ReceivedMessage& message); // writes the rest of the message to the file as it is read
     void sendLatestEntityDataToDS();
 
 private:
@@ -70,9 +74,12 @@ private:
     QString _filename;
     std::chrono::milliseconds _persistInterval;
     std::chrono::steady_clock::time_point _lastPersistCheck;
+    std::chrono::steady_clock::time_point _lastRebalance;
     bool _initialLoadComplete;
 
     quint64 _loadTimeUSecs;
+    mutable std::mutex _loadTimingsMutex; // the stats are read from the server's thread
+    Octree::LoadTimings _loadTimings;
 
     bool _debugTimestampNow;
     quint64 _lastTimeDebug;
@@ -1277,6 +1277,14 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    _loadingPriority = priority;
+    auto resource = _renderWatcher.getResource();
+    if (resource && !resource->isLoaded()) {
+        resource->setLoadPriority(this, priority);
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
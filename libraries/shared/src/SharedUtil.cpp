@@ -17,6 +17,7 @@
 #include <cstring>
 #include <cctype>
 #include <time.h>
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -122,15 +123,15 @@ void setGlobalInstance(const char* propertyName, const QVariant& variant) {
     }
 }
 
-static qint64 usecTimestampNowAdjust = 0; // in usec
+static std::atomic<qint64> usecTimestampNowAdjust { 0 }; // in usec, can be changed while other threads read the time
 void usecTimestampNowForceClockSkew(qint64 clockSkew) {
-    ::usecTimestampNowAdjust = clockSkew;
+    ::usecTimestampNowAdjust.store(clockSkew, std::memory_order_relaxed);
 }
 
 quint64 usecTimestampNow(bool wantDebug) {
     using namespace std::chrono;
     static const auto unixEpoch = system_clock::from_time_t(0);
-    return duration_cast<microseconds>(system_clock::now() - unixEpoch).count() + usecTimestampNowAdjust;
+    return duration_cast<microseconds>(system_clock::now() - unixEpoch).count() + usecTimestampNowAdjust.load(std::memory_order_relaxed);
 }
 
 float secTimestampNow() {
@@ -0,0 +1,171 @@
+//
+//  BakingScheduler.cpp
+//  libraries/shared/src/shared
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakingScheduler.h"
+
+#include <algorithm>
+
+static const double BYTES_PER_MB = 1024.0 * 1024.0;
+
+// bakes take some time whatever their size, starting the oven and writing the output
+static const qint64 FIXED_COST_BYTES = 64 * 1024;
+
+static const double DEFAULT_MSECS_PER_MB = 1000.0;
+
+// how much the time of the last bake of a kind counts in the expected time of the next ones
+static const double RATE_SMOOTHING = 0.3;
+
+BakingScheduler::BakingScheduler(QThreadPool& threadPool, int maxConcurrentBakes, qint64 memoryBudget) :
+    _threadPool(threadPool)
+{
+    setLimits(maxConcurrentBakes, memoryBudget);
+}
+
+void BakingScheduler::setLimits(int maxConcurrentBakes, qint64 memoryBudget) {
+    _maxConcurrentBakes = std::max(maxConcurrentBakes, 1);
+    _memoryBudget = memoryBudget;
+
+    // the scheduler keeps the bakes that can't start yet, the pool never has to queue any
+    _threadPool.setMaxThreadCount(_maxConcurrentBakes);
+
+    startBakes();
+}
+
+void BakingScheduler::setInitialRate(const QString& kind, double msecsPerMB) {
+    _msecsPerMB[kind] = msecsPerMB;
+}
+
+bool BakingScheduler::enqueue(const Bake& bake) {
+    if (contains(bake.key)) {
+        return false;
+    }
+
+    QueuedBake queuedBake { bake, QElapsedTimer() };
+    queuedBake.queuedTimer.start();
+    _queue.push_back(queuedBake);
+    _queuedKeys.insert(bake.key);
+
+    startBakes();
+    return true;
+}
+
+void BakingScheduler::bakeFinished(const QString& key) {
+    endBake(key, true);
+}
+
+void BakingScheduler::bakeAborted(const QString& key) {
+    endBake(key, false);
+}
+
+QStringList BakingScheduler::clearQueued() {
+    QStringList keys;
+    for (auto& queuedBake : _queue) {
+        keys << queuedBake.bake.key;
+    }
+    _queue.clear();
+    _queuedKeys.clear();
+    return keys;
+}
+
+BakingScheduler::Stats BakingScheduler::getStats() const {
+    Stats stats;
+    stats.numQueued = (int)_queue.size();
+    stats.maxConcurrentBakes = _maxConcurrentBakes;
+    stats.memoryInUse = _memoryInUse;
+
+    double remainingMsecs = 0.0;
+    for (auto& queuedBake : _queue) {
+        remainingMsecs += expectedMsecs(queuedBake.bake.kind, queuedBake.bake.size);
+    }
+    for (auto& runningBake : _running) {
+        auto elapsed = runningBake.timer.elapsed();
+        remainingMsecs += std::max(expectedMsecs(runningBake.bake.kind, runningBake.bake.size) - elapsed, 0.0);
+
+        auto& bake = runningBake.bake;
+        stats.running.push_back({ bake.key, bake.path, bake.kind, bake.size, elapsed });
+    }
+    stats.etaMsecs = (qint64)(remainingMsecs / _maxConcurrentBakes);
+
+    stats.recent.assign(_recent.begin(), _recent.end());
+    return stats;
+}
+
+double BakingScheduler::expectedMsecs(const QString& kind, qint64 size) const {
+    return _msecsPerMB.value(kind, DEFAULT_MSECS_PER_MB) * (size + FIXED_COST_BYTES) / BYTES_PER_MB;
+}
+
+void BakingScheduler::endBake(const QString& key, bool wasTimed) {
+    auto it = _running.find(key);
+    if (it == _running.end()) {
+        return;
+    }
+
+    auto& bake = it->bake;
+    _memoryInUse -= bake.memoryEstimate;
+
+    if (wasTimed) {
+        auto msecs = it->timer.elapsed();
+        double msecsPerMB = msecs * BYTES_PER_MB / (bake.size + FIXED_COST_BYTES);
+        _msecsPerMB[bake.kind] = RATE_SMOOTHING * msecsPerMB +
+            (1.0 - RATE_SMOOTHING) * _msecsPerMB.value(bake.kind, DEFAULT_MSECS_PER_MB);
+
+        _recent.push_front({ bake.key, bake.path, bake.kind, bake.size, msecs });
+        if ((int)_recent.size() > MAX_RECENT_BAKES) {
+            _recent.pop_back();
+        }
+    }
+
+    _running.erase(it);
+    startBakes();
+}
+
+void BakingScheduler::startBakes() {
+    while (!_queue.empty() && _running.size() < _maxConcurrentBakes) {
+        auto next = _queue.end();
+
+        if (_queue.front().queuedTimer.elapsed() > MAX_WAIT_MSECS) {
+            // a bake that waited too long goes first, and the ones behind it wait for it to fit in the memory budget
+            next = _queue.begin();
+            if (!_running.empty() && _memoryInUse + next->bake.memoryEstimate > _memoryBudget) {
+                break;
+            }
+        } else {
+            double shortestMsecs = 0.0;
+            for (auto it = _queue.begin(); it != _queue.end(); ++it) {
+                if (!_running.empty() && _memoryInUse + it->bake.memoryEstimate > _memoryBudget) {
+                    continue;
+                }
+
+                // with nothing running, the bake is started even if it is expected to need more than the whole budget
+                double msecs = expectedMsecs(it->bake.kind, it->bake.size);
+                if (next == _queue.end() || msecs < shortestMsecs) {
+                    next = it;
+                    shortestMsecs = msecs;
+                }
+            }
+        }
+
+        if (next == _queue.end()) {
+            break;
+        }
+
+        Bake bake = next->bake;
+        _queue.erase(next);
+        _queuedKeys.remove(bake.key);
+
+        RunningBake& runningBake = _running[bake.key];
+        runningBake.bake = bake;
+        runningBake.timer.start();
+        _memoryInUse += bake.memoryEstimate;
+
+        _threadPool.start(bake.runnable);
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  BakingScheduler.h
+//  libraries/shared/src/shared
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakingScheduler_h
+#define hifi_BakingScheduler_h
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QRunnable>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+
+// Runs bakes on a thread pool, as many at a time as a number of concurrent bakes and a memory budget allow.
+// The bakes expected to finish first are started first, so that small scripts and textures don't wait behind huge
+// models, unless a bake has been waiting for longer than MAX_WAIT_MSECS.  How long bakes take is learned per kind of
+// bake, from the bakes that finished, to order the queue and estimate when it will be empty.
+// Not thread safe, all members are to be called from the thread the scheduler was created on.
+class BakingScheduler {
+public:
+    static const qint64 MAX_WAIT_MSECS = 10 * 60 * 1000;
+
+    struct Bake {
+        QString key; // bakes with the same key are only queued once
+        QString path;
+        QString kind; // model, texture or script for the asset server
+        qint64 size { 0 };
+        qint64 memoryEstimate { 0 }; // how much memory the bake is expected to need at most
+        QRunnable* runnable { nullptr }; // isn't owned by the scheduler
+    };
+
+    struct BakeRecord {
+        QString key;
+        QString path;
+        QString kind;
+        qint64 size { 0 };
+        qint64 msecs { 0 }; // how long the bake took, or has been running for
+    };
+
+    struct Stats {
+        int numQueued { 0 };
+        int maxConcurrentBakes { 0 };
+        qint64 memoryInUse { 0 };
+        qint64 etaMsecs { 0 }; // when the queue is expected to be empty and all the bakes done
+        std::vector<BakeRecord> running;
+        std::vector<BakeRecord> recent; // the last bakes that finished, most recent first
+    };
+
+    static const int MAX_RECENT_BAKES = 32;
+
+    BakingScheduler(QThreadPool& threadPool, int maxConcurrentBakes, qint64 memoryBudget);
+
+    void setLimits(int maxConcurrentBakes, qint64 memoryBudget);
+
+    // how long bakes of a kind are expected to take per MB, before the times of the bakes that finish adjust it
+    void setInitialRate(const QString& kind, double msecsPerMB);
+
+    // returns false, and doesn't queue the bake, if a bake with the same key is queued or running
+    bool enqueue(const Bake& bake);
+
+    bool contains(const QString& key) const { return _queuedKeys.contains(key) || _running.contains(key); }
+    bool isRunning(const QString& key) const { return _running.contains(key); }
+
+    // to be called once the runnable of a started bake is done, which lets the next ones start
+    void bakeFinished(const QString& key);
+    // same as bakeFinished, for bakes that didn't run to the end and whose time can't be learned from
+    void bakeAborted(const QString& key);
+
+    // removes the bakes that weren't started and returns their keys
+    QStringList clearQueued();
+
+    Stats getStats() const;
+
+private:
+    struct QueuedBake {
+        Bake bake;
+        QElapsedTimer queuedTimer;
+    };
+
+    struct RunningBake {
+        Bake bake;
+        QElapsedTimer timer;
+    };
+
+    double expectedMsecs(const QString& kind, qint64 size) const;
+    void endBake(const QString& key, bool wasTimed);
+    void startBakes();
+
+    QThreadPool& _threadPool;
+    int _maxConcurrentBakes;
+    qint64 _memoryBudget;
+    qint64 _memoryInUse { 0 };
+
+    std::deque<QueuedBake> _queue; // in the order the bakes were queued
+    QSet<QString> _queuedKeys;
+    QHash<QString, RunningBake> _running;
+
+    QHash<QString, double> _msecsPerMB;
+    std::deque<BakeRecord> _recent;
+};
+
+#endif // hifi_BakingScheduler_h
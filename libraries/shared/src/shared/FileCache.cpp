@@ -217,6 +217,12 @@ FilePointer FileCache::getFile(const Key& key) {
     return file;
 }
 
+bool FileCache::hasFile(const Key& key) {
+    Lock lock(_mutex);
+    const auto it = _files.find(key);
+    return it != _files.cend() && !it->second.expired();
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + DIR_SEP + key + EXT_SEP + _ext;
 }
@@ -60,6 +60,7 @@ public:
     size_t getNumCachedFiles() const { return _numUnusedFiles; }
     size_t getSizeTotalFiles() const { return _totalFilesSize; }
     size_t getSizeCachedFiles() const { return _unusedFilesSize; }
+    const std::string& getDirpath() const { return _dirpath; }
 
     // Set the maximum amount of disk space to use on disk
     void setMaxSize(size_t maxCacheSize);
@@ -98,6 +99,8 @@ public:
     // Add file to the cache and return the cache entry.  
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
+    // whether the cache holds the file, without it counting as a use of the file
+    bool hasFile(const Key& key);
 
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
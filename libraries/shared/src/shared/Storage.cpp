@@ -32,6 +32,21 @@ StoragePointer Storage::createView(size_t viewSize, size_t offset) const {
     return std::make_shared<ViewStorage>(shared_from_this(), viewSize, data() + offset);
 }
 
+void Storage::pageIn() const {
+    // the smallest page size of the platforms we run on
+    static const size_t PAGE_SIZE = 4096;
+    auto bytes = data();
+    auto byteCount = size();
+    if (!bytes || byteCount == 0) {
+        return;
+    }
+    volatile uint8_t sum = 0;
+    for (size_t offset = 0; offset < byteCount; offset += PAGE_SIZE) {
+        sum += bytes[offset];
+    }
+    sum += bytes[byteCount - 1];
+}
+
 StoragePointer Storage::toMemoryStorage() const {
     return std::make_shared<MemoryStorage>(size(), data());
 }
@@ -41,6 +41,10 @@ namespace storage {
         StoragePointer toFileStorage(const QString& filename) const;
         StoragePointer toMemoryStorage() const;
 
+        // Reads a byte of each page, so that the pages of a mapped file are read from disk by the calling thread
+        // rather than by the one that uses the data
+        void pageIn() const;
+
         // Aliases to prevent having to re-write a ton of code
         inline size_t getSize() const { return size(); }
         inline const uint8_t* readData() const { return data(); }
@@ -0,0 +1,327 @@
+//
+//  TinyLFUCache.h
+//  libraries/shared/src/shared
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TinyLFUCache_h
+#define hifi_TinyLFUCache_h
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QHash>
+
+namespace cache {
+
+// Estimates how often keys were seen recently, with a count-min sketch of 4 bit counters.  The counters are halved
+// once as many samples as the sketch has counters in use were added, so that old popularity fades.
+class FrequencySketch {
+public:
+    static const int MAX_FREQUENCY = 15;
+
+    FrequencySketch(size_t expectedEntries = 1024) { resize(expectedEntries); }
+
+    void resize(size_t expectedEntries) {
+        // one 64 bit word holds 16 counters, keep about 16 counters per expected entry over the 4 rows
+        size_t numWords = 1;
+        while (numWords < std::max(expectedEntries, (size_t)1)) {
+            numWords <<= 1;
+        }
+        _table.assign(numWords, 0);
+        _mask = numWords - 1;
+        _sampleSize = 10 * std::max(expectedEntries, (size_t)1);
+        _size = 0;
+    }
+
+    void increment(uint64_t hash) {
+        bool added = false;
+        for (int i = 0; i < NUM_ROWS; ++i) {
+            uint64_t rowHash = rehash(hash, i);
+            uint64_t& word = _table[rowHash & _mask];
+            int shift = counterShift(rowHash);
+            if (((word >> shift) & 0xF) < MAX_FREQUENCY) {
+                word += (uint64_t)1 << shift;
+                added = true;
+            }
+        }
+        if (added && ++_size >= _sampleSize) {
+            halve();
+        }
+    }
+
+    int estimate(uint64_t hash) const {
+        int frequency = MAX_FREQUENCY;
+        for (int i = 0; i < NUM_ROWS; ++i) {
+            uint64_t rowHash = rehash(hash, i);
+            frequency = std::min(frequency, (int)((_table[rowHash & _mask] >> counterShift(rowHash)) & 0xF));
+        }
+        return frequency;
+    }
+
+private:
+    static const int NUM_ROWS = 4;
+
+    static uint64_t rehash(uint64_t hash, int row) {
+        static const uint64_t SEEDS[NUM_ROWS] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+        };
+        uint64_t h = (hash + SEEDS[row]) * 0x9e3779b97f4a7c15ULL;
+        return h ^ (h >> 29);
+    }
+
+    // each row uses its own counter of the word, picked by bits the word index doesn't use
+    static int counterShift(uint64_t rowHash) { return (int)((rowHash >> 60) & 0xF) << 2; }
+
+    void halve() {
+        for (auto& word : _table) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        _size /= 2;
+    }
+
+    std::vector<uint64_t> _table;
+    size_t _mask { 0 };
+    size_t _sampleSize { 0 };
+    size_t _size { 0 };
+};
+
+template <typename Key>
+struct QtHasher {
+    size_t operator()(const Key& key) const { return qHash(key); }
+};
+
+// A cache of weighted values that keeps the most frequently used ones, in the W-TinyLFU way:
+// - new values go to a small LRU window, so that bursts of accesses to a new key get a chance to build up a frequency
+// - values leaving the window only displace the least recently used value of the main cache if a FrequencySketch
+//   says they are used more often
+// - the main cache is a segmented LRU, values used again while in its probation segment move to its protected segment
+// All members are thread safe.
+template <typename Key, typename Value, typename Hasher = QtHasher<Key>>
+class TinyLFUCache {
+public:
+    struct Stats {
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint64_t hitWeight { 0 }; // the weight of the values returned, bytes for a cache of data
+        uint64_t weight { 0 };
+        size_t numEntries { 0 };
+    };
+
+    TinyLFUCache(uint64_t maxWeight, size_t expectedEntries) :
+        _sketch(expectedEntries)
+    {
+        setMaxWeight(maxWeight);
+    }
+
+    void setMaxWeight(uint64_t maxWeight) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _maxWeight = maxWeight;
+        // a small cache still gets a window, as long as there is any weight to give it
+        _windowMaxWeight = std::min(std::max(maxWeight / 100, (uint64_t)1), maxWeight);
+        _mainMaxWeight = maxWeight - _windowMaxWeight;
+        _protectedMaxWeight = _mainMaxWeight * 4 / 5;
+        evict();
+    }
+
+    // values heavier than this are never cached, lighter ones that are still heavier than the window go straight to
+    // competing for a place in the main cache
+    uint64_t getMaxEntryWeight() const { return _maxWeight / 8; }
+
+    // every lookup counts towards the frequency of the key, whether it is cached or not
+    bool get(const Key& key, Value& value) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _sketch.increment(_hasher(key));
+
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            ++_stats.misses;
+            return false;
+        }
+
+        auto entry = it->second;
+        touch(entry);
+        value = entry->value;
+        ++_stats.hits;
+        _stats.hitWeight += entry->weight;
+        return true;
+    }
+
+    // Whether a value missing from the cache would stay in it once put, from how often its key was looked up against
+    // how often the value it would displace was, so that callers can avoid loading values that wouldn't be kept
+    bool wouldAdmit(const Key& key, uint64_t weight) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_maxWeight == 0 || weight > getMaxEntryWeight()) {
+            return false;
+        }
+        bool hasRoom = _probationWeight + _protectedWeight + weight <= _mainMaxWeight;
+        if (hasRoom || _index.find(key) != _index.end()) {
+            return true;
+        }
+        auto& victims = !_probation.empty() ? _probation : _protected;
+        return victims.empty() || _sketch.estimate(_hasher(key)) > _sketch.estimate(_hasher(victims.back().key));
+    }
+
+    // returns false if the value is too heavy to be cached, or the cache has no weight at all
+    bool put(const Key& key, const Value& value, uint64_t weight) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_maxWeight == 0 || weight > getMaxEntryWeight()) {
+            return false;
+        }
+
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            auto entry = it->second;
+            segmentWeight(entry->segment) += weight - entry->weight;
+            entry->value = value;
+            entry->weight = weight;
+            touch(entry);
+        } else {
+            _window.push_front(Entry { key, value, weight, Segment::Window });
+            _index.emplace(key, _window.begin());
+            _windowWeight += weight;
+        }
+        evict();
+        return true;
+    }
+
+    void remove(const Key& key) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            erase(it->second);
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _index.clear();
+        _window.clear();
+        _probation.clear();
+        _protected.clear();
+        _windowWeight = _probationWeight = _protectedWeight = 0;
+    }
+
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Stats stats = _stats;
+        stats.weight = _windowWeight + _probationWeight + _protectedWeight;
+        stats.numEntries = _index.size();
+        return stats;
+    }
+
+private:
+    enum class Segment { Window, Probation, Protected };
+
+    struct Entry {
+        Key key;
+        Value value;
+        uint64_t weight;
+        Segment segment;
+    };
+    using Entries = std::list<Entry>;
+    using EntryIterator = typename Entries::iterator;
+
+    Entries& segmentEntries(Segment segment) {
+        return segment == Segment::Window ? _window : (segment == Segment::Probation ? _probation : _protected);
+    }
+    uint64_t& segmentWeight(Segment segment) {
+        return segment == Segment::Window ? _windowWeight :
+            (segment == Segment::Probation ? _probationWeight : _protectedWeight);
+    }
+
+    void moveToFront(EntryIterator entry, Segment segment) {
+        segmentWeight(entry->segment) -= entry->weight;
+        segmentEntries(segment).splice(segmentEntries(segment).begin(), segmentEntries(entry->segment), entry);
+        entry->segment = segment;
+        segmentWeight(segment) += entry->weight;
+    }
+
+    void touch(EntryIterator entry) {
+        if (entry->segment == Segment::Window) {
+            moveToFront(entry, Segment::Window);
+            return;
+        }
+
+        // a value used again while on probation is promoted, which can push the oldest protected ones back
+        moveToFront(entry, Segment::Protected);
+        while (_protectedWeight > _protectedMaxWeight && _protected.size() > 1) {
+            moveToFront(std::prev(_protected.end()), Segment::Probation);
+        }
+    }
+
+    void erase(EntryIterator entry) {
+        segmentWeight(entry->segment) -= entry->weight;
+        _index.erase(entry->key);
+        segmentEntries(entry->segment).erase(entry);
+    }
+
+    void evict() {
+        // what leaves the window is a candidate for the main cache
+        while (_windowWeight > _windowMaxWeight && !_window.empty()) {
+            moveToFront(std::prev(_window.end()), Segment::Probation);
+            admitCandidate(_probation.begin());
+        }
+        // a cache without weight holds nothing, not even values that weigh nothing
+        while (!_index.empty() && (_windowWeight + _probationWeight + _protectedWeight > _maxWeight || _maxWeight == 0)) {
+            auto& segment = !_probation.empty() ? _probation : (!_protected.empty() ? _protected : _window);
+            erase(std::prev(segment.end()));
+        }
+    }
+
+    void admitCandidate(EntryIterator candidate) {
+        int candidateFrequency = _sketch.estimate(_hasher(candidate->key));
+
+        while (_probationWeight + _protectedWeight > _mainMaxWeight) {
+            if (_probation.size() <= 1 && !_protected.empty()) {
+                // only the candidate is on probation, take the next victim from the protected segment
+                moveToFront(std::prev(_protected.end()), Segment::Probation);
+                _probation.splice(_probation.begin(), _probation, candidate);
+            }
+
+            auto victim = std::prev(_probation.end());
+            if (victim == candidate) {
+                erase(candidate);
+                return;
+            }
+            if (candidateFrequency > _sketch.estimate(_hasher(victim->key))) {
+                erase(victim);
+            } else {
+                erase(candidate);
+                return;
+            }
+        }
+    }
+
+    mutable std::mutex _mutex;
+    Hasher _hasher;
+    FrequencySketch _sketch;
+
+    std::unordered_map<Key, EntryIterator, Hasher> _index;
+    Entries _window;
+    Entries _probation;
+    Entries _protected;
+
+    uint64_t _maxWeight { 0 };
+    uint64_t _windowMaxWeight { 0 };
+    uint64_t _mainMaxWeight { 0 }; // the probation and protected segments together
+    uint64_t _protectedMaxWeight { 0 };
+    uint64_t _windowWeight { 0 };
+    uint64_t _probationWeight { 0 };
+    uint64_t _protectedWeight { 0 };
+
+    Stats _stats;
+};
+
+}
+
+#endif // hifi_TinyLFUCache_h
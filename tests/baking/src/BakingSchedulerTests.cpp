@@ -0,0 +1,213 @@
+//
+//  BakingSchedulerTests.cpp
+//  tests/baking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakingSchedulerTests.h"
+
+#include <atomic>
+#include <functional>
+
+#include <shared/BakingScheduler.h>
+#include <JSBaker.h>
+
+QTEST_MAIN(BakingSchedulerTests)
+
+namespace {
+
+class TestBake : public QRunnable {
+public:
+    TestBake(std::function<void()> work) : _work(work) {}
+    void run() override { _work(); }
+
+private:
+    std::function<void()> _work;
+};
+
+// a script with comments and whitespace for the baker to remove, of about numLines lines
+QByteArray makeFixtureScript(int index, int numLines) {
+    QByteArray script = "// fixture " + QByteArray::number(index) + "\n";
+    for (int line = 0; line < numLines; ++line) {
+        auto number = QByteArray::number(index * 1000 + line);
+        script += "var value" + number + "   =\t" + number + "; // the value\n";
+        if (line % 7 == 0) {
+            script += "/* a block\n   comment */\n\n\n";
+        }
+    }
+    return script;
+}
+
+}
+
+void BakingSchedulerTests::concurrentBakesMatchSerialTest() {
+    const int NUM_SCRIPTS = 64;
+
+    std::vector<QByteArray> scripts;
+    std::vector<QByteArray> serialOutputs(NUM_SCRIPTS);
+    for (int i = 0; i < NUM_SCRIPTS; ++i) {
+        scripts.push_back(makeFixtureScript(i, 10 + (i * 37) % 500));
+        QVERIFY(JSBaker::bakeJS(scripts[i], serialOutputs[i]));
+    }
+
+    QThreadPool threadPool;
+    BakingScheduler scheduler(threadPool, 4, 1024 * 1024 * 1024);
+
+    std::vector<QByteArray> outputs(NUM_SCRIPTS);
+    std::atomic<int> numRunning { 0 };
+    std::atomic<int> maxRunning { 0 };
+    int numFinished = 0;
+
+    for (int i = 0; i < NUM_SCRIPTS; ++i) {
+        BakingScheduler::Bake bake;
+        bake.key = QString::number(i);
+        bake.path = "/scripts/" + bake.key + ".js";
+        bake.kind = "script";
+        bake.size = scripts[i].size();
+        bake.memoryEstimate = 2 * bake.size;
+        bake.runnable = new TestBake([&, i] {
+            int running = ++numRunning;
+            int previousMax = maxRunning;
+            while (running > previousMax && !maxRunning.compare_exchange_weak(previousMax, running)) {}
+
+            JSBaker::bakeJS(scripts[i], outputs[i]);
+
+            --numRunning;
+            QMetaObject::invokeMethod(this, [&, i] {
+                scheduler.bakeFinished(QString::number(i));
+                ++numFinished;
+            }, Qt::QueuedConnection);
+        });
+        QVERIFY(scheduler.enqueue(bake));
+
+        // the same asset queued again is baked once
+        BakingScheduler::Bake duplicate = bake;
+        duplicate.runnable = nullptr;
+        QVERIFY(!scheduler.enqueue(duplicate));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(numFinished, NUM_SCRIPTS, 30000);
+    QVERIFY(maxRunning <= 4);
+
+    for (int i = 0; i < NUM_SCRIPTS; ++i) {
+        QCOMPARE(outputs[i], serialOutputs[i]);
+    }
+
+    auto stats = scheduler.getStats();
+    QCOMPARE(stats.numQueued, 0);
+    QVERIFY(stats.running.empty());
+    QCOMPARE((int)stats.recent.size(), (int)BakingScheduler::MAX_RECENT_BAKES);
+    QCOMPARE(stats.memoryInUse, (qint64)0);
+}
+
+void BakingSchedulerTests::priorityTest() {
+    QThreadPool threadPool;
+    BakingScheduler scheduler(threadPool, 1, 1024 * 1024 * 1024);
+    scheduler.setInitialRate("script", 20.0);
+    scheduler.setInitialRate("texture", 2000.0);
+    scheduler.setInitialRate("model", 8000.0);
+
+    QSemaphore gate;
+    QStringList startOrder;
+    QMutex startOrderMutex;
+    int numFinished = 0;
+
+    auto enqueue = [&](const QString& key, const QString& kind, qint64 size) {
+        BakingScheduler::Bake bake;
+        bake.key = key;
+        bake.path = "/" + key;
+        bake.kind = kind;
+        bake.size = size;
+        bake.runnable = new TestBake([&, key] {
+            {
+                QMutexLocker lock(&startOrderMutex);
+                startOrder << key;
+            }
+            if (key == "gate") {
+                gate.acquire();
+            }
+            QMetaObject::invokeMethod(this, [&, key] {
+                scheduler.bakeFinished(key);
+                ++numFinished;
+            }, Qt::QueuedConnection);
+        });
+        QVERIFY(scheduler.enqueue(bake));
+    };
+
+    // holds the only slot while the others are queued
+    enqueue("gate", "gate", 0);
+
+    const qint64 MB = 1024 * 1024;
+    enqueue("hugeModel", "model", 200 * MB);
+    enqueue("largeTexture", "texture", 32 * MB);
+    enqueue("smallModel", "model", 1 * MB);
+    enqueue("smallTexture", "texture", 256 * 1024);
+    enqueue("script", "script", 64 * 1024);
+
+    auto stats = scheduler.getStats();
+    QCOMPARE(stats.numQueued, 5);
+    QVERIFY(stats.etaMsecs > 0);
+
+    gate.release();
+    QTRY_COMPARE_WITH_TIMEOUT(numFinished, 6, 10000);
+
+    QCOMPARE(startOrder, QStringList({ "gate", "script", "smallTexture", "smallModel", "largeTexture", "hugeModel" }));
+}
+
+void BakingSchedulerTests::memoryBudgetTest() {
+    const int NUM_BAKES = 16;
+    const qint64 MEMORY_BUDGET = 100;
+
+    QThreadPool threadPool;
+    BakingScheduler scheduler(threadPool, 8, MEMORY_BUDGET);
+
+    std::atomic<qint64> memoryInUse { 0 };
+    std::atomic<qint64> maxMemoryInUse { 0 };
+    int numFinished = 0;
+
+    for (int i = 0; i < NUM_BAKES; ++i) {
+        BakingScheduler::Bake bake;
+        bake.key = QString::number(i);
+        bake.kind = "texture";
+        bake.size = 1000;
+        bake.memoryEstimate = i % 2 == 0 ? 40 : 30;
+        auto memoryEstimate = bake.memoryEstimate;
+        bake.runnable = new TestBake([&, i, memoryEstimate] {
+            qint64 inUse = memoryInUse += memoryEstimate;
+            qint64 previousMax = maxMemoryInUse;
+            while (inUse > previousMax && !maxMemoryInUse.compare_exchange_weak(previousMax, inUse)) {}
+
+            QThread::msleep(5);
+
+            memoryInUse -= memoryEstimate;
+            QMetaObject::invokeMethod(this, [&, i] {
+                scheduler.bakeFinished(QString::number(i));
+                ++numFinished;
+            }, Qt::QueuedConnection);
+        });
+        QVERIFY(scheduler.enqueue(bake));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(numFinished, NUM_BAKES, 10000);
+    QVERIFY(maxMemoryInUse <= MEMORY_BUDGET);
+    QVERIFY(maxMemoryInUse > 40);
+
+    // a bake needing more than the whole budget still runs, on its own
+    BakingScheduler::Bake hugeBake;
+    hugeBake.key = "huge";
+    hugeBake.kind = "model";
+    hugeBake.memoryEstimate = 2 * MEMORY_BUDGET;
+    hugeBake.runnable = new TestBake([&] {
+        QMetaObject::invokeMethod(this, [&] {
+            scheduler.bakeFinished("huge");
+            ++numFinished;
+        }, Qt::QueuedConnection);
+    });
+    QVERIFY(scheduler.enqueue(hugeBake));
+    QTRY_COMPARE_WITH_TIMEOUT(numFinished, NUM_BAKES + 1, 10000);
+}
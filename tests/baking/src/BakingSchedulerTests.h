@@ -0,0 +1,32 @@
+//
+//  BakingSchedulerTests.h
+//  tests/baking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakingSchedulerTests_h
+#define hifi_BakingSchedulerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class BakingSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a fixture set baked concurrently gives the same output as baked one at a time
+    void concurrentBakesMatchSerialTest();
+
+    // Test that the bakes expected to finish first are started first
+    void priorityTest();
+
+    // Test that the bakes running at the same time stay within the memory budget
+    void memoryBudgetTest();
+};
+
+#endif // hifi_BakingSchedulerTests_h
@@ -10,6 +10,7 @@
 
 #include <mutex>
 
+#include <QtCore/QElapsedTimer>
 #include <QtTest/QtTest>
 
 #include <ktx/KTX.h>
@@ -30,6 +31,51 @@ QString getRootPath() {
     return result;
 }
 
+// A texture with all its mips, filled with a pattern that differs by seed
+gpu::TexturePointer createMippedTexture(uint16_t size, uint8_t seed) {
+    const auto format = gpu::Element::COLOR_SRGBA_32;
+    uint16_t numMips = 1;
+    while ((size >> numMips) > 0) {
+        ++numMips;
+    }
+    auto texture = gpu::Texture::create2D(format, size, size, numMips);
+    texture->setStoredMipFormat(format);
+    for (uint16_t level = 0; level < numMips; ++level) {
+        auto mipSize = texture->evalStoredMipSize(level, format);
+        std::vector<uint8_t> mip(mipSize);
+        for (size_t i = 0; i < mipSize; ++i) {
+            mip[i] = (uint8_t)(i * 7 + level + seed);
+        }
+        texture->assignStoredMip(level, mipSize, mip.data());
+    }
+    return texture;
+}
+
+bool writeKtx(const gpu::Texture& texture, const QString& filename) {
+    auto ktxMemory = gpu::Texture::serialize(texture);
+    if (!ktxMemory) {
+        return false;
+    }
+    const auto& storage = ktxMemory->getStorage();
+    QFile file(filename);
+    return file.open(QIODevice::WriteOnly) &&
+        file.write((const char*)storage->data(), storage->size()) == (qint64)storage->size();
+}
+
+// A field of /proc/self/status in KB, or -1 where there is none
+qint64 getProcessMemoryKB(const QByteArray& field) {
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    for (auto& line : status.readAll().split('\n')) {
+        if (line.startsWith(field + ':')) {
+            return line.mid(field.size() + 1).simplified().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
 void KtxTests::initTestCase() {
 }
 
@@ -142,6 +188,114 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+void KtxTests::testKtxMappedMips() {
+    const uint16_t SIZE = 64;
+    auto texture = createMippedTexture(SIZE, 1);
+    QTemporaryDir dir;
+    auto filename = dir.filePath("mipped.ktx");
+    QVERIFY(writeKtx(*texture, filename));
+
+    auto fileTexture = gpu::Texture::unserialize(filename.toStdString());
+    QVERIFY(fileTexture);
+    for (uint16_t level = 0; level < texture->getNumMips(); ++level) {
+        auto expected = texture->accessStoredMipFace(level);
+        auto mip = fileTexture->accessStoredMipFace(level);
+        QVERIFY(mip);
+        QCOMPARE(mip->size(), expected->size());
+        QVERIFY(0 == memcmp(mip->data(), expected->data(), mip->size()));
+
+        // the mip is read from the file's mapping rather than copied, so two reads of it are the same memory
+        QVERIFY(fileTexture->accessStoredMipFace(level)->data() == mip->data());
+    }
+
+    // a mip stays valid after the open files are released
+    auto mip = fileTexture->accessStoredMipFace(0);
+    gpu::Texture::KtxStorage::releaseOpenKtxFiles();
+    QVERIFY(0 == memcmp(mip->data(), texture->accessStoredMipFace(0)->data(), mip->size()));
+}
+
+void KtxTests::benchmarkKtxCacheLoad() {
+    // 1024 x 1024 textures with their mips, about 5.6 MB each: a 4 GB cache is some 730 of them, the benchmark
+    // loads a slice of one
+    const uint16_t SIZE = 1024;
+    const int NUM_TEXTURES = 32;
+    QTemporaryDir dir;
+    QStringList filenames;
+    for (int i = 0; i < NUM_TEXTURES; ++i) {
+        filenames.append(dir.filePath(QString("texture%1.ktx").arg(i)));
+        QVERIFY(writeKtx(*createMippedTexture(SIZE, (uint8_t)i), filenames.back()));
+    }
+
+    struct LoadResult {
+        bool isComplete { false };
+        qint64 msecs { 0 };
+        qint64 anonymousKB { -1 };
+        qint64 fileKB { -1 };
+    };
+
+    // loads every mip of every texture and holds them, the way textures waiting for their transfers do, from files
+    // that are in the OS page cache as they were just written
+    auto load = [&](bool isCopied) {
+        LoadResult result;
+        auto startAnonymousKB = getProcessMemoryKB("RssAnon");
+        auto startFileKB = getProcessMemoryKB("RssFile");
+        QElapsedTimer timer;
+        timer.start();
+
+        std::vector<gpu::TexturePointer> textures;
+        std::vector<storage::StoragePointer> mips;
+        for (auto& filename : filenames) {
+            auto texture = gpu::Texture::unserialize(filename.toStdString());
+            if (!texture) {
+                return result;
+            }
+            for (uint16_t level = 0; level < texture->getNumMips(); ++level) {
+                auto mip = texture->accessStoredMipFace(level);
+                if (isCopied) {
+                    // what reading a mip did before it was a view of the mapped file
+                    mip = mip->toMemoryStorage();
+                }
+                mip->pageIn();
+                mips.push_back(mip);
+            }
+            textures.push_back(texture);
+        }
+
+        result.isComplete = true;
+        result.msecs = timer.elapsed();
+        if (startAnonymousKB >= 0) {
+            result.anonymousKB = getProcessMemoryKB("RssAnon") - startAnonymousKB;
+            result.fileKB = getProcessMemoryKB("RssFile") - startFileKB;
+        }
+        mips.clear();
+        textures.clear();
+        gpu::Texture::KtxStorage::releaseOpenKtxFiles();
+        return result;
+    };
+
+    auto mapped = load(false);
+    auto copied = load(true);
+    QVERIFY(mapped.isComplete && copied.isComplete);
+
+    qint64 cacheKB = 0;
+    for (auto& filename : filenames) {
+        cacheKB += QFileInfo(filename).size() / 1024;
+    }
+    // the mapped mips are in the page cache, shared with other processes, rather than in the process' own memory
+    if (mapped.anonymousKB >= 0) {
+        QVERIFY(copied.anonymousKB > cacheKB / 2);
+        QVERIFY(mapped.anonymousKB < copied.anonymousKB / 4);
+    }
+
+    auto report = [](const char* name, const LoadResult& result) {
+        qDebug().nospace() << name << ": " << result.msecs << " ms, resident " << result.anonymousKB / 1024
+            << " MB of process memory and " << result.fileKB / 1024 << " MB of mapped files";
+    };
+    qDebug() << "loading all the mips of" << NUM_TEXTURES << "textures," << cacheKB / 1024 << "MB of KTX cache";
+    report("mips read from the mapped files", mapped);
+    report("mips copied out of the mapped files", copied);
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
@@ -0,0 +1,135 @@
+//
+//  AssetChunkingTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkingTests.h"
+
+#include <random>
+
+#include <AssetChunking.h>
+
+QTEST_MAIN(AssetChunkingTests)
+
+namespace {
+
+QByteArray randomData(std::mt19937& random, int size) {
+    QByteArray data(size, Qt::Uninitialized);
+    for (auto& byte : data) {
+        byte = (char)random();
+    }
+    return data;
+}
+
+qint64 totalSize(const std::vector<AssetUtils::AssetChunk>& chunks) {
+    qint64 size = 0;
+    for (auto& chunk : chunks) {
+        size += chunk.size;
+    }
+    return size;
+}
+
+}
+
+void AssetChunkingTests::boundariesTest() {
+    std::mt19937 random(1);
+    auto data = randomData(random, 3 * 1024 * 1024 + 123);
+
+    auto chunks = AssetUtils::chunkData(data);
+    QVERIFY(chunks.size() > 1);
+    QCOMPARE(totalSize(chunks), (qint64)data.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        QVERIFY(chunks[i].size <= AssetUtils::MAX_CHUNK_SIZE);
+        QVERIFY(chunks[i].size >= AssetUtils::MIN_CHUNK_SIZE || i == chunks.size() - 1);
+        QCOMPARE(chunks[i].hash.size(), 32);
+    }
+
+    auto chunksAgain = AssetUtils::chunkData(data);
+    QCOMPARE(chunksAgain.size(), chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        QCOMPARE(chunksAgain[i].hash, chunks[i].hash);
+    }
+
+    // data that never matches a cut point is cut at the maximum chunk size
+    QByteArray zeros((int)AssetUtils::MAX_CHUNK_SIZE * 3, 0);
+    auto zeroChunks = AssetUtils::chunkData(zeros);
+    QCOMPARE(zeroChunks.size(), (size_t)3);
+    QCOMPARE(zeroChunks[0].size, (uint32_t)AssetUtils::MAX_CHUNK_SIZE);
+
+    // everything can be put together from the data itself
+    QByteArray reassembled;
+    auto missingRanges = AssetUtils::reuseChunks(data, chunks, reassembled);
+    QVERIFY(missingRanges.empty());
+    QVERIFY(reassembled == data);
+}
+
+void AssetChunkingTests::iterativeUploadsTest() {
+    // a model uploaded again after each of a series of edits, the way one is iterated on in a domain
+    const int NUM_VERSIONS = 10;
+    std::mt19937 random(2);
+    std::vector<QByteArray> versions { randomData(random, 6 * 1024 * 1024) };
+    for (int i = 1; i < NUM_VERSIONS; ++i) {
+        QByteArray version = versions.back();
+        int position = (int)(random() % version.size());
+        switch (i % 4) {
+            case 0: // vertices added
+                version.insert(position, randomData(random, 4096));
+                break;
+            case 1: // a material changed
+                version.replace(position, 200, randomData(random, 200));
+                break;
+            case 2: // an animation added
+                version.append(randomData(random, 96 * 1024));
+                break;
+            default: // a mesh removed
+                version.remove(position, 20 * 1024);
+                break;
+        }
+        versions.push_back(version);
+    }
+
+    qint64 fullBytes = 0;
+    qint64 storedBytes = 0;
+    QSet<QByteArray> storedChunks;
+
+    qint64 fullTransferBytes = 0;
+    qint64 deltaTransferBytes = 0;
+
+    for (size_t i = 0; i < versions.size(); ++i) {
+        auto chunks = AssetUtils::chunkData(versions[i]);
+        fullBytes += versions[i].size();
+        for (auto& chunk : chunks) {
+            if (!storedChunks.contains(chunk.hash)) {
+                storedChunks.insert(chunk.hash);
+                storedBytes += chunk.size;
+            }
+        }
+
+        // a client that has the previous version only downloads the chunks that changed
+        if (i > 0) {
+            QByteArray data;
+            auto missingRanges = AssetUtils::reuseChunks(versions[i - 1], chunks, data);
+            for (auto& range : missingRanges) {
+                memcpy(data.data() + range.fromInclusive, versions[i].constData() + range.fromInclusive, range.size());
+                deltaTransferBytes += range.size();
+            }
+            QVERIFY(data == versions[i]);
+            fullTransferBytes += versions[i].size();
+        }
+    }
+
+    double storageSaved = 100.0 * (fullBytes - storedBytes) / fullBytes;
+    double transferSaved = 100.0 * (fullTransferBytes - deltaTransferBytes) / fullTransferBytes;
+    qDebug() << "Stored" << storedBytes << "bytes for" << fullBytes << "bytes of uploads," << storageSaved << "% saved";
+    qDebug() << "Transferred" << deltaTransferBytes << "bytes for" << fullTransferBytes << "bytes of updates,"
+        << transferSaved << "% saved";
+
+    QVERIFY(storageSaved > 70.0);
+    QVERIFY(transferSaved > 90.0);
+}
@@ -0,0 +1,29 @@
+//
+//  AssetChunkingTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkingTests_h
+#define hifi_AssetChunkingTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AssetChunkingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that chunks cover the data, within the minimum and maximum chunk sizes, the same way every time
+    void boundariesTest();
+
+    // Measure the storage and the transfers saved by sharing chunks between successive uploads of an edited model
+    void iterativeUploadsTest();
+};
+
+#endif // hifi_AssetChunkingTests_h
@@ -0,0 +1,283 @@
+//
+//  AssetGetBatchTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetGetBatchTests.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <random>
+
+#include <QtCore/QCryptographicHash>
+
+#include <AssetGetBatch.h>
+#include <NLPacketList.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(AssetGetBatchTests)
+
+using namespace AssetUtils;
+
+namespace {
+
+QByteArray makeHash(int i) {
+    return QCryptographicHash::hash(QByteArray::number(i), QCryptographicHash::Sha256);
+}
+
+// reads a packet list the way the receiving end gets it
+std::unique_ptr<ReceivedMessage> receive(NLPacketList& packetList) {
+    packetList.closeCurrentPacket();
+    return std::unique_ptr<ReceivedMessage>(new ReceivedMessage(packetList));
+}
+
+qint64 getRequestSize() {
+    auto packet = NLPacket::create(PacketType::AssetGet, -1, true);
+    packet->writePrimitive((MessageID)0);
+    packet->write(makeHash(0));
+    packet->writePrimitive((DataOffset)0);
+    packet->writePrimitive((DataOffset)0);
+    return packet->getDataSize();
+}
+
+qint64 getReplySize(qint64 assetSize) {
+    auto packetList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
+    packetList->write(makeHash(0));
+    packetList->writePrimitive((MessageID)0);
+    packetList->writePrimitive(AssetServerError::NoError);
+    packetList->writePrimitive((DataOffset)assetSize);
+    packetList->write(QByteArray((int)assetSize, 'x'));
+    return packetList->getDataSize();
+}
+
+// One direction of a link: messages are serialized at the bandwidth one after the other, and take half the round
+// trip time to get across
+class SimulatedLink {
+public:
+    SimulatedLink(double bitsPerSecond, double rttSeconds) : _bitsPerSecond(bitsPerSecond), _oneWaySeconds(rttSeconds / 2) {}
+
+    // when a message sent at time arrives
+    double send(double time, qint64 bytes) {
+        _freeTime = std::max(time, _freeTime) + bytes * 8 / _bitsPerSecond;
+        return _freeTime + _oneWaySeconds;
+    }
+
+private:
+    double _bitsPerSecond;
+    double _oneWaySeconds;
+    double _freeTime { 0.0 };
+};
+
+struct LoadResult {
+    double seconds { 0.0 };
+    int numRequestMessages { 0 };
+    qint64 bytesDown { 0 };
+};
+
+// Loads the assets with at most maxInFlight gets waiting for a reply.  Batched, the gets made at the same time go
+// out together, the way AssetClient coalesces the gets of a pass of its event loop, and those left out of a full
+// batch reply are sent after it on their own.
+LoadResult simulateLoad(const std::vector<qint64>& assetSizes, size_t maxInFlight, bool isBatched) {
+    const double BITS_PER_SECOND = 50e6;
+    const double RTT_SECONDS = 0.1;
+    SimulatedLink up(BITS_PER_SECOND, RTT_SECONDS);
+    SimulatedLink down(BITS_PER_SECOND, RTT_SECONDS);
+    const qint64 requestSize = getRequestSize();
+
+    LoadResult result;
+    std::deque<int> toLoad;
+    for (int i = 0; i < (int)assetSizes.size(); ++i) {
+        toLoad.push_back(i);
+    }
+    std::multimap<double, int> completions; // when gets are answered
+    size_t inFlight = 0;
+
+    auto sendGets = [&](double time) {
+        std::vector<int> assets;
+        while (inFlight < maxInFlight && !toLoad.empty()) {
+            assets.push_back(toLoad.front());
+            toLoad.pop_front();
+            ++inFlight;
+        }
+        if (!isBatched || assets.size() == 1) {
+            for (int asset : assets) {
+                ++result.numRequestMessages;
+                qint64 replySize = getReplySize(assetSizes[asset]);
+                result.bytesDown += replySize;
+                completions.insert({ down.send(up.send(time, requestSize), replySize), asset });
+            }
+            return;
+        }
+
+        for (size_t first = 0; first < assets.size(); first += MAX_BATCHED_GETS) {
+            size_t last = std::min(assets.size(), first + MAX_BATCHED_GETS);
+
+            std::vector<BatchedGet> gets;
+            for (size_t i = first; i < last; ++i) {
+                gets.push_back({ (MessageID)assets[i], makeHash(assets[i]), 0, 0 });
+            }
+            auto requestList = NLPacketList::create(PacketType::AssetGetBatch, QByteArray(), true, true);
+            writeBatchedGets(*requestList, gets);
+            ++result.numRequestMessages;
+
+            // the same rules as the asset server's
+            auto replyList = NLPacketList::create(PacketType::AssetGetBatchReply, QByteArray(), true, true);
+            writeBatchedGetRepliesHeader(*replyList, gets);
+            qint64 replySize = 0;
+            std::vector<int> leftOut;
+            std::vector<int> included;
+            for (size_t i = first; i < last; ++i) {
+                BatchedGetReply reply;
+                reply.messageID = (MessageID)assets[i];
+                qint64 size = assetSizes[assets[i]];
+                reply.isIncluded = size <= MAX_BATCHED_ASSET_SIZE && replySize + size <= MAX_BATCH_REPLY_SIZE;
+                if (reply.isIncluded) {
+                    reply.data = QByteArray((int)size, 'x');
+                    replySize += size;
+                    included.push_back(assets[i]);
+                } else {
+                    leftOut.push_back(assets[i]);
+                }
+                writeBatchedGetReply(*replyList, reply);
+            }
+            result.bytesDown += replyList->getDataSize();
+
+            double requestTime = up.send(time, requestList->getDataSize());
+            double replyTime = down.send(requestTime, replyList->getDataSize());
+            for (int asset : included) {
+                completions.insert({ replyTime, asset });
+            }
+
+            // the asset server sends the assets left out after the batch reply
+            for (int asset : leftOut) {
+                qint64 separateReplySize = getReplySize(assetSizes[asset]);
+                result.bytesDown += separateReplySize;
+                completions.insert({ down.send(requestTime, separateReplySize), asset });
+            }
+        }
+    };
+
+    sendGets(0.0);
+    while (!completions.empty()) {
+        double time = completions.begin()->first;
+        while (!completions.empty() && completions.begin()->first == time) {
+            completions.erase(completions.begin());
+            --inFlight;
+        }
+        result.seconds = time;
+        sendGets(time);
+    }
+    return result;
+}
+
+}
+
+void AssetGetBatchTests::framingTest() {
+    std::vector<BatchedGet> gets;
+    for (int i = 0; i < 5; ++i) {
+        gets.push_back({ (MessageID)(100 + i), makeHash(i), i * 10, i * 20 });
+    }
+
+    auto requestList = NLPacketList::create(PacketType::AssetGetBatch, QByteArray(), true, true);
+    writeBatchedGets(*requestList, gets);
+    auto request = receive(*requestList);
+    auto readGets = readBatchedGets(*request);
+
+    QCOMPARE(readGets.size(), gets.size());
+    for (size_t i = 0; i < gets.size(); ++i) {
+        QCOMPARE(readGets[i].messageID, gets[i].messageID);
+        QCOMPARE(readGets[i].hash, gets[i].hash);
+        QCOMPARE(readGets[i].start, gets[i].start);
+        QCOMPARE(readGets[i].end, gets[i].end);
+    }
+
+    // an asset, an error, an asset left out, and an asset large enough to span several packets
+    std::vector<BatchedGetReply> replies(4);
+    replies[0] = { 1, AssetServerError::NoError, true, QByteArray("small asset") };
+    replies[1] = { 2, AssetServerError::AssetNotFound, false, QByteArray() };
+    replies[2] = { 3, AssetServerError::NoError, false, QByteArray() };
+    replies[3] = { 4, AssetServerError::NoError, true, QByteArray(20000, 'z') };
+    std::vector<BatchedGet> repliedGets;
+    for (auto& reply : replies) {
+        repliedGets.push_back({ reply.messageID, makeHash(0), 0, 0 });
+    }
+
+    auto replyList = NLPacketList::create(PacketType::AssetGetBatchReply, QByteArray(), true, true);
+    writeBatchedGetRepliesHeader(*replyList, repliedGets);
+    for (auto& reply : replies) {
+        writeBatchedGetReply(*replyList, reply);
+    }
+    auto replyMessage = receive(*replyList);
+    std::vector<MessageID> messageIDs;
+    auto readReplies = readBatchedGetReplies(*replyMessage, messageIDs);
+
+    QCOMPARE(messageIDs.size(), replies.size());
+    QCOMPARE(readReplies.size(), replies.size());
+    for (size_t i = 0; i < replies.size(); ++i) {
+        QCOMPARE(messageIDs[i], replies[i].messageID);
+        QCOMPARE(readReplies[i].messageID, replies[i].messageID);
+        QCOMPARE(readReplies[i].error, replies[i].error);
+        QCOMPARE(readReplies[i].isIncluded, replies[i].isIncluded);
+        QCOMPARE(readReplies[i].data, replies[i].data);
+    }
+
+    // a reply that ends early still names the gets it leaves out
+    auto truncatedReplyList = NLPacketList::create(PacketType::AssetGetBatchReply, QByteArray(), true, true);
+    writeBatchedGetRepliesHeader(*truncatedReplyList, repliedGets);
+    writeBatchedGetReply(*truncatedReplyList, replies[0]);
+    truncatedReplyList->writePrimitive(replies[1].messageID);
+    auto truncatedReply = receive(*truncatedReplyList);
+    readReplies = readBatchedGetReplies(*truncatedReply, messageIDs);
+    QCOMPARE(messageIDs.size(), replies.size());
+    QCOMPARE(readReplies.size(), (size_t)1);
+
+    // a batch claiming more gets than it has is dropped
+    auto truncatedList = NLPacketList::create(PacketType::AssetGetBatch, QByteArray(), true, true);
+    truncatedList->writePrimitive((uint32_t)3);
+    truncatedList->writePrimitive((MessageID)1);
+    auto truncated = receive(*truncatedList);
+    QVERIFY(readBatchedGets(*truncated).empty());
+}
+
+void AssetGetBatchTests::loadBenchmark() {
+    // small assets, from a few bytes of script to the textures of a detailed scene
+    const int NUM_ASSETS = 2000;
+    std::mt19937 random(2000);
+    std::uniform_int_distribution<qint64> sizeDistribution(1024, 32 * 1024);
+    std::vector<qint64> assetSizes;
+    qint64 totalSize = 0;
+    for (int i = 0; i < NUM_ASSETS; ++i) {
+        assetSizes.push_back(sizeDistribution(random));
+        totalSize += assetSizes.back();
+    }
+
+    // the resource cache lets 10 requests wait at a time by default
+    const size_t RESOURCE_CACHE_REQUEST_LIMIT = 10;
+    auto oneAtATime = simulateLoad(assetSizes, RESOURCE_CACHE_REQUEST_LIMIT, false);
+    auto allAtOnce = simulateLoad(assetSizes, NUM_ASSETS, false);
+    auto batchedLimited = simulateLoad(assetSizes, RESOURCE_CACHE_REQUEST_LIMIT, true);
+    auto batched = simulateLoad(assetSizes, NUM_ASSETS, true);
+
+    // batches take a handful of requests, and about as long as the bandwidth allows
+    QVERIFY(batched.numRequestMessages < NUM_ASSETS / 100);
+    QVERIFY(batched.bytesDown < allAtOnce.bytesDown);
+    QVERIFY(batched.seconds < allAtOnce.seconds + 0.1);
+    QVERIFY(batched.seconds < oneAtATime.seconds / 2);
+
+    auto report = [](const char* name, const LoadResult& result) {
+        qDebug().nospace() << name << ": " << QString::number(result.seconds, 'f', 2) << " s, "
+            << result.numRequestMessages << " requests, " << result.bytesDown / 1000 << " KB down";
+    };
+    qDebug() << NUM_ASSETS << "assets," << totalSize / 1000 << "KB, over a 100 ms RTT, 50 Mbps link";
+    report("a get each, 10 in flight", oneAtATime);
+    report("a get each, all in flight", allAtOnce);
+    report("batched, 10 in flight", batchedLimited);
+    report("batched, all in flight", batched);
+}
@@ -0,0 +1,29 @@
+//
+//  AssetGetBatchTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetGetBatchTests_h
+#define hifi_AssetGetBatchTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AssetGetBatchTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that batched gets and their replies read back the way they were written
+    void framingTest();
+
+    // Compare loading 2000 small assets with a get each and with batched gets, over a simulated 100 ms RTT link
+    void loadBenchmark();
+};
+
+#endif // hifi_AssetGetBatchTests_h
@@ -0,0 +1,242 @@
+//
+//  AssetMappingStoreTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMappingStoreTests.h"
+
+#include <memory>
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+
+#include <AssetMappingStore.h>
+
+QTEST_MAIN(AssetMappingStoreTests)
+
+namespace {
+
+const int NUM_BENCHMARK_FOLDERS = 1000;
+const int NUM_BENCHMARK_FILES_PER_FOLDER = 1000;
+const int NUM_BENCHMARK_HASHES = 1000;
+const uint32_t PAGE_SIZE = 1000;
+
+AssetUtils::AssetHash makeHash(int i) {
+    return QString("%1").arg(i, AssetUtils::SHA256_HASH_HEX_LENGTH, 16, QChar('0'));
+}
+
+QString makePath(int folder, int file) {
+    return QString("/models/folder%1/model%2.fbx").arg(folder).arg(file);
+}
+
+// a domain with a million mappings, shared by the benchmarks
+struct BenchmarkStore {
+    QTemporaryDir dir;
+    AssetMappingStore store;
+
+    BenchmarkStore() {
+        store.load(dir.filePath("map.json"));
+
+        std::vector<AssetUtils::AssetHash> hashes;
+        for (int i = 0; i < NUM_BENCHMARK_HASHES; ++i) {
+            hashes.push_back(makeHash(i));
+        }
+
+        AssetMappingStore::Edits edits;
+        edits.reserve(NUM_BENCHMARK_FOLDERS * NUM_BENCHMARK_FILES_PER_FOLDER);
+        for (int folder = 0; folder < NUM_BENCHMARK_FOLDERS; ++folder) {
+            for (int file = 0; file < NUM_BENCHMARK_FILES_PER_FOLDER; ++file) {
+                edits.push_back({ makePath(folder, file), hashes[(folder + file) % NUM_BENCHMARK_HASHES] });
+            }
+        }
+        store.apply(edits);
+    }
+};
+
+AssetMappingStore& getBenchmarkStore() {
+    static std::unique_ptr<BenchmarkStore> benchmarkStore;
+    if (!benchmarkStore) {
+        benchmarkStore.reset(new BenchmarkStore());
+    }
+    return benchmarkStore->store;
+}
+
+}
+
+void AssetMappingStoreTests::journalTest() {
+    QTemporaryDir dir;
+    auto mapFilePath = dir.filePath("map.json");
+
+    AssetMappingStore store;
+    QVERIFY(store.load(mapFilePath));
+    QCOMPARE(store.size(), (size_t)0);
+
+    QVERIFY(store.set("/a.fbx", makeHash(1)));
+    QVERIFY(store.set("/b.fbx", makeHash(2)));
+    QVERIFY(store.set("/c.fbx", makeHash(2)));
+    QVERIFY(store.apply({ { "/a.fbx", AssetUtils::AssetHash() }, { "/d.fbx", makeHash(1) } }));
+    QCOMPARE(store.getJournalEdits(), 5);
+    QVERIFY(store.isMapped(makeHash(1)));
+    QVERIFY(store.isMapped(makeHash(2)));
+
+    QVERIFY(store.set("/b.fbx", makeHash(3)));
+    QVERIFY(store.set("/c.fbx", makeHash(3)));
+    QVERIFY(!store.isMapped(makeHash(2)));
+
+    auto expected = store.getMappings();
+
+    // a crash while writing an entry leaves part of it at the end of the journal
+    {
+        QFile journal { mapFilePath + ".journal" };
+        QVERIFY(journal.open(QIODevice::Append));
+        journal.write(QByteArray("\x00\x00\x01\x00\x12", 5));
+    }
+
+    AssetMappingStore reloaded;
+    QVERIFY(reloaded.load(mapFilePath));
+    QVERIFY(reloaded.getMappings() == expected);
+    QCOMPARE(reloaded.getJournalEdits(), 0);
+    QVERIFY(reloaded.isMapped(makeHash(1)));
+    QVERIFY(!reloaded.isMapped(makeHash(2)));
+
+    // the journal was folded into the map file on load, and can be edited again
+    QCOMPARE(QFileInfo(mapFilePath + ".journal").size(), (qint64)0);
+    QVERIFY(reloaded.set("/e.fbx", makeHash(4)));
+
+    AssetMappingStore reloadedAgain;
+    QVERIFY(reloadedAgain.load(mapFilePath));
+    QCOMPARE(reloadedAgain.size(), expected.size() + 1);
+}
+
+void AssetMappingStoreTests::compactionTest() {
+    QTemporaryDir dir;
+    auto mapFilePath = dir.filePath("map.json");
+
+    AssetMappingStore store;
+    QVERIFY(store.load(mapFilePath));
+
+    // paths that need escaping in JSON
+    QVERIFY(store.set(QString::fromUtf8("/caf\xc3\xa9 \"quoted\"/back\\slash.fbx"), makeHash(1)));
+
+    for (int i = 0; i < AssetMappingStore::MIN_COMPACTION_EDITS - 2; ++i) {
+        QVERIFY(store.set(makePath(0, i), makeHash(i)));
+    }
+    QCOMPARE(store.getJournalEdits(), AssetMappingStore::MIN_COMPACTION_EDITS - 1);
+
+    QVERIFY(store.set(makePath(1, 0), makeHash(0)));
+    QCOMPARE(store.getJournalEdits(), 0);
+
+    QFile mapFile { mapFilePath };
+    QVERIFY(mapFile.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    auto root = QJsonDocument::fromJson(mapFile.readAll(), &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE((size_t)root.size(), store.size());
+    for (auto& mapping : store) {
+        QCOMPARE(root.value(mapping.first).toString(), mapping.second);
+    }
+}
+
+void AssetMappingStoreTests::prefixTest() {
+    QTemporaryDir dir;
+    AssetMappingStore store;
+    QVERIFY(store.load(dir.filePath("map.json")));
+
+    AssetMappingStore::Edits edits;
+    for (int folder = 0; folder < 3; ++folder) {
+        for (int file = 0; file < 25; ++file) {
+            edits.push_back({ makePath(folder, file), makeHash(file) });
+        }
+    }
+    QVERIFY(store.apply(edits));
+
+    auto folder = store.findPrefix("/models/folder1/");
+    QCOMPARE((int)std::distance(folder.first, folder.second), 25);
+    QVERIFY(folder.first->first.startsWith("/models/folder1/"));
+
+    // page through the folder ten at a time, the way the asset server answers paged requests
+    QStringList paths;
+    AssetUtils::AssetPath startAfter;
+    int numPages = 0;
+    do {
+        auto it = store.lowerBound("/models/folder1/", startAfter);
+        int count = 0;
+        for (; it != store.end() && it->first.startsWith("/models/folder1/") && count < 10; ++it, ++count) {
+            paths << it->first;
+            startAfter = it->first;
+        }
+        ++numPages;
+        if (it == store.end() || !it->first.startsWith("/models/folder1/")) {
+            break;
+        }
+    } while (true);
+    QCOMPARE(numPages, 3);
+    QCOMPARE(paths.size(), 25);
+    QCOMPARE(paths.toSet().size(), 25);
+
+    QCOMPARE((int)std::distance(store.findPrefix("/nothing/").first, store.findPrefix("/nothing/").second), 0);
+}
+
+void AssetMappingStoreTests::setBenchmark() {
+    auto& store = getBenchmarkStore();
+    QCOMPARE(store.size(), (size_t)(NUM_BENCHMARK_FOLDERS * NUM_BENCHMARK_FILES_PER_FOLDER));
+
+    int i = 0;
+    QBENCHMARK {
+        store.set(makePath(NUM_BENCHMARK_FOLDERS / 2, i % NUM_BENCHMARK_FILES_PER_FOLDER), makeHash(i));
+        ++i;
+    }
+}
+
+void AssetMappingStoreTests::renameFolderBenchmark() {
+    auto& store = getBenchmarkStore();
+
+    // renames a folder of a thousand mappings back and forth
+    bool isRenamed = false;
+    QBENCHMARK {
+        QString from = isRenamed ? "/models/renamed/" : "/models/folder7/";
+        QString to = isRenamed ? "/models/folder7/" : "/models/renamed/";
+        auto folder = store.findPrefix(from);
+        AssetMappingStore::Edits removals;
+        AssetMappingStore::Edits additions;
+        for (auto it = folder.first; it != folder.second; ++it) {
+            removals.push_back({ it->first, AssetUtils::AssetHash() });
+            additions.push_back({ to + it->first.mid(from.size()), it->second });
+        }
+        removals.insert(removals.end(), additions.begin(), additions.end());
+        store.apply(removals);
+        isRenamed = !isRenamed;
+    }
+    QVERIFY(store.findPrefix("/models/folder7/").first != store.end());
+}
+
+void AssetMappingStoreTests::getAllPageBenchmark() {
+    auto& store = getBenchmarkStore();
+
+    // a page of mappings from the middle of the domain, as paths and raw hashes the way they are sent
+    int pageSize = 0;
+    QBENCHMARK {
+        QByteArray page;
+        auto it = store.lowerBound("/models/", makePath(NUM_BENCHMARK_FOLDERS / 3, 0));
+        for (uint32_t count = 0; it != store.end() && count < PAGE_SIZE; ++it, ++count) {
+            page.append(it->first.toUtf8());
+            page.append(QByteArray::fromHex(it->second.toUtf8()));
+        }
+        pageSize = page.size();
+    }
+    QVERIFY(pageSize > 0);
+}
+
+void AssetMappingStoreTests::rewriteMapFileBenchmark() {
+    auto& store = getBenchmarkStore();
+    QBENCHMARK_ONCE {
+        QVERIFY(store.compact());
+    }
+}
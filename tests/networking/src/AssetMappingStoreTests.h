@@ -0,0 +1,39 @@
+//
+//  AssetMappingStoreTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMappingStoreTests_h
+#define hifi_AssetMappingStoreTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AssetMappingStoreTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that edits survive reloading from the journal, and that an entry cut short is dropped
+    void journalTest();
+
+    // Test that the journal is folded into a map file QJsonDocument reads the same mappings from
+    void compactionTest();
+
+    // Test prefix queries and paging through them
+    void prefixTest();
+
+    // Time the edits and queries of the asset server with 1M mappings, and a rewrite of the whole map file, which is
+    // what every edit used to cost
+    void setBenchmark();
+    void renameFolderBenchmark();
+    void getAllPageBenchmark();
+    void rewriteMapFileBenchmark();
+};
+
+#endif // hifi_AssetMappingStoreTests_h
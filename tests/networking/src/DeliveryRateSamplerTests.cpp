@@ -0,0 +1,86 @@
+//
+//  DeliveryRateSamplerTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DeliveryRateSamplerTests.h"
+
+#include <udt/DeliveryRateSampler.h>
+
+QTEST_MAIN(DeliveryRateSamplerTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+namespace {
+
+const int PACKET_SIZE = 1400;
+
+}
+
+void DeliveryRateSamplerTests::steadyRateTest() {
+    // one packet every millisecond, each ACKed 50 ms after it was sent
+    const int NUM_PACKETS = 200;
+    const milliseconds SEND_INTERVAL { 1 };
+    const milliseconds RTT { 50 };
+
+    DeliveryRateSampler sampler;
+    auto start = p_high_resolution_clock::now();
+    SequenceNumber first { 1000 };
+
+    DeliveryRateSample lastSample;
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        sampler.onPacketSent(first + i, PACKET_SIZE, start + i * SEND_INTERVAL);
+
+        // ACK the packet sent one RTT ago
+        int acked = i - (int)(RTT / SEND_INTERVAL);
+        if (acked >= 0) {
+            lastSample = sampler.onACK(first + acked, start + acked * SEND_INTERVAL + RTT);
+            QVERIFY(lastSample.isValid);
+            QCOMPARE(lastSample.newlyDelivered, 1);
+            QCOMPARE(lastSample.rtt, (int)duration_cast<microseconds>(RTT).count());
+        }
+    }
+
+    // 1000 packets per second once a full round trip has been delivered
+    QVERIFY(qAbs(lastSample.deliveryRate - 1000) <= 10);
+    QVERIFY(qAbs(lastSample.deliveryRateBytes - 1000 * PACKET_SIZE) <= 10 * PACKET_SIZE);
+    QCOMPARE(lastSample.inFlight, sampler.getInFlight());
+
+    // an ACK that covers nothing new gives no sample
+    QVERIFY(!sampler.onACK(first, start + NUM_PACKETS * SEND_INTERVAL + RTT).isValid);
+}
+
+void DeliveryRateSamplerTests::cumulativeACKTest() {
+    DeliveryRateSampler sampler;
+    auto start = p_high_resolution_clock::now();
+    SequenceNumber first { 0 };
+
+    for (int i = 0; i < 10; ++i) {
+        sampler.onPacketSent(first + i, PACKET_SIZE, start + milliseconds(i));
+    }
+    sampler.onPacketReSent(first + 5);
+    QCOMPARE(sampler.getInFlight(), 10);
+
+    auto sample = sampler.onACK(first + 3, start + milliseconds(20));
+    QVERIFY(sample.isValid);
+    QCOMPARE(sample.newlyDelivered, 4);
+    QCOMPARE(sample.delivered, (int64_t)4);
+    QCOMPARE(sample.priorDelivered, (int64_t)0);
+    QCOMPARE(sample.inFlight, 6);
+    QCOMPARE(sample.rtt, 17000);
+
+    // the re-sent packet is the last one covered, so the RTT is ambiguous
+    sample = sampler.onACK(first + 5, start + milliseconds(30));
+    QVERIFY(sample.isValid);
+    QCOMPARE(sample.newlyDelivered, 2);
+    QCOMPARE(sample.delivered, (int64_t)6);
+    QCOMPARE(sample.rtt, -1);
+    QVERIFY(sample.deliveryRate > 0);
+}
@@ -0,0 +1,29 @@
+//
+//  DeliveryRateSamplerTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DeliveryRateSamplerTests_h
+#define hifi_DeliveryRateSamplerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class DeliveryRateSamplerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test the rate and RTT sampled from a steady stream of packets and ACKs
+    void steadyRateTest();
+
+    // Test that cumulative ACKs count every packet they cover, and re-sent packets give no RTT
+    void cumulativeACKTest();
+};
+
+#endif // hifi_DeliveryRateSamplerTests_h
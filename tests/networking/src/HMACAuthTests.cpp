@@ -0,0 +1,207 @@
+//
+//  HMACAuthTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HMACAuthTests.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include <HMACAuth.h>
+#include <NLPacket.h>
+
+QTEST_MAIN(HMACAuthTests)
+
+Q_DECLARE_METATYPE(HMACAuth::AuthMethod)
+
+namespace {
+
+const int BENCHMARK_PAYLOAD_SIZE = 512;
+
+std::unique_ptr<NLPacket> createVerifiedPacket(int payloadSize, char seed) {
+    auto packet = NLPacket::create(PacketType::AvatarData);
+    for (int i = 0; i < payloadSize; ++i) {
+        char byte = (char)(seed + i);
+        packet->write(&byte, 1);
+    }
+    packet->writeSourceID(1);
+    return packet;
+}
+
+}
+
+void HMACAuthTests::sipHashVectorTest() {
+    // key and messages are the byte sequences 0, 1, 2... used by the SipHash reference implementation
+    char key[16];
+    char message[15];
+    for (int i = 0; i < 16; ++i) {
+        key[i] = (char)i;
+    }
+    for (int i = 0; i < 15; ++i) {
+        message[i] = (char)i;
+    }
+
+    HMACAuth auth(HMACAuth::SIPHASH);
+    QVERIFY(auth.setKey(key, sizeof(key)));
+
+    HMACAuth::HMACHash hash;
+    QVERIFY(auth.calculateHash(hash, message, 0));
+    QCOMPARE(QByteArray((const char*)hash.data(), (int)hash.size()).toHex(), QByteArray("a3817f04ba25a8e66df67214c7550293"));
+
+    QVERIFY(auth.calculateHash(hash, message, 1));
+    QCOMPARE(QByteArray((const char*)hash.data(), (int)hash.size()).toHex(), QByteArray("da87c1d86b99af44347659119b22fc45"));
+
+    // the streaming interface gives the same hash
+    auth.addData(message, 0);
+    auth.addData(message, 1);
+    QCOMPARE(auth.result(), hash);
+}
+
+void HMACAuthTests::signAndVerifyTest_data() {
+    QTest::addColumn<HMACAuth::AuthMethod>("authMethod");
+
+    QTest::newRow("MD5") << HMACAuth::MD5;
+    QTest::newRow("SipHash") << HMACAuth::SIPHASH;
+}
+
+void HMACAuthTests::signAndVerifyTest() {
+    QFETCH(HMACAuth::AuthMethod, authMethod);
+
+    const QUuid secret = QUuid::createUuid();
+    HMACAuth senderAuth(authMethod);
+    HMACAuth receiverAuth(authMethod);
+    senderAuth.setKey(secret);
+    receiverAuth.setKey(secret);
+
+    // sign one packet at a time
+    auto packet = createVerifiedPacket(100, 0);
+    packet->writeVerificationHash(senderAuth);
+    QCOMPARE(NLPacket::hashForPacketAndHMAC(*packet, receiverAuth), NLPacket::verificationHashInHeader(*packet));
+
+    // sign a batch and verify it, with one packet tampered with and one signed with the wrong key
+    std::vector<std::unique_ptr<NLPacket>> packets;
+    std::vector<const NLPacket*> toSign;
+    for (int i = 0; i < 8; ++i) {
+        packets.push_back(createVerifiedPacket(50 + i * 10, (char)i));
+        toSign.push_back(packets.back().get());
+    }
+    NLPacket::writeVerificationHashes(toSign, senderAuth);
+
+    const int TAMPERED_INDEX = 3;
+    const int WRONG_KEY_INDEX = 5;
+    packets[TAMPERED_INDEX]->getData()[packets[TAMPERED_INDEX]->getDataSize() - 1] ^= 0x01;
+    HMACAuth otherAuth(authMethod);
+    otherAuth.setKey(QUuid::createUuid());
+    packets[WRONG_KEY_INDEX]->writeVerificationHash(otherAuth);
+
+    for (int i = 0; i < (int)packets.size(); ++i) {
+        bool isVerified = NLPacket::hashForPacketAndHMAC(*packets[i], receiverAuth) ==
+            NLPacket::verificationHashInHeader(*packets[i]);
+        QCOMPARE(isVerified, i != TAMPERED_INDEX && i != WRONG_KEY_INDEX);
+    }
+}
+
+void HMACAuthTests::rekeyTest() {
+    const QUuid firstSecret = QUuid::createUuid();
+    const QUuid secondSecret = QUuid::createUuid();
+    auto packet = createVerifiedPacket(100, 0);
+
+    HMACAuth firstAuth(HMACAuth::SIPHASH);
+    firstAuth.setKey(firstSecret);
+    HMACAuth secondAuth(HMACAuth::SIPHASH);
+    secondAuth.setKey(secondSecret);
+    auto firstHash = NLPacket::hashForPacketAndHMAC(*packet, firstAuth);
+    auto secondHash = NLPacket::hashForPacketAndHMAC(*packet, secondAuth);
+
+    // while one thread keeps re-keying, every hash the others make is with one whole key or the other
+    HMACAuth auth(HMACAuth::SIPHASH);
+    auth.setKey(firstSecret);
+    std::atomic<bool> isDone { false };
+    std::atomic<int> numTorn { 0 };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            while (!isDone) {
+                auto hash = NLPacket::hashForPacketAndHMAC(*packet, auth);
+                if (hash != firstHash && hash != secondHash) {
+                    ++numTorn;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 100000; ++i) {
+        auth.setKey(i % 2 ? firstSecret : secondSecret);
+    }
+    isDone = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    QCOMPARE(numTorn.load(), 0);
+}
+
+void HMACAuthTests::signVerifyBenchmark_data() {
+    QTest::addColumn<HMACAuth::AuthMethod>("authMethod");
+    QTest::addColumn<int>("numThreads");
+
+    for (int numThreads : { 1, 4, 16 }) {
+        QTest::newRow(qPrintable(QString("MD5, %1 threads").arg(numThreads))) << HMACAuth::MD5 << numThreads;
+        QTest::newRow(qPrintable(QString("SipHash, %1 threads").arg(numThreads))) << HMACAuth::SIPHASH << numThreads;
+    }
+}
+
+void HMACAuthTests::signVerifyBenchmark() {
+    QFETCH(HMACAuth::AuthMethod, authMethod);
+    QFETCH(int, numThreads);
+
+    const int PACKETS_PER_THREAD = 20000;
+
+    // like a mixer, every thread hashes with the one HMACAuth of the node it is talking to
+    HMACAuth auth(authMethod);
+    auth.setKey(QUuid::createUuid());
+
+    std::vector<std::unique_ptr<NLPacket>> packets;
+    for (int i = 0; i < numThreads; ++i) {
+        packets.push_back(createVerifiedPacket(BENCHMARK_PAYLOAD_SIZE, (char)i));
+    }
+
+    auto runThreads = [&](std::function<void(NLPacket&)> work) {
+        QElapsedTimer timer;
+        timer.start();
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; ++i) {
+            threads.emplace_back([&, i] {
+                for (int j = 0; j < PACKETS_PER_THREAD; ++j) {
+                    work(*packets[i]);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        return (double)numThreads * PACKETS_PER_THREAD * 1.0e9 / std::max<qint64>(timer.nsecsElapsed(), 1);
+    };
+
+    double signRate = runThreads([&](NLPacket& packet) {
+        packet.writeVerificationHash(auth);
+    });
+
+    std::atomic<int> numFailed { 0 };
+    double verifyRate = runThreads([&](NLPacket& packet) {
+        if (NLPacket::hashForPacketAndHMAC(packet, auth) != NLPacket::verificationHashInHeader(packet)) {
+            ++numFailed;
+        }
+    });
+    QCOMPARE(numFailed.load(), 0);
+
+    qDebug() << QTest::currentDataTag() << "- packets/sec: sign" << (qint64)signRate << "verify" << (qint64)verifyRate;
+}
@@ -0,0 +1,37 @@
+//
+//  HMACAuthTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HMACAuthTests_h
+#define hifi_HMACAuthTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class HMACAuthTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test SipHash against the reference test vectors
+    void sipHashVectorTest();
+
+    // Test signing packets, singly and in batches, and verifying them
+    void signAndVerifyTest_data();
+    void signAndVerifyTest();
+
+    // Test that hashing while the key changes always uses a whole key
+    void rekeyTest();
+
+    // Compare sign and verify throughput of the hash methods from several threads sharing one node's hash
+    void signVerifyBenchmark_data();
+    void signVerifyBenchmark();
+};
+
+#endif // hifi_HMACAuthTests_h
@@ -0,0 +1,173 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <udt/Constants.h>
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+namespace {
+
+using Range = std::pair<SequenceNumber::Type, SequenceNumber::Type>;
+
+std::vector<Range> writtenRanges(LossList& lossList, int maxPairs = -1) {
+    auto packet = ControlPacket::create(ControlPacket::ACK);
+    lossList.write(*packet, maxPairs);
+
+    std::vector<Range> ranges;
+    packet->seek(0);
+    while (packet->bytesLeftToRead() >= (qint64)(2 * sizeof(SequenceNumber))) {
+        SequenceNumber first, last;
+        packet->readPrimitive(&first);
+        packet->readPrimitive(&last);
+        ranges.emplace_back((SequenceNumber::Type)first, (SequenceNumber::Type)last);
+    }
+    return ranges;
+}
+
+SequenceNumber seq(SequenceNumber::Type value) {
+    return SequenceNumber(value);
+}
+
+}
+
+void LossListTests::rangeTest() {
+    LossList lossList;
+    QVERIFY(lossList.isEmpty());
+
+    lossList.append(seq(10));
+    lossList.append(seq(11), seq(15));
+    lossList.append(seq(20), seq(22));
+    QCOMPARE(lossList.getLength(), 9);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(10));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 10, 15 }, { 20, 22 } }));
+
+    // inserting before, between and across existing ranges only counts new losses
+    lossList.insert(seq(5), seq(6));
+    lossList.insert(seq(14), seq(19));
+    QCOMPARE(lossList.getLength(), 15);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(5));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 5, 6 }, { 10, 22 } }));
+    QCOMPARE(writtenRanges(lossList, 1), (std::vector<Range> { { 5, 6 } }));
+
+    QVERIFY(lossList.remove(seq(12)));
+    QVERIFY(!lossList.remove(seq(12)));
+    QVERIFY(!lossList.remove(seq(8)));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 5, 6 }, { 10, 11 }, { 13, 22 } }));
+
+    lossList.remove(seq(0), seq(10));
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(11));
+    lossList.remove(seq(18), seq(30));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 11, 11 }, { 13, 17 } }));
+    QCOMPARE(lossList.getLength(), 6);
+
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(11));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(13));
+    QCOMPARE(lossList.getLength(), 4);
+
+    // appending after the last loss works again once the tail was removed
+    lossList.remove(seq(17));
+    lossList.append(seq(17));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 14, 17 } }));
+
+    lossList.clear();
+    QVERIFY(lossList.isEmpty());
+    QVERIFY(writtenRanges(lossList).empty());
+    lossList.append(seq(1000));
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(1000));
+    QCOMPARE(lossList.getLength(), 1);
+}
+
+void LossListTests::wrapAroundTest() {
+    LossList lossList;
+    const SequenceNumber::Type MAX = SequenceNumber::MAX;
+
+    lossList.append(seq(MAX - 2), seq(MAX));
+    lossList.append(seq(0), seq(1));
+    lossList.append(seq(5));
+    QCOMPARE(lossList.getLength(), 6);
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { MAX - 2, 1 }, { 5, 5 } }));
+
+    QVERIFY(lossList.remove(seq(MAX)));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { MAX - 2, MAX - 1 }, { 0, 1 }, { 5, 5 } }));
+
+    lossList.insert(seq(MAX - 5), seq(MAX));
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(MAX - 5));
+
+    lossList.remove(seq(MAX - 10), seq(0));
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(1));
+    QCOMPARE(lossList.getLength(), 2);
+}
+
+void LossListTests::largeWindowTest() {
+    LossList lossList;
+    const int WINDOW = MAX_PACKETS_IN_FLIGHT;
+
+    // every other packet of a window far larger than the initial ring
+    for (int i = 0; i < WINDOW; i += 2) {
+        lossList.append(seq(1000 + i));
+    }
+    QCOMPARE(lossList.getLength(), WINDOW / 2);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(1000));
+
+    auto ranges = writtenRanges(lossList);
+    QCOMPARE((int)ranges.size(), WINDOW / 2);
+    QCOMPARE(ranges.back(), Range(1000 + WINDOW - 2, 1000 + WINDOW - 2));
+
+    lossList.insert(seq(0), seq(1000 + WINDOW));
+    QCOMPARE(lossList.getLength(), 1001 + WINDOW);
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 0, 1000 + WINDOW } }));
+}
+
+void LossListTests::oversizedGapTest() {
+    LossList lossList;
+    const SequenceNumber::Type FORGED_GAP = 1 << 26;
+
+    // a gap no flow window could leave is dropped, instead of growing the ring to hold it
+    lossList.append(seq(10));
+    lossList.append(seq(11), seq(10 + FORGED_GAP));
+    lossList.append(seq(10 + FORGED_GAP));
+    lossList.insert(seq(20), seq(20 + FORGED_GAP));
+    QCOMPARE(lossList.getLength(), 1);
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 10, 10 } }));
+
+    LossList emptyList;
+    emptyList.append(seq(0), seq(FORGED_GAP));
+    QVERIFY(emptyList.isEmpty());
+
+    // losses up to a full flow window apart are still kept
+    lossList.append(seq(10 + MAX_PACKETS_IN_FLIGHT));
+    QCOMPARE(writtenRanges(lossList), (std::vector<Range> { { 10, 10 }, { 10 + MAX_PACKETS_IN_FLIGHT, 10 + MAX_PACKETS_IN_FLIGHT } }));
+}
+
+void LossListTests::lossRecoveryBenchmark() {
+    const int NUM_PACKETS = 100000;
+    const int LOSS_INTERVAL = 20;
+    const int RECOVERY_DELAY = 500; // packets sent between a loss and its recovery
+
+    QBENCHMARK {
+        LossList lossList;
+        for (int i = 0; i < NUM_PACKETS; ++i) {
+            if (i % LOSS_INTERVAL == 0) {
+                lossList.append(seq(i));
+            }
+            if (i >= RECOVERY_DELAY && (i - RECOVERY_DELAY) % LOSS_INTERVAL == 0) {
+                lossList.remove(seq(i - RECOVERY_DELAY));
+            }
+        }
+        QVERIFY(lossList.getLength() <= RECOVERY_DELAY / LOSS_INTERVAL);
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test appending, inserting and removing losses, and the ranges it writes out
+    void rangeTest();
+
+    // Test losses on both sides of the sequence number wrap around
+    void wrapAroundTest();
+
+    // Test a window of losses larger than the initial ring
+    void largeWindowTest();
+
+    // Test that losses further apart than a flow window are dropped
+    void oversizedGapTest();
+
+    // Time losing and recovering one packet in twenty over a sliding window
+    void lossRecoveryBenchmark();
+};
+
+#endif // hifi_LossListTests_h
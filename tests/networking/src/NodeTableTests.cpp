@@ -0,0 +1,227 @@
+//
+//  NodeTableTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeTableTests.h"
+
+#include <thread>
+
+#include <QtCore/QReadWriteLock>
+
+#include <NodeTable.h>
+#include <TBBHelpers.h>
+
+QTEST_MAIN(NodeTableTests)
+
+namespace {
+
+const int NUM_NODES = 2000;
+const int NUM_PACKETS = 100000;
+
+// local IDs are handed out from a random start with a fixed stride, so they are spread over the whole range
+const Node::LocalID FIRST_LOCAL_ID = 12345;
+const Node::LocalID LOCAL_ID_STRIDE = 2039;
+
+SharedNodePointer createNode(Node::LocalID localID) {
+    SharedNodePointer node(new Node(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr()));
+    node->setLocalID(localID);
+    return node;
+}
+
+std::vector<Node::LocalID> createLocalIDs() {
+    std::vector<Node::LocalID> localIDs;
+    Node::LocalID localID = FIRST_LOCAL_ID;
+    for (int i = 0; i < NUM_NODES; ++i) {
+        localIDs.push_back(localID);
+        localID += LOCAL_ID_STRIDE;
+    }
+    return localIDs;
+}
+
+// how LimitedNodeList looked nodes up before the node table
+struct LockedNodeHash {
+    using LocalIDMapping = tbb::concurrent_unordered_map<Node::LocalID, SharedNodePointer>;
+
+    SharedNodePointer nodeWithLocalID(Node::LocalID localID) const {
+        QReadLocker readLocker(&mutex);
+        auto it = nodes.find(localID);
+        return it == nodes.cend() ? SharedNodePointer() : it->second;
+    }
+
+    LocalIDMapping nodes;
+    mutable QReadWriteLock mutex { QReadWriteLock::Recursive };
+};
+
+}
+
+void NodeTableTests::localIDTest() {
+    NodeTable table;
+    auto first = createNode(1);
+    auto second = createNode(2);
+    auto unindexed = createNode(Node::NULL_LOCAL_ID);
+
+    table.insert(first);
+    table.insert(second);
+    table.insert(unindexed);
+    QCOMPARE(table.size(), (size_t)3);
+    QCOMPARE(table.nodeWithLocalID(1), first);
+    QCOMPARE(table.nodeWithLocalID(2), second);
+    QVERIFY(table.nodeWithLocalID(3).isNull());
+    QVERIFY(table.nodeWithLocalID(Node::NULL_LOCAL_ID).isNull());
+
+    // a reconnecting node can get the local ID of one that hasn't been killed yet
+    auto replacement = createNode(1);
+    table.insert(replacement);
+    QCOMPARE(table.nodeWithLocalID(1), replacement);
+    table.remove(replacement);
+    QCOMPARE(table.nodeWithLocalID(1), first);
+
+    // a node is removed by the local ID it was indexed under
+    table.remove(second);
+    second->setLocalID(4);
+    table.insert(second);
+    QVERIFY(table.nodeWithLocalID(2).isNull());
+    QCOMPARE(table.nodeWithLocalID(4), second);
+
+    table.remove(first);
+    table.remove(second);
+    table.remove(unindexed);
+    QCOMPARE(table.size(), (size_t)0);
+    QVERIFY(table.nodeWithLocalID(4).isNull());
+
+    table.insert(first);
+    table.clear();
+    QVERIFY(table.nodeWithLocalID(1).isNull());
+}
+
+void NodeTableTests::snapshotTest() {
+    NodeTable table;
+    std::vector<QWeakPointer<Node>> weakNodes;
+    for (auto localID : createLocalIDs()) {
+        auto node = createNode(localID);
+        table.insert(node);
+        weakNodes.push_back(node);
+    }
+
+    {
+        NodeTable::ReadGuard snapshot(table);
+        for (auto& weakNode : weakNodes) {
+            table.remove(weakNode.toStrongRef());
+        }
+        QCOMPARE(table.size(), (size_t)0);
+
+        // the snapshot still holds every node
+        QCOMPARE(snapshot->nodes.size(), (size_t)NUM_NODES);
+        for (auto& weakNode : weakNodes) {
+            auto node = weakNode.toStrongRef();
+            QVERIFY(!node.isNull());
+            QCOMPARE(*snapshot->find(node->getLocalID()), node);
+        }
+    }
+
+    // and lets go of them once it is released
+    for (auto& weakNode : weakNodes) {
+        QVERIFY(weakNode.isNull());
+    }
+}
+
+void NodeTableTests::waitForReadersTest() {
+    NodeTable table;
+    auto node = createNode(FIRST_LOCAL_ID);
+    table.insert(node);
+
+    std::atomic<bool> isReading { false };
+    std::atomic<bool> isDoneReading { false };
+    std::thread reader([&] {
+        NodeTable::ReadGuard snapshot(table);
+        isReading = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        isDoneReading = true;
+    });
+    while (!isReading) {
+        std::this_thread::yield();
+    }
+
+    // a reader that started before the node was removed has to be done before the wait returns
+    table.remove(node);
+    table.waitForReaders();
+    QVERIFY(isDoneReading);
+    reader.join();
+
+    // and the calling thread's own guard doesn't make it wait on itself
+    NodeTable::ReadGuard snapshot(table);
+    table.waitForReaders();
+}
+
+void NodeTableTests::sourceLookupBenchmark_data() {
+    QTest::addColumn<bool>("useNodeTable");
+    QTest::newRow("NodeTable") << true;
+    QTest::newRow("locked hash") << false;
+}
+
+void NodeTableTests::sourceLookupBenchmark() {
+    QFETCH(bool, useNodeTable);
+
+    auto localIDs = createLocalIDs();
+    NodeTable table;
+    LockedNodeHash hash;
+    for (auto localID : localIDs) {
+        auto node = createNode(localID);
+        table.insert(node);
+        hash.nodes.insert({ localID, node });
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (int i = 0; i < NUM_PACKETS; ++i) {
+            Node::LocalID sourceID = localIDs[(i * 7) % NUM_NODES];
+            auto node = useNodeTable ? table.nodeWithLocalID(sourceID) : hash.nodeWithLocalID(sourceID);
+            found += node ? 1 : 0;
+        }
+    }
+    QCOMPARE(found, NUM_PACKETS);
+}
+
+void NodeTableTests::iterationBenchmark_data() {
+    sourceLookupBenchmark_data();
+}
+
+void NodeTableTests::iterationBenchmark() {
+    QFETCH(bool, useNodeTable);
+
+    NodeTable table;
+    LockedNodeHash hash;
+    for (auto localID : createLocalIDs()) {
+        auto node = createNode(localID);
+        table.insert(node);
+        hash.nodes.insert({ localID, node });
+    }
+
+    const int NUM_ITERATIONS = 1000;
+    int visited = 0;
+    QBENCHMARK {
+        visited = 0;
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            if (useNodeTable) {
+                NodeTable::ReadGuard snapshot(table);
+                for (const auto& node : snapshot->nodes) {
+                    visited += node->getType() == NodeType::Agent ? 1 : 0;
+                }
+            } else {
+                QReadLocker readLocker(&hash.mutex);
+                for (auto it = hash.nodes.cbegin(); it != hash.nodes.cend(); ++it) {
+                    visited += it->second->getType() == NodeType::Agent ? 1 : 0;
+                }
+            }
+        }
+    }
+    QCOMPARE(visited, NUM_ITERATIONS * NUM_NODES);
+}
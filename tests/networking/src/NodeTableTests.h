@@ -0,0 +1,40 @@
+//
+//  NodeTableTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeTableTests_h
+#define hifi_NodeTableTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class NodeTableTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test finding nodes by local ID as they are added, removed and re-indexed
+    void localIDTest();
+
+    // Test that a snapshot keeps its nodes while they are removed from the table
+    void snapshotTest();
+
+    // Test that waiting for readers returns only once the readers that started before it are done
+    void waitForReadersTest();
+
+    // Benchmark the per-packet source lookup with 2000 nodes, against the locked hash it replaces
+    void sourceLookupBenchmark_data();
+    void sourceLookupBenchmark();
+
+    // Benchmark iterating 2000 nodes, against the locked hash it replaces
+    void iterationBenchmark_data();
+    void iterationBenchmark();
+};
+
+#endif // hifi_NodeTableTests_h
@@ -0,0 +1,112 @@
+//
+//  PacketCaptureTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCaptureTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <udt/PacketCapture.h>
+
+QTEST_MAIN(PacketCaptureTests)
+
+using namespace udt;
+
+namespace {
+
+const quint64 START_TIME = 1700000000000000;
+const HifiSockAddr SENDER(QHostAddress("10.0.0.1"), 40102);
+
+QByteArray datagram(quint32 index, int size) {
+    QByteArray data(size, (char)(index % 251));
+    memcpy(data.data(), &index, sizeof(index));
+    return data;
+}
+
+quint32 indexOf(const PacketCaptureReader::Record& record) {
+    quint32 index;
+    memcpy(&index, record.data.get(), sizeof(index));
+    return index;
+}
+
+}
+
+void PacketCaptureTests::roundTripTest() {
+    QTemporaryDir dir;
+    QString path = dir.filePath("capture");
+
+    {
+        PacketCapture capture(path);
+        for (quint32 i = 0; i < 100; ++i) {
+            auto data = datagram(i, 4 + i * 13);
+            capture.write(START_TIME + i * 1000, HifiSockAddr(QHostAddress(0x0A000000 + i), 1000 + i), data.data(), data.size());
+        }
+    }
+
+    PacketCaptureReader reader;
+    QVERIFY(reader.open(path));
+
+    PacketCaptureReader::Record record;
+    for (quint32 i = 0; i < 100; ++i) {
+        QVERIFY(reader.readNext(record));
+        QCOMPARE(record.timestamp, START_TIME + i * 1000);
+        QCOMPARE(record.senderSockAddr, HifiSockAddr(QHostAddress(0x0A000000 + i), 1000 + i));
+        QCOMPARE(QByteArray(record.data.get(), (int)record.size), datagram(i, 4 + i * 13));
+        QCOMPARE(record.startsSegment, i == 0);
+    }
+    QVERIFY(!reader.readNext(record));
+}
+
+void PacketCaptureTests::ringTest() {
+    const qint64 MAX_SIZE = 3 * 1024 * 1024;
+    const int DATAGRAM_SIZE = 1000;
+    const quint32 NUM_DATAGRAMS = 20000; // about 20 MB
+
+    QTemporaryDir dir;
+    QString path = dir.filePath("capture");
+
+    {
+        PacketCapture capture(path, MAX_SIZE);
+        for (quint32 i = 0; i < NUM_DATAGRAMS; ++i) {
+            auto data = datagram(i, DATAGRAM_SIZE);
+            capture.write(START_TIME + i * 100, SENDER, data.data(), data.size());
+        }
+    }
+
+    auto segments = PacketCapture::segmentPaths(path);
+    QCOMPARE(segments.size(), 3);
+    QVERIFY(segments.first().endsWith(".0"));
+
+    qint64 totalSize = 0;
+    for (auto& segment : segments) {
+        totalSize += QFileInfo(segment).size();
+    }
+    QVERIFY(totalSize <= MAX_SIZE + 3 * (DATAGRAM_SIZE + 64)); // each segment can go over by one record
+
+    // the first segment, then a gap, then the last datagrams without one missing
+    PacketCaptureReader reader;
+    QVERIFY(reader.open(path));
+
+    PacketCaptureReader::Record record;
+    quint32 expectedIndex = 0;
+    int numGaps = 0;
+    while (reader.readNext(record)) {
+        quint32 index = indexOf(record);
+        if (index != expectedIndex) {
+            QVERIFY(record.startsSegment);
+            QVERIFY(index > expectedIndex);
+            ++numGaps;
+        }
+        QCOMPARE(record.timestamp, START_TIME + index * 100);
+        expectedIndex = index + 1;
+    }
+    QCOMPARE(numGaps, 1);
+    QCOMPARE(expectedIndex, NUM_DATAGRAMS);
+}
@@ -0,0 +1,29 @@
+//
+//  PacketCaptureTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCaptureTests_h
+#define hifi_PacketCaptureTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketCaptureTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that datagrams read back from a capture as they were written
+    void roundTripTest();
+
+    // Test that a capture keeps its first segment and the most recent datagrams within its maximum size
+    void ringTest();
+};
+
+#endif // hifi_PacketCaptureTests_h
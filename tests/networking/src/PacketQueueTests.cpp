@@ -0,0 +1,275 @@
+//
+//  PacketQueueTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketQueueTests.h"
+
+#include <chrono>
+#include <cstring>
+
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(PacketQueueTests)
+
+using namespace udt;
+
+namespace {
+
+using Priority = PacketList::Priority;
+
+// the transfer is queued as many lists, like the chunks of a large asset
+const int TRANSFER_SIZE = 100 * 1024 * 1024;
+const int TRANSFER_LIST_SIZE = 1024 * 1024;
+const int SMALL_MESSAGE_SIZE = 3000;
+const int SMALL_MESSAGE_INTERVAL = 1000; // packets sent between two small messages
+const double LINK_BITS_PER_SECOND = 100.0e6;
+
+std::unique_ptr<PacketList> createPacketList(int size, Priority priority) {
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    packetList->setPriority(priority);
+    packetList->write(QByteArray(size, 'x'));
+    packetList->closeCurrentPacket();
+    return packetList;
+}
+
+struct LatencyResult {
+    int numMessages { 0 };
+    int messagePackets { 0 };
+    int maxPackets { 0 };
+    double averagePackets { 0.0 };
+    double maxMilliseconds { 0.0 };
+};
+
+// sends the whole transfer, queueing a small message every so often and counting the packets sent until all of it is out
+LatencyResult measureSmallMessageLatency(Priority transferPriority, Priority smallMessagePriority) {
+    PacketQueue queue;
+    for (int queued = 0; queued < TRANSFER_SIZE; queued += TRANSFER_LIST_SIZE) {
+        queue.queuePacketList(createPacketList(TRANSFER_LIST_SIZE, transferPriority));
+    }
+
+    LatencyResult result;
+    int64_t totalPackets = 0;
+    int sinceLastMessage = 0;
+    while (!queue.isEmpty()) {
+        if (sinceLastMessage < SMALL_MESSAGE_INTERVAL) {
+            queue.takePacket();
+            ++sinceLastMessage;
+            continue;
+        }
+        sinceLastMessage = 0;
+
+        auto smallMessage = createPacketList(SMALL_MESSAGE_SIZE, smallMessagePriority);
+        int messagePackets = (int)smallMessage->getNumPackets();
+        queue.queuePacketList(std::move(smallMessage));
+        auto messageNumber = queue.getCurrentMessageNumber();
+
+        int packetsSent = 0;
+        int64_t bytesSent = 0;
+        for (int remaining = messagePackets; remaining > 0;) {
+            auto packet = queue.takePacket();
+            ++packetsSent;
+            bytesSent += packet->getWireSize();
+            if (packet->getMessageNumber() == messageNumber) {
+                --remaining;
+            }
+        }
+
+        ++result.numMessages;
+        result.messagePackets = messagePackets;
+        result.maxPackets = std::max(result.maxPackets, packetsSent);
+        result.maxMilliseconds = std::max(result.maxMilliseconds, bytesSent * 8 * 1000.0 / LINK_BITS_PER_SECOND);
+        totalPackets += packetsSent;
+    }
+    result.averagePackets = result.numMessages > 0 ? (double)totalPackets / result.numMessages : 0.0;
+    return result;
+}
+
+// data whose bytes are their offset, counting how much of it has been read
+class CountingStreamedData : public PacketList::StreamedData {
+public:
+    CountingStreamedData(qint64 size, qint64& bytesRead) : _size(size), _bytesRead(bytesRead) {}
+
+    qint64 size() const override { return _size; }
+    bool read(qint64 offset, char* data, qint64 size) override {
+        for (qint64 i = 0; i < size; ++i) {
+            data[i] = (char)(offset + i);
+        }
+        _bytesRead += size;
+        return true;
+    }
+
+private:
+    qint64 _size;
+    qint64& _bytesRead;
+};
+
+// data that can't be read past an offset, like a file cut short
+class FailingStreamedData : public PacketList::StreamedData {
+public:
+    FailingStreamedData(qint64 size, qint64 failOffset) : _size(size), _failOffset(failOffset) {}
+
+    qint64 size() const override { return _size; }
+    bool read(qint64 offset, char* data, qint64 size) override {
+        if (offset + size > _failOffset) {
+            return false;
+        }
+        memset(data, 1, size);
+        return true;
+    }
+
+private:
+    qint64 _size;
+    qint64 _failOffset;
+};
+
+}
+
+void PacketQueueTests::smallMessageLatencyTest() {
+    auto prioritized = measureSmallMessageLatency(Priority::Bulk, Priority::Urgent);
+    auto unprioritized = measureSmallMessageLatency(Priority::Normal, Priority::Normal);
+
+    qDebug() << "Small message latency with priorities:" << prioritized.averagePackets << "packets on average,"
+        << prioritized.maxPackets << "at most," << prioritized.maxMilliseconds << "ms at 100 Mb/s";
+    qDebug() << "Small message latency without priorities:" << unprioritized.averagePackets << "packets on average,"
+        << unprioritized.maxPackets << "at most," << unprioritized.maxMilliseconds << "ms at 100 Mb/s";
+
+    // an urgent message goes out ahead of the whole transfer
+    QVERIFY(prioritized.numMessages > 0);
+    QCOMPARE(prioritized.maxPackets, prioritized.messagePackets);
+    QVERIFY(prioritized.maxPackets < unprioritized.maxPackets);
+}
+
+void PacketQueueTests::starvationTest() {
+    PacketQueue queue;
+    queue.queuePacketList(createPacketList(TRANSFER_LIST_SIZE, Priority::Bulk));
+    auto bulkMessageNumber = queue.getCurrentMessageNumber();
+    for (int i = 0; i < 1000; ++i) {
+        queue.queuePacketList(createPacketList(SMALL_MESSAGE_SIZE, Priority::Urgent));
+    }
+
+    // the bulk list gets at least one packet in every seventeen
+    const int NUM_ROUNDS = 10;
+    int bulkPackets = 0;
+    for (int i = 0; i < 17 * NUM_ROUNDS; ++i) {
+        if (queue.takePacket()->getMessageNumber() == bulkMessageNumber) {
+            ++bulkPackets;
+        }
+    }
+    QVERIFY(bulkPackets >= NUM_ROUNDS);
+}
+
+void PacketQueueTests::deadlineTest() {
+    PacketQueue queue;
+    auto now = p_high_resolution_clock::now();
+
+    queue.queuePacketList(createPacketList(SMALL_MESSAGE_SIZE, Priority::Bulk));
+    auto plainMessageNumber = queue.getCurrentMessageNumber();
+
+    auto laterList = createPacketList(SMALL_MESSAGE_SIZE, Priority::Bulk);
+    laterList->setDeadline(now + std::chrono::seconds(1));
+    int laterPackets = (int)laterList->getNumPackets();
+    queue.queuePacketList(std::move(laterList));
+    auto laterMessageNumber = queue.getCurrentMessageNumber();
+
+    auto lateList = createPacketList(SMALL_MESSAGE_SIZE, Priority::Bulk);
+    lateList->setDeadline(now - std::chrono::seconds(1));
+    int latePackets = (int)lateList->getNumPackets();
+    queue.queuePacketList(std::move(lateList));
+    auto lateMessageNumber = queue.getCurrentMessageNumber();
+
+    auto urgentList = createPacketList(SMALL_MESSAGE_SIZE, Priority::Urgent);
+    int urgentPackets = (int)urgentList->getNumPackets();
+    queue.queuePacketList(std::move(urgentList));
+    auto urgentMessageNumber = queue.getCurrentMessageNumber();
+
+    // the overdue bulk list waits for the urgent one, then the bulk lists go earliest deadline first
+    for (int i = 0; i < urgentPackets; ++i) {
+        QCOMPARE(queue.takePacket()->getMessageNumber(), urgentMessageNumber);
+    }
+    for (int i = 0; i < latePackets; ++i) {
+        QCOMPARE(queue.takePacket()->getMessageNumber(), lateMessageNumber);
+    }
+    for (int i = 0; i < laterPackets; ++i) {
+        QCOMPARE(queue.takePacket()->getMessageNumber(), laterMessageNumber);
+    }
+    QCOMPARE(queue.takePacket()->getMessageNumber(), plainMessageNumber);
+}
+
+void PacketQueueTests::streamedListTest() {
+    const qint64 STREAMED_SIZE = 1024 * 1024;
+    const QByteArray HEADER = "header";
+
+    qint64 bytesRead = 0;
+    auto streamedList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    streamedList->write(HEADER);
+    streamedList->setStreamedData(PacketList::StreamedDataPointer(new CountingStreamedData(STREAMED_SIZE, bytesRead)));
+    int numPackets = (int)streamedList->getNumPackets();
+
+    PacketQueue queue;
+    queue.queuePacketList(std::move(streamedList));
+    QCOMPARE(bytesRead, (qint64)0);
+
+    QByteArray message;
+    for (int i = 0; i < numPackets; ++i) {
+        auto packet = queue.takePacket();
+        QVERIFY(packet);
+        QCOMPARE(packet->getMessagePartNumber(), (Packet::MessagePartNumber)i);
+        auto expectedPosition = i == 0 ? Packet::PacketPosition::FIRST :
+            i == numPackets - 1 ? Packet::PacketPosition::LAST : Packet::PacketPosition::MIDDLE;
+        QCOMPARE(packet->getPacketPosition(), expectedPosition);
+
+        // no more is read than what has been taken
+        message.append(packet->getPayload(), (int)packet->getPayloadSize());
+        QVERIFY(bytesRead <= message.size());
+    }
+    QVERIFY(queue.isEmpty());
+
+    QCOMPARE(message.size(), HEADER.size() + (int)STREAMED_SIZE);
+    QVERIFY(message.startsWith(HEADER));
+    for (int i = 0; i < (int)STREAMED_SIZE; ++i) {
+        if (message[HEADER.size() + i] != (char)i) {
+            QFAIL("Streamed data arrived out of order");
+        }
+    }
+}
+
+void PacketQueueTests::streamedReadFailureTest() {
+    const qint64 STREAMED_SIZE = 1024 * 1024;
+    const qint64 FAIL_OFFSET = 100 * 1024;
+
+    auto failingList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    failingList->write("header");
+    failingList->setStreamedData(PacketList::StreamedDataPointer(new FailingStreamedData(STREAMED_SIZE, FAIL_OFFSET)));
+    size_t numPackets = failingList->getNumPackets();
+
+    PacketQueue queue;
+    queue.queuePacketList(std::move(failingList));
+    auto failingMessageNumber = queue.getCurrentMessageNumber();
+    queue.queuePacketList(createPacketList(SMALL_MESSAGE_SIZE, Priority::Normal));
+
+    // the message ends with the packet whose read failed, empty, and the list after it is sent whole
+    size_t failingPackets = 0;
+    qint64 failingBytes = 0;
+    std::unique_ptr<Packet> lastPacket;
+    while (!queue.isEmpty()) {
+        auto packet = queue.takePacket();
+        if (packet->getMessageNumber() == failingMessageNumber) {
+            ++failingPackets;
+            failingBytes += packet->getPayloadSize();
+            lastPacket = std::move(packet);
+        }
+    }
+    QVERIFY(lastPacket);
+    QCOMPARE(lastPacket->getPacketPosition(), Packet::PacketPosition::LAST);
+    QCOMPARE(lastPacket->getPayloadSize(), (qint64)0);
+    QCOMPARE(lastPacket->getMessagePartNumber() + 1, (Packet::MessagePartNumber)failingPackets);
+    QVERIFY(failingPackets < numPackets);
+    QVERIFY(failingBytes <= FAIL_OFFSET + (qint64)sizeof("header"));
+}
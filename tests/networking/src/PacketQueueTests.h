@@ -0,0 +1,38 @@
+//
+//  PacketQueueTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketQueueTests_h
+#define hifi_PacketQueueTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test how long small urgent messages wait while a 100 MB bulk transfer is queued
+    void smallMessageLatencyTest();
+
+    // Test that a bulk list keeps moving while urgent messages keep arriving
+    void starvationTest();
+
+    // Test that deadlines order the lists of a priority, and that an overdue list doesn't jump ahead of higher priorities
+    void deadlineTest();
+
+    // Test that streamed data is read into packets only as they are taken, and arrives whole and in order
+    void streamedListTest();
+
+    // Test that a read of streamed data that fails ends the message early, rather than sending what wasn't read
+    void streamedReadFailureTest();
+};
+
+#endif // hifi_PacketQueueTests_h
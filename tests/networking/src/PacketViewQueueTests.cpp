@@ -0,0 +1,212 @@
+//
+//  PacketViewQueueTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketViewQueueTests.h"
+
+#include <thread>
+
+#include <PacketViewQueue.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(PacketViewQueueTests)
+
+namespace {
+
+const PacketType VIEW_PACKET_TYPE = PacketType::MicrophoneAudioNoEcho;
+const int AUDIO_PAYLOAD_SIZE = 480;
+
+// a packet as it comes off the wire, carrying its index in the payload
+std::unique_ptr<udt::Packet> createReceivedPacket(quint32 index, int payloadSize = sizeof(quint32)) {
+    auto packet = NLPacket::create(VIEW_PACKET_TYPE);
+    packet->writePrimitive(index);
+    for (int i = sizeof(quint32); i < payloadSize; ++i) {
+        packet->writePrimitive((char)i);
+    }
+
+    auto dataSize = packet->getDataSize();
+    auto data = std::unique_ptr<char[]>(new char[dataSize]);
+    memcpy(data.get(), packet->getData(), dataSize);
+    auto received = udt::Packet::fromReceivedPacket(std::move(data), dataSize, HifiSockAddr());
+    received->setReceiveTime(p_high_resolution_clock::now());
+    return received;
+}
+
+ReceivedPacketView createView(quint32 index, int payloadSize = sizeof(quint32)) {
+    return ReceivedPacketView(createReceivedPacket(index, payloadSize), VIEW_PACKET_TYPE,
+                              NLPacket::totalHeaderSize(VIEW_PACKET_TYPE), SharedNodePointer());
+}
+
+quint32 indexOf(const ReceivedPacketView& view) {
+    quint32 index;
+    memcpy(&index, view.getPayload(), sizeof(index));
+    return index;
+}
+
+}
+
+class PacketViewListener : public QObject {
+public:
+    void handlePacket(QSharedPointer<ReceivedMessage> message) {
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch());
+        latencyUsecs += now.count() - message->getFirstPacketReceiveTime();
+        ++numPackets;
+    }
+
+    qint64 latencyUsecs { 0 };
+    int numPackets { 0 };
+};
+
+void PacketViewQueueTests::fifoTest() {
+    PacketViewQueue queue(5);
+    QCOMPARE(queue.getCapacity(), (size_t)8);
+
+    for (quint32 i = 0; i < 10; ++i) {
+        QCOMPARE(queue.push(createView(i)), i < 8);
+    }
+    QCOMPARE(queue.getPushedCount(), (uint64_t)8);
+    QCOMPARE(queue.getDroppedCount(), (uint64_t)2);
+
+    ReceivedPacketView view;
+    for (quint32 i = 0; i < 8; ++i) {
+        QVERIFY(queue.pop(view));
+        QCOMPARE(view.getType(), VIEW_PACKET_TYPE);
+        QCOMPARE(view.getPayloadSize(), (qint64)sizeof(quint32));
+        QCOMPARE(indexOf(view), i);
+    }
+    QVERIFY(!queue.pop(view));
+
+    // the queue is reused once it is drained, and a view hands its packet on to a ReceivedMessage
+    QVERIFY(queue.push(createView(42)));
+    QVERIFY(queue.pop(view));
+    auto message = view.toReceivedMessage();
+    QVERIFY(!view.isValid());
+    QCOMPARE(message->getType(), VIEW_PACKET_TYPE);
+    quint32 index;
+    message->readPrimitive(&index);
+    QCOMPARE(index, (quint32)42);
+
+    // or the message is reset to the packet of the next view
+    QVERIFY(queue.push(createView(43, 100)));
+    QVERIFY(queue.pop(view));
+    message->reset(view);
+    QVERIFY(!view.isValid());
+    QCOMPARE(message->getSize(), (qint64)100);
+    QCOMPARE(message->getPosition(), (qint64)0);
+    message->readPrimitive(&index);
+    QCOMPARE(index, (quint32)43);
+}
+
+void PacketViewQueueTests::concurrencyTest() {
+    const int NUM_PRODUCERS = 4;
+    const quint32 PACKETS_PER_PRODUCER = 20000;
+
+    PacketViewQueue queue(256);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < NUM_PRODUCERS; ++i) {
+        producers.emplace_back([&queue, i] {
+            for (quint32 j = 0; j < PACKETS_PER_PRODUCER; ++j) {
+                ReceivedPacketView view = createView(i * PACKETS_PER_PRODUCER + j);
+                while (!queue.push(std::move(view))) {
+                    // a failed push drops the packet, so retry with a new one
+                    view = createView(i * PACKETS_PER_PRODUCER + j);
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<bool> popped(NUM_PRODUCERS * PACKETS_PER_PRODUCER, false);
+    std::vector<quint32> lastFromProducer(NUM_PRODUCERS, 0);
+    size_t numPopped = 0;
+    bool inOrder = true;
+    bool unique = true;
+    ReceivedPacketView view;
+    while (numPopped < popped.size()) {
+        if (!queue.pop(view)) {
+            std::this_thread::yield();
+            continue;
+        }
+        quint32 index = indexOf(view);
+        unique = unique && !popped[index];
+        popped[index] = true;
+
+        // packets pushed by one thread stay in order
+        quint32 producer = index / PACKETS_PER_PRODUCER;
+        inOrder = inOrder && (index % PACKETS_PER_PRODUCER == 0 || lastFromProducer[producer] < index);
+        lastFromProducer[producer] = index;
+        ++numPopped;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    QVERIFY(unique);
+    QVERIFY(inOrder);
+    QVERIFY(!queue.pop(view));
+}
+
+void PacketViewQueueTests::dispatchBenchmark_data() {
+    QTest::addColumn<bool>("useViewQueue");
+    QTest::addColumn<bool>("reuseMessage");
+    QTest::newRow("ReceivedMessage, queued invocation") << false << false;
+    QTest::newRow("PacketViewQueue, a ReceivedMessage each") << true << false;
+    QTest::newRow("PacketViewQueue, one ReceivedMessage reset to each") << true << true;
+}
+
+void PacketViewQueueTests::dispatchBenchmark() {
+    QFETCH(bool, useViewQueue);
+    QFETCH(bool, reuseMessage);
+
+    // a frame worth of audio from a busy mixer, received and then handled by the listener
+    const int PACKETS_PER_FRAME = 200;
+
+    PacketViewQueue queue;
+    PacketViewListener listener;
+    std::vector<std::unique_ptr<udt::Packet>> packets;
+    packets.reserve(PACKETS_PER_FRAME);
+
+    QBENCHMARK {
+        for (int i = 0; i < PACKETS_PER_FRAME; ++i) {
+            packets.push_back(createReceivedPacket(i, AUDIO_PAYLOAD_SIZE));
+        }
+
+        if (useViewQueue) {
+            for (auto& packet : packets) {
+                queue.push(ReceivedPacketView(std::move(packet), VIEW_PACKET_TYPE,
+                                              NLPacket::totalHeaderSize(VIEW_PACKET_TYPE), SharedNodePointer()));
+            }
+            ReceivedPacketView view;
+            QSharedPointer<ReceivedMessage> message;
+            while (queue.pop(view)) {
+                if (reuseMessage && message) {
+                    message->reset(view);
+                    listener.handlePacket(message);
+                } else {
+                    message = view.toReceivedMessage();
+                    listener.handlePacket(message);
+                }
+            }
+        } else {
+            for (auto& packet : packets) {
+                auto message = QSharedPointer<ReceivedMessage>::create(NLPacket::fromBase(std::move(packet)));
+                QMetaObject::invokeMethod(&listener, [&listener, message] {
+                    listener.handlePacket(message);
+                }, Qt::QueuedConnection);
+            }
+            QCoreApplication::processEvents();
+        }
+        packets.clear();
+    }
+
+    QVERIFY(listener.numPackets > 0);
+    qDebug() << "Average latency from receipt to handling:"
+             << (double)listener.latencyUsecs / listener.numPackets << "us";
+}
@@ -0,0 +1,34 @@
+//
+//  PacketViewQueueTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketViewQueueTests_h
+#define hifi_PacketViewQueueTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketViewQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that packets come out in the order they went in, and that a full queue drops them
+    void fifoTest();
+
+    // Test that every packet pushed from several threads is popped exactly once
+    void concurrencyTest();
+
+    // Compare handing a packet to a listener through a view queue, with a ReceivedMessage each or one reused, with a
+    // ReceivedMessage and a queued invocation.  Reports the time per frame and the latency from receipt to handling.
+    void dispatchBenchmark_data();
+    void dispatchBenchmark();
+};
+
+#endif // hifi_PacketViewQueueTests_h
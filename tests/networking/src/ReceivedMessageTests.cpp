@@ -0,0 +1,280 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+namespace {
+
+const PacketType MESSAGE_PACKET_TYPE = PacketType::AssetGetReply;
+
+char byteAt(qint64 position) {
+    return (char)((position * 7) % 251);
+}
+
+// the packets of a reliable message, as they come off the wire
+std::vector<std::unique_ptr<NLPacket>> createMessagePackets(qint64 messageSize) {
+    std::vector<std::unique_ptr<NLPacket>> packets;
+    const qint64 payloadSize = NLPacket::maxPayloadSize(MESSAGE_PACKET_TYPE, true);
+    const int numPackets = std::max<int>(1, (int)((messageSize + payloadSize - 1) / payloadSize));
+
+    qint64 position = 0;
+    for (int i = 0; i < numPackets; ++i) {
+        auto packet = NLPacket::create(MESSAGE_PACKET_TYPE, -1, true, true);
+        qint64 size = std::min(payloadSize, messageSize - position);
+        for (qint64 j = 0; j < size; ++j) {
+            char byte = byteAt(position++);
+            packet->write(&byte, 1);
+        }
+
+        auto packetPosition = numPackets == 1 ? udt::Packet::ONLY :
+            (i == 0 ? udt::Packet::FIRST : (i == numPackets - 1 ? udt::Packet::LAST : udt::Packet::MIDDLE));
+        packet->writeMessageNumber(1, packetPosition, i);
+
+        auto dataSize = packet->getDataSize();
+        auto data = std::unique_ptr<char[]>(new char[dataSize]);
+        memcpy(data.get(), packet->getData(), dataSize);
+        packets.push_back(NLPacket::fromReceivedPacket(std::move(data), dataSize, HifiSockAddr()));
+    }
+    return packets;
+}
+
+QSharedPointer<ReceivedMessage> assembleMessage(std::vector<std::unique_ptr<NLPacket>>& packets) {
+    auto message = QSharedPointer<ReceivedMessage>::create(std::move(packets.front()));
+    for (size_t i = 1; i < packets.size(); ++i) {
+        message->appendPacket(std::move(packets[i]));
+    }
+    packets.clear();
+    return message;
+}
+
+QByteArray expectedBytes(qint64 position, qint64 size) {
+    QByteArray bytes(size, Qt::Uninitialized);
+    for (qint64 i = 0; i < size; ++i) {
+        bytes[(int)i] = byteAt(position + i);
+    }
+    return bytes;
+}
+
+}
+
+void ReceivedMessageTests::segmentedReadTest() {
+    const qint64 MESSAGE_SIZE = 10000;
+    auto packets = createMessagePackets(MESSAGE_SIZE);
+    const qint64 payloadSize = packets.front()->getPayloadSize();
+    auto message = assembleMessage(packets);
+
+    QVERIFY(message->isComplete());
+    QCOMPARE(message->getSize(), MESSAGE_SIZE);
+    QVERIFY(message->getNumSegments() > 1);
+
+    // a primitive that straddles the first packet boundary
+    message->seek(payloadSize - 2);
+    quint32 straddling;
+    QCOMPARE(message->peekPrimitive(&straddling), (qint64)sizeof(straddling));
+    QByteArray straddlingBytes((const char*)&straddling, sizeof(straddling));
+    QCOMPARE(straddlingBytes, expectedBytes(payloadSize - 2, sizeof(straddling)));
+
+    // a copy that spans several packets
+    message->seek(10);
+    QCOMPARE(message->read(3 * payloadSize), expectedBytes(10, 3 * payloadSize));
+    QCOMPARE(message->getPosition(), 10 + 3 * payloadSize);
+
+    // a view within one packet doesn't join the message
+    message->seek(payloadSize + 1);
+    auto view = message->readWithoutCopy(20);
+    QCOMPARE(view, expectedBytes(payloadSize + 1, 20));
+    QVERIFY(message->getNumSegments() > 1);
+
+    // reading past the end stops at the end
+    message->seek(MESSAGE_SIZE - 5);
+    char tail[16];
+    QCOMPARE(message->read(tail, sizeof(tail)), (qint64)5);
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+
+    // a view across a boundary joins the message into one buffer, once
+    message->seek(payloadSize - 10);
+    QCOMPARE(message->readWithoutCopy(20), expectedBytes(payloadSize - 10, 20));
+    QCOMPARE(message->getNumSegments(), 1);
+    QCOMPARE(message->getMessage(), expectedBytes(0, MESSAGE_SIZE));
+
+    // and the views taken before it was joined still point to live data
+    QCOMPARE(view, expectedBytes(payloadSize + 1, 20));
+}
+
+void ReceivedMessageTests::readSegmentsTest() {
+    const qint64 MESSAGE_SIZE = 5000;
+    auto packets = createMessagePackets(MESSAGE_SIZE);
+    auto message = assembleMessage(packets);
+    int numSegments = message->getNumSegments();
+
+    message->seek(100);
+    QByteArray streamed;
+    int numCalls = 0;
+    qint64 bytesRead = message->readSegments(MESSAGE_SIZE, [&](const char* data, qint64 size) {
+        streamed.append(data, size);
+        ++numCalls;
+    });
+
+    QCOMPARE(bytesRead, MESSAGE_SIZE - 100);
+    QCOMPARE(streamed, expectedBytes(100, MESSAGE_SIZE - 100));
+    QCOMPARE(numCalls, numSegments);
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+    QCOMPARE(message->getNumSegments(), numSegments);
+}
+
+void ReceivedMessageTests::readArrivedTest() {
+    const qint64 MESSAGE_SIZE = 100000;
+    const size_t PACKETS_PER_ROUND = 7;
+    auto packets = createMessagePackets(MESSAGE_SIZE);
+    const size_t numPackets = packets.size();
+
+    auto message = QSharedPointer<ReceivedMessage>::create(std::move(packets.front()));
+    QVERIFY(!message->isComplete());
+
+    // a header is read from the first packet, the rest is streamed
+    quint32 header;
+    message->readHeadPrimitive(&header);
+    QByteArray streamed;
+    auto reader = [&streamed](const char* data, qint64 size) {
+        streamed.append(data, size);
+    };
+    message->readArrived(reader);
+
+    int maxSegments = 0;
+    for (size_t i = 1; i < numPackets; ++i) {
+        message->appendPacket(std::move(packets[i]));
+        if (i % PACKETS_PER_ROUND == 0) {
+            maxSegments = std::max(maxSegments, message->getNumSegments());
+            message->readArrived(reader);
+            QCOMPARE(message->getNumSegments(), 0);
+            QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+        }
+    }
+    QVERIFY(message->isComplete());
+    message->readArrived(reader);
+
+    // nothing more than what arrived in a round was held, and every byte was read once
+    QCOMPARE(maxSegments, (int)PACKETS_PER_ROUND);
+    QCOMPARE(streamed, expectedBytes(sizeof(header), MESSAGE_SIZE - sizeof(header)));
+    QCOMPARE(message->getPosition(), MESSAGE_SIZE);
+    QCOMPARE(message->readArrived(reader), (qint64)0);
+}
+
+void ReceivedMessageTests::largeMessageBenchmark() {
+    const qint64 MESSAGE_SIZE = 50 * 1000 * 1000;
+    auto packets = createMessagePackets(MESSAGE_SIZE);
+
+    // the previous approach: append every payload to one growing buffer, then copy it out past the header
+    QElapsedTimer timer;
+    timer.start();
+    int appendAllocations = 0;
+    QByteArray appended;
+    for (const auto& packet : packets) {
+        auto capacity = appended.capacity();
+        appended.append(packet->getPayload(), packet->getPayloadSize());
+        if (appended.capacity() != capacity) {
+            ++appendAllocations;
+        }
+    }
+    QByteArray appendedResult = appended.mid(1);
+    ++appendAllocations;
+    qint64 appendNsecs = timer.nsecsElapsed();
+    QCOMPARE(appendedResult.size(), (int)MESSAGE_SIZE - 1);
+    appended.clear();
+    appendedResult.clear();
+
+    // the segmented message keeps the packets, and only allocates for the final contiguous copy
+    timer.restart();
+    auto message = assembleMessage(packets);
+    message->seek(1);
+    QByteArray segmentedResult = message->readAll();
+    qint64 segmentedNsecs = timer.nsecsElapsed();
+    QCOMPARE(segmentedResult.size(), (int)MESSAGE_SIZE - 1);
+    int segmentedAllocations = 1;
+
+    // streaming the message needs no allocation at all
+    timer.restart();
+    message->seek(1);
+    quint64 checksum = 0;
+    message->readSegments(message->getBytesLeftToRead(), [&checksum](const char* data, qint64 size) {
+        checksum += (unsigned char)data[0] + (unsigned char)data[size - 1];
+    });
+    qint64 streamedNsecs = timer.nsecsElapsed();
+    QVERIFY(checksum > 0);
+
+    auto megabytesPerSecond = [&](qint64 nsecs) {
+        return (qint64)(MESSAGE_SIZE * 1000.0 / std::max<qint64>(nsecs, 1));
+    };
+    qDebug() << "50 MB message in" << message->getNumPackets() << "packets";
+    qDebug() << "append into one buffer:" << megabytesPerSecond(appendNsecs) << "MB/s," << appendAllocations << "buffer allocations";
+    qDebug() << "segmented, read out:" << megabytesPerSecond(segmentedNsecs) << "MB/s," << segmentedAllocations << "buffer allocation";
+    qDebug() << "segmented, streamed:" << megabytesPerSecond(streamedNsecs) << "MB/s, no buffer allocations";
+}
+
+void ReceivedMessageTests::uploadMemoryBenchmark() {
+    // an upload is read every 50 packets, when the message signals its progress
+    const qint64 MESSAGE_SIZE = 100 * 1000 * 1000;
+    const size_t PACKETS_PER_READ = 50;
+    const qint64 HEADER_SIZE = 45; // the message ID, the size and the declared hash
+
+    // read once complete: every packet is held until it is joined into one buffer, and the file data is then copied
+    // out of that buffer
+    auto packets = createMessagePackets(MESSAGE_SIZE);
+    QElapsedTimer timer;
+    timer.start();
+    auto message = assembleMessage(packets);
+    qint64 wholePeakBytes = 2 * message->getSize();
+    QByteArray data = message->getMessage();
+    QByteArray fileData = data.mid(HEADER_SIZE);
+    auto wholeHash = QCryptographicHash::hash(fileData, QCryptographicHash::Sha256);
+    qint64 wholeNsecs = timer.nsecsElapsed();
+    data.clear();
+    fileData.clear();
+    message.reset();
+
+    // read as it arrives: only the packets that arrived since the last read are held
+    packets = createMessagePackets(MESSAGE_SIZE);
+    const size_t numPackets = packets.size();
+    timer.restart();
+    message = QSharedPointer<ReceivedMessage>::create(std::move(packets.front()));
+    message->seek(HEADER_SIZE);
+    QCryptographicHash streamedHash(QCryptographicHash::Sha256);
+    auto reader = [&streamedHash](const char* data, qint64 size) {
+        streamedHash.addData(data, (int)size);
+    };
+    qint64 streamedPeakBytes = 0;
+    for (size_t i = 1; i < numPackets; ++i) {
+        message->appendPacket(std::move(packets[i]));
+        if (i % PACKETS_PER_READ == 0 || message->isComplete()) {
+            streamedPeakBytes = std::max(streamedPeakBytes, message->getBytesLeftToRead());
+            message->readArrived(reader);
+        }
+    }
+    qint64 streamedNsecs = timer.nsecsElapsed();
+    QCOMPARE(streamedHash.result(), wholeHash);
+
+    auto megabytes = [](qint64 bytes) {
+        return QString::number(bytes / 1.0e6, 'f', 2);
+    };
+    auto megabytesPerSecond = [&](qint64 nsecs) {
+        return (qint64)(MESSAGE_SIZE * 1000.0 / std::max<qint64>(nsecs, 1));
+    };
+    qDebug() << "100 MB upload in" << numPackets << "packets";
+    qDebug() << "read once complete:" << megabytes(wholePeakBytes) << "MB at peak," << megabytesPerSecond(wholeNsecs) << "MB/s";
+    qDebug() << "read as it arrives:" << megabytes(streamedPeakBytes) << "MB at peak," << megabytesPerSecond(streamedNsecs) << "MB/s";
+}
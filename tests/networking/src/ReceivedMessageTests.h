@@ -0,0 +1,38 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test reads that cross the packets a message arrived in, and views that outlive joining them
+    void segmentedReadTest();
+
+    // Test streaming a message out segment by segment
+    void readSegmentsTest();
+
+    // Test reading a message while its packets are still arriving
+    void readArrivedTest();
+
+    // Compare assembling a 50 MB message by appending into one buffer with keeping the packets
+    void largeMessageBenchmark();
+
+    // Compare the memory a 100 MB upload takes when read once complete with reading it as it arrives
+    void uploadMemoryBenchmark();
+};
+
+#endif // hifi_ReceivedMessageTests_h
@@ -0,0 +1,370 @@
+//
+//  ResourceDiskCacheTests.cpp
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceDiskCacheTests.h"
+
+#include <random>
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include <AssetClient.h>
+#include <AssetRequest.h>
+#include <AssetUtils.h>
+#include <DependencyManager.h>
+#include <HTTPResourceRequest.h>
+#include <NodeList.h>
+#include <ResourceDiskCache.h>
+#include <StatTracker.h>
+#include <shared/GlobalAppProperties.h>
+
+QTEST_MAIN(ResourceDiskCacheTests)
+
+namespace {
+
+// Serves resources over HTTP/1.1 the way a web server does, with an ETag for each, after a delay standing in for the
+// round trip, and counts what it was asked for
+class StandInHttpServer : public QObject {
+public:
+    StandInHttpServer(int latencyMsecs) : _latencyMsecs(latencyMsecs) {
+        connect(&_server, &QTcpServer::newConnection, this, &StandInHttpServer::accept);
+        _server.listen(QHostAddress::LocalHost);
+    }
+
+    QUrl getUrl(const QString& path) const {
+        return QUrl(QString("http://127.0.0.1:%1%2").arg(_server.serverPort()).arg(path));
+    }
+
+    void setResource(const QString& path, const QByteArray& data, const QByteArray& cacheControl) {
+        _resources[path] = { data, cacheControl };
+    }
+
+    int numRequests { 0 };
+    int numNotModified { 0 };
+    qint64 bytesSent { 0 };
+
+private:
+    struct Resource {
+        QByteArray data;
+        QByteArray cacheControl;
+    };
+
+    void accept() {
+        while (auto socket = _server.nextPendingConnection()) {
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket] { read(socket); });
+            connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+                _buffers.remove(socket);
+                socket->deleteLater();
+            });
+        }
+    }
+
+    void read(QTcpSocket* socket) {
+        auto& buffer = _buffers[socket];
+        buffer += socket->readAll();
+        int headEnd = buffer.indexOf("\r\n\r\n");
+        if (headEnd < 0) {
+            return;
+        }
+
+        auto lines = buffer.left(headEnd).split('\n');
+        buffer.remove(0, headEnd + 4);
+        auto path = QString::fromLatin1(lines[0].split(' ').value(1));
+        QByteArray ifNoneMatch;
+        for (auto& line : lines) {
+            if (line.toLower().startsWith("if-none-match:")) {
+                ifNoneMatch = line.mid(line.indexOf(':') + 1).trimmed();
+            }
+        }
+
+        ++numRequests;
+        QTimer::singleShot(_latencyMsecs, socket, [this, socket, path, ifNoneMatch] {
+            respond(socket, path, ifNoneMatch);
+        });
+    }
+
+    void respond(QTcpSocket* socket, const QString& path, const QByteArray& ifNoneMatch) {
+        QByteArray response;
+        if (!_resources.contains(path)) {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        } else {
+            auto& resource = _resources[path];
+            auto etag = "\"" + AssetUtils::hashData(resource.data).toHex().left(16) + "\"";
+            auto headers = "ETag: " + etag + "\r\nCache-Control: " + resource.cacheControl + "\r\nConnection: close\r\n";
+            if (ifNoneMatch == etag) {
+                ++numNotModified;
+                response = "HTTP/1.1 304 Not Modified\r\n" + headers + "\r\n";
+            } else {
+                response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: " +
+                    QByteArray::number(resource.data.size()) + "\r\n" + headers + "\r\n" + resource.data;
+            }
+        }
+        bytesSent += response.size();
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer _server;
+    int _latencyMsecs;
+    QHash<QString, Resource> _resources;
+    QHash<QTcpSocket*, QByteArray> _buffers;
+};
+
+struct LoadResult {
+    qint64 msecs { 0 };
+    int numLoaded { 0 }; // with the expected data
+    int numFromCache { 0 };
+};
+
+// loads the URLs all at once, the way the resource cache does for a scene
+LoadResult load(const QList<QUrl>& urls, const QList<QByteArray>& expectedData) {
+    LoadResult result;
+    QElapsedTimer timer;
+    timer.start();
+
+    QEventLoop loop;
+    int numFinished = 0;
+    std::vector<std::unique_ptr<HTTPResourceRequest>> requests;
+    for (int i = 0; i < urls.size(); ++i) {
+        requests.emplace_back(new HTTPResourceRequest(urls[i], ResourceRequest::IS_NOT_OBSERVABLE));
+        auto request = requests.back().get();
+        QObject::connect(request, &ResourceRequest::finished, &loop, [&, request, i] {
+            if (request->getResult() == ResourceRequest::Success && request->getData() == expectedData[i]) {
+                ++result.numLoaded;
+            }
+            if (request->loadedFromCache()) {
+                ++result.numFromCache;
+            }
+            if (++numFinished == urls.size()) {
+                loop.quit();
+            }
+        });
+    }
+
+    const int TIMEOUT_MSECS = 20000;
+    QTimer::singleShot(TIMEOUT_MSECS, &loop, &QEventLoop::quit);
+    for (auto& request : requests) {
+        request->send();
+    }
+    if (numFinished < urls.size()) {
+        loop.exec();
+    }
+
+    result.msecs = timer.elapsed();
+    return result;
+}
+
+}
+
+void ResourceDiskCacheTests::initTestCase() {
+    qApp->setProperty(hifi::properties::APP_LOCAL_DATA_PATH, _testDir.path());
+
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+    DependencyManager::set<AssetClient>()->initCaching();
+    QVERIFY(DependencyManager::get<AssetClient>()->getDiskCache());
+}
+
+void ResourceDiskCacheTests::freshnessLifetimeTest() {
+    const QByteArray DATE = "Sun, 06 Nov 1994 08:49:37 GMT";
+    const QByteArray HOUR_LATER = "Sun, 06 Nov 1994 09:49:37 GMT";
+    const QByteArray TEN_HOURS_EARLIER = "Sat, 05 Nov 1994 22:49:37 GMT";
+    const qint64 HOUR_MSECS = 60 * 60 * 1000;
+
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("max-age=60", "", DATE, ""), (qint64)60 * 1000);
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("public, Max-Age=60", HOUR_LATER, DATE, ""), (qint64)60 * 1000);
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("no-cache, max-age=60", "", DATE, ""), (qint64)0);
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("max-age=60, no-store", "", DATE, ""), (qint64)-1);
+
+    // without a max-age, Expires counts from the Date of the response
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("", HOUR_LATER, DATE, ""), HOUR_MSECS);
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("", "0", DATE, ""), (qint64)0);
+
+    // and without either, a tenth of the age of the response
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("", "", DATE, TEN_HOURS_EARLIER), HOUR_MSECS);
+    QCOMPARE(ResourceDiskCache::getFreshnessLifetime("", "", DATE, ""), (qint64)0);
+}
+
+void ResourceDiskCacheTests::contentAddressedTest() {
+    QTemporaryDir dir;
+    auto cache = std::make_shared<ResourceDiskCache>(dir.path().toStdString());
+    cache->initialize();
+
+    QByteArray data(10000, 'c');
+    auto hash = cache->store(data);
+    QCOMPARE(hash, QString(AssetUtils::hashData(data).toHex()));
+    QCOMPARE(cache->store(data), hash);
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)1);
+    QCOMPARE(cache->load(hash), data);
+    QVERIFY(cache->load(AssetUtils::hashData("missing").toHex()).isNull());
+
+    // the responses of two URLs with the same data share it
+    ResourceDiskCache::HTTPEntry entry;
+    entry.hash = hash;
+    entry.etag = "\"1\"";
+    QVERIFY(cache->setHTTPEntry(QUrl("http://a.example/model.fbx"), entry));
+    QVERIFY(cache->setHTTPEntry(QUrl("http://b.example/copy.fbx"), entry));
+    ResourceDiskCache::HTTPEntry readEntry;
+    QVERIFY(cache->getHTTPEntry(QUrl("http://b.example/copy.fbx"), readEntry));
+    QCOMPARE(readEntry.hash, hash);
+    QCOMPARE(readEntry.etag, entry.etag);
+    QVERIFY(!cache->getHTTPEntry(QUrl("http://c.example/other.fbx"), readEntry));
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)1);
+
+    // what is cached is there again once the cache is opened again, until it is evicted
+    cache.reset();
+    cache = std::make_shared<ResourceDiskCache>(dir.path().toStdString());
+    cache->initialize();
+    QCOMPARE(cache->load(hash), data);
+    QVERIFY(cache->getHTTPEntry(QUrl("http://a.example/model.fbx"), readEntry));
+
+    cache->wipe();
+    QVERIFY(cache->load(hash).isNull());
+    QVERIFY(!cache->getHTTPEntry(QUrl("http://a.example/model.fbx"), readEntry));
+
+    // and the entries left without data are removed when it opens
+    cache.reset();
+    cache = std::make_shared<ResourceDiskCache>(dir.path().toStdString());
+    cache->initialize();
+    QCOMPARE(QDir(dir.filePath("entries")).entryList(QDir::Files).size(), 0);
+}
+
+void ResourceDiskCacheTests::assetFromCacheTest() {
+    QByteArray data;
+    for (int i = 0; i < 1000; ++i) {
+        data += QByteArray::number(i);
+    }
+    QString hash = AssetUtils::hashData(data).toHex();
+    QVERIFY(AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), data));
+
+    // there is no asset server, what is loaded comes from the cache
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto loadAsset = [&](const ByteRange& byteRange, AssetRequest::Error& error) {
+        std::unique_ptr<AssetRequest> request(assetClient->createRequest(hash, byteRange));
+        QSignalSpy finished(request.get(), &AssetRequest::finished);
+        request->start();
+        if (finished.isEmpty()) {
+            finished.wait(1000);
+        }
+        error = request->getError();
+        return request->getData();
+    };
+
+    AssetRequest::Error error;
+    QCOMPARE(loadAsset(ByteRange(), error), data);
+    QCOMPARE(error, AssetRequest::NoError);
+
+    ByteRange range;
+    range.fromInclusive = 100;
+    range.toExclusive = 200;
+    QCOMPARE(loadAsset(range, error), data.mid(100, 100));
+
+    range.fromInclusive = -50;
+    range.toExclusive = 0;
+    QCOMPARE(loadAsset(range, error), data.right(50));
+
+    range.fromInclusive = data.size();
+    range.toExclusive = data.size() + 10;
+    loadAsset(range, error);
+    QCOMPARE(error, AssetRequest::InvalidByteRange);
+}
+
+void ResourceDiskCacheTests::httpCacheTest() {
+    StandInHttpServer server(0);
+    QByteArray data = "a script";
+    server.setResource("/fresh.js", data, "max-age=3600");
+    server.setResource("/revalidated.js", data, "no-cache");
+    server.setResource("/uncached.js", data, "no-store");
+
+    auto loadOnce = [&](const QString& path, const QByteArray& expected) {
+        return load({ server.getUrl(path) }, { expected });
+    };
+
+    // a fresh response is loaded without asking the server
+    QCOMPARE(loadOnce("/fresh.js", data).numFromCache, 0);
+    auto fresh = loadOnce("/fresh.js", data);
+    QCOMPARE(fresh.numLoaded, 1);
+    QCOMPARE(fresh.numFromCache, 1);
+    QCOMPARE(server.numRequests, 1);
+
+    // a stale one is asked for again, and not sent again if it didn't change
+    loadOnce("/revalidated.js", data);
+    auto revalidated = loadOnce("/revalidated.js", data);
+    QCOMPARE(revalidated.numLoaded, 1);
+    QCOMPARE(revalidated.numFromCache, 1);
+    QCOMPARE(server.numRequests, 3);
+    QCOMPARE(server.numNotModified, 1);
+
+    // and downloaded again if it did
+    QByteArray changedData = "a changed script";
+    server.setResource("/revalidated.js", changedData, "no-cache");
+    auto changed = loadOnce("/revalidated.js", changedData);
+    QCOMPARE(changed.numLoaded, 1);
+    QCOMPARE(changed.numFromCache, 0);
+    QCOMPARE(server.numNotModified, 1);
+
+    // a response that isn't to be stored never is
+    loadOnce("/uncached.js", data);
+    auto uncached = loadOnce("/uncached.js", data);
+    QCOMPARE(uncached.numLoaded, 1);
+    QCOMPARE(uncached.numFromCache, 0);
+    QCOMPARE(server.numRequests, 6);
+}
+
+void ResourceDiskCacheTests::sceneLoadBenchmark() {
+    // the models, textures and scripts of a scene, from a server 20 ms away
+    const int NUM_RESOURCES = 200;
+    const int LATENCY_MSECS = 20;
+    StandInHttpServer server(LATENCY_MSECS);
+
+    std::mt19937 random(200);
+    std::uniform_int_distribution<int> sizeDistribution(4 * 1024, 64 * 1024);
+    QList<QUrl> freshUrls;
+    QList<QUrl> revalidatedUrls;
+    QList<QByteArray> resources;
+    qint64 totalSize = 0;
+    for (int i = 0; i < NUM_RESOURCES; ++i) {
+        QByteArray data(sizeDistribution(random), (char)('a' + i % 26));
+        data += QByteArray::number(i);
+        server.setResource(QString("/fresh/%1").arg(i), data, "max-age=86400");
+        server.setResource(QString("/revalidated/%1").arg(i), data, "no-cache");
+        freshUrls.push_back(server.getUrl(QString("/fresh/%1").arg(i)));
+        revalidatedUrls.push_back(server.getUrl(QString("/revalidated/%1").arg(i)));
+        resources.push_back(data);
+        totalSize += data.size();
+    }
+
+    auto cold = load(freshUrls, resources);
+    qint64 coldBytes = server.bytesSent;
+    QCOMPARE(cold.numLoaded, NUM_RESOURCES);
+    QCOMPARE(server.numRequests, NUM_RESOURCES);
+
+    auto warm = load(freshUrls, resources);
+    QCOMPARE(warm.numLoaded, NUM_RESOURCES);
+    QCOMPARE(warm.numFromCache, NUM_RESOURCES);
+    QCOMPARE(server.numRequests, NUM_RESOURCES);
+    QVERIFY(warm.msecs < cold.msecs);
+
+    load(revalidatedUrls, resources);
+    qint64 bytesBeforeRevalidating = server.bytesSent;
+    auto revalidated = load(revalidatedUrls, resources);
+    QCOMPARE(revalidated.numLoaded, NUM_RESOURCES);
+    QCOMPARE(server.numNotModified, NUM_RESOURCES);
+    QVERIFY((server.bytesSent - bytesBeforeRevalidating) * 10 < coldBytes);
+
+    qDebug() << NUM_RESOURCES << "resources," << totalSize / 1000 << "KB, from a server" << LATENCY_MSECS << "ms away";
+    qDebug() << "cold:" << cold.msecs << "ms," << coldBytes / 1000 << "KB sent";
+    qDebug() << "warm, fresh:" << warm.msecs << "ms, no requests";
+    qDebug() << "warm, revalidated:" << revalidated.msecs << "ms," << (server.bytesSent - bytesBeforeRevalidating) / 1000
+             << "KB sent";
+}
@@ -0,0 +1,40 @@
+//
+//  ResourceDiskCacheTests.h
+//  tests/networking/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceDiskCacheTests_h
+#define hifi_ResourceDiskCacheTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+
+class ResourceDiskCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    // how long responses stay fresh from their headers
+    void freshnessLifetimeTest();
+    // data is stored once under its hash, and entries whose data was evicted are dropped
+    void contentAddressedTest();
+    // cached assets, and ranges of them, are loaded without an asset server
+    void assetFromCacheTest();
+    // fresh responses aren't asked for, stale ones are revalidated, and changed ones downloaded again
+    void httpCacheTest();
+    // loading a scene with an empty cache, a fresh one, and one whose responses need revalidating
+    void sceneLoadBenchmark();
+
+private:
+    QTemporaryDir _testDir;
+};
+
+#endif // hifi_ResourceDiskCacheTests_h
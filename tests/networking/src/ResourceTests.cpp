@@ -9,13 +9,24 @@
 
 #include "ResourceTests.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
 #include <QNetworkDiskCache>
 
+#include <glm/glm.hpp>
+
 #include <ExternalResource.h>
 #include <ResourceCache.h>
 #include <LimitedNodeList.h>
 #include <NodeList.h>
 #include <NetworkAccessManager.h>
+#include <NumericalConstants.h>
 #include <DependencyManager.h>
 #include <StatTracker.h>
 
@@ -94,3 +105,339 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+namespace {
+
+// Stands in for the servers resources come from: responses start after the latency, and share the bandwidth equally
+// while they download, the way connections share a link
+class MockBackend : public QObject {
+public:
+    MockBackend(qint64 bytesPerSecond, int latencyMsecs);
+
+    void send(ResourceRequest* request, std::function<void()> started);
+    // receive returns whether the response is all in
+    void startDownload(ResourceRequest* request, std::function<bool(qint64 bytes)> receive);
+
+private:
+    struct Download {
+        QPointer<ResourceRequest> request;
+        std::function<bool(qint64 bytes)> receive;
+    };
+
+    void download();
+
+    const qint64 _bytesPerSecond;
+    const int _latencyMsecs;
+    QTimer _timer;
+    QElapsedTimer _clock;
+    qint64 _lastDownloadTime { 0 };
+    std::vector<Download> _downloads;
+};
+
+class MockRequest : public ResourceRequest {
+public:
+    MockRequest(const QUrl& url, MockBackend& backend, qint64 size) :
+        ResourceRequest(url, IS_NOT_OBSERVABLE), _backend(backend), _size(size) {}
+
+protected:
+    void doSend() override {
+        _backend.send(this, [this] {
+            emit progress(0, _size);
+            _backend.startDownload(this, [this](qint64 bytes) {
+                _bytesReceived = std::min(_bytesReceived + bytes, _size);
+                emit progress(_bytesReceived, _size);
+                if (_bytesReceived < _size) {
+                    return false;
+                }
+                _data = QByteArray((int)_size, 'x');
+                _result = Success;
+                _state = Finished;
+                emit finished();
+                return true;
+            });
+        });
+    }
+
+private:
+    MockBackend& _backend;
+    const qint64 _size;
+    qint64 _bytesReceived { 0 };
+};
+
+class MockResource : public Resource {
+public:
+    MockResource(const QUrl& url, MockBackend& backend, qint64 size) : Resource(url), _backend(backend), _size(size) {}
+
+protected:
+    void makeRequest() override {
+        _request = new MockRequest(_url, _backend, _size);
+        connect(_request, &ResourceRequest::progress, this, &Resource::handleDownloadProgress);
+        connect(_request, &ResourceRequest::finished, this, &Resource::handleReplyFinished);
+        _request->send();
+    }
+
+private:
+    MockBackend& _backend;
+    const qint64 _size;
+};
+
+MockBackend::MockBackend(qint64 bytesPerSecond, int latencyMsecs) :
+    _bytesPerSecond(bytesPerSecond),
+    _latencyMsecs(latencyMsecs)
+{
+    const int DOWNLOAD_INTERVAL_MSECS = 2;
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &MockBackend::download);
+    _timer.start(DOWNLOAD_INTERVAL_MSECS);
+    _clock.start();
+}
+
+void MockBackend::send(ResourceRequest* request, std::function<void()> started) {
+    QPointer<ResourceRequest> guardedRequest = request;
+    QTimer::singleShot(_latencyMsecs, Qt::PreciseTimer, this, [guardedRequest, started] {
+        if (guardedRequest) {
+            started();
+        }
+    });
+}
+
+void MockBackend::startDownload(ResourceRequest* request, std::function<bool(qint64 bytes)> receive) {
+    _downloads.push_back({ request, receive });
+}
+
+void MockBackend::download() {
+    qint64 now = _clock.elapsed();
+    qint64 bytes = (now - _lastDownloadTime) * _bytesPerSecond / (qint64)MSECS_PER_SECOND;
+    _lastDownloadTime = now;
+    if (_downloads.empty()) {
+        return;
+    }
+
+    // the responses that finish start others, which join the next time around
+    std::vector<Download> downloads;
+    downloads.swap(_downloads);
+    qint64 share = bytes / (qint64)downloads.size();
+    for (auto& download : downloads) {
+        if (download.request && !download.receive(share)) {
+            _downloads.push_back(download);
+        }
+    }
+}
+
+QSharedPointer<Resource> makeResource(const QString& url, QObject* owner, float priority) {
+    auto resource = QSharedPointer<Resource>::create(QUrl(url));
+    resource->setSelf(resource);
+    resource->setLoadPriority(owner, priority);
+    return resource;
+}
+
+struct SceneResource {
+    glm::vec3 position;
+    qint64 size;
+};
+
+// the angular size of a resource a meter across, as the view sees it
+float getLoadPriority(const SceneResource& resource, const glm::vec3& view) {
+    return atan2f(1.0f, glm::distance(resource.position, view));
+}
+
+struct LoadResult {
+    bool isComplete { false };
+    double seconds { 0.0 };
+};
+
+// Starts loading the scene from where the view starts, moves the view after a while, and times how long the resources
+// nearest it then take to load
+LoadResult loadNearest(const std::vector<SceneResource>& scene, qint64 requestBytesLimit, bool isReprioritized) {
+    const uint32_t REQUEST_LIMIT = 16;
+    const qint64 BYTES_PER_SECOND = 20 * 1000 * 1000;
+    const int LATENCY_MSECS = 50;
+    const int MOVE_DELAY_MSECS = 100;
+    const int MAX_LOAD_MSECS = 20 * 1000;
+    const size_t NUM_NEAREST = 20;
+    const glm::vec3 START(-80.0f, 0.0f, -80.0f);
+    const glm::vec3 VIEW(80.0f, 0.0f, 80.0f);
+
+    // nothing measured from the runs before
+    DependencyManager::set<ResourceCacheSharedItems>();
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setRequestLimit(REQUEST_LIMIT);
+    sharedItems->setRequestBytesLimit(requestBytesLimit);
+
+    MockBackend backend(BYTES_PER_SECOND, LATENCY_MSECS);
+    QObject owner;
+    std::vector<QSharedPointer<Resource>> resources;
+    for (size_t i = 0; i < scene.size(); ++i) {
+        auto resource = QSharedPointer<MockResource>::create(QUrl("http://example.com/" + QString::number(i)), backend,
+                                                             scene[i].size);
+        resource->setSelf(resource);
+        resource->setLoadPriority(&owner, getLoadPriority(scene[i], START));
+        resources.push_back(resource);
+    }
+    for (auto& resource : resources) {
+        resource->ensureLoading();
+    }
+    QTest::qWait(MOVE_DELAY_MSECS);
+
+    QElapsedTimer timer;
+    timer.start();
+    if (isReprioritized) {
+        for (size_t i = 0; i < scene.size(); ++i) {
+            resources[i]->setLoadPriority(&owner, getLoadPriority(scene[i], VIEW));
+        }
+    }
+
+    std::vector<size_t> nearest(scene.size());
+    std::iota(nearest.begin(), nearest.end(), 0);
+    std::sort(nearest.begin(), nearest.end(), [&](size_t a, size_t b) {
+        return glm::distance(scene[a].position, VIEW) < glm::distance(scene[b].position, VIEW);
+    });
+    nearest.resize(NUM_NEAREST);
+
+    QEventLoop loop;
+    auto isNearestLoaded = [&] {
+        return std::all_of(nearest.begin(), nearest.end(), [&](size_t i) { return resources[i]->isLoaded(); });
+    };
+    for (auto i : nearest) {
+        QObject::connect(resources[i].data(), &Resource::finished, &loop, [&] {
+            if (isNearestLoaded()) {
+                loop.quit();
+            }
+        });
+    }
+    if (!isNearestLoaded()) {
+        QTimer::singleShot(MAX_LOAD_MSECS, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+
+    LoadResult result;
+    result.seconds = timer.elapsed() / (double)MSECS_PER_SECOND;
+    result.isComplete = isNearestLoaded();
+
+    // leave nothing to start as the resources are freed
+    sharedItems->clear();
+    return result;
+}
+
+}
+
+void ResourceTests::pendingOrderTest() {
+    DependencyManager::set<ResourceCacheSharedItems>();
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    auto freedOwner = new QObject();
+    auto a = makeResource("http://example.com/a", &owner, 1.0f);
+    auto b = makeResource("http://example.com/b", freedOwner, 3.0f);
+    auto c = makeResource("file:///c", &owner, 0.0f);
+    auto d = makeResource("http://example.com/d", &owner, 2.0f);
+    auto e = makeResource("http://example.com/e", &owner, 2.0f);
+    auto freed = makeResource("http://example.com/freed", &owner, 5.0f);
+    for (auto& resource : { a, b, c, d, e, freed }) {
+        QVERIFY(!sharedItems->appendRequest(resource));
+    }
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 6u);
+
+    // moved up as its priority is set, down as its only owner is freed, and dropped as it is freed
+    d->setLoadPriority(&owner, 4.0f);
+    delete freedOwner;
+    freed.reset();
+
+    // file URLs first, then by priority, the latest first among equals
+    QList<QSharedPointer<Resource>> expected { c, d, e, a, b };
+    for (auto& resource : expected) {
+        QCOMPARE(sharedItems->getHighestPendingRequest(), resource);
+    }
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 0u);
+}
+
+void ResourceTests::requestLimitTest() {
+    DependencyManager::set<ResourceCacheSharedItems>();
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    const uint32_t REQUEST_LIMIT = 4;
+    const qint64 SMALL_SIZE = 16 * 1024;
+    const qint64 LARGE_SIZE = 2 * 1024 * 1024;
+    sharedItems->setRequestLimit(REQUEST_LIMIT);
+    sharedItems->setRequestBytesLimit(REQUEST_LIMIT * 64 * 1024);
+
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    auto startRequest = [&](qint64 size) {
+        auto resource = makeResource("http://example.com/" + QString::number(resources.size()), &owner, 0.0f);
+        resources.append(resource);
+        if (!sharedItems->appendRequest(resource)) {
+            return false;
+        }
+        if (size > 0) {
+            sharedItems->updateRequestProgress(resource, 0, size);
+        }
+        return true;
+    };
+
+    // as many requests whose sizes aren't known yet as the limit
+    for (uint32_t i = 0; i < REQUEST_LIMIT; ++i) {
+        QVERIFY(startRequest(0));
+    }
+    QVERIFY(!sharedItems->canStartRequest());
+    sharedItems->clear();
+
+    // more small requests
+    while (sharedItems->canStartRequest()) {
+        QVERIFY(startRequest(SMALL_SIZE));
+    }
+    QVERIFY(sharedItems->getLoadingRequestsCount() > 2 * REQUEST_LIMIT);
+    sharedItems->clear();
+
+    // fewer large ones, until what they have left is small
+    while (sharedItems->canStartRequest()) {
+        QVERIFY(startRequest(LARGE_SIZE));
+    }
+    QCOMPARE(sharedItems->getLoadingRequestsCount(), 2u);
+    for (auto& resource : sharedItems->getLoadingRequests()) {
+        sharedItems->updateRequestProgress(resource, LARGE_SIZE - SMALL_SIZE, LARGE_SIZE);
+    }
+    QVERIFY(sharedItems->canStartRequest());
+    sharedItems->clear();
+
+    // as many as the limit whatever their sizes, without a bytes limit
+    sharedItems->setRequestBytesLimit(ResourceCacheSharedItems::NO_REQUEST_BYTES_LIMIT);
+    while (sharedItems->canStartRequest()) {
+        QVERIFY(startRequest(LARGE_SIZE));
+    }
+    QCOMPARE(sharedItems->getLoadingRequestsCount(), REQUEST_LIMIT);
+    sharedItems->clear();
+}
+
+void ResourceTests::timeToVisibleBenchmark() {
+    // resources spread around the view, a few large ones among many small
+    const int NUM_RESOURCES = 150;
+    const float LARGE_FRACTION = 0.3f;
+    std::mt19937 random(150);
+    std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> fractionDistribution(0.0f, 1.0f);
+    std::vector<SceneResource> scene;
+    for (int i = 0; i < NUM_RESOURCES; ++i) {
+        glm::vec3 position(positionDistribution(random), 0.0f, positionDistribution(random));
+        qint64 size = fractionDistribution(random) < LARGE_FRACTION ? 1024 * 1024 : 16 * 1024;
+        scene.push_back({ position, size });
+    }
+
+    auto stale = loadNearest(scene, ResourceCacheSharedItems::NO_REQUEST_BYTES_LIMIT, false);
+    auto reprioritized = loadNearest(scene, ResourceCacheSharedItems::NO_REQUEST_BYTES_LIMIT, true);
+    auto bandwidthAware = loadNearest(scene, ResourceCacheSharedItems::BANDWIDTH_REQUEST_BYTES_LIMIT, true);
+    QVERIFY(stale.isComplete && reprioritized.isComplete && bandwidthAware.isComplete);
+
+    QVERIFY(reprioritized.seconds < stale.seconds / 2.0);
+    // timer noise aside, sharing the link among fewer large requests doesn't make the nearest resources later
+    QVERIFY(bandwidthAware.seconds < reprioritized.seconds * 1.1);
+
+    qDebug() << "time to load the 20 resources nearest the view after it moved, over a 50 ms, 20 MB/s link:";
+    qDebug() << "  priorities from where it was, 16 requests at a time:" << stale.seconds << "s";
+    qDebug() << "  reprioritized, 16 requests at a time:" << reprioritized.seconds << "s";
+    qDebug() << "  reprioritized, requests limited by their sizes too:" << bandwidthAware.seconds << "s";
+
+    // for the tests after
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
@@ -18,6 +18,12 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    // pending requests come out by priority, and move when it changes
+    void pendingOrderTest();
+    // requests in flight are limited by their sizes as well as their count
+    void requestLimitTest();
+    // how long the resources nearest the view take to load once it has moved
+    void timeToVisibleBenchmark();
     void cleanupTestCase();
 };
 
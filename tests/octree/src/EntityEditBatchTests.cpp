@@ -0,0 +1,171 @@
+//
+//  EntityEditBatchTests.cpp
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditBatchTests.h"
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityEditBatchTests)
+
+namespace {
+
+EntityTreePointer makeTree(EntityItemID& entityID) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName("original");
+    properties.setPosition(glm::vec3(1.0f));
+    properties.setDimensions(glm::vec3(1.0f));
+    entityID = EntityItemID(QUuid::createUuid());
+    tree->withWriteLock([&] {
+        tree->addEntity(entityID, properties);
+    });
+    return tree;
+}
+
+SharedNodePointer makeSender() {
+    auto sender = SharedNodePointer::create(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr());
+    NodePermissions permissions;
+    permissions.set(NodePermissions::Permission::canRezPermanentEntities);
+    sender->setPermissions(permissions);
+    return sender;
+}
+
+NodeSharedReceivedMessagePair makeEditMessage(PacketType packetType, const EntityItemID& entityID,
+                                              const EntityItemProperties& properties, const SharedNodePointer& sender) {
+    QByteArray buffer(NLPacket::maxPayloadSize(packetType), 0);
+    EntityPropertyFlags didntFitProperties;
+    EntityItemProperties::encodeEntityEditPacket(packetType, entityID, properties, buffer,
+                                                 properties.getChangedProperties(), didntFitProperties);
+    auto message = QSharedPointer<ReceivedMessage>::create(buffer, packetType, versionForPacketType(packetType),
+                                                           HifiSockAddr());
+    return { sender, message };
+}
+
+EntityItemProperties nameProperties(const QString& name) {
+    EntityItemProperties properties;
+    properties.setName(name);
+    properties.setLastEdited(usecTimestampNow());
+    return properties;
+}
+
+}
+
+void EntityEditBatchTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityEditBatchTests::coalescesEditsFromOneSender() {
+    EntityItemID entityID;
+    auto tree = makeTree(entityID);
+    auto sender = makeSender();
+
+    EntityItemProperties moveProperties;
+    moveProperties.setPosition(glm::vec3(5.0f));
+    moveProperties.setLastEdited(usecTimestampNow());
+
+    std::vector<NodeSharedReceivedMessagePair> messages {
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("first"), sender),
+        makeEditMessage(PacketType::EntityEdit, entityID, moveProperties, sender),
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("last"), sender)
+    };
+    auto stats = tree->processEditPacketBatch(messages);
+
+    QCOMPARE(stats.editsReceived, 3);
+    QCOMPARE(stats.editsApplied, 1);
+    QCOMPARE(stats.editsPerMessage, std::vector<int>({ 1, 1, 1 }));
+
+    auto entity = tree->findEntityByEntityItemID(entityID);
+    QCOMPARE(entity->getName(), QString("last"));
+    QCOMPARE(entity->getWorldPosition(), glm::vec3(5.0f));
+}
+
+void EntityEditBatchTests::keepsOrderAcrossSenders() {
+    EntityItemID entityID;
+    auto tree = makeTree(entityID);
+    auto firstSender = makeSender();
+    auto secondSender = makeSender();
+
+    std::vector<NodeSharedReceivedMessagePair> messages {
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("first"), firstSender),
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("second"), secondSender),
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("third"), firstSender)
+    };
+    auto stats = tree->processEditPacketBatch(messages);
+
+    // an edit from another sender in between means nothing can be folded together
+    QCOMPARE(stats.editsReceived, 3);
+    QCOMPARE(stats.editsApplied, 3);
+    QCOMPARE(tree->findEntityByEntityItemID(entityID)->getName(), QString("third"));
+}
+
+void EntityEditBatchTests::ownershipChangesAreNotCoalesced() {
+    EntityItemID entityID;
+    auto tree = makeTree(entityID);
+    auto sender = makeSender();
+
+    EntityItemProperties bidProperties;
+    bidProperties.setSimulationOwner(sender->getUUID(), SCRIPT_POKE_SIMULATION_PRIORITY);
+    bidProperties.setLastEdited(usecTimestampNow());
+
+    EntityItemProperties privateProperties = nameProperties("last");
+    privateProperties.setPrivateUserData("secret");
+
+    std::vector<NodeSharedReceivedMessagePair> messages {
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("first"), sender),
+        makeEditMessage(PacketType::EntityEdit, entityID, bidProperties, sender),
+        makeEditMessage(PacketType::EntityEdit, entityID, privateProperties, sender)
+    };
+    auto stats = tree->processEditPacketBatch(messages);
+
+    // the ownership bid is applied on its own, and the last edit is still checked for private user data rights
+    QCOMPARE(stats.editsReceived, 3);
+    QCOMPARE(stats.editsApplied, 3);
+    auto entity = tree->findEntityByEntityItemID(entityID);
+    QCOMPARE(entity->getName(), QString("last"));
+    QVERIFY(entity->getPrivateUserData().isEmpty());
+}
+
+void EntityEditBatchTests::addsAreNotCoalesced() {
+    EntityItemID entityID;
+    auto tree = makeTree(entityID);
+    auto sender = makeSender();
+
+    EntityItemID newEntityID(QUuid::createUuid());
+    EntityItemProperties addProperties;
+    addProperties.setType(EntityTypes::Box);
+    addProperties.setName("added");
+    addProperties.setPosition(glm::vec3(-1.0f));
+    addProperties.setDimensions(glm::vec3(1.0f));
+    addProperties.setLastEdited(usecTimestampNow());
+
+    std::vector<NodeSharedReceivedMessagePair> messages {
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("first"), sender),
+        makeEditMessage(PacketType::EntityAdd, newEntityID, addProperties, sender),
+        makeEditMessage(PacketType::EntityEdit, entityID, nameProperties("last"), sender)
+    };
+    auto stats = tree->processEditPacketBatch(messages);
+
+    QCOMPARE(stats.editsReceived, 3);
+    QCOMPARE(stats.editsApplied, 3);
+    QVERIFY(tree->findEntityByEntityItemID(newEntityID));
+    QCOMPARE(tree->findEntityByEntityItemID(entityID)->getName(), QString("last"));
+}
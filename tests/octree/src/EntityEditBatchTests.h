@@ -0,0 +1,29 @@
+//
+//  EntityEditBatchTests.h
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditBatchTests_h
+#define hifi_EntityEditBatchTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditBatchTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void coalescesEditsFromOneSender();
+    void keepsOrderAcrossSenders();
+    void ownershipChangesAreNotCoalesced();
+    void addsAreNotCoalesced();
+};
+
+#endif // hifi_EntityEditBatchTests_h
@@ -0,0 +1,210 @@
+//
+//  EntityEditFilterTests.cpp
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFilterTests.h"
+
+#include <DependencyManager.h>
+#include <EntityEditFilters.h>
+#include <shared/ScriptInitializerMixin.h>
+
+QTEST_MAIN(EntityEditFilterTests)
+
+namespace {
+
+const int NUM_BENCHMARK_EDITS = 10000;
+const float MAX_DIMENSION = 2.0f;
+
+// the same filter as a script and as a rule set: clamp the dimensions and refuse forbidden names
+const QByteArray SCRIPT_FILTER =
+    "function filter(properties, type) {\n"
+    "    if (properties.name !== undefined && properties.name.indexOf('forbidden') !== -1) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    if (properties.dimensions !== undefined) {\n"
+    "        properties.dimensions.x = Math.min(properties.dimensions.x, 2);\n"
+    "        properties.dimensions.y = Math.min(properties.dimensions.y, 2);\n"
+    "        properties.dimensions.z = Math.min(properties.dimensions.z, 2);\n"
+    "    }\n"
+    "    return properties;\n"
+    "}\n";
+
+const QByteArray RULE_FILTER =
+    "{\n"
+    "    \"clamp\": { \"dimensions\": { \"max\": 2 } },\n"
+    "    \"reject\": [ { \"property\": \"name\", \"contains\": \"forbidden\" } ]\n"
+    "}\n";
+
+std::vector<EntityItemProperties> makeEdits(int numEdits) {
+    std::vector<EntityItemProperties> edits;
+    edits.reserve(numEdits);
+    for (int i = 0; i < numEdits; ++i) {
+        EntityItemProperties properties;
+        properties.setName(i % 10 == 0 ? "forbidden" : "edit " + QString::number(i));
+        properties.setDimensions(glm::vec3(0.5f + (float)(i % 4)));
+        properties.setPosition(glm::vec3((float)i, 0.0f, 0.0f));
+        properties.setLastEdited(usecTimestampNow());
+        edits.push_back(properties);
+    }
+    return edits;
+}
+
+bool runFilter(EntityEditFilters& filters, EntityItemProperties& properties, bool& wasChanged,
+               EntityTree::FilterType filterType = EntityTree::FilterType::Edit) {
+    glm::vec3 position = properties.getPosition();
+    EntityItemID entityID;
+    wasChanged = false;
+    return filters.filter(position, properties, properties, wasChanged, filterType, entityID, EntityItemPointer());
+}
+
+int filterEdits(EntityEditFilters& filters, const std::vector<EntityItemProperties>& edits) {
+    int accepted = 0;
+    for (const auto& edit : edits) {
+        EntityItemProperties properties = edit;
+        bool wasChanged;
+        if (runFilter(filters, properties, wasChanged)) {
+            ++accepted;
+        }
+    }
+    return accepted;
+}
+
+void benchmarkFilter(EntityEditFilters& filters) {
+    auto edits = makeEdits(NUM_BENCHMARK_EDITS);
+    int accepted = 0;
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        accepted = filterEdits(filters, edits);
+        ++iterations;
+    }
+    qint64 elapsed = std::max<qint64>(timer.elapsed(), 1);
+    qInfo() << "edits/sec:" << (qint64)iterations * NUM_BENCHMARK_EDITS * 1000 / elapsed;
+    QCOMPARE(accepted, NUM_BENCHMARK_EDITS - NUM_BENCHMARK_EDITS / 10);
+}
+
+}
+
+void EntityEditFilterTests::initTestCase() {
+    DependencyManager::set<ScriptInitializers>();
+}
+
+void EntityEditFilterTests::rulesClampEdits() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterContents(EntityItemID(), "http://localhost/filter.json",
+        "{ \"clamp\": { \"dimensions\": { \"min\": 0.1, \"max\": 2 }, \"velocity\": { \"maxLength\": 5 },"
+        "  \"lifetime\": { \"max\": 60 } } }"));
+
+    EntityItemProperties properties;
+    properties.setDimensions(glm::vec3(0.01f, 1.0f, 4.0f));
+    properties.setVelocity(glm::vec3(0.0f, 0.0f, 10.0f));
+    properties.setLifetime(3600.0f);
+    bool wasChanged;
+    QVERIFY(runFilter(filters, properties, wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE(properties.getDimensions(), glm::vec3(0.1f, 1.0f, 2.0f));
+    QCOMPARE(properties.getVelocity(), glm::vec3(0.0f, 0.0f, 5.0f));
+    QCOMPARE(properties.getLifetime(), 60.0f);
+
+    // values inside the ranges are left alone, and properties the edit doesn't touch aren't clamped
+    EntityItemProperties inRange;
+    inRange.setDimensions(glm::vec3(1.0f));
+    QVERIFY(runFilter(filters, inRange, wasChanged));
+    QVERIFY(!wasChanged);
+    QVERIFY(!inRange.lifetimeChanged());
+}
+
+void EntityEditFilterTests::rulesRejectEdits() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterContents(EntityItemID(), "http://localhost/filter.json",
+        "{ \"allowedProperties\": [ \"name\", \"position\", \"dynamic\", \"density\" ],"
+        "  \"reject\": ["
+        "    { \"property\": \"position\", \"outside\": { \"min\": -100, \"max\": 100 } },"
+        "    { \"all\": [ { \"property\": \"dynamic\", \"equals\": true }, { \"property\": \"density\", \"greaterThan\": 5000 } ] },"
+        "    { \"not\": { \"property\": \"name\", \"startsWith\": [ \"ok\", \"fine\" ] } }"
+        "  ] }"));
+
+    bool wasChanged;
+    EntityItemProperties allowed;
+    allowed.setName("ok thing");
+    allowed.setPosition(glm::vec3(10.0f));
+    QVERIFY(runFilter(filters, allowed, wasChanged));
+
+    EntityItemProperties notWhitelisted;
+    notWhitelisted.setName("ok thing");
+    notWhitelisted.setScript("http://localhost/script.js");
+    QVERIFY(!runFilter(filters, notWhitelisted, wasChanged));
+
+    EntityItemProperties outside;
+    outside.setName("ok thing");
+    outside.setPosition(glm::vec3(1000.0f, 0.0f, 0.0f));
+    QVERIFY(!runFilter(filters, outside, wasChanged));
+
+    EntityItemProperties heavy;
+    heavy.setName("fine thing");
+    heavy.setDynamic(true);
+    heavy.setDensity(9000.0f);
+    QVERIFY(!runFilter(filters, heavy, wasChanged));
+    heavy.setDynamic(false);
+    QVERIFY(runFilter(filters, heavy, wasChanged));
+
+    EntityItemProperties badName;
+    badName.setName("something else");
+    QVERIFY(!runFilter(filters, badName, wasChanged));
+
+    // the filter only applies to the edit types it asks for
+    QVERIFY(runFilter(filters, badName, wasChanged, EntityTree::FilterType::Delete));
+}
+
+void EntityEditFilterTests::rulesMatchScriptFilter() {
+    EntityEditFilters scriptFilters;
+    QVERIFY(scriptFilters.setFilterContents(EntityItemID(), "http://localhost/filter.js", SCRIPT_FILTER));
+    EntityEditFilters ruleFilters;
+    QVERIFY(ruleFilters.setFilterContents(EntityItemID(), "http://localhost/filter.json", RULE_FILTER));
+
+    for (const auto& edit : makeEdits(100)) {
+        EntityItemProperties scriptProperties = edit;
+        EntityItemProperties ruleProperties = edit;
+        bool scriptChanged;
+        bool ruleChanged;
+        bool scriptAccepted = runFilter(scriptFilters, scriptProperties, scriptChanged);
+        bool ruleAccepted = runFilter(ruleFilters, ruleProperties, ruleChanged);
+        QCOMPARE(ruleAccepted, scriptAccepted);
+        if (scriptAccepted) {
+            QCOMPARE(ruleChanged, scriptChanged);
+            QCOMPARE(ruleProperties.getDimensions(), scriptProperties.getDimensions());
+            QVERIFY(glm::all(glm::lessThanEqual(ruleProperties.getDimensions(), glm::vec3(MAX_DIMENSION))));
+        }
+    }
+}
+
+void EntityEditFilterTests::badRulesAreRefused() {
+    EntityEditFilters filters;
+    QVERIFY(!filters.setFilterContents(EntityItemID(), "http://localhost/filter.json", "{ \"reject\": ["));
+    QVERIFY(!filters.setFilterContents(EntityItemID(), "http://localhost/filter.json",
+        "{ \"allowedProperties\": [ \"noSuchProperty\" ] }"));
+    QVERIFY(!filters.setFilterContents(EntityItemID(), "http://localhost/filter.json",
+        "{ \"clamp\": { \"name\": { \"max\": 2 } } }"));
+    QVERIFY(!filters.setFilterContents(EntityItemID(), "http://localhost/filter.json",
+        "{ \"reject\": [ { \"property\": \"type\", \"equals\": \"NoSuchType\" } ] }"));
+}
+
+void EntityEditFilterTests::benchmarkScriptFilter() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterContents(EntityItemID(), "http://localhost/filter.js", SCRIPT_FILTER));
+    benchmarkFilter(filters);
+}
+
+void EntityEditFilterTests::benchmarkRuleFilter() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterContents(EntityItemID(), "http://localhost/filter.json", RULE_FILTER));
+    benchmarkFilter(filters);
+}
@@ -0,0 +1,32 @@
+//
+//  EntityEditFilterTests.h
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditFilterTests_h
+#define hifi_EntityEditFilterTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditFilterTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void rulesClampEdits();
+    void rulesRejectEdits();
+    void rulesMatchScriptFilter();
+    void badRulesAreRefused();
+
+    void benchmarkScriptFilter();
+    void benchmarkRuleFilter();
+};
+
+#endif // hifi_EntityEditFilterTests_h
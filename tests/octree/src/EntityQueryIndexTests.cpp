@@ -0,0 +1,228 @@
+//
+//  EntityQueryIndexTests.cpp
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityQueryIndexTests.h"
+
+#include <random>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityNodeData.h>
+#include <EntityQueryIndex.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityQueryIndexTests)
+
+namespace {
+
+const int NUM_BENCHMARK_ENTITIES = 100000;
+const int NUM_TEST_ENTITIES = 5000;
+
+// one in every MATCHING_ENTITY_INTERVAL entities is a named zone, so a filter on either matches 1%
+const int MATCHING_ENTITY_INTERVAL = 100;
+const QString MATCHING_NAME = "match";
+
+EntityTreePointer makeTree(int numEntities, std::vector<EntityItemID>& entityIDs) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+
+    std::mt19937 generator(numEntities);
+    std::uniform_real_distribution<float> positionDistribution(-2000.0f, 2000.0f);
+
+    tree->withWriteLock([&] {
+        std::vector<EntityItemPointer> entities;
+        entities.reserve(numEntities);
+        for (int i = 0; i < numEntities; ++i) {
+            glm::vec3 position(positionDistribution(generator), positionDistribution(generator),
+                               positionDistribution(generator));
+
+            EntityItemProperties properties;
+            bool matching = i % MATCHING_ENTITY_INTERVAL == 0;
+            properties.setType(matching ? EntityTypes::Zone : EntityTypes::Box);
+            properties.setName(matching ? MATCHING_NAME : QString("entity %1").arg(i % 1000));
+            properties.setPosition(position);
+            properties.setDimensions(glm::vec3(1.0f));
+            properties.setQueryAACube(AACube(position - glm::vec3(1.0f), 2.0f));
+            if (i % 10 == 1) {
+                properties.setParentID(entityIDs[i - 1]);
+            }
+            if (i % 50 == 0) {
+                properties.setServerScripts("http://example.com/serverScript.js");
+            }
+
+            EntityItemID entityID(QUuid::createUuid());
+            entityIDs.push_back(entityID);
+            entities.push_back(tree->createEntity(entityID, properties));
+        }
+        tree->addEntities(entities);
+    });
+    return tree;
+}
+
+QSet<EntityItemID> findWithFullScan(const EntityTreePointer& tree, const QJsonObject& jsonFilters) {
+    QSet<EntityItemID> found;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                if (entity->matchesJSONFilters(jsonFilters)) {
+                    found.insert(entity->getEntityItemID());
+                }
+            });
+            return true;
+        });
+    });
+    return found;
+}
+
+QSet<EntityItemID> findWithIndex(const EntityTreePointer& tree, const QJsonObject& jsonFilters) {
+    QVector<EntityItemPointer> entities;
+    tree->withReadLock([&] {
+        tree->findEntitiesMatchingJSONFilters(jsonFilters, entities);
+    });
+    QSet<EntityItemID> found;
+    for (const auto& entity : entities) {
+        found.insert(entity->getEntityItemID());
+    }
+    return found;
+}
+
+QJsonObject makeFilter(const QString& property, const QJsonValue& value) {
+    QJsonObject jsonFilters;
+    jsonFilters[property] = value;
+    return jsonFilters;
+}
+
+}
+
+void EntityQueryIndexTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityQueryIndexTests::indexMatchesFullScan() {
+    using namespace EntityJSONQueryProperties;
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = makeTree(NUM_TEST_ENTITIES, entityIDs);
+
+    QJsonObject typeAndName = makeFilter(TYPE_PROPERTY, "Zone");
+    typeAndName[NAME_PROPERTY] = MATCHING_NAME;
+
+    QList<QJsonObject> filters {
+        makeFilter(SERVER_SCRIPTS_PROPERTY, EntityQueryFilterSymbol::NonDefault),
+        makeFilter(TYPE_PROPERTY, "Zone"),
+        makeFilter(TYPE_PROPERTY, "Model"),
+        makeFilter(NAME_PROPERTY, MATCHING_NAME),
+        makeFilter(PARENT_ID_PROPERTY, entityIDs[10].toString()),
+        makeFilter(OWNING_AVATAR_ID_PROPERTY, QUuid::createUuid().toString()),
+        typeAndName
+    };
+
+    for (const auto& jsonFilters : filters) {
+        QVERIFY(EntityQueryIndex::canQuery(jsonFilters));
+        QCOMPARE(findWithIndex(tree, jsonFilters), findWithFullScan(tree, jsonFilters));
+    }
+
+    QCOMPARE(findWithIndex(tree, makeFilter(TYPE_PROPERTY, "Zone")).size(), NUM_TEST_ENTITIES / MATCHING_ENTITY_INTERVAL);
+    QVERIFY(!EntityQueryIndex::canQuery(QJsonObject()));
+    QVERIFY(!EntityQueryIndex::canQuery(makeFilter(NAME_PROPERTY, true)));
+}
+
+void EntityQueryIndexTests::indexFollowsEditsAndDeletes() {
+    using namespace EntityJSONQueryProperties;
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = makeTree(NUM_TEST_ENTITIES, entityIDs);
+    QJsonObject nameFilter = makeFilter(NAME_PROPERTY, MATCHING_NAME);
+    int matchCount = findWithIndex(tree, nameFilter).size();
+
+    // rename a non-matching entity into the filter and a matching one out of it
+    EntityItemProperties renameIn;
+    renameIn.setName(MATCHING_NAME);
+    EntityItemProperties renameOut;
+    renameOut.setName("no longer a match");
+    bool renamedIn = false;
+    bool renamedOut = false;
+    tree->withWriteLock([&] {
+        renamedIn = tree->updateEntity(entityIDs[1], renameIn);
+        renamedOut = tree->updateEntity(entityIDs[0], renameOut);
+    });
+    QVERIFY(renamedIn);
+    QVERIFY(renamedOut);
+
+    auto found = findWithIndex(tree, nameFilter);
+    QCOMPARE(found.size(), matchCount);
+    QVERIFY(found.contains(entityIDs[1]));
+    QVERIFY(!found.contains(entityIDs[0]));
+    QCOMPARE(found, findWithFullScan(tree, nameFilter));
+
+    tree->withWriteLock([&] {
+        tree->deleteEntity(entityIDs[1], true);
+    });
+    found = findWithIndex(tree, nameFilter);
+    QCOMPARE(found.size(), matchCount - 1);
+    QVERIFY(!found.contains(entityIDs[1]));
+}
+
+void EntityQueryIndexTests::indexFollowsServerSideChanges() {
+    using namespace EntityJSONQueryProperties;
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = makeTree(NUM_TEST_ENTITIES, entityIDs);
+
+    // reparent and hand over entities directly, the way the server does without an edit
+    QUuid owningAvatarID = QUuid::createUuid();
+    tree->withWriteLock([&] {
+        tree->findEntityByEntityItemID(entityIDs[2])->setParentID(entityIDs[10]);
+        tree->findEntityByEntityItemID(entityIDs[11])->setParentID(QUuid());
+        tree->findEntityByEntityItemID(entityIDs[3])->setOwningAvatarID(owningAvatarID);
+    });
+
+    QJsonObject parentFilter = makeFilter(PARENT_ID_PROPERTY, entityIDs[10].toString());
+    auto found = findWithIndex(tree, parentFilter);
+    QVERIFY(found.contains(entityIDs[2]));
+    QVERIFY(!found.contains(entityIDs[11]));
+    QCOMPARE(found, findWithFullScan(tree, parentFilter));
+
+    QJsonObject ownerFilter = makeFilter(OWNING_AVATAR_ID_PROPERTY, owningAvatarID.toString());
+    found = findWithIndex(tree, ownerFilter);
+    QCOMPARE(found, QSet<EntityItemID>({ entityIDs[3] }));
+    QCOMPARE(found, findWithFullScan(tree, ownerFilter));
+}
+
+void EntityQueryIndexTests::benchmarkFilteredQueryFullScan() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = makeTree(NUM_BENCHMARK_ENTITIES, entityIDs);
+    QJsonObject jsonFilters = makeFilter(EntityJSONQueryProperties::TYPE_PROPERTY, "Zone");
+
+    QSet<EntityItemID> found;
+    QBENCHMARK {
+        found = findWithFullScan(tree, jsonFilters);
+    }
+    QCOMPARE(found.size(), NUM_BENCHMARK_ENTITIES / MATCHING_ENTITY_INTERVAL);
+}
+
+void EntityQueryIndexTests::benchmarkFilteredQueryIndexed() {
+    std::vector<EntityItemID> entityIDs;
+    auto tree = makeTree(NUM_BENCHMARK_ENTITIES, entityIDs);
+    QJsonObject jsonFilters = makeFilter(EntityJSONQueryProperties::TYPE_PROPERTY, "Zone");
+
+    QSet<EntityItemID> found;
+    QBENCHMARK {
+        found = findWithIndex(tree, jsonFilters);
+    }
+    QCOMPARE(found.size(), NUM_BENCHMARK_ENTITIES / MATCHING_ENTITY_INTERVAL);
+}
@@ -0,0 +1,31 @@
+//
+//  EntityQueryIndexTests.h
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityQueryIndexTests_h
+#define hifi_EntityQueryIndexTests_h
+
+#include <QtTest/QtTest>
+
+class EntityQueryIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void indexMatchesFullScan();
+    void indexFollowsEditsAndDeletes();
+    void indexFollowsServerSideChanges();
+
+    void benchmarkFilteredQueryFullScan();
+    void benchmarkFilteredQueryIndexed();
+};
+
+#endif // hifi_EntityQueryIndexTests_h
@@ -0,0 +1,281 @@
+//
+//  EntityTreeBuildTests.cpp
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBuildTests.h"
+
+#include <random>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(EntityTreeBuildTests)
+
+namespace {
+
+const int NUM_BENCHMARK_ENTITIES = 100000;
+const int NUM_TEST_ENTITIES = 5000;
+const int NUM_CONVERTED_ENTITIES = 2000;
+const int SERIAL_CONVERT_CHUNK = 200; // small enough that readFromMap converts it on the calling thread
+
+struct TestEntity {
+    EntityItemID id;
+    EntityItemProperties properties;
+};
+
+std::vector<TestEntity> makeTestEntities(int numEntities) {
+    std::mt19937 generator(numEntities);
+    std::uniform_real_distribution<float> positionDistribution(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> sizeDistribution(0.05f, 20.0f);
+
+    std::vector<TestEntity> testEntities(numEntities);
+    for (auto& testEntity : testEntities) {
+        glm::vec3 position(positionDistribution(generator), positionDistribution(generator) / 10.0f,
+                           positionDistribution(generator));
+        float size = sizeDistribution(generator);
+
+        testEntity.id = EntityItemID(QUuid::createUuid());
+        testEntity.properties.setType(EntityTypes::Box);
+        testEntity.properties.setPosition(position);
+        testEntity.properties.setDimensions(glm::vec3(size));
+        testEntity.properties.setQueryAACube(AACube(position - glm::vec3(size), 2.0f * size));
+    }
+    return testEntities;
+}
+
+EntityTreePointer makeTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+    return tree;
+}
+
+void addWithOperator(const EntityTreePointer& tree, const std::vector<TestEntity>& testEntities) {
+    tree->withWriteLock([&] {
+        for (const auto& testEntity : testEntities) {
+            tree->addEntity(testEntity.id, testEntity.properties);
+        }
+    });
+}
+
+void addBulk(const EntityTreePointer& tree, const std::vector<TestEntity>& testEntities) {
+    tree->withWriteLock([&] {
+        std::vector<EntityItemPointer> entities;
+        entities.reserve(testEntities.size());
+        for (const auto& testEntity : testEntities) {
+            entities.push_back(tree->createEntity(testEntity.id, testEntity.properties));
+        }
+        tree->addEntities(entities);
+    });
+}
+
+// entities as saved before zone light modes, with zones, materials and clientOnly flags that loading converts
+QVariantList makeOldContentEntities(int numEntities) {
+    QVariantList entities;
+    for (int i = 0; i < numEntities; ++i) {
+        QVariantMap entity;
+        entity["id"] = QUuid::createUuid().toString();
+        entity["name"] = QString("entity %1").arg(i);
+        entity["position"] = QVariantMap { { "x", (float)i }, { "y", 1.0f }, { "z", (float)-i } };
+        entity["dimensions"] = QVariantMap { { "x", 1.0f }, { "y", 1.0f }, { "z", 1.0f } };
+        switch (i % 4) {
+            case 0:
+                entity["type"] = "Box";
+                break;
+            case 1:
+                entity["type"] = "Box";
+                entity["clientOnly"] = false;
+                break;
+            case 2:
+                entity["type"] = "Zone";
+                entity["keyLight"] = QVariantMap { { "ambientURL", i % 8 == 2 ? QString("http://ambient/%1").arg(i) : QString() } };
+                entity["skybox"] = QVariantMap { { "url", QString("http://skybox/%1").arg(i) } };
+                if (i % 3 == 0) {
+                    entity["backgroundMode"] = "skybox";
+                }
+                break;
+            default:
+                entity["type"] = "Material";
+                entity["materialURL"] = "userData";
+                entity["userData"] = QString("{ \"materials\": { \"albedo\": [%1, 0, 0] } }").arg(i % 2);
+                break;
+        }
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+bool loadEntities(const EntityTreePointer& tree, const QVariantList& entities) {
+    QVariantMap map;
+    map["Version"] = (int)EntityVersion::ZoneLightInheritModes - 1;
+    map["Entities"] = entities;
+    bool success = false;
+    tree->withWriteLock([&] {
+        success = tree->readFromMap(map);
+    });
+    return success;
+}
+
+}
+
+void EntityTreeBuildTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityTreeBuildTests::bulkBuildMatchesOperator() {
+    auto testEntities = makeTestEntities(NUM_TEST_ENTITIES);
+
+    auto operatorTree = makeTree();
+    addWithOperator(operatorTree, testEntities);
+    auto bulkTree = makeTree();
+    addBulk(bulkTree, testEntities);
+
+    for (const auto& testEntity : testEntities) {
+        auto operatorElement = operatorTree->getContainingElement(testEntity.id);
+        auto bulkElement = bulkTree->getContainingElement(testEntity.id);
+        QVERIFY(operatorElement);
+        QVERIFY(bulkElement);
+        QCOMPARE(bulkElement->getAACube(), operatorElement->getAACube());
+    }
+    QCOMPARE(bulkTree->getOctreeElementsCount(), operatorTree->getOctreeElementsCount());
+}
+
+void EntityTreeBuildTests::relocateMovedEntities() {
+    auto testEntities = makeTestEntities(NUM_TEST_ENTITIES);
+    auto tree = makeTree();
+    addBulk(tree, testEntities);
+
+    std::vector<EntityItemPointer> movedEntities;
+    for (size_t i = 0; i < testEntities.size(); i += 10) {
+        auto entity = tree->findEntityByEntityItemID(testEntities[i].id);
+        QVERIFY(entity);
+        glm::vec3 newPosition = -entity->getWorldPosition();
+        entity->setQueryAACube(AACube(newPosition - glm::vec3(1.0f), 2.0f));
+        movedEntities.push_back(entity);
+    }
+
+    tree->withWriteLock([&] {
+        tree->relocateEntities(movedEntities);
+    });
+
+    for (const auto& entity : movedEntities) {
+        QVERIFY(entity->getElement());
+        QVERIFY(entity->getElement()->bestFitEntityBounds(entity));
+    }
+    QCOMPARE(tree->rebalanceTree(), 0);
+}
+
+void EntityTreeBuildTests::rebalanceAfterMassDelete() {
+    auto testEntities = makeTestEntities(NUM_TEST_ENTITIES);
+    auto tree = makeTree();
+    addBulk(tree, testEntities);
+    uint64_t elementCountBefore = tree->getOctreeElementsCount();
+
+    // move some entities without telling the tree, then delete most of the rest
+    std::vector<EntityItemID> entitiesToDelete;
+    int misplacedCount = 0;
+    for (size_t i = 0; i < testEntities.size(); ++i) {
+        if (i % 10 == 0) {
+            auto entity = tree->findEntityByEntityItemID(testEntities[i].id);
+            entity->setQueryAACube(AACube(glm::vec3(1000.25f + (float)i), 0.5f));
+            ++misplacedCount;
+        } else {
+            entitiesToDelete.push_back(testEntities[i].id);
+        }
+    }
+    tree->withWriteLock([&] {
+        tree->deleteEntitiesByID(entitiesToDelete, true);
+    });
+
+    QCOMPARE(tree->rebalanceTree(), misplacedCount);
+    QCOMPARE(tree->rebalanceTree(), 0);
+    QVERIFY(tree->getOctreeElementsCount() < elementCountBefore);
+}
+
+void EntityTreeBuildTests::rebalanceIsBounded() {
+    auto testEntities = makeTestEntities(NUM_TEST_ENTITIES);
+    auto tree = makeTree();
+    addBulk(tree, testEntities);
+
+    for (const auto& testEntity : testEntities) {
+        auto entity = tree->findEntityByEntityItemID(testEntity.id);
+        entity->setQueryAACube(AACube(-entity->getWorldPosition() - glm::vec3(0.25f), 0.5f));
+    }
+
+    // each pass only relocates part of the misplaced entities, the rest follow in later passes
+    int relocatedCount = 0;
+    int passes = 0;
+    for (int relocated = tree->rebalanceTree(); relocated > 0; relocated = tree->rebalanceTree()) {
+        QVERIFY(relocated < NUM_TEST_ENTITIES);
+        relocatedCount += relocated;
+        ++passes;
+    }
+    QVERIFY(passes > 1);
+    QVERIFY(relocatedCount <= NUM_TEST_ENTITIES);
+    for (const auto& testEntity : testEntities) {
+        auto entity = tree->findEntityByEntityItemID(testEntity.id);
+        QVERIFY(entity->getElement());
+        QVERIFY(entity->getElement()->bestFitEntityBounds(entity));
+    }
+}
+
+void EntityTreeBuildTests::parallelConversionMatchesSerial() {
+    auto entities = makeOldContentEntities(NUM_CONVERTED_ENTITIES);
+
+    auto parallelTree = makeTree();
+    QVERIFY(loadEntities(parallelTree, entities));
+
+    auto serialTree = makeTree();
+    for (int begin = 0; begin < entities.size(); begin += SERIAL_CONVERT_CHUNK) {
+        QVERIFY(loadEntities(serialTree, entities.mid(begin, SERIAL_CONVERT_CHUNK)));
+    }
+
+    for (const auto& entityVariant : entities) {
+        EntityItemID id(QUuid(entityVariant.toMap()["id"].toString()));
+        auto parallelEntity = parallelTree->findEntityByEntityItemID(id);
+        auto serialEntity = serialTree->findEntityByEntityItemID(id);
+        QVERIFY(parallelEntity);
+        QVERIFY(serialEntity);
+
+        EntityItemProperties parallel = parallelEntity->getProperties();
+        EntityItemProperties serial = serialEntity->getProperties();
+        QCOMPARE(parallel.getType(), serial.getType());
+        QCOMPARE(parallel.getName(), serial.getName());
+        QCOMPARE(parallel.getPosition(), serial.getPosition());
+        QCOMPARE(parallel.getEntityHostType(), serial.getEntityHostType());
+        QCOMPARE(parallel.getKeyLightMode(), serial.getKeyLightMode());
+        QCOMPARE(parallel.getAmbientLightMode(), serial.getAmbientLightMode());
+        QCOMPARE(parallel.getSkyboxMode(), serial.getSkyboxMode());
+        QCOMPARE(parallel.getAmbientLight().getAmbientURL(), serial.getAmbientLight().getAmbientURL());
+        QCOMPARE(parallel.getMaterialURL(), serial.getMaterialURL());
+        QCOMPARE(parallel.getUserData(), serial.getUserData());
+    }
+}
+
+void EntityTreeBuildTests::benchmarkImportWithOperator() {
+    auto testEntities = makeTestEntities(NUM_BENCHMARK_ENTITIES);
+    QBENCHMARK_ONCE {
+        addWithOperator(makeTree(), testEntities);
+    }
+}
+
+void EntityTreeBuildTests::benchmarkImportBulk() {
+    auto testEntities = makeTestEntities(NUM_BENCHMARK_ENTITIES);
+    QBENCHMARK_ONCE {
+        addBulk(makeTree(), testEntities);
+    }
+}
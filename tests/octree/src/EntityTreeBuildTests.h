@@ -0,0 +1,33 @@
+//
+//  EntityTreeBuildTests.h
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBuildTests_h
+#define hifi_EntityTreeBuildTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeBuildTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void bulkBuildMatchesOperator();
+    void relocateMovedEntities();
+    void rebalanceAfterMassDelete();
+    void rebalanceIsBounded();
+    void parallelConversionMatchesSerial();
+
+    void benchmarkImportWithOperator();
+    void benchmarkImportBulk();
+};
+
+#endif // hifi_EntityTreeBuildTests_h
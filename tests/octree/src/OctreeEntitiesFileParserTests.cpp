@@ -0,0 +1,110 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <QUuid>
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+namespace {
+
+const int NUM_TEST_ENTITIES = 10000;
+
+QByteArray makeEntitiesJSON(int numEntities, const QByteArray& badEntity = QByteArray(), int badEntityIndex = -1) {
+    QByteArray json = "{\n  \"DataVersion\": 3,\n  \"Entities\": [\n";
+    for (int i = 0; i < numEntities; ++i) {
+        if (i > 0) {
+            json += ",\n";
+        }
+        if (i == badEntityIndex) {
+            json += badEntity;
+            continue;
+        }
+        json += QString("    { \"id\": \"%1\", \"type\": \"Box\", \"name\": \"box \\\"%2\\\" {}\","
+                        " \"position\": { \"x\": %2, \"y\": 1, \"z\": -%2 },"
+                        " \"userData\": \"{\\\"index\\\": %2}\" }")
+            .arg(QUuid::createUuid().toString()).arg(i).toUtf8();
+    }
+    json += "\n  ],\n  \"Id\": \"{5c5e1e0b-6bc2-4a5f-a2b3-7a0a12d6a8e4}\",\n  \"Version\": 120\n}\n";
+    return json;
+}
+
+bool parse(const QByteArray& json, bool parallel, QVariantMap& result, const QUrl& relativeURL = QUrl()) {
+    OctreeEntitiesFileParser parser;
+    parser.setParallelParsing(parallel);
+    parser.setRelativeURL(relativeURL);
+    parser.setEntitiesString(json);
+    return parser.parseEntities(result);
+}
+
+}
+
+void OctreeEntitiesFileParserTests::parallelMatchesSerial() {
+    QByteArray json = makeEntitiesJSON(NUM_TEST_ENTITIES);
+
+    QVariantMap serial;
+    QVERIFY(parse(json, false, serial));
+    QVariantMap parallel;
+    QVERIFY(parse(json, true, parallel));
+
+    QCOMPARE(parallel["DataVersion"].toInt(), 3);
+    QCOMPARE(parallel["Version"].toInt(), 120);
+    QCOMPARE(parallel["Id"].toUuid(), serial["Id"].toUuid());
+
+    QVariantList serialEntities = serial["Entities"].toList();
+    QVariantList parallelEntities = parallel["Entities"].toList();
+    QCOMPARE(parallelEntities.size(), NUM_TEST_ENTITIES);
+    QCOMPARE(parallelEntities.size(), serialEntities.size());
+    for (int i = 0; i < NUM_TEST_ENTITIES; ++i) {
+        QCOMPARE(parallelEntities[i].toMap(), serialEntities[i].toMap());
+    }
+    QCOMPARE(parallelEntities.last().toMap()["userData"].toString(), QString("{\"index\": %1}").arg(NUM_TEST_ENTITIES - 1));
+}
+
+void OctreeEntitiesFileParserTests::parallelReportsBadEntity() {
+    QByteArray json = makeEntitiesJSON(NUM_TEST_ENTITIES, "    { \"id\": }", NUM_TEST_ENTITIES / 2);
+
+    QVariantMap result;
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(json);
+    QVERIFY(!parser.parseEntities(result));
+    QVERIFY(QString::fromStdString(parser.getErrorString()).contains("Ill-formed entity"));
+}
+
+void OctreeEntitiesFileParserTests::relativeURLs() {
+    QByteArray json = "{ \"Entities\": [ { \"type\": \"Model\", \"modelURL\": \"./models/chair.fbx\","
+                      " \"skybox\": { \"url\": \"../sky.jpg\" } } ], \"Version\": 120 }";
+
+    QVariantMap result;
+    QVERIFY(parse(json, true, result, QUrl("file:///content/scene/")));
+    QVariantMap entity = result["Entities"].toList().first().toMap();
+    QCOMPARE(entity["modelURL"].toString(), QString("file:///content/scene/models/chair.fbx"));
+    QCOMPARE(entity["skybox"].toMap()["url"].toString(), QString("file:///content/sky.jpg"));
+}
+
+void OctreeEntitiesFileParserTests::benchmarkSerialParse() {
+    QByteArray json = makeEntitiesJSON(NUM_TEST_ENTITIES);
+    QBENCHMARK {
+        QVariantMap result;
+        parse(json, false, result);
+    }
+}
+
+void OctreeEntitiesFileParserTests::benchmarkParallelParse() {
+    QByteArray json = makeEntitiesJSON(NUM_TEST_ENTITIES);
+    QBENCHMARK {
+        QVariantMap result;
+        parse(json, true, result);
+    }
+}
@@ -0,0 +1,28 @@
+//
+//  OctreeEntitiesFileParserTests.h
+//  tests/octree/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEntitiesFileParserTests_h
+#define hifi_OctreeEntitiesFileParserTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeEntitiesFileParserTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void parallelMatchesSerial();
+    void parallelReportsBadEntity();
+    void relativeURLs();
+    void benchmarkSerialParse();
+    void benchmarkParallelParse();
+};
+
+#endif // hifi_OctreeEntitiesFileParserTests_h
@@ -0,0 +1,259 @@
+//
+//  TinyLFUCacheTests.cpp
+//  tests/shared/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TinyLFUCacheTests.h"
+
+#include <cmath>
+#include <list>
+#include <random>
+#include <unordered_map>
+
+#include <shared/TinyLFUCache.h>
+
+QTEST_MAIN(TinyLFUCacheTests)
+
+using namespace cache;
+
+namespace {
+
+using Cache = TinyLFUCache<int, int, std::hash<int>>;
+
+// the cache the TinyLFU one is measured against
+class LRUCache {
+public:
+    LRUCache(uint64_t maxWeight) : _maxWeight(maxWeight) {}
+
+    bool get(int key) {
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            return false;
+        }
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return true;
+    }
+
+    void put(int key, uint64_t weight) {
+        if (weight > _maxWeight / 8) {
+            return;
+        }
+        _entries.emplace_front(key, weight);
+        _index[key] = _entries.begin();
+        _weight += weight;
+        while (_weight > _maxWeight) {
+            _weight -= _entries.back().second;
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+    }
+
+private:
+    uint64_t _maxWeight;
+    uint64_t _weight { 0 };
+    std::list<std::pair<int, uint64_t>> _entries;
+    std::unordered_map<int, std::list<std::pair<int, uint64_t>>::iterator> _index;
+};
+
+struct ReplayResult {
+    double hitRate { 0.0 };
+    double byteHitRate { 0.0 };
+};
+
+}
+
+void TinyLFUCacheTests::weightTest() {
+    Cache cache(1000, 100);
+    for (int i = 0; i < 1000; ++i) {
+        int value;
+        if (!cache.get(i, value)) {
+            QVERIFY(cache.put(i, i, 10));
+        }
+        QVERIFY(cache.getStats().weight <= 1000);
+    }
+    QVERIFY(cache.getStats().numEntries <= 100);
+
+    // too heavy to be cached
+    QVERIFY(!cache.put(-1, -1, 200));
+
+    int value = 0;
+    cache.remove(999);
+    QVERIFY(!cache.get(999, value));
+}
+
+void TinyLFUCacheTests::smallWeightTest() {
+    int value;
+
+    // caches lighter than their window would be on a larger cache still keep to their weight
+    for (uint64_t maxWeight : { 1, 8, 50, 99 }) {
+        Cache cache(maxWeight, 16);
+        for (int i = 0; i < 1000; ++i) {
+            if (!cache.get(i % 200, value)) {
+                cache.put(i % 200, i, i % 2);
+            }
+            QVERIFY(cache.getStats().weight <= maxWeight);
+        }
+    }
+
+    // a cache without weight holds nothing, and emptying one that had some drops what it held
+    Cache cache(0, 16);
+    QVERIFY(!cache.wouldAdmit(0, 0));
+    QVERIFY(!cache.put(0, 0, 0));
+    QVERIFY(!cache.get(0, value));
+
+    cache.setMaxWeight(100);
+    for (int i = 0; i < 50; ++i) {
+        QVERIFY(cache.put(i, i, i % 2));
+    }
+    QVERIFY(cache.getStats().numEntries > 0);
+    cache.setMaxWeight(0);
+    QCOMPARE(cache.getStats().numEntries, (size_t)0);
+    QCOMPARE(cache.getStats().weight, (uint64_t)0);
+    QVERIFY(!cache.put(1, 1, 0));
+}
+
+void TinyLFUCacheTests::scanResistanceTest() {
+    const int NUM_HOT_KEYS = 50;
+    Cache cache(100, 100);
+
+    for (int round = 0; round < 5; ++round) {
+        for (int key = 0; key < NUM_HOT_KEYS; ++key) {
+            int value;
+            if (!cache.get(key, value)) {
+                cache.put(key, key, 1);
+            }
+        }
+    }
+
+    // keys seen once each, many more of them than the cache holds
+    for (int key = 1000; key < 11000; ++key) {
+        int value;
+        if (!cache.get(key, value)) {
+            cache.put(key, key, 1);
+        }
+    }
+
+    int numHotKeysLeft = 0;
+    for (int key = 0; key < NUM_HOT_KEYS; ++key) {
+        int value;
+        if (cache.get(key, value)) {
+            QCOMPARE(value, key);
+            ++numHotKeysLeft;
+        }
+    }
+    qDebug() << numHotKeysLeft << "of" << NUM_HOT_KEYS << "hot keys are still cached after the scan";
+    QVERIFY(numHotKeysLeft >= NUM_HOT_KEYS * 9 / 10);
+}
+
+void TinyLFUCacheTests::admissionTest() {
+    Cache cache(100, 100);
+    int value;
+
+    // with room to spare anything is admitted, but not what is too heavy
+    QVERIFY(cache.wouldAdmit(0, 1));
+    QVERIFY(!cache.wouldAdmit(0, 20));
+
+    // fill the cache with keys used a few times each
+    for (int round = 0; round < 3; ++round) {
+        for (int key = 0; key < 100; ++key) {
+            if (!cache.get(key, value)) {
+                cache.put(key, key, 1);
+            }
+        }
+    }
+
+    // a key looked up once doesn't displace them, one looked up more often than them does
+    const int NEW_KEY = 1000;
+    cache.get(NEW_KEY, value);
+    QVERIFY(!cache.wouldAdmit(NEW_KEY, 1));
+    for (int i = 0; i < 5; ++i) {
+        cache.get(NEW_KEY, value);
+    }
+    QVERIFY(cache.wouldAdmit(NEW_KEY, 1));
+}
+
+void TinyLFUCacheTests::zipfReplayBenchmark() {
+    const int NUM_ASSETS = 20000;
+    const int NUM_REQUESTS = 1000000;
+    const double ZIPF_EXPONENT = 0.9;
+
+    std::mt19937 random(42);
+
+    // asset sizes between 10 KB and 4 MB, evenly spread on a log scale, like FSTs, scripts and textures
+    std::vector<uint64_t> sizes(NUM_ASSETS);
+    std::uniform_real_distribution<double> logSize(std::log(10.0e3), std::log(4.0e6));
+    uint64_t totalSize = 0;
+    for (auto& size : sizes) {
+        size = (uint64_t)std::exp(logSize(random));
+        totalSize += size;
+    }
+
+    // the popularity of the assets follows a Zipf distribution, asset 0 being the most popular
+    std::vector<double> cumulative(NUM_ASSETS);
+    double sum = 0.0;
+    for (int i = 0; i < NUM_ASSETS; ++i) {
+        sum += 1.0 / std::pow(i + 1, ZIPF_EXPONENT);
+        cumulative[i] = sum;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, sum);
+    std::vector<int> requests(NUM_REQUESTS);
+    for (auto& request : requests) {
+        request = (int)(std::lower_bound(cumulative.begin(), cumulative.end(), uniform(random)) - cumulative.begin());
+    }
+
+    // a cache holding 5% of the assets' bytes
+    const uint64_t CACHE_SIZE = totalSize / 20;
+
+    Cache tinyLFU(CACHE_SIZE, NUM_ASSETS / 10);
+    LRUCache lru(CACHE_SIZE);
+
+    ReplayResult tinyLFUResult;
+    ReplayResult lruResult;
+    uint64_t requestedBytes = 0;
+    uint64_t tinyLFUHitBytes = 0;
+    uint64_t lruHitBytes = 0;
+    int tinyLFUHits = 0;
+    int lruHits = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int asset : requests) {
+        requestedBytes += sizes[asset];
+        int value;
+        if (tinyLFU.get(asset, value)) {
+            ++tinyLFUHits;
+            tinyLFUHitBytes += sizes[asset];
+        } else {
+            tinyLFU.put(asset, asset, sizes[asset]);
+        }
+    }
+    auto tinyLFUMsecs = timer.elapsed();
+
+    for (int asset : requests) {
+        if (lru.get(asset)) {
+            ++lruHits;
+            lruHitBytes += sizes[asset];
+        } else {
+            lru.put(asset, sizes[asset]);
+        }
+    }
+
+    tinyLFUResult.hitRate = 100.0 * tinyLFUHits / NUM_REQUESTS;
+    tinyLFUResult.byteHitRate = 100.0 * tinyLFUHitBytes / requestedBytes;
+    lruResult.hitRate = 100.0 * lruHits / NUM_REQUESTS;
+    lruResult.byteHitRate = 100.0 * lruHitBytes / requestedBytes;
+
+    qDebug() << "Zipf" << ZIPF_EXPONENT << "replay of" << NUM_REQUESTS << "requests for" << NUM_ASSETS << "assets,"
+        << CACHE_SIZE / (1024 * 1024) << "MB cache:";
+    qDebug() << "  TinyLFU hit rate" << tinyLFUResult.hitRate << "% byte hit rate" << tinyLFUResult.byteHitRate << "% in"
+        << tinyLFUMsecs << "ms";
+    qDebug() << "  LRU     hit rate" << lruResult.hitRate << "% byte hit rate" << lruResult.byteHitRate << "%";
+
+    QVERIFY(tinyLFUResult.hitRate > lruResult.hitRate);
+}
@@ -0,0 +1,38 @@
+//
+//  TinyLFUCacheTests.h
+//  tests/shared/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TinyLFUCacheTests_h
+#define hifi_TinyLFUCacheTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TinyLFUCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the cache stays within its weight and evicts what it has to
+    void weightTest();
+
+    // Test that caches of less than 100, down to no weight at all, still keep to their weight
+    void smallWeightTest();
+
+    // Test that a scan of keys used once doesn't push out the keys used often
+    void scanResistanceTest();
+
+    // Test that a key is only worth loading for the cache once it is looked up more often than what it would displace
+    void admissionTest();
+
+    // Replay Zipf distributed requests for assets of varied sizes and compare the hit rates with an LRU cache
+    void zipfReplayBenchmark();
+};
+
+#endif // hifi_TinyLFUCacheTests_h
@@ -27,6 +27,8 @@
 #include <SettingHandle.h>
 #include <AssetUpload.h>
 #include <StatTracker.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 #define HIGH_FIDELITY_ATP_CLIENT_USER_AGENT "Mozilla/5.0 (HighFidelityATPClient)"
 #define TIMEOUT_MILLISECONDS 8000
@@ -58,6 +60,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption concurrentDownloadsOption("c", "download the asset this many times at once and report the throughput",
+                                                       "1");
+    parser.addOption(concurrentDownloadsOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -122,6 +128,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
         _waitingForLogin = true;
     }
 
+    if (parser.isSet(concurrentDownloadsOption)) {
+        _concurrentDownloads = std::max(parser.value(concurrentDownloadsOption).toInt(), 1);
+    }
+
     if (parser.isSet(listenPortOption)) {
         _listenPort = parser.value(listenPortOption).toInt();
     }
@@ -206,7 +216,7 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
 
-    QTimer* _timeoutTimer = new QTimer(this);
+    _timeoutTimer = new QTimer(this);
     _timeoutTimer->setSingleShot(true);
     connect(_timeoutTimer, &QTimer::timeout, this, &ATPClientApp::timedOut);
     _timeoutTimer->start(TIMEOUT_MILLISECONDS);
@@ -352,7 +362,11 @@ void ATPClientApp::lookupAsset() {
             qDebug() << "not found: " << request->getErrorString();
         } else if (result == GetMappingRequest::NoError) {
             qDebug() << "found, hash is " << request->getHash();
-            download(request->getHash());
+            if (_concurrentDownloads > 1) {
+                benchmarkDownloads(request->getHash());
+            } else {
+                download(request->getHash());
+            }
         } else {
             qDebug() << "error -- " << request->getError() << " -- " << request->getErrorString();
         }
@@ -391,6 +405,43 @@ void ATPClientApp::download(AssetUtils::AssetHash hash) {
     assetRequest->start();
 }
 
+void ATPClientApp::benchmarkDownloads(AssetUtils::AssetHash hash) {
+    // large downloads take longer than the client otherwise waits
+    if (_timeoutTimer) {
+        _timeoutTimer->stop();
+    }
+
+    auto startTime = usecTimestampNow();
+    auto numFinished = std::make_shared<int>(0);
+    auto bytesDownloaded = std::make_shared<qint64>(0);
+
+    for (int i = 0; i < _concurrentDownloads; ++i) {
+        auto assetRequest = new AssetRequest(hash);
+
+        connect(assetRequest, &AssetRequest::finished, this, [=](AssetRequest* request) mutable {
+            if (request->getError() == AssetRequest::Error::NoError) {
+                *bytesDownloaded += request->getData().size();
+            } else {
+                qDebug() << "download failed: " << request->getError();
+            }
+            request->deleteLater();
+
+            if (++*numFinished < _concurrentDownloads) {
+                return;
+            }
+
+            float seconds = (float)(usecTimestampNow() - startTime) / USECS_PER_SECOND;
+            float megabytes = (float)*bytesDownloaded / (BYTES_PER_KILOBYTE * BYTES_PER_KILOBYTE);
+            qDebug().noquote() << QString("%1 concurrent downloads: %2 MB in %3 s, %4 MB/s")
+                .arg(_concurrentDownloads).arg(megabytes, 0, 'f', 1).arg(seconds, 0, 'f', 2)
+                .arg(megabytes / std::max(seconds, 0.001f), 0, 'f', 1);
+            finish(0);
+        });
+
+        assetRequest->start();
+    }
+}
+
 void ATPClientApp::finish(int exitCode) {
     auto nodeList = DependencyManager::get<NodeList>();
 
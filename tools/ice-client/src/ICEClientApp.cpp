@@ -19,6 +19,8 @@
 #include <LimitedNodeList.h>
 #include <NetworkLogging.h>
 
+#include "ICELoadGenerator.h"
+
 ICEClientApp::ICEClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
@@ -44,6 +46,16 @@ ICEClientApp::ICEClientApp(int argc, char* argv[]) :
     const QCommandLineOption cacheSTUNOption("s", "cache stun-server response");
     parser.addOption(cacheSTUNOption);
 
+    const QCommandLineOption loadOption("load", "load the ice-server with the heartbeats of this many domains", "10000");
+    parser.addOption(loadOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to load the ice-server for", "30");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption publicKeyPortOption("public-key-port", "port to serve the loading domains' public key on",
+                                                 QString::number(ICELoadGenerator::DEFAULT_PUBLIC_KEY_PORT));
+    parser.addOption(publicKeyPortOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -104,6 +116,20 @@ ICEClientApp::ICEClientApp(int argc, char* argv[]) :
         qDebug() << "ICE-server address is" << _iceServerAddr;
     }
 
+    if (parser.isSet(loadOption)) {
+        int numDomains = parser.value(loadOption).toInt();
+        int durationSeconds = parser.isSet(durationOption) ? parser.value(durationOption).toInt() : 30;
+        quint16 publicKeyPort = parser.isSet(publicKeyPortOption) ?
+            (quint16)parser.value(publicKeyPortOption).toUInt() : ICELoadGenerator::DEFAULT_PUBLIC_KEY_PORT;
+
+        // the generator replaces the client's connection test
+        _loadGenerator = new ICELoadGenerator(_iceServerAddr, std::max(numDomains, 1), std::max(durationSeconds, 1),
+                                              publicKeyPort, this);
+        connect(_loadGenerator, &ICELoadGenerator::finished, this, &QCoreApplication::quit, Qt::QueuedConnection);
+        QMetaObject::invokeMethod(_loadGenerator, "start", Qt::QueuedConnection);
+        return;
+    }
+
     setState(lookUpStunServer);
 
     QTimer* doTimer = new QTimer(this);
@@ -0,0 +1,288 @@
+//
+//  ICELoadGenerator.cpp
+//  tools/ice-client/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ICELoadGenerator.h"
+
+#include <algorithm>
+
+#include <openssl/err.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <HTTPConnection.h>
+#include <NetworkPeer.h>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+namespace {
+
+// the domains' heartbeats are spread over a few sockets, as they would be coming from different hosts
+const int NUM_SOCKETS = 16;
+const int SEND_INTERVAL_MSECS = 5;
+const int REPORT_INTERVAL_MSECS = 1000;
+
+// a heartbeat not answered within this long is counted as unanswered
+const std::chrono::milliseconds REPLY_TIMEOUT { 2000 };
+
+float percentile(std::vector<float>& values, float fraction) {
+    if (values.empty()) {
+        return 0.0f;
+    }
+    auto nth = values.begin() + std::min(values.size() - 1, (size_t)(fraction * values.size()));
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+}
+
+ICELoadGenerator::ICELoadGenerator(const HifiSockAddr& iceServerAddr, int numDomains, int durationSeconds,
+                                   quint16 publicKeyPort, QObject* parent) :
+    QObject(parent),
+    _iceServerAddr(iceServerAddr),
+    _numDomains(numDomains),
+    _durationSeconds(durationSeconds),
+    _publicKeyServer(QHostAddress::LocalHost, publicKeyPort, QString(), this)
+{
+    connect(&_sendTimer, &QTimer::timeout, this, &ICELoadGenerator::sendDueHeartbeats);
+    connect(&_reportTimer, &QTimer::timeout, this, &ICELoadGenerator::reportStats);
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+}
+
+ICELoadGenerator::~ICELoadGenerator() {
+    // the sockets' handlers refer back to this generator
+    _sockets.clear();
+}
+
+void ICELoadGenerator::start() {
+    if (!generateKeypair()) {
+        emit finished();
+        return;
+    }
+
+    for (int i = 0; i < NUM_SOCKETS; ++i) {
+        LoadSocket loadSocket;
+        loadSocket.socket.reset(new udt::Socket());
+        loadSocket.socket->bind(QHostAddress::AnyIPv4);
+        loadSocket.socket->setPacketHandler([this, i](std::unique_ptr<udt::Packet> packet) {
+            processReply(i, std::move(packet));
+        });
+        _sockets.push_back(std::move(loadSocket));
+    }
+
+    createDomains();
+
+    qDebug() << "Sending heartbeats of" << _numDomains << "domains to" << _iceServerAddr << "for"
+        << _durationSeconds << "seconds, serving their public key on port" << _publicKeyServer.serverPort();
+
+    _startTime = p_high_resolution_clock::now();
+    _sendTimer.start(SEND_INTERVAL_MSECS);
+    _reportTimer.start(REPORT_INTERVAL_MSECS);
+}
+
+bool ICELoadGenerator::generateKeypair() {
+    // every simulated domain signs its heartbeats with the same key, only the signing is expensive here
+    RSA* keyPair = RSA_new();
+    BIGNUM* exponent = BN_new();
+
+    const unsigned long RSA_KEY_EXPONENT = 65537;
+    BN_set_word(exponent, RSA_KEY_EXPONENT);
+
+    const int RSA_KEY_BITS = 2048;
+    bool generated = RSA_generate_key_ex(keyPair, RSA_KEY_BITS, exponent, NULL);
+    BN_free(exponent);
+
+    if (!generated) {
+        qCritical() << "Error generating" << RSA_KEY_BITS << "bit RSA keypair -" << ERR_get_error();
+        RSA_free(keyPair);
+        return false;
+    }
+
+    unsigned char* publicKeyDER = NULL;
+    int publicKeyLength = i2d_RSA_PUBKEY(keyPair, &publicKeyDER);
+
+    unsigned char* privateKeyDER = NULL;
+    int privateKeyLength = i2d_RSAPrivateKey(keyPair, &privateKeyDER);
+
+    RSA_free(keyPair);
+
+    if (publicKeyLength <= 0 || privateKeyLength <= 0) {
+        qCritical() << "Error getting DER public or private key from RSA struct -" << ERR_get_error();
+        if (publicKeyLength > 0) {
+            OPENSSL_free(publicKeyDER);
+        }
+        if (privateKeyLength > 0) {
+            OPENSSL_free(privateKeyDER);
+        }
+        return false;
+    }
+
+    QByteArray publicKey { reinterpret_cast<char*>(publicKeyDER), publicKeyLength };
+    _privateKey = QByteArray { reinterpret_cast<char*>(privateKeyDER), privateKeyLength };
+    OPENSSL_free(publicKeyDER);
+    OPENSSL_free(privateKeyDER);
+
+    QJsonObject dataObject;
+    dataObject["public_key"] = QString::fromUtf8(publicKey.toBase64());
+    QJsonObject responseObject;
+    responseObject["status"] = "success";
+    responseObject["data"] = dataObject;
+    _publicKeyResponse = QJsonDocument(responseObject).toJson(QJsonDocument::Compact);
+
+    return true;
+}
+
+void ICELoadGenerator::createDomains() {
+    qDebug() << "Signing the heartbeats of" << _numDomains << "domains";
+
+    const char* privateKeyData = _privateKey.constData();
+    RSA* rsaPrivateKey = d2i_RSAPrivateKey(NULL, reinterpret_cast<const unsigned char**>(&privateKeyData),
+                                           _privateKey.size());
+
+    _domains.reserve(_numDomains);
+    for (int i = 0; i < _numDomains; ++i) {
+        SimulatedDomain domain;
+        domain.id = QUuid::createUuid();
+        domain.socketIndex = i % NUM_SOCKETS;
+
+        // the same heartbeat a domain-server sends, see DomainServer::sendHeartbeatToIceServer
+        HifiSockAddr domainSocket(QHostAddress::LocalHost, _sockets[domain.socketIndex].socket->localPort());
+        domain.heartbeatPacket = NLPacket::create(PacketType::ICEServerHeartbeat);
+
+        QDataStream heartbeatDataStream(domain.heartbeatPacket.get());
+        heartbeatDataStream << domain.id << domainSocket << domainSocket;
+
+        auto plaintext = QByteArray::fromRawData(domain.heartbeatPacket->getPayload(),
+                                                 domain.heartbeatPacket->getPayloadSize());
+        QByteArray hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+
+        QByteArray signature(RSA_size(rsaPrivateKey), 0);
+        unsigned int signatureBytes = 0;
+        RSA_sign(NID_sha256, reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()), hashedPlaintext.size(),
+                 reinterpret_cast<unsigned char*>(signature.data()), &signatureBytes, rsaPrivateKey);
+
+        heartbeatDataStream << signature;
+        _domains.push_back(std::move(domain));
+    }
+
+    RSA_free(rsaPrivateKey);
+}
+
+void ICELoadGenerator::sendDueHeartbeats() {
+    auto now = p_high_resolution_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - _startTime);
+
+    if (elapsed >= std::chrono::seconds(_durationSeconds)) {
+        _sendTimer.stop();
+        return;
+    }
+
+    // every domain sends a heartbeat each ICE_HEARBEAT_INTERVAL_MSECS, spread evenly over the interval
+    quint64 numDue = (quint64)_numDomains * elapsed.count() / ICE_HEARBEAT_INTERVAL_MSECS;
+    for (; _numSent < numDue; ++_numSent) {
+        auto& domain = _domains[_nextDomain];
+        auto& loadSocket = _sockets[domain.socketIndex];
+
+        loadSocket.socket->writePacket(*domain.heartbeatPacket, _iceServerAddr);
+        loadSocket.pendingSendTimes.push_back(now);
+        ++_intervalCounts.sent;
+
+        _nextDomain = (_nextDomain + 1) % _numDomains;
+    }
+}
+
+void ICELoadGenerator::processReply(int socketIndex, std::unique_ptr<udt::Packet> packet) {
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+
+    auto& pendingSendTimes = _sockets[socketIndex].pendingSendTimes;
+    if (pendingSendTimes.empty()) {
+        // the answer to a heartbeat already counted as unanswered
+        return;
+    }
+
+    // the replies don't say which heartbeat they answer, so pair them with the oldest heartbeat sent from this socket.
+    // The ice-server answers repeated heartbeats before it answers ones it has to verify, so single latencies can be
+    // off, but their distribution holds
+    if (nlPacket->getType() == PacketType::ICEServerHeartbeatACK) {
+        ++_intervalCounts.acked;
+    } else if (nlPacket->getType() == PacketType::ICEServerHeartbeatDenied) {
+        ++_intervalCounts.denied;
+    } else {
+        return;
+    }
+
+    auto latency = p_high_resolution_clock::now() - pendingSendTimes.front();
+    pendingSendTimes.pop_front();
+    _intervalCounts.latenciesMsecs.push_back(std::chrono::duration<float, std::milli>(latency).count());
+}
+
+void ICELoadGenerator::dropUnansweredHeartbeats() {
+    auto timedOutBefore = p_high_resolution_clock::now() - REPLY_TIMEOUT;
+    for (auto& loadSocket : _sockets) {
+        auto& pendingSendTimes = loadSocket.pendingSendTimes;
+        while (!pendingSendTimes.empty() && pendingSendTimes.front() < timedOutBefore) {
+            pendingSendTimes.pop_front();
+            ++_intervalCounts.unanswered;
+        }
+    }
+}
+
+void ICELoadGenerator::reportStats() {
+    dropUnansweredHeartbeats();
+
+    auto& latencies = _intervalCounts.latenciesMsecs;
+    qDebug().noquote() << QString("sent %1/s acked %2/s denied %3/s unanswered %4 - latency p50 %5 ms p99 %6 ms")
+        .arg(_intervalCounts.sent).arg(_intervalCounts.acked).arg(_intervalCounts.denied)
+        .arg(_intervalCounts.unanswered)
+        .arg(percentile(latencies, 0.5f), 0, 'f', 2).arg(percentile(latencies, 0.99f), 0, 'f', 2);
+
+    _totalCounts.sent += _intervalCounts.sent;
+    _totalCounts.acked += _intervalCounts.acked;
+    _totalCounts.denied += _intervalCounts.denied;
+    _totalCounts.unanswered += _intervalCounts.unanswered;
+    _totalCounts.latenciesMsecs.insert(_totalCounts.latenciesMsecs.end(), latencies.begin(), latencies.end());
+    _intervalCounts = Counts();
+
+    // leave time for the last heartbeats to be answered before the summary
+    if (++_numReports < _durationSeconds + REPLY_TIMEOUT.count() / REPORT_INTERVAL_MSECS) {
+        return;
+    }
+
+    _reportTimer.stop();
+
+    auto& totalLatencies = _totalCounts.latenciesMsecs;
+    quint64 numAnswered = _totalCounts.acked + _totalCounts.denied;
+    qDebug().noquote() << QString("%1 domains over %2 s: sent %3, answered %4 (%5/s sustained), acked %6, denied %7, "
+                                  "unanswered %8 - latency p50 %9 ms p99 %10 ms")
+        .arg(_numDomains).arg(_durationSeconds)
+        .arg(_totalCounts.sent).arg(numAnswered).arg(numAnswered / std::max(_durationSeconds, 1))
+        .arg(_totalCounts.acked).arg(_totalCounts.denied).arg(_totalCounts.unanswered)
+        .arg(percentile(totalLatencies, 0.5f), 0, 'f', 2).arg(percentile(totalLatencies, 0.99f), 0, 'f', 2);
+
+    emit finished();
+}
+
+bool ICELoadGenerator::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    // the ice-server asks for /<metaverse path>/api/v1/domains/<domain ID>/public_key
+    static const QString PUBLIC_KEY_PATH_SUFFIX = "/public_key";
+    if (connection->requestOperation() == QNetworkAccessManager::GetOperation &&
+        url.path().endsWith(PUBLIC_KEY_PATH_SUFFIX)) {
+        connection->respond(HTTPConnection::StatusCode200, _publicKeyResponse, "application/json");
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,100 @@
+//
+//  ICELoadGenerator.h
+//  tools/ice-client/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ICELoadGenerator_h
+#define hifi_ICELoadGenerator_h
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <HTTPManager.h>
+#include <NLPacket.h>
+#include <PortableHighResolutionClock.h>
+#include <udt/Socket.h>
+
+// Loads an ice-server with the heartbeats of many simulated domains, each sending one signed heartbeat a second the way
+// a domain-server does, and reports how many the server answers and how quickly.
+// The domains' public keys are served from a local HTTP server, so the ice-server under test has to be started with
+// HIFI_METAVERSE_URL pointing at it (http://127.0.0.1:<public key port>).
+class ICELoadGenerator : public QObject, public HTTPRequestHandler {
+    Q_OBJECT
+public:
+    static const quint16 DEFAULT_PUBLIC_KEY_PORT = 40110;
+
+    ICELoadGenerator(const HifiSockAddr& iceServerAddr, int numDomains, int durationSeconds, quint16 publicKeyPort,
+                     QObject* parent = nullptr);
+    ~ICELoadGenerator();
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
+public slots:
+    void start();
+
+signals:
+    void finished();
+
+private slots:
+    void sendDueHeartbeats();
+    void reportStats();
+
+private:
+    struct SimulatedDomain {
+        QUuid id;
+        std::unique_ptr<NLPacket> heartbeatPacket;
+        int socketIndex;
+    };
+
+    // the heartbeats sent from a socket and not answered yet, oldest first
+    struct LoadSocket {
+        std::unique_ptr<udt::Socket> socket;
+        std::deque<p_high_resolution_clock::time_point> pendingSendTimes;
+    };
+
+    bool generateKeypair();
+    void createDomains();
+    void processReply(int socketIndex, std::unique_ptr<udt::Packet> packet);
+    void dropUnansweredHeartbeats();
+
+    HifiSockAddr _iceServerAddr;
+    int _numDomains;
+    int _durationSeconds;
+
+    QByteArray _privateKey;
+    QByteArray _publicKeyResponse; // the JSON the metaverse API answers public key requests with
+    HTTPManager _publicKeyServer;
+
+    std::vector<LoadSocket> _sockets;
+    std::vector<SimulatedDomain> _domains;
+
+    QTimer _sendTimer { this };
+    QTimer _reportTimer { this };
+    p_high_resolution_clock::time_point _startTime;
+    quint64 _numSent { 0 };
+    int _nextDomain { 0 };
+
+    // counts for the report interval in progress, and for the whole run
+    struct Counts {
+        quint64 sent { 0 };
+        quint64 acked { 0 };
+        quint64 denied { 0 };
+        quint64 unanswered { 0 };
+        std::vector<float> latenciesMsecs;
+    };
+    Counts _intervalCounts;
+    Counts _totalCounts;
+    int _numReports { 0 };
+};
+
+#endif // hifi_ICELoadGenerator_h
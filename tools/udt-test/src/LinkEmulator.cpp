@@ -0,0 +1,127 @@
+//
+//  LinkEmulator.cpp
+//  tools/udt-test/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LinkEmulator.h"
+
+#include <QtCore/QDebug>
+
+#include <udt/Constants.h>
+
+using namespace std::chrono;
+
+static const double BYTES_PER_MEGABIT = 1000000.0 / 8.0;
+static const double USECS_PER_SECOND = 1000000.0;
+
+LinkEmulator::LinkEmulator(const HifiSockAddr& target, int latencyMs, double bandwidthMbps, int queuePackets,
+                           QObject* parent) :
+    QObject(parent),
+    _target(target),
+    _latency(milliseconds(std::max(latencyMs, 0)))
+{
+    _forward.bandwidth = std::max(bandwidthMbps, 0.0) * BYTES_PER_MEGABIT / USECS_PER_SECOND;
+    _maxQueueDelay = _forward.bandwidth > 0.0 ?
+        microseconds((int64_t)(std::max(queuePackets, 1) * udt::MAX_PACKET_SIZE / _forward.bandwidth)) :
+        microseconds(0);
+
+    _socket.bind(QHostAddress::AnyIPv4);
+    connect(&_socket, &QUdpSocket::readyRead, this, &LinkEmulator::readPendingDatagrams);
+
+    _releaseTimer.setSingleShot(true);
+    _releaseTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_releaseTimer, &QTimer::timeout, this, &LinkEmulator::releaseDatagrams);
+
+    qDebug() << "Emulating a link to" << _target << "with" << latencyMs << "ms of latency and"
+        << (bandwidthMbps > 0.0 ? QString("%1 Mb/s").arg(bandwidthMbps) : QString("unlimited bandwidth"))
+        << "- send to" << getAddress();
+}
+
+HifiSockAddr LinkEmulator::getAddress() const {
+    return HifiSockAddr(QHostAddress::LocalHost, _socket.localPort());
+}
+
+int LinkEmulator::takeDroppedPackets() {
+    int droppedPackets = _droppedPackets;
+    _droppedPackets = 0;
+    return droppedPackets;
+}
+
+void LinkEmulator::readPendingDatagrams() {
+    auto now = Clock::now();
+
+    while (_socket.hasPendingDatagrams()) {
+        QByteArray data(_socket.pendingDatagramSize(), 0);
+        HifiSockAddr from;
+        _socket.readDatagram(data.data(), data.size(), from.getAddressPointer(), from.getPortPointer());
+
+        if (from == _target) {
+            if (!_sender.isNull()) {
+                send(_backward, std::move(data), _sender, now);
+            }
+        } else {
+            _sender = from;
+            send(_forward, std::move(data), _target, now);
+        }
+    }
+
+    scheduleRelease();
+}
+
+void LinkEmulator::send(Direction& direction, QByteArray data, const HifiSockAddr& destination, Clock::time_point now) {
+    Clock::time_point departureTime = now;
+
+    if (direction.bandwidth > 0.0) {
+        // the datagram waits for the ones ahead of it to be serialized, unless the queue is already full
+        auto startTime = std::max(now, direction.linkFreeTime);
+        if (startTime - now > _maxQueueDelay) {
+            ++_droppedPackets;
+            return;
+        }
+
+        departureTime = startTime + microseconds((int64_t)(data.size() / direction.bandwidth));
+        direction.linkFreeTime = departureTime;
+    }
+
+    direction.inFlight.push_back({ std::move(data), destination, departureTime + _latency });
+}
+
+void LinkEmulator::releaseDatagrams() {
+    auto now = Clock::now();
+
+    for (auto direction : { &_forward, &_backward }) {
+        while (!direction->inFlight.empty() && direction->inFlight.front().releaseTime <= now) {
+            auto& datagram = direction->inFlight.front();
+            _socket.writeDatagram(datagram.data, datagram.destination.getAddress(), datagram.destination.getPort());
+            direction->inFlight.pop_front();
+        }
+    }
+
+    scheduleRelease();
+}
+
+void LinkEmulator::scheduleRelease() {
+    auto nextRelease = Clock::time_point::max();
+    for (auto direction : { &_forward, &_backward }) {
+        if (!direction->inFlight.empty()) {
+            nextRelease = std::min(nextRelease, direction->inFlight.front().releaseTime);
+        }
+    }
+
+    if (nextRelease == Clock::time_point::max()) {
+        return;
+    }
+
+    // timers have millisecond resolution, datagrams due within the same millisecond go out together
+    auto untilRelease = duration_cast<milliseconds>(nextRelease - Clock::now());
+    int interval = std::max(0, (int)untilRelease.count());
+    if (!_releaseTimer.isActive() || _releaseTimer.remainingTime() > interval) {
+        _releaseTimer.start(interval);
+    }
+}
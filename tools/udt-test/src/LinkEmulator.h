@@ -0,0 +1,77 @@
+//
+//  LinkEmulator.h
+//  tools/udt-test/src
+//
+//  Created on 18 Oct 2026.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LinkEmulator_h
+#define hifi_LinkEmulator_h
+
+#include <deque>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+#include <PortableHighResolutionClock.h>
+
+// An emulated network link between one sender and a target, run in-process as a UDP relay on the loopback interface.
+// Datagrams the sender sends to the relay go out to the target after the one-way latency, serialized at the link
+// bandwidth behind a drop-tail queue, like a bottleneck router would. Datagrams coming back from the target only get
+// the latency. This lets congestion controls be compared on a long or narrow path without a real network.
+class LinkEmulator : public QObject {
+    Q_OBJECT
+public:
+    // a bandwidth of 0 means no bandwidth limit, the queue is the number of full size packets the bottleneck can hold
+    LinkEmulator(const HifiSockAddr& target, int latencyMs, double bandwidthMbps, int queuePackets,
+                 QObject* parent = nullptr);
+
+    HifiSockAddr getAddress() const; // send here to go through the link
+
+    int takeDroppedPackets(); // packets dropped by the queue since the last call
+
+private slots:
+    void readPendingDatagrams();
+    void releaseDatagrams();
+
+private:
+    using Clock = p_high_resolution_clock;
+
+    struct Datagram {
+        QByteArray data;
+        HifiSockAddr destination;
+        Clock::time_point releaseTime;
+    };
+
+    struct Direction {
+        std::deque<Datagram> inFlight; // ordered by release time
+        Clock::time_point linkFreeTime; // when the last queued datagram is done being serialized
+        double bandwidth { 0.0 }; // bytes per microsecond, 0 for no limit
+    };
+
+    void send(Direction& direction, QByteArray data, const HifiSockAddr& destination, Clock::time_point now);
+    void scheduleRelease();
+
+    QUdpSocket _socket;
+    QTimer _releaseTimer;
+
+    HifiSockAddr _target;
+    HifiSockAddr _sender; // the last address that sent to us other than the target
+
+    std::chrono::microseconds _latency;
+    std::chrono::microseconds _maxQueueDelay; // how long the queue takes to drain when full
+    Direction _forward; // sender to target
+    Direction _backward; // target to sender
+
+    int _droppedPackets { 0 };
+};
+
+#endif // hifi_LinkEmulator_h
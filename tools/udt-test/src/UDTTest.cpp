@@ -12,13 +12,24 @@
 #include "UDTTest.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
 
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/TransportEngine.h>
 
 #include <LogHandler.h>
 
+#include "LinkEmulator.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <tlhelp32.h>
+#else
+#include <sys/resource.h>
+#endif
+
 const QCommandLineOption PORT_OPTION { "p", "listening port for socket (defaults to random)", "port", 0 };
 const QCommandLineOption TARGET_OPTION {
     "target", "target for sent packets (default is listen only)",
@@ -55,10 +66,29 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption CONNECTIONS {
+    "connections", "number of concurrent connections to open to the target, each from its own socket (default is 1)",
+    "connections"
+};
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control for sent packets, vegas or bbr (default is vegas)", "name"
+};
+const QCommandLineOption LINK_LATENCY {
+    "link-latency", "send through an emulated link with this one-way latency (default is 0)", "milliseconds"
+};
+const QCommandLineOption LINK_BANDWIDTH {
+    "link-bandwidth", "send through an emulated link with this bandwidth (default is unlimited)", "megabits per second"
+};
+const QCommandLineOption LINK_QUEUE {
+    "link-queue", "packets queued at the emulated link bottleneck before it drops them (default is 100)", "packets"
+};
+const QCommandLineOption LOSS {
+    "loss", "percentage of received data packets to drop, to emulate a lossy link (default is 0)", "percent"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
-    "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
-    "Recv ACK", "Procd ACK", "Sent Packets", "Re-sent Packets"
+    "Send (Mb/s)", "Est. Max (Mb/s)", "Delivery (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
+    "Recv ACK", "Procd ACK", "Sent Packets", "Re-sent Packets", "Link Drops"
 };
 
 const QStringList SERVER_STATS_TABLE_HEADERS {
@@ -66,6 +96,66 @@ const QStringList SERVER_STATS_TABLE_HEADERS {
     "Sent ACK", "Duplicates (P)"
 };
 
+const QStringList AGGREGATE_STATS_TABLE_HEADERS {
+    "Connections", "Threads", "Transport Threads", "CPU (%)", "Goodput (Mb/s)", "Re-sent Packets", "Dropped Packets"
+};
+
+namespace {
+
+// CPU time used by all threads of this process
+double processCPUSeconds() {
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    auto toSeconds = [](const FILETIME& time) {
+        return (double)(((uint64_t)time.dwHighDateTime << 32) | time.dwLowDateTime) / 1.0e7; // 100ns units
+    };
+    return toSeconds(kernelTime) + toSeconds(userTime);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1.0e6;
+#endif
+}
+
+// number of threads in this process, or -1 if we can't tell on this platform
+int processThreadCount() {
+#ifdef Q_OS_WIN
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    int count = 0;
+    THREADENTRY32 entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+        if (entry.th32OwnerProcessID == GetCurrentProcessId()) {
+            ++count;
+        }
+    }
+    CloseHandle(snapshot);
+    return count;
+#elif defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        for (QByteArray line = status.readLine(); !line.isEmpty(); line = status.readLine()) {
+            if (line.startsWith("Threads:")) {
+                return line.mid(strlen("Threads:")).trimmed().toInt();
+            }
+        }
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+}
+
 UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
@@ -166,9 +256,65 @@ UDTTest::UDTTest(int& argc, char** argv) :
     
     // seed the generator with a value that the receiver will also use when verifying the ordered message
     _generator.seed(messageSeed);
+
+    if (_argumentParser.isSet(CONNECTIONS)) {
+        if (!_target.isNull()) {
+            _numConnections = std::max(1, _argumentParser.value(CONNECTIONS).toInt());
+        } else {
+            qWarning() << "connections has no effect if not sending - it will be ignored";
+        }
+    }
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        _congestionControl = _argumentParser.value(CONGESTION_CONTROL);
+        auto factory = udt::createCongestionControlFactory(_congestionControl);
+        if (factory) {
+            _socket.setCongestionControlFactory(std::move(factory));
+            qDebug() << "Using" << _congestionControl << "congestion control";
+        } else {
+            qCritical() << "Unknown congestion control" << _congestionControl;
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
+
+    if (_argumentParser.isSet(LINK_LATENCY) || _argumentParser.isSet(LINK_BANDWIDTH)) {
+        if (_target.isNull()) {
+            qWarning() << "link emulation has no effect if not sending - it will be ignored";
+        } else if (_numConnections > 1) {
+            qWarning() << "link emulation only supports a single connection - it will be ignored";
+        } else {
+            static const int DEFAULT_LINK_QUEUE_PACKETS = 100;
+            int queuePackets = _argumentParser.isSet(LINK_QUEUE) ?
+                _argumentParser.value(LINK_QUEUE).toInt() : DEFAULT_LINK_QUEUE_PACKETS;
+
+            // send to the emulated link instead, which passes the packets on to the real target
+            _linkEmulator = new LinkEmulator(_target, _argumentParser.value(LINK_LATENCY).toInt(),
+                                             _argumentParser.value(LINK_BANDWIDTH).toDouble(), queuePackets, this);
+            _target = _linkEmulator->getAddress();
+        }
+    }
+
+    if (_argumentParser.isSet(LOSS)) {
+        _lossRate = std::min(std::max(_argumentParser.value(LOSS).toDouble(), 0.0), 100.0) / 100.0;
+        qDebug() << "Dropping" << QString("%1%").arg(_lossRate * 100.0) << "of received data packets";
+
+        // data packets go through the filter before their sequence numbers are processed, so a dropped
+        // packet looks exactly like one lost on the wire and is reported and re-sent as such
+        _socket.setPacketFilterOperator([this](const udt::Packet& packet) {
+            if (_lossDistribution(_lossGenerator) < _lossRate) {
+                ++_droppedPackets;
+                return false;
+            }
+            return true;
+        });
+    }
     
     if (!_target.isNull()) {
-        sendInitialPackets();
+        if (_numConnections > 1) {
+            sendInitialPacketsToAllConnections();
+        } else {
+            sendInitialPackets();
+        }
     } else {
         // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
         // so that they can be verified
@@ -224,7 +370,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONNECTIONS, LOSS,
+        CONGESTION_CONTROL, LINK_LATENCY, LINK_BANDWIDTH, LINK_QUEUE
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -245,7 +392,7 @@ void UDTTest::sendInitialPackets() {
     int numPackets = std::max(NUM_INITIAL_PACKETS, _maxSendPackets);
     
     for (int i = 0; i < numPackets; ++i) {
-        sendPacket();
+        sendPacket(_socket);
     }
     
     if (numPackets == NUM_INITIAL_PACKETS) {
@@ -254,7 +401,45 @@ void UDTTest::sendInitialPackets() {
     }
 }
 
-void UDTTest::sendPacket() {
+void UDTTest::sendInitialPacketsToAllConnections() {
+    static const int NUM_INITIAL_PACKETS = 500;
+    static const int MIN_INITIAL_PACKETS_PER_CONNECTION = 8;
+
+    // each connection needs a socket of its own, since connections are keyed by address
+    std::vector<udt::Socket*> sockets { &_socket };
+    for (int i = 1; i < _numConnections; ++i) {
+        _connectionSockets.emplace_back(new udt::Socket(this));
+        _connectionSockets.back()->bind(QHostAddress::AnyIPv4);
+        if (!_congestionControl.isEmpty()) {
+            _connectionSockets.back()->setCongestionControlFactory(udt::createCongestionControlFactory(_congestionControl));
+        }
+        sockets.push_back(_connectionSockets.back().get());
+    }
+    qDebug() << "Opening" << _numConnections << "connections to" << _target;
+
+    // don't let a large number of connections queue up a huge backlog between them
+    int numPacketsPerConnection = std::max(NUM_INITIAL_PACKETS / _numConnections, MIN_INITIAL_PACKETS_PER_CONNECTION);
+
+    for (auto socket : sockets) {
+        for (int i = 0; i < numPacketsPerConnection; ++i) {
+            sendPacket(*socket);
+        }
+
+        // the first packet created the connection, everytime it says a packet has gone out we add a new one
+        QObject* connection = socket->findOrCreateConnection(_target);
+        _socketsByConnection.insert(connection, socket);
+        connect(connection, SIGNAL(packetSent()), this, SLOT(refillConnectionPacket()));
+    }
+}
+
+void UDTTest::refillConnectionPacket() {
+    auto socket = _socketsByConnection.value(sender());
+    if (socket) {
+        sendPacket(*socket);
+    }
+}
+
+void UDTTest::sendPacket(udt::Socket& socket) {
     
     if (_maxSendPackets != -1 && _totalQueuedPackets > _maxSendPackets) {
         // don't send more packets, we've hit max
@@ -310,7 +495,7 @@ void UDTTest::sendPacket() {
             _totalQueuedBytes += (int)packetList->getDataSize();
             _totalQueuedPackets += (int)packetList->getNumPackets();
             
-            _socket.writePacketList(std::move(packetList), _target);
+            socket.writePacketList(std::move(packetList), _target);
         }
         
     } else {
@@ -321,9 +506,9 @@ void UDTTest::sendPacket() {
         
         // queue or send this packet by calling write packet on the socket for our target
         if (_sendReliable) {
-            _socket.writePacket(std::move(newPacket), _target);
+            socket.writePacket(std::move(newPacket), _target);
         } else {
-            _socket.writePacket(*newPacket, _target);
+            socket.writePacket(*newPacket, _target);
         }
         
         ++_totalQueuedPackets;
@@ -365,7 +550,14 @@ void UDTTest::sampleStats() {
     static const double PPS_TO_MBPS = udt::MAX_PACKET_SIZE * MEGABITS_PER_BYTE;
 
 
-    if (!_target.isNull()) {
+    // with loss emulation on, report throughput and CPU together
+    if (!_target.isNull() && (_numConnections > 1 || _lossRate > 0.0)) {
+        std::vector<udt::ConnectionStats::Stats> connectionStats { _socket.sampleStatsForConnection(_target) };
+        for (auto& socket : _connectionSockets) {
+            connectionStats.push_back(socket->sampleStatsForConnection(_target));
+        }
+        sampleAggregateStats(connectionStats);
+    } else if (!_target.isNull()) {
         if (first) {
             // output the headers for stats for our table
             qDebug() << qPrintable(CLIENT_STATS_TABLE_HEADERS.join(" | "));
@@ -380,26 +572,36 @@ void UDTTest::sampleStats() {
         QStringList values {
             QString::number(stats.sendRate * PPS_TO_MBPS).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.estimatedBandwith * PPS_TO_MBPS).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.deliveryRateBytes * MEGABITS_PER_BYTE, 'f', 2).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.congestionWindowSize).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.packetSendPeriod).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.events[udt::ConnectionStats::Stats::ReceivedACK]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.events[udt::ConnectionStats::Stats::ProcessedACK]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.sentPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
-            QString::number(stats.retransmittedPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
+            QString::number(stats.retransmittedPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(_linkEmulator ? _linkEmulator->takeDroppedPackets() : 0).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
         };
         
         // output this line of values
         qDebug() << qPrintable(values.join(" | "));
     } else {
-        if (first) {
+        auto sockets = _socket.getConnectionSockAddrs();
+
+        if (first && sockets.size() <= 1 && _lossRate == 0.0) {
             // output the headers for stats for our table
             qDebug() << qPrintable(SERVER_STATS_TABLE_HEADERS.join(" | "));
             first = false;
         }
         
-        auto sockets = _socket.getConnectionSockAddrs();
-        if (sockets.size() > 0) {
+        if (sockets.size() > 1 || (sockets.size() > 0 && _lossRate > 0.0)) {
+            // we're receiving from several connections, report on all of them together
+            std::vector<udt::ConnectionStats::Stats> connectionStats;
+            for (auto& addressStats : _socket.sampleStatsForAllConnections()) {
+                connectionStats.push_back(addressStats.second);
+            }
+            sampleAggregateStats(connectionStats);
+        } else if (sockets.size() > 0) {
             udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(sockets.front());
             
             int headerIndex = -1;
@@ -422,3 +624,50 @@ void UDTTest::sampleStats() {
         }
     }
 }
+
+void UDTTest::sampleAggregateStats(const std::vector<udt::ConnectionStats::Stats>& connectionStats) {
+    static bool first = true;
+    static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+    static const double MS_PER_SECOND = 1000.0;
+
+    if (first) {
+        // output the headers for stats for our table
+        qDebug() << qPrintable(AGGREGATE_STATS_TABLE_HEADERS.join(" | "));
+        first = false;
+
+        _lastProcessCPUSeconds = processCPUSeconds();
+        _aggregateStatsTimer.start();
+        return;
+    }
+
+    // goodput only counts the first copy of each payload - re-sent and duplicate packets are overhead
+    uint64_t goodputBytes = 0;
+    uint32_t retransmittedPackets = 0;
+    for (const auto& stats : connectionStats) {
+        goodputBytes += _target.isNull() ? stats.receivedUtilBytes - stats.duplicateUtilBytes : stats.sentUtilBytes;
+        retransmittedPackets += stats.retransmittedPackets;
+    }
+
+    double elapsedSeconds = std::max<qint64>(_aggregateStatsTimer.restart(), 1) / MS_PER_SECOND;
+    double cpuSeconds = processCPUSeconds();
+    double cpuPercent = 100.0 * (cpuSeconds - _lastProcessCPUSeconds) / elapsedSeconds;
+    _lastProcessCPUSeconds = cpuSeconds;
+
+    int threadCount = processThreadCount();
+
+    int headerIndex = -1;
+
+    // setup a list of left justified values
+    QStringList values {
+        QString::number(connectionStats.size()).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size()),
+        (threadCount >= 0 ? QString::number(threadCount) : QString("?")).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(udt::TransportEngine::getInstance().getThreadCount()).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(cpuPercent, 'f', 1).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(goodputBytes * MEGABITS_PER_BYTE / elapsedSeconds, 'f', 2).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(retransmittedPackets).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(_droppedPackets.exchange(0)).rightJustified(AGGREGATE_STATS_TABLE_HEADERS[++headerIndex].size())
+    };
+
+    // output this line of values
+    qDebug() << qPrintable(values.join(" | "));
+}
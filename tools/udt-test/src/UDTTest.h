@@ -15,16 +15,21 @@
 #define hifi_UDTTest_h
 
 
+#include <atomic>
 #include <random>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 
 #include <udt/Constants.h>
 #include <udt/Socket.h>
 
 #include <ReceivedMessage.h>
 
+class LinkEmulator;
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -36,7 +41,8 @@ public:
     UDTTest(int& argc, char** argv);
 
 public slots:
-    void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
+    void refillPacket() { sendPacket(_socket); } // adds a new packet to the queue when we are told one is sent
+    void refillConnectionPacket(); // same as refillPacket, for the connection that sent the signal
     void sampleStats();
     
 private:
@@ -44,10 +50,28 @@ private:
     void handleMessage(std::unique_ptr<Message> message);
     
     void sendInitialPackets(); // fills the queue with packets to start
-    void sendPacket(); // constructs and sends a packet according to the test parameters
+    void sendInitialPacketsToAllConnections(); // same as sendInitialPackets, split over all the connections
+    void sendPacket(udt::Socket& socket); // constructs and sends a packet according to the test parameters
+
+    void sampleAggregateStats(const std::vector<udt::ConnectionStats::Stats>& connectionStats);
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
+
+    int _numConnections { 1 }; // the number of concurrent connections to open to the target
+    std::vector<std::unique_ptr<udt::Socket>> _connectionSockets; // one socket per connection beyond the first
+    QHash<QObject*, udt::Socket*> _socketsByConnection; // the socket to refill when a connection sends a packet
+
+    QString _congestionControl; // name of the congestion control for our sockets, empty for the default
+    LinkEmulator* _linkEmulator { nullptr }; // the emulated link our packets go through, if any
+
+    double _lossRate { 0.0 }; // fraction of received data packets dropped to emulate a lossy link
+    std::mt19937 _lossGenerator { 1 }; // only used from the socket thread, by the packet filter
+    std::uniform_real_distribution<double> _lossDistribution { 0.0, 1.0 };
+    std::atomic<uint64_t> _droppedPackets { 0 }; // dropped since the last stats sample
+
+    QElapsedTimer _aggregateStatsTimer;
+    double _lastProcessCPUSeconds { 0.0 };
     
     HifiSockAddr _target; // the target for sent packets
     